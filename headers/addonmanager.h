@@ -3,19 +3,13 @@
 
 #include "gpaddon.h"
 
+#include <string>
 #include <vector>
 
-enum ADDON_PROCESS {
-    CORE0_INPUT,
-    CORE0_USBREPORT,
-    CORE1_ALWAYS,
-    CORE1_LOOP
-};
-
-struct AddonBlock {
-    GPAddon * ptr;
-    ADDON_PROCESS process;
-};
+// Add-ons one manager can hold, available add-ons past this are not loaded
+#ifndef ADDON_MANAGER_MAX_ADDONS
+#define ADDON_MANAGER_MAX_ADDONS 32
+#endif
 
 class AddonManager {
 public:
@@ -29,7 +23,19 @@ public:
     void PostprocessAddons(bool);
     GPAddon * GetAddon(std::string); // hack for NeoPicoLED
 private:
-    std::vector<AddonBlock*> addons;    // addons currently loaded
+    // Add-ons that do work in one phase, as indexes into addons in load order
+    struct PhaseList {
+        uint8_t count = 0;
+        uint8_t index[ADDON_MANAGER_MAX_ADDONS];
+
+        void add(uint8_t i) { index[count++] = i; }
+    };
+
+    GPAddon * addons[ADDON_MANAGER_MAX_ADDONS];     // addons currently loaded
+    uint8_t addonCount = 0;
+    PhaseList preprocessList;
+    PhaseList processList;
+    PhaseList postprocessList;
 };
 
 #endif
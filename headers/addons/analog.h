@@ -135,6 +135,7 @@ typedef struct
 class AnalogInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // Analog Setup
     virtual void process();     // Analog Process
     virtual void preprocess() {}
@@ -27,6 +27,8 @@
 class BoardLedAddon : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
+    virtual ADDON_PROCESS core() { return CORE1_LOOP; }
     virtual void setup();       // BoardLed Setup
     virtual void process();     // BoardLed Process
     virtual void preprocess() {}
@@ -18,6 +18,7 @@
 class BootselButtonAddon : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PREPROCESS; }
     virtual void setup();       // BootselButton Setup
     virtual void process() {}     // BootselButton Process
     virtual void preprocess();
@@ -19,6 +19,7 @@
 class DualDirectionalInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PREPROCESS | ADDON_PHASE_PROCESS; }
     virtual void setup();       // Dual Directional Setup
     virtual void process();     // Dual Directional Process
     virtual void postprocess(bool sent) {}
@@ -27,14 +28,13 @@ public:
     virtual std::string name() { return DualDirectionalName; }
 private:
     uint8_t gpadToBinary(DpadMode, GamepadState);
-    uint8_t updateDpadDDI(uint8_t dpad, DpadDirection direction);
-    uint8_t filterToFourWayModeDDI(uint8_t dpad);
     void SOCDDualClean(SOCDMode);
     uint8_t SOCDCombine(SOCDMode, uint8_t);
     uint8_t SOCDGamepadClean(uint8_t, bool isLastWin);
     void OverrideGamepad(Gamepad *, DpadMode, uint8_t);
     const SOCDMode getSOCDMode(const GamepadOptions&);
     uint8_t dualState;          // Dual Directional State
+    DpadFilter dpadFilter;      // Dual Directional 4-way history
     DpadDirection lastGPUD; // Gamepad Last Up-Down
     DpadDirection lastGPLR; // Gamepad Last Left-Right
     DpadDirection lastDualUD; // Dual Last Up-Down
@@ -38,6 +38,7 @@
 class FocusModeAddon : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // FocusMode Setup
     virtual void process();     // FocusMode Process
     virtual void preprocess() {}
@@ -17,6 +17,7 @@
 class GamepadUSBHostAddon : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PREPROCESS; }
     virtual void setup();       // GamepadUSBHost Setup
     virtual void process() {}   // GamepadUSBHost Process
     virtual void preprocess();
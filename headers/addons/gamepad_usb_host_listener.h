@@ -7,6 +7,7 @@
 #include "drivers/ps3/PS3Descriptors.h"
 #include "drivers/ps4/PS4Descriptors.h"
 #include "drivers/ps4/PS4Driver.h"
+#include "drivers/shared/hidreportplan.h"
 
 #define GAMEPAD_HOST_DEBUG false
 #define GAMEPAD_HOST_USE_FEATURES true
@@ -110,12 +111,44 @@ typedef struct __attribute__((packed)) {
     uint8_t miscData[54];
 } DSReport;
 
+// Controllers merged into the gamepad state at once, the host never mounts more HID interfaces
+#define GAMEPAD_HOST_MAX_DEVICES CFG_TUH_HID
+
+// Stick travel from center before a later controller's stick is used over an earlier resting one
+#define GAMEPAD_HOST_STICK_DEADZONE 0x0800
+
+// One mounted controller interface and the state its reports last set
+struct GamepadHostDevice {
+    bool enabled;
+    uint8_t dev_addr;
+    uint8_t instance;
+    uint16_t vid;
+    uint16_t pid;
+    GamepadState state;
+
+    bool awaiting_cb;
+    bool isDS4Identified;
+    bool hasDS4DefReport;
+    bool isDFInit;
+    PS4ControllerConfig ds4Config;
+    uint8_t report_buffer[PS4_ENDPOINT_SIZE];
+
+    // previous report used to compare for changes
+    union {
+        PS4Report ds4;
+        DSReport ds;
+    } prev_report;
+
+    // controllers without a hand-tuned handler, decoded from their report descriptor
+    HIDReportPlan plan;
+};
+
 // Add other controller structs here
 class GamepadUSBHostListener : public USBListener {
     public:// USB Listener Features
         virtual void setup();
-        virtual void mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len);
-        virtual void xmount(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype) {}
+        virtual bool mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len);
+        virtual bool xmount(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype) { return false; }
         virtual void unmount(uint8_t dev_addr);
         virtual void report_received(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len);
         virtual void report_sent(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {}
@@ -123,37 +156,29 @@ class GamepadUSBHostListener : public USBListener {
         virtual void get_report_complete(uint8_t dev_addr, uint8_t instance, uint8_t report_id, uint8_t report_type, uint16_t len);
         void process();
     private:
-        bool awaiting_cb = false;
-        bool host_get_report(uint8_t report_id, void* report, uint16_t len);
-        bool host_set_report(uint8_t report_id, void* report, uint16_t len);
+        GamepadHostDevice _devices[GAMEPAD_HOST_MAX_DEVICES];
+        GamepadHostDevice* find_device(uint8_t dev_addr, uint8_t instance);
 
-        GamepadState _controller_host_state;
-        bool _controller_host_enabled;
-        uint8_t _controller_dev_addr = 0;
-        uint8_t _controller_instance = 0;
-        void process_ctrlr_report(uint8_t dev_addr, uint8_t const* report, uint16_t len);
+        bool host_get_report(GamepadHostDevice& device, uint8_t report_id, void* report, uint16_t len);
+        bool host_set_report(GamepadHostDevice& device, uint8_t report_id, void* report, uint16_t len);
+
+        void process_ctrlr_report(GamepadHostDevice& device, uint8_t const* report, uint16_t len);
 
         // Controller report processor functions
-        bool isDS4Identified = false;
-        bool hasDS4DefReport = false;
         // ds4 initialization step, if needed
-        void init_ds4(const uint8_t* descReport, uint16_t descLen);
+        void init_ds4(GamepadHostDevice& device, const uint8_t* descReport, uint16_t descLen);
         // general ds4 setup
-        void setup_ds4();
+        void setup_ds4(GamepadHostDevice& device);
         // update ds4 output reporting
-        void update_ds4();
+        void update_ds4(GamepadHostDevice& device);
         // handle ds4 input reporting
-        void process_ds4(uint8_t const* report, uint16_t len);
-        PS4ControllerConfig ds4Config;
-        uint8_t report_buffer[PS4_ENDPOINT_SIZE];
-
-        void process_ds(uint8_t const* report, uint16_t len);
+        void process_ds4(GamepadHostDevice& device, uint8_t const* report, uint16_t len);
 
-        void process_stadia(uint8_t const* report, uint16_t len);
+        void process_ds(GamepadHostDevice& device, uint8_t const* report, uint16_t len);
 
-        void process_ultrastik360(uint8_t const* report, uint16_t len);
+        void process_stadia(GamepadHostDevice& device, uint8_t const* report, uint16_t len);
 
-        uint16_t controller_pid, controller_vid;
+        void process_ultrastik360(GamepadHostDevice& device, uint8_t const* report, uint16_t len);
 
         uint16_t map(uint8_t x, uint8_t in_min, uint8_t in_max, uint16_t out_min, uint16_t out_max);
 
@@ -163,9 +188,8 @@ class GamepadUSBHostListener : public USBListener {
         bool diff_report(PS4Report const* rpt1, PS4Report const* rpt2);
 
         // wheel check
-        bool isDFInit = false;
-        void setup_df_wheel();
-        void process_dfgt(uint8_t const* report, uint16_t len);
+        void setup_df_wheel(GamepadHostDevice& device);
+        void process_dfgt(GamepadHostDevice& device, uint8_t const* report, uint16_t len);
 };
 
 #endif
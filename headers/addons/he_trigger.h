@@ -551,6 +551,7 @@
 class HETriggerAddon : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PREPROCESS; }
     virtual void setup();
     virtual void process() {}
     virtual void preprocess();
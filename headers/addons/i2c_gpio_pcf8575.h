@@ -139,6 +139,7 @@
 class PCF8575Addon : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();
     virtual void preprocess() {}
     virtual void process();
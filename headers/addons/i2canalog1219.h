@@ -42,6 +42,7 @@ typedef struct {
 class I2CAnalog1219Input : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // Analog Setup
     virtual void preprocess() {}
     virtual void process();     // Analog Process
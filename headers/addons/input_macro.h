@@ -35,6 +35,7 @@
 class InputMacro : public GPAddon {
 public:
     virtual bool available();   // GPAddon available
+    virtual uint8_t phases() { return ADDON_PHASE_PREPROCESS; }
     virtual void setup();       // Analog Setup
     virtual void process() {};     // Analog Process
     virtual void preprocess();
@@ -29,6 +29,7 @@
 class KeyboardHostAddon : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PREPROCESS; }
     virtual void setup();       // KeyboardHost Setup
     virtual void process() {}   // KeyboardHost Process
     virtual void preprocess();
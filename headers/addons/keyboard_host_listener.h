@@ -5,6 +5,9 @@
 #include "gamepad.h"
 #include "class/hid/hid.h"
 
+// Keyboards merged into the gamepad state at once, the host never mounts more HID interfaces
+#define KEYBOARD_HOST_MAX_KEYBOARDS CFG_TUH_HID
+
 struct KeyboardButtonMapping
 {
     uint8_t key;
@@ -22,12 +25,22 @@ struct KeyboardButtonMapping
     bool isAssigned() const { return key != 0xff; }
 };
 
+// Inputs held on one mounted keyboard
+struct KeyboardHostDevice
+{
+    bool mounted;
+    uint8_t dev_addr;
+    uint8_t instance;
+    uint8_t dpad;
+    uint32_t buttons;
+};
+
 
 class KeyboardHostListener : public USBListener {
 public:// USB Listener Features
     virtual void setup();
-    virtual void mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len);
-    virtual void xmount(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype) {}
+    virtual bool mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len);
+    virtual bool xmount(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype) { return false; }
     virtual void unmount(uint8_t dev_addr);
     virtual void report_received(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len);
     virtual void report_sent(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {}
@@ -37,7 +50,7 @@ public:// USB Listener Features
 private:
     uint8_t getKeycodeFromModifier(uint8_t modifier);
     void preprocess_report();
-    void process_kbd_report(uint8_t dev_addr, hid_keyboard_report_t const *report);
+    void process_kbd_report(KeyboardHostDevice& keyboard, hid_keyboard_report_t const *report);
     void process_mouse_report(uint8_t dev_addr, hid_mouse_report_t const *report);
     uint16_t scaleMouseToJoystick(int8_t mouseVal);
     KeyboardButtonMapping _keyboard_host_mapDpadUp;
@@ -60,10 +73,9 @@ private:
     KeyboardButtonMapping _keyboard_host_mapButtonA2;
     KeyboardButtonMapping _keyboard_host_mapButtonA3;
     KeyboardButtonMapping _keyboard_host_mapButtonA4;
-    GamepadState _keyboard_host_state;
-    bool _keyboard_host_mounted;
-    uint8_t _keyboard_dev_addr;
-    uint8_t _keyboard_instance;
+    GamepadState _keyboard_host_state;     // Mouse buttons and movement
+    KeyboardHostDevice _keyboards[KEYBOARD_HOST_MAX_KEYBOARDS];
+    uint8_t _keyboards_mounted;
     bool _mouse_host_mounted;
     uint8_t _mouse_dev_addr;
     uint8_t _mouse_instance;
@@ -35,6 +35,8 @@ class PlayerLEDAddon : public GPAddon
 {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
+    virtual ADDON_PROCESS core() { return CORE1_LOOP; }
     virtual void setup();
     virtual void preprocess() {}
     virtual void process();
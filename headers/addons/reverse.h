@@ -39,6 +39,7 @@
 class ReverseInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // Reverse Button Setup
     virtual void preprocess() {}
     virtual void process();     // Reverse process
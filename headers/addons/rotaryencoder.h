@@ -84,6 +84,7 @@
 class RotaryEncoderInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // Rotary Setup
     virtual void preprocess() {}
     virtual void process();     // Rotary process
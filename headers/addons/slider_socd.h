@@ -28,6 +28,7 @@
 class SliderSOCDInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // SliderSOCD Button Setup
     virtual void reinit();
     virtual void preprocess() {}
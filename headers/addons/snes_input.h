@@ -31,6 +31,7 @@
 class SNESpadInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // SNESpad Setup
     virtual void process();     // SNESpad Process
     virtual void preprocess() {}
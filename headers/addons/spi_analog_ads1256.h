@@ -35,6 +35,7 @@
 class SPIAnalog1256Input : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // Analog Setup
     virtual void preprocess() {}
     virtual void process();     // Analog Process
@@ -39,6 +39,7 @@
 class TG16padInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // TG16pad Setup
     virtual void process();     // TG16pad Process
     virtual void preprocess() {}
@@ -93,6 +93,7 @@
 class TiltInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PREPROCESS | ADDON_PHASE_PROCESS; }
     virtual void setup();       // Tilt Setup
     virtual void process();     // Tilt Process
     virtual void preprocess();  // Tilt Pre-Process (Cheat)
@@ -102,6 +102,7 @@
 class TurboInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // TURBO Button Setup
     virtual void reinit();
     virtual void preprocess() {}
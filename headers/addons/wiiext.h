@@ -81,6 +81,7 @@ typedef struct {
 class WiiExtensionInput : public GPAddon {
 public:
     virtual bool available();
+    virtual uint8_t phases() { return ADDON_PHASE_PROCESS; }
     virtual void setup();       // WiiExtension Setup
     virtual void process();     // WiiExtension Process
     virtual void preprocess() {}
@@ -0,0 +1,58 @@
+#ifndef _BOOTTIMELINE_H_
+#define _BOOTTIMELINE_H_
+
+#include <stdint.h>
+
+#include "pico/time.h"
+
+// Boot milestones, in the order a regular boot reaches them
+typedef enum {
+	BOOT_STAGE_STORAGE = 0,     // Config loaded
+	BOOT_STAGE_PERIPHERALS,     // USB host, SPI and I2C initialized
+	BOOT_STAGE_GAMEPAD,         // Gamepad and button GPIO set up
+	BOOT_STAGE_ADDONS,          // Core0 addons loaded
+	BOOT_STAGE_BOOT_ACTION,     // Boot buttons read
+	BOOT_STAGE_DRIVER,          // Input driver set up
+	BOOT_STAGE_CORE1_READY,     // Core1 setup done, core0 released
+	BOOT_STAGE_USB_INIT,        // TinyUSB device stack started
+	BOOT_STAGE_USB_MOUNTED,     // Host configured the device
+	BOOT_STAGE_FIRST_REPORT,    // First report handed to the host
+	BOOT_STAGE_CORE1_ADDONS,    // Deferred core1 addons loaded (fast boot)
+	BOOT_STAGE_COUNT
+} BootStage;
+
+/**
+ * @brief Timestamps of the boot milestones, in microseconds since reset.
+ *
+ * Stages are marked once, a stage that was not reached stays at 0. The timeline of the last gamepad
+ * mode boot is kept in uninitialized RAM so it survives the reboot into web config, where
+ * /api/getBootTimeline reads it next to the timeline of the current boot.
+ */
+class BootTimeline {
+public:
+	BootTimeline(BootTimeline const&) = delete;
+	void operator=(BootTimeline const&)  = delete;
+	static BootTimeline& getInstance() {
+		static BootTimeline instance;
+		return instance;
+	}
+
+	void mark(BootStage stage);
+	bool reached(BootStage stage) const { return stages[stage] != 0; }
+	uint32_t get(BootStage stage) const { return stages[stage]; }
+
+	void keep(bool enabled);
+	bool hasKept() const;
+	uint32_t getKept(BootStage stage) const;
+
+	static const char* getStageName(BootStage stage);
+private:
+	BootTimeline() {}
+
+	void store();
+
+	volatile uint32_t stages[BOOT_STAGE_COUNT] = {};
+	bool keepEnabled = false;
+};
+
+#endif
@@ -5,13 +5,20 @@
 #include <string>
 
 namespace ConfigUtils {
-    void load(Config& config);
+    // Returns true when the display, LED and animation sections were left for loadDeferred()
+    bool load(Config& config);
+    void loadDeferred(Config& config);
     bool save(Config& config);
     
     void initUnsetPropertiesWithDefaults(Config& config);
 
     std::string toJSON(const Config& config);
     bool fromJSON(Config& config, const char* data, size_t dataLen);
+    bool patchJSON(Config& config, const char* data, size_t dataLen);
+
+    // Encoded the same way as in flash
+    std::string toBinary(Config& config);
+    bool fromBinary(Config& config, const uint8_t* data, size_t dataLen);
     bool fromLegacyStorage(Config& config);
 }
 
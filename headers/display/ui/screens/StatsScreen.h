@@ -21,6 +21,7 @@ class StatsScreen : public GPScreen {
         GPLabel* board;
         GPLabel* boardType;
         GPLabel* arch;
+        GPLabel* loopTime;
         GPLabel* exit;
 };
 
@@ -32,8 +32,6 @@ private:
 	void pressKey(uint8_t code);
     uint8_t getModifier(uint8_t code);
     uint8_t getMultimedia(uint8_t code);
-    uint8_t last_report[CFG_TUD_ENDPOINT0_SIZE] = { };
-    uint16_t last_report_size;
     KeyboardReport keyboardReport;
     int8_t volumeChange;
 };
@@ -26,7 +26,6 @@ public:
     virtual uint16_t GetJoystickMidValue();
     virtual USBListener * get_usb_auth_listener() { return nullptr; }
 private:
-    uint8_t last_report[CFG_TUD_ENDPOINT0_SIZE] = { };
     MDMiniReport mdminiReport;
 };
 
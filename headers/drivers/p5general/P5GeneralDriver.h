@@ -38,7 +38,6 @@ public:
     bool getDongleAuthRequired();
 private:
     P5GenerorReport p5GeneralReport;
-    P5GenerorReport p5GeneralReport_last;
     TouchpadData touchpadData;
     //PSSensor gyroscope;
     //PSSensor accelerometer;
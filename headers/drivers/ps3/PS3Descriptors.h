@@ -68,6 +68,27 @@
 #define PS3_MASK_PS       (1U << 12)
 #define PS3_MASK_TP       (1U << 13)
 
+// Digital buttons of PS3Report, bytes 2 to 4 read as one little endian value
+#define PS3_REPORT_BUTTONS_OFFSET 2
+#define PS3_REPORT_MASK_SELECT    (1U <<  0)
+#define PS3_REPORT_MASK_L3        (1U <<  1)
+#define PS3_REPORT_MASK_R3        (1U <<  2)
+#define PS3_REPORT_MASK_START     (1U <<  3)
+#define PS3_REPORT_MASK_UP        (1U <<  4)
+#define PS3_REPORT_MASK_RIGHT     (1U <<  5)
+#define PS3_REPORT_MASK_DOWN      (1U <<  6)
+#define PS3_REPORT_MASK_LEFT      (1U <<  7)
+#define PS3_REPORT_MASK_L2        (1U <<  8)
+#define PS3_REPORT_MASK_R2        (1U <<  9)
+#define PS3_REPORT_MASK_L1        (1U << 10)
+#define PS3_REPORT_MASK_R1        (1U << 11)
+#define PS3_REPORT_MASK_NORTH     (1U << 12)
+#define PS3_REPORT_MASK_EAST      (1U << 13)
+#define PS3_REPORT_MASK_SOUTH     (1U << 14)
+#define PS3_REPORT_MASK_WEST      (1U << 15)
+#define PS3_REPORT_MASK_PS        (1U << 16)
+#define PS3_REPORT_MASK_TP        (1U << 17)
+
 // HID analog sticks only report 8 bits
 #define PS3_JOYSTICK_MIN 0x00
 #define PS3_JOYSTICK_MID 0x7F
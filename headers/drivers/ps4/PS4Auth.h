@@ -2,8 +2,12 @@
 #define _PS4AUTH_H_
 
 #include "drivers/shared/gpauthdriver.h"
+#include "drivers/ps4/PS4AuthSigner.h"
 #include "mbedtls/rsa.h"
 
+// Time Core1 spends signing per processAux() pass in key mode, the signature is built over as many passes as it takes
+#define PS4_AUTH_SIGN_SLICE_US 500
+
 // PS4 Auth Data in a single struct
 typedef struct {
     struct mbedtls_rsa_context rsa_context;
@@ -19,13 +23,15 @@ public:
     PS4Auth(InputModeAuthType inType) { authType = inType; }
     virtual void initialize();
     virtual bool available();
-    void process();
+    void process(uint32_t budgetUs);
     PS4AuthData * getAuthData() { return &ps4AuthData; }
     void resetAuth();
 private:
     void keyModeInitialize();
-    void keyModeProcess();
+    void keyModeProcess(uint32_t budgetUs);
     PS4AuthData ps4AuthData;
+    PS4AuthSigner * signer = nullptr;
+    uint8_t signingNonceId = 0;
 };
 
 #endif
@@ -0,0 +1,100 @@
+#ifndef _PS4AUTHSIGNER_H_
+#define _PS4AUTHSIGNER_H_
+
+#include <stdint.h>
+
+#include "mbedtls/sha256.h"
+
+#define PS4_AUTH_SIGNATURE_SIZE 256                             // RSA-2048 modulus and signature
+#define PS4_AUTH_NONCE_SIZE 256
+#define PS4_AUTH_PRIME_SIZE (PS4_AUTH_SIGNATURE_SIZE / 2)
+#define PS4_AUTH_PRIME_LIMBS (PS4_AUTH_PRIME_SIZE / 4)
+#define PS4_AUTH_WINDOW_BITS 4                                  // Fixed exponent window, 16 table entries per prime
+#define PS4_AUTH_WINDOW_TABLE (1 << PS4_AUTH_WINDOW_BITS)
+#define PS4_AUTH_WINDOWS (PS4_AUTH_PRIME_LIMBS * 32 / PS4_AUTH_WINDOW_BITS)
+
+typedef enum {
+    PS4_AUTH_SIGNER_IDLE = 0,
+    PS4_AUTH_SIGNER_HASH,           // SHA-256 of the nonce, one block per step
+    PS4_AUTH_SIGNER_ENCODE,         // EMSA-PSS hash of salt and nonce hash
+    PS4_AUTH_SIGNER_MASK,           // EMSA-PSS MGF1 mask, one hash per step
+    PS4_AUTH_SIGNER_EXP_P,          // Encoded message ^ DP mod P, one Montgomery row per step
+    PS4_AUTH_SIGNER_EXP_Q,          // Encoded message ^ DQ mod Q
+    PS4_AUTH_SIGNER_COMBINE,        // Garner recombination of both halves
+    PS4_AUTH_SIGNER_DONE,
+} PS4AuthSignerStage;
+
+// One prime of the private key and its Montgomery constants, all little endian 32-bit limbs
+typedef struct {
+    uint32_t m[PS4_AUTH_PRIME_LIMBS];           // P or Q
+    uint32_t exponent[PS4_AUTH_PRIME_LIMBS];    // DP or DQ
+    uint32_t one[PS4_AUTH_PRIME_LIMBS];         // R mod m, R = 2^1024
+    uint32_t rr[PS4_AUTH_PRIME_LIMBS];          // R^2 mod m
+    uint32_t rrr[PS4_AUTH_PRIME_LIMBS];         // R^3 mod m
+    uint32_t mInv;                              // -m^-1 mod 2^32
+} PS4AuthPrime;
+
+/**
+ * @brief RSASSA-PSS (SHA-256) signature of a PS4 nonce, computed a small step at a time.
+ *
+ * Signing with a 2048-bit key takes far longer than a Core1 loop pass, and used to stall the display, LEDs and
+ * every other Core1 add-on until it was done. The signer instead keeps the whole computation as resumable
+ * state: hash blocks, mask hashes and single rows of a Montgomery multiplication are the steps, each a few
+ * tens of microseconds at most, so the caller can stop at any budget and resume on its next pass.
+ *
+ * The private operation uses CRT with the P, Q, DP, DQ and QP given to setKey(), and the Montgomery constants
+ * for both primes are computed there once rather than per signature.
+ */
+class PS4AuthSigner {
+public:
+    PS4AuthSigner() {}
+
+    // Big endian P, Q, DP, DQ and QP of a 2048-bit key, PS4_AUTH_PRIME_SIZE bytes each. False if unusable.
+    bool setKey(const uint8_t * p, const uint8_t * q, const uint8_t * dp, const uint8_t * dq, const uint8_t * qp);
+
+    // Start signing nonce, the signature is written over signature once the last step ran (both may be the same buffer)
+    void start(const uint8_t * nonce, uint8_t * signature);
+
+    // Run one step, true once the signature has been written
+    bool step();
+
+    void cancel() { stage = PS4_AUTH_SIGNER_IDLE; }
+    bool isBusy() const { return stage != PS4_AUTH_SIGNER_IDLE && stage != PS4_AUTH_SIGNER_DONE; }
+    PS4AuthSignerStage getStage() const { return stage; }
+private:
+    bool queueExponentOp();
+    bool queueCombineOp();
+    void startMul(const PS4AuthPrime * prime, const uint32_t * a, const uint32_t * b, uint32_t * out);
+    bool stepMul();
+    void montMul(const PS4AuthPrime * prime, const uint32_t * a, const uint32_t * b, uint32_t * out);
+
+    PS4AuthPrime primes[2];                                 // P then Q
+    uint32_t qp[PS4_AUTH_PRIME_LIMBS];                      // Q^-1 mod P
+
+    PS4AuthSignerStage stage = PS4_AUTH_SIGNER_IDLE;
+    const uint8_t * nonce = nullptr;
+    uint8_t * signature = nullptr;
+    uint16_t counter = 0;                                   // Hash block, mask block, exponent or combine op of the stage
+    mbedtls_sha256_context sha;
+    uint8_t hash[32];
+    uint8_t salt[32];
+    uint8_t encoded[PS4_AUTH_SIGNATURE_SIZE];               // EMSA-PSS encoded message, big endian
+
+    // Current Montgomery multiplication, out is only written by its last row so it may alias a or b
+    const PS4AuthPrime * mulPrime = nullptr;
+    const uint32_t * mulA = nullptr;
+    const uint32_t * mulB = nullptr;
+    uint32_t * mulOut = nullptr;
+    uint8_t mulRow = 0;
+    bool mulActive = false;
+    uint32_t mulSum[PS4_AUTH_PRIME_LIMBS + 2];
+
+    uint32_t message[PS4_AUTH_PRIME_LIMBS * 2];             // Encoded message as an integer, then the signature
+    uint32_t table[PS4_AUTH_WINDOW_TABLE][PS4_AUTH_PRIME_LIMBS];
+    uint32_t acc[PS4_AUTH_PRIME_LIMBS];
+    uint32_t halfP[PS4_AUTH_PRIME_LIMBS];                   // Message ^ DP mod P, Montgomery form
+    uint32_t halfQ[PS4_AUTH_PRIME_LIMBS];                   // Message ^ DQ mod Q
+    uint32_t temp[PS4_AUTH_PRIME_LIMBS];
+};
+
+#endif
@@ -55,13 +55,11 @@ public:
     bool getAuthSent() { return authsent;}
     bool getDongleAuthRequired();
 private:
-    uint8_t last_report[CFG_TUD_ENDPOINT0_SIZE] = { };
     uint8_t last_report_counter;
     uint16_t last_axis_counter;
     PS4Report ps4Report;
     TouchpadData touchpadData;
     PSSensorData sensorData;
-    uint32_t last_report_timer;
     PS4Auth * ps4AuthDriver;
     PS4AuthData * ps4AuthData;      // PS4 Authentication Data
     uint8_t cur_nonce_chunk;            // PS4 Encryption Nonce Chunk (Max 19)
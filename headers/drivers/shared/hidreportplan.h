@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#ifndef _HID_REPORT_PLAN_H_
+#define _HID_REPORT_PLAN_H_
+
+#include <stdint.h>
+
+#include "gamepad/GamepadState.h"
+
+// Fields kept per plan, runs of buttons that land on consecutive gamepad bits share one
+#define HID_REPORT_PLAN_MAX_FIELDS 24
+
+// Widest field read from a report, wider axes are skipped
+#define HID_REPORT_PLAN_MAX_BITS 24
+
+// Gamepad state a compiled field is written to
+enum HIDReportTarget : uint8_t {
+	HID_REPORT_TARGET_BUTTONS,      // state.buttons, from bitShift up
+	HID_REPORT_TARGET_DPAD,         // state.dpad, from bitShift up
+	HID_REPORT_TARGET_HAT,          // state.dpad, from a 4 or 8 position hat switch
+	HID_REPORT_TARGET_LX,
+	HID_REPORT_TARGET_LY,
+	HID_REPORT_TARGET_RX,
+	HID_REPORT_TARGET_RY,
+	HID_REPORT_TARGET_LT,
+	HID_REPORT_TARGET_RT,
+};
+
+// One value to extract from a report: where it is, and how it maps onto the gamepad state
+struct HIDReportField {
+	uint16_t bitOffset;             // From the first byte after the report ID
+	uint8_t bitSize;
+	uint8_t target;                 // HIDReportTarget
+	uint8_t bitShift;               // Buttons and dpad: gamepad bit of the field's first bit. Axes: fraction bits of scale
+	bool isSigned;
+	int32_t logicalMin;
+	uint32_t range;                 // Logical maximum - logical minimum
+	uint32_t scale;                 // Axes: (output range << bitShift) / range
+};
+
+/**
+ * @brief Decoding plan for the input report of a generic HID gamepad, compiled from its report descriptor.
+ *
+ * compile() walks the descriptor once, at mount, and picks the input report that looks most like a gamepad
+ * (inside a Joystick or Gamepad application collection, with the most buttons, hat and axes). Its fields
+ * become a flat list of bit offset, size, logical range and precomputed scale, so decode() is one read and
+ * one store per field with no descriptor parsing per report.
+ *
+ * Buttons follow the GP2040-CE DirectInput order (HID mode): 1-4 are B3 B1 B2 B4, 5-16 L1 to A4, 17-20 the
+ * dpad and 21-32 E1 to E12. X/Y are the left stick, Z/Rz the right stick with Rx/Ry as triggers (or Rx/Ry the
+ * right stick when there is no Z/Rz), and Brake/Accelerator the triggers.
+ */
+class HIDReportPlan {
+public:
+	HIDReportPlan() {}
+
+	// Build the plan, false if the descriptor has no usable input report
+	bool compile(const uint8_t * descriptor, uint16_t length);
+
+	// Decode a report into state, false if it is not the planned report or too short. Only planned axes are written.
+	bool decode(const uint8_t * report, uint16_t length, GamepadState & state) const;
+
+	bool isValid() const { return fieldCount > 0; }
+	uint8_t getReportId() const { return reportId; }
+	uint8_t getFieldCount() const { return fieldCount; }
+	const HIDReportField & getField(uint8_t index) const { return fields[index]; }
+private:
+	bool addField(const HIDReportField & field);
+
+	HIDReportField fields[HID_REPORT_PLAN_MAX_FIELDS] = {};
+	uint8_t fieldCount = 0;
+	uint8_t reportId = 0;           // 0 when the device does not use report IDs
+	uint16_t reportBytes = 0;       // Bytes a report needs after the report ID to hold every field
+};
+
+#endif // _HID_REPORT_PLAN_H_
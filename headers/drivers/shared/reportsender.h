@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#ifndef _REPORT_SENDER_H_
+#define _REPORT_SENDER_H_
+
+#include <stdint.h>
+#include <functional>
+
+#include "enums.pb.h"
+
+// Largest input report a driver hands to the sender
+#define REPORT_SENDER_MAX_SIZE 64
+
+// Hold new reports until the next USB start-of-frame instead of sending them from the loop
+#ifndef REPORT_SENDER_FRAME_ALIGNED
+#define REPORT_SENDER_FRAME_ALIGNED 0
+#endif
+
+// Input modes with their own counters, the config mode sends no reports and is not counted
+#define REPORT_SENDER_MODES (INPUT_MODE_P5GENERAL + 1)
+
+struct ReportSenderCounters {
+	uint32_t sent;
+	uint32_t coalesced;
+	uint32_t dropped;
+};
+
+/**
+ * @brief Input report send engine shared by the USB device drivers.
+ *
+ * Drivers build their report every loop and offer it with send(). The sender keeps the last report
+ * the host got and the pending one, so it only transmits on change, retries a pending report while
+ * the endpoint is busy, and can align transmission to the USB start-of-frame so that a new state goes
+ * out at a fixed offset from the host's poll.
+ *
+ * Counters:
+ *  - sent:      reports handed to the USB stack
+ *  - coalesced: pending reports replaced by a newer, different report before going out
+ *  - dropped:   pending reports withdrawn because the state went back to what the host already has
+ *
+ * The counters are totals per input mode over every sender of the boot, kept in uninitialized RAM like the
+ * latency stats so that they survive the reboot into web config, where /api/getReportStats reads them.
+ */
+class ReportSender {
+public:
+	// Hand a report to the USB stack, false if the endpoint can't take it right now
+	typedef std::function<bool(const uint8_t * report, uint16_t size)> TransmitFunction;
+
+	ReportSender() {}
+
+	void init(TransmitFunction transmit);
+
+	// Resend interval for unchanged reports, 0 disables (see keepaliveDue)
+	void setKeepalive(uint32_t intervalMs) { keepaliveMs = intervalMs; }
+	// Minimum time between two transmits, 0 sends as fast as the endpoint allows
+	void setMinInterval(uint32_t intervalMs) { minIntervalMs = intervalMs; }
+	// Ignore the first bytes (e.g. a sequence header) when comparing reports
+	void setCompareOffset(uint16_t offset) { compareOffset = offset; }
+	void setFrameAligned(bool aligned) { frameAligned = aligned; }
+
+	/**
+	 * @brief Offer the current report.
+	 *
+	 * @return true if the report was transmitted during this call.
+	 */
+	bool send(const void * report, uint16_t size);
+
+	// Transmit a report held for the start-of-frame, called from tud_sof_cb
+	void onFrame();
+
+	/**
+	 * @brief Transmit the report the host already has once more, or the pending one if there is one.
+	 *
+	 * For hosts that expect reports while nothing changes, on keepaliveDue() or after a change.
+	 * @return true if a report was transmitted during this call.
+	 */
+	bool repeat();
+
+	// Record a transmit done outside the sender (a protocol reply, the driver's own keepalive packet), for the
+	// minimum interval and the keepalive
+	void markTransmit();
+
+	// The report has not changed for the keepalive interval, drivers bump their counters on this
+	bool keepaliveDue() const;
+
+	// Transmit for drivers with a single HID interface and no report ID
+	static bool transmitHID(const uint8_t * report, uint16_t size);
+
+	// Count into mode from now on, keeping the counts of previous boots
+	static void initCounters(InputMode mode);
+	static void resetCounters();
+	static const ReportSenderCounters& getCounters(InputMode mode);
+private:
+	bool transmitPending(uint32_t nowMs);
+
+	TransmitFunction transmit;
+
+	uint8_t lastReport[REPORT_SENDER_MAX_SIZE] = {};
+	uint8_t pendingReport[REPORT_SENDER_MAX_SIZE] = {};
+	uint16_t lastSize = 0;
+	uint16_t pendingSize = 0;
+	bool pending = false;
+
+	uint16_t compareOffset = 0;
+	bool frameAligned = REPORT_SENDER_FRAME_ALIGNED;
+	bool frameCallbackEnabled = false;
+	uint32_t keepaliveMs = 0;
+	uint32_t minIntervalMs = 0;
+	uint32_t lastChangeMs = 0;
+	uint32_t lastTransmitMs = 0;
+};
+
+#endif // _REPORT_SENDER_H_
@@ -31,7 +31,6 @@ public:
     virtual USBListener * get_usb_auth_listener() { return nullptr; }
 private:
     uint8_t report[SWITCH_PRO_ENDPOINT_SIZE] = { };
-    uint8_t last_report[SWITCH_PRO_ENDPOINT_SIZE] = { };
     SwitchProReport switchReport;
     uint8_t last_report_counter;
     uint32_t last_report_timer;
@@ -33,10 +33,8 @@ private:
     void process_report_queue(uint32_t now);
     bool send_xbone_usb(uint8_t const *buffer, uint16_t bufsize);
     void set_ack_wait();
-    uint8_t last_report[CFG_TUD_ENDPOINT0_SIZE] = { };
     uint8_t last_report_counter;
     XboxOneGamepad_Data_t xboneReport;
-    uint32_t keep_alive_timer;
     uint8_t keep_alive_sequence;
     uint8_t virtual_keycode_sequence;
     bool xb1_guide_pressed;
@@ -32,7 +32,6 @@ public:
     virtual USBListener * get_usb_auth_listener();
     bool getAuthSent();
 private:
-    uint8_t last_report[CFG_TUD_ENDPOINT0_SIZE] = { };
     XInputReport xinputReport;
     XInputAuth * xAuthDriver;
     uint8_t featureBuffer[XINPUT_OUT_SIZE];
@@ -6,11 +6,16 @@
 #include <string>
 #include <deque>
 #include <array>
+#include <atomic>
 #include <functional>
+#include <new>
+#include <utility>
 #include <cctype>
 #include "config.pb.h"
 #include "enums.pb.h"
 
+#include "pico/platform.h"
+
 #include "GPEvent.h"
 #include "GPGamepadEvent.h"
 #include "GPEncoderEvent.h"
@@ -24,10 +29,54 @@
 
 #define EVENTMGR EventManager::getInstance()
 
+// Queued events per core, must be a power of two
+#ifndef EVENTMGR_QUEUE_SIZE
+#define EVENTMGR_QUEUE_SIZE 16
+#endif
+
+// Largest event that can be queued, checked at compile time by postEvent
+#ifndef EVENTMGR_SLOT_SIZE
+#define EVENTMGR_SLOT_SIZE 64
+#endif
+
+// Queue core0 events until the end of the loop instead of dispatching them when posted
+#ifndef EVENTMGR_DEFERRED_DISPATCH
+#define EVENTMGR_DEFERRED_DISPATCH 0
+#endif
+
+/**
+ * @brief Fixed-size single producer, single consumer ring of event slots.
+ *
+ * The producer constructs an event in place in the slot returned by reserve() and publishes it with
+ * commit(), the consumer reads it with front() and releases it with pop(). Head and tail are only ever
+ * written by one side, so the queue is safe to use between core1 (producer) and core0 (consumer).
+ */
+class EventQueue {
+    public:
+        void* reserve();
+        void commit();
+        GPEvent* front();
+        void pop();
+
+        uint32_t getDropped() const { return dropped; }
+    private:
+        struct alignas(8) Slot {
+            uint8_t data[EVENTMGR_SLOT_SIZE];
+        };
+
+        Slot slots[EVENTMGR_QUEUE_SIZE];
+        std::atomic<uint32_t> head {0};
+        std::atomic<uint32_t> tail {0};
+        uint32_t dropped = 0;
+
+        static_assert((EVENTMGR_QUEUE_SIZE & (EVENTMGR_QUEUE_SIZE - 1)) == 0, "EVENTMGR_QUEUE_SIZE must be a power of two");
+    public:
+        static constexpr size_t SLOT_ALIGN = alignof(Slot);
+};
+
 class EventManager {
     public:
         typedef std::function<void(GPEvent* event)> EventFunction;
-        typedef std::pair<GPEventType, std::vector<EventFunction>> EventEntry;
 
         EventManager(EventManager const&) = delete;
         void operator=(EventManager const&)  = delete;
@@ -42,11 +91,54 @@ class EventManager {
 
         void registerEventHandler(GPEventType eventType, EventFunction handler);
         void unregisterEventHandler(GPEventType eventType, EventFunction handler);
+
+        // Dispatch a heap allocated event immediately and delete it
         void triggerEvent(GPEvent* event);
+
+        /**
+         * @brief Post an event without allocating.
+         *
+         * On core0 the event is built on the stack and dispatched immediately, unless deferred dispatch
+         * is enabled, in which case it is queued until the next drainEvents(). On core1 the event is always
+         * queued and handed over to core0 on its next drainEvents().
+         *
+         * @return false if the event was dropped because the queue was full.
+         */
+        template<typename T, typename... Args>
+        bool postEvent(Args&&... args) {
+            static_assert(sizeof(T) <= EVENTMGR_SLOT_SIZE, "event does not fit in an event queue slot");
+            static_assert(alignof(T) <= EventQueue::SLOT_ALIGN, "event is over-aligned for an event queue slot");
+
+            uint core = get_core_num();
+            if (core == 0 && !deferredDispatch) {
+                T event(std::forward<Args>(args)...);
+                dispatchEvent(&event);
+                return true;
+            }
+
+            EventQueue& queue = eventQueues[core];
+            void* slot = queue.reserve();
+            if (slot == nullptr)
+                return false;
+            new (slot) T(std::forward<Args>(args)...);
+            queue.commit();
+            return true;
+        }
+
+        // Dispatch everything queued so far, called once per core0 loop
+        void drainEvents();
+
+        void setDeferredDispatch(bool deferred) { deferredDispatch = deferred; }
+        bool getDeferredDispatch() const { return deferredDispatch; }
+        uint32_t getDroppedEvents() const { return eventQueues[0].getDropped() + eventQueues[1].getDropped(); }
     private:
         EventManager(){}
 
-        std::vector<EventEntry> eventList;
+        void dispatchEvent(GPEvent* event);
+
+        std::array<std::vector<EventFunction>, _GPEventType_ARRAYSIZE> eventHandlers;
+        EventQueue eventQueues[2];
+        bool deferredDispatch = EVENTMGR_DEFERRED_DISPATCH;
 };
 
-#endif
\ No newline at end of file
+#endif
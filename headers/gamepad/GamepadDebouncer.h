@@ -0,0 +1,56 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "types.h"
+#include "enums.pb.h"
+
+// Bit planes of the vertical debounce counters, enough to hold the longest configurable delay
+#define DEBOUNCE_COUNTER_BITS 13
+#define DEBOUNCE_COUNTER_MAX  ((1U << DEBOUNCE_COUNTER_BITS) - 1)
+
+/**
+ * @brief Bit-parallel GPIO debouncer.
+ *
+ * Every pin owns a millisecond counter, stored as a vertical counter: bit N of each pin's counter lives
+ * in counter[N], with the pin's bit position. Updating, loading and testing the counters for all pins
+ * is a fixed number of word operations, so the cost of a pass does not depend on how many pins changed.
+ *
+ * A pin's counter is either a lockout (eager transitions: report the edge, then ignore bounce until it
+ * runs out) or a stability window (deferred transitions: report the edge once the pin has held its new
+ * level until it runs out). Which one applies is chosen per pin from the debounce mode and the direction
+ * of the pin's next transition.
+ */
+class GamepadDebouncer {
+public:
+	GamepadDebouncer() {}
+
+	void reset(Mask_t state, DebounceMode mode, uint32_t delayMs, uint32_t nowUs);
+
+	/**
+	 * @brief Debounce a raw (active high) GPIO sample taken at the given time.
+	 *
+	 * @param raw The raw GPIO state, 1 = active.
+	 * @param nowUs The sample time from the 32-bit microsecond timer, wrapping is fine.
+	 * @return Mask_t The debounced state, 1 = active.
+	 */
+	Mask_t update(Mask_t raw, uint32_t nowUs);
+
+	Mask_t getState() const { return state; }
+private:
+	Mask_t eagerPins(Mask_t debounced) const;
+	Mask_t activeCounters() const;
+	void loadCounters(Mask_t pins, uint32_t value);
+	void elapseCounters(uint32_t elapsedMs);
+
+	Mask_t counter[DEBOUNCE_COUNTER_BITS] = {};
+	Mask_t state = 0;
+	DebounceMode mode = DEBOUNCE_MODE_EAGER;
+	uint32_t delay = 0;
+	uint32_t lastUs = 0;
+};
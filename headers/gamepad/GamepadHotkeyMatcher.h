@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "GamepadState.h"
+#include "enums.pb.h"
+#include "config.pb.h"
+
+// Hotkey entries the matcher can hold, the config currently provides 16
+#define HOTKEY_MATCHER_MAX_ENTRIES 32
+
+/**
+ * @brief Precompiled hotkey index.
+ *
+ * Entries are grouped by their modifier (the button and aux masks they require), and each group holds
+ * the dpad combinations that complete it. Groups are ordered most specific first, so a combination that
+ * contains another one wins over it, and ties keep the config slot order. Matching a hotkey strips its
+ * buttons and dpad from the state like before, which stops less specific hotkeys sharing those inputs
+ * from firing as well.
+ *
+ * Every group also contributes one of its modifier bits to a gate mask. While none of the gate bits are
+ * held no hotkey can match, so the per-loop cost without a modifier held is a single test regardless of
+ * how many hotkeys are configured.
+ */
+class GamepadHotkeyMatcher {
+public:
+	GamepadHotkeyMatcher() {}
+
+	void clear();
+	bool add(const HotkeyEntry & entry);
+	void compile();
+
+	/**
+	 * @brief Check whether any hotkey could match the state.
+	 */
+	inline bool __attribute__((always_inline)) armed(const GamepadState & state) const {
+		return ((state.buttons & gateButtons) | (state.aux & gateAux) | (state.dpad & gateDpad)) != 0;
+	}
+
+	/**
+	 * @brief Find the next held hotkey, removing its inputs from the state.
+	 *
+	 * @param state The gamepad state to match against.
+	 * @param cursor Match position, start at 0 and pass back in to continue.
+	 * @return GamepadHotkey The hotkey action, HOTKEY_NONE once no further hotkey matches.
+	 */
+	GamepadHotkey next(GamepadState & state, uint8_t & cursor) const;
+
+	uint8_t getCount() const { return entryCount; }
+private:
+	struct Entry {
+		uint32_t buttonsMask;
+		uint16_t auxMask;
+		uint8_t dpadMask;
+		uint8_t slot;
+		GamepadHotkey action;
+	};
+
+	struct Key {
+		uint8_t dpadMask;
+		uint8_t group;
+		GamepadHotkey action;
+	};
+
+	struct Group {
+		uint32_t buttonsMask;
+		uint16_t auxMask;
+		uint8_t first;
+		uint8_t count;
+		uint8_t slot;
+	};
+
+	Entry entries[HOTKEY_MATCHER_MAX_ENTRIES] = {};
+	uint8_t entryCount = 0;
+
+	Key keys[HOTKEY_MATCHER_MAX_ENTRIES] = {};
+	Group groups[HOTKEY_MATCHER_MAX_ENTRIES] = {};
+	uint8_t keyCount = 0;
+	uint8_t groupCount = 0;
+
+	uint32_t gateButtons = 0;
+	uint16_t gateAux = 0;
+	uint8_t gateDpad = 0;
+};
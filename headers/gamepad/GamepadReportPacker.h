@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+#include "GamepadState.h"
+
+// Gamepad state field a report bit is read from
+enum GamepadReportSource : uint8_t {
+	GAMEPAD_REPORT_SOURCE_BUTTONS,  // state.buttons, GAMEPAD_MASK_B1 ... GAMEPAD_MASK_E12
+	GAMEPAD_REPORT_SOURCE_DPAD,     // state.dpad, GAMEPAD_MASK_UP ... GAMEPAD_MASK_RIGHT
+	GAMEPAD_REPORT_SOURCE_AUX,      // state.aux
+};
+
+// One entry of a mode's mapping table, reportMask is set while the single input bit in mask is pressed
+struct GamepadReportBit {
+	GamepadReportSource source;
+	uint32_t mask;
+	uint32_t reportMask;
+};
+
+/**
+ * @brief Packs gamepad state into a report's button bits, from a constexpr mapping table.
+ *
+ * The table is compiled when the firmware is: entries that read the same state field and move their bit
+ * by the same distance are merged into a single mask and shift, and the packer unrolls to one AND, shift
+ * and OR per merged group. A table that keeps the gamepad's own order (like HID) is a single AND, tables
+ * that reorder (like Switch) cost a handful of groups instead of one test and branch per button.
+ *
+ * Usage, with the table at namespace scope:
+ *
+ *     static constexpr GamepadReportBit switchButtonBits[] = { ... };
+ *     switchReport.buttons = GamepadReportPacker<switchButtonBits>::pack(gamepad->state);
+ *
+ * Every mask and reportMask must be a single bit and no report bit may be mapped twice, both are checked
+ * at compile time.
+ */
+template <const auto & Bits>
+class GamepadReportPacker {
+private:
+	static constexpr size_t BitCount = sizeof(Bits) / sizeof(Bits[0]);
+
+	struct Group {
+		GamepadReportSource source;
+		uint32_t mask;
+		int8_t shift;   // Positive moves the input bits up
+	};
+
+	struct Program {
+		Group groups[BitCount];
+		size_t count;
+		bool valid;
+	};
+
+	static constexpr bool singleBit(uint32_t mask) { return mask != 0 && (mask & (mask - 1)) == 0; }
+
+	static constexpr int8_t bitIndex(uint32_t mask) {
+		int8_t index = 0;
+		while (mask > 1) {
+			mask >>= 1;
+			index++;
+		}
+		return index;
+	}
+
+	static constexpr Program compile() {
+		Program program = {};
+		program.valid = true;
+		uint32_t reportMask = 0;
+		for (size_t bit = 0; bit < BitCount; bit++) {
+			const GamepadReportBit & entry = Bits[bit];
+			if (!singleBit(entry.mask) || !singleBit(entry.reportMask) || (reportMask & entry.reportMask))
+				program.valid = false;
+			reportMask |= entry.reportMask;
+
+			const int8_t shift = bitIndex(entry.reportMask) - bitIndex(entry.mask);
+			size_t group = 0;
+			while (group < program.count && (program.groups[group].source != entry.source || program.groups[group].shift != shift))
+				group++;
+			if (group == program.count)
+				program.groups[program.count++] = { entry.source, 0, shift };
+			program.groups[group].mask |= entry.mask;
+		}
+		return program;
+	}
+
+	static constexpr Program program = compile();
+	static_assert(program.valid, "GamepadReportPacker: masks must be single bits and report bits mapped once");
+
+	template <size_t Index>
+	static inline uint32_t __attribute__((always_inline)) packGroup(const GamepadState & state) {
+		constexpr Group group = program.groups[Index];
+		uint32_t value;
+		switch (group.source) {
+			case GAMEPAD_REPORT_SOURCE_DPAD: value = state.dpad; break;
+			case GAMEPAD_REPORT_SOURCE_AUX:  value = state.aux; break;
+			default:                         value = state.buttons; break;
+		}
+		value &= group.mask;
+		if constexpr (group.shift >= 0)
+			return value << group.shift;
+		else
+			return value >> -group.shift;
+	}
+
+	template <size_t... Index>
+	static inline uint32_t __attribute__((always_inline)) packGroups(const GamepadState & state, std::index_sequence<Index...>) {
+		return (0U | ... | packGroup<Index>(state));
+	}
+public:
+	static inline uint32_t __attribute__((always_inline)) pack(const GamepadState & state) {
+		return packGroups(state, std::make_index_sequence<program.count>{});
+	}
+};
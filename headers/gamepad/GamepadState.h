@@ -6,7 +6,6 @@
 #pragma once
 
 #include <stdint.h>
-#include <list>
 using namespace std;
 #include "GamepadEnums.h"
 #include "enums.pb.h"
@@ -160,23 +159,41 @@ uint16_t dpadToAnalogY(uint8_t dpad);
 
 uint8_t getMaskFromDirection(DpadDirection direction);
 
-uint8_t updateDpad(uint8_t dpad, DpadDirection direction);
-
-/**
- * @brief Filter diagonals out of the dpad, making the device work as a 4-way lever.
- *
- * The most recent cardinal direction wins.
- *
- * @param dpad The GameState.dpad value.
- * @return uint8_t The new dpad value.
- */
-uint8_t filterToFourWayMode(uint8_t dpad);
-
 /**
- * @brief Run SOCD cleaning against a D-pad value.
+ * @brief Direction history for 4-way filtering and SOCD cleaning of a D-pad.
  *
- * @param mode The SOCD cleaning mode.
- * @param dpad The GamepadState.dpad value.
- * @return uint8_t The clean D-pad value.
+ * Tracks the order in which the held cardinal directions were pressed in a fixed array, so updating it
+ * never allocates. Each D-pad source (the gamepad, Dual Directional) owns its own filter.
  */
-uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad);
+class DpadFilter
+{
+public:
+	/**
+	 * @brief Filter diagonals out of the dpad, making the device work as a 4-way lever.
+	 *
+	 * The most recent cardinal direction wins.
+	 *
+	 * @param dpad The GameState.dpad value.
+	 * @return uint8_t The new dpad value.
+	 */
+	uint8_t filterToFourWayMode(uint8_t dpad);
+
+	/**
+	 * @brief Run SOCD cleaning against a D-pad value.
+	 *
+	 * @param mode The SOCD cleaning mode.
+	 * @param dpad The GamepadState.dpad value.
+	 * @return uint8_t The clean D-pad value.
+	 */
+	uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad);
+
+private:
+	uint8_t updateDpad(uint8_t dpad, DpadDirection direction);
+
+	DpadDirection pressOrder[4] {DIRECTION_NONE, DIRECTION_NONE, DIRECTION_NONE, DIRECTION_NONE}; // held directions, oldest first
+	uint8_t pressCount {0};
+	uint8_t heldMask {0};
+
+	DpadDirection lastUD {DIRECTION_NONE};
+	DpadDirection lastLR {DIRECTION_NONE};
+};
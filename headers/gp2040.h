@@ -10,6 +10,7 @@
 
 // GP2040 Classes
 #include "gamepad.h"
+#include "GamepadDebouncer.h"
 #include "addonmanager.h"
 #include "eventmanager.h"
 #include "gpdriver.h"
@@ -22,13 +23,20 @@ public:
     ~GP2040(){}
     void setup();           // setup core0
     void run();             // loop core0
+    void start();           // USB and instrumentation start of core0, run() calls it before looping
+    void loop();            // single pass of the core0 loop
 private:
     Gamepad snapshot;
     AddonManager addons;
+    GPDriver * inputDriver = nullptr;
+    bool configMode = false;
+    bool firstReportSent = false;
+    void traceInput(Gamepad* gamepad);
     // GPIO debouncer
     void debounceGpioGetAll();
+    Mask_t rawGpio = 0;
     Mask_t buttonGpios;
-    uint32_t gpioDebounceTime[NUM_BANK0_GPIOS];
+    GamepadDebouncer debouncer;
 
     struct RebootHotkeys {
         RebootHotkeys();
@@ -9,6 +9,8 @@
 #include "addonmanager.h"
 #include "drivermanager.h"
 
+#include "pico/time.h"
+
 class GP2040Aux {
 public:
 	GP2040Aux();
@@ -17,9 +19,13 @@ public:
     void run();             // loop core1
     bool ready(){ return isReady; }
 private:
+    void loadOutputAddons();
+
     GPDriver * inputDriver;
     AddonManager addons;
     bool isReady;
+    bool deferredAddons;            // fast boot, output add-ons not loaded yet
+    absolute_time_t deferTimeout;
 };
 
 #endif
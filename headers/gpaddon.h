@@ -6,6 +6,22 @@
 
 #include <string>
 
+// Core and loop an add-on runs in, see GPAddon::core()
+enum ADDON_PROCESS {
+    CORE0_INPUT,
+    CORE0_USBREPORT,
+    CORE1_ALWAYS,
+    CORE1_LOOP
+};
+
+// Loop phases an add-on does work in, see GPAddon::phases()
+enum AddonPhase : uint8_t {
+    ADDON_PHASE_PREPROCESS  = (1 << 0),
+    ADDON_PHASE_PROCESS     = (1 << 1),
+    ADDON_PHASE_POSTPROCESS = (1 << 2),
+    ADDON_PHASE_ALL         = ADDON_PHASE_PREPROCESS | ADDON_PHASE_PROCESS | ADDON_PHASE_POSTPROCESS,
+};
+
 class GPAddon
 {
 public:
@@ -17,6 +33,19 @@ public:
     virtual void postprocess(bool) = 0;
     virtual std::string name() = 0;
 
+    /**
+     * Bitmask of AddonPhase values for the loop phases this addon implements. The AddonManager only
+     * calls preprocess(), process() and postprocess() for the phases listed here, so addons should
+     * return just the phases with non-empty bodies.
+     */
+    virtual uint8_t phases() { return ADDON_PHASE_ALL; }
+
+    /**
+     * The core the addon runs on. The AddonManager of the other core refuses to load it, so an addon
+     * cannot end up set up and processed on both cores.
+     */
+    virtual ADDON_PROCESS core() { return CORE0_INPUT; }
+
     /**
      * Reinitialize the addon --- only implement this if it makes sense to, e.g. if this
      * addon allows its pin assignments to be changed, in which case it needs to rebuild
@@ -16,6 +16,7 @@
 #include "device/usbd_pvt.h"
 
 #include "usblistener.h"
+#include "drivers/shared/reportsender.h"
 
 // Forward declare gamepad
 class Gamepad;
@@ -40,8 +41,10 @@ public:
     virtual uint16_t GetJoystickMidValue() = 0;
     const usbd_class_driver_t * get_class_driver() { return &class_driver; }
     virtual USBListener * get_usb_auth_listener() = 0;
+    ReportSender & getReportSender() { return reportSender; }
 protected:
     usbd_class_driver_t class_driver;
+    ReportSender reportSender;
 };
 
 #endif
@@ -0,0 +1,98 @@
+#ifndef _INPUTTRACE_H_
+#define _INPUTTRACE_H_
+
+#include <stdint.h>
+
+#include "gamepad/GamepadState.h"
+
+#include "pico/time.h"
+
+// Frames kept for the web config, a client polling every 100ms keeps up with the fastest rate
+#define INPUT_TRACE_FRAMES 256
+
+#define INPUT_TRACE_DEFAULT_INTERVAL_US 1000
+#define INPUT_TRACE_MIN_INTERVAL_US 250
+#define INPUT_TRACE_MAX_INTERVAL_US 1000000
+
+// Sampling stops when no client polled for this long
+#define INPUT_TRACE_IDLE_TIMEOUT_US 2000000
+
+// ADC inputs 0-3, GPIO26-29
+#define INPUT_TRACE_ADC_INPUTS 4
+#define INPUT_TRACE_ADC_FIRST_PIN 26
+
+// One sample of the core0 loop, sent as is (little endian) by /api/getInputTrace
+struct InputTraceFrame {
+	uint32_t timeUs;
+	uint32_t rawGpio;           // Active pins before debouncing, 1 = active
+	uint32_t debouncedGpio;
+	uint32_t buttons;           // GamepadState after gamepad processing
+	uint16_t aux;
+	uint8_t dpad;
+	uint8_t lt;
+	uint8_t rt;
+	uint8_t adcMask;            // ADC inputs sampled into adc
+	uint16_t loops;             // Loop passes since the previous frame
+	uint16_t lx;
+	uint16_t ly;
+	uint16_t rx;
+	uint16_t ry;
+	uint16_t adc[INPUT_TRACE_ADC_INPUTS];
+};
+
+// Leads every /api/getInputTrace response, followed by frameCount frames of frameSize bytes
+struct InputTraceBatchHeader {
+	uint32_t firstSequence;     // Sequence of the first frame, a gap after the client's cursor means lost frames
+	uint16_t frameCount;
+	uint16_t frameSize;
+	uint32_t intervalUs;
+	uint32_t inputPins;         // GPIO inputs read by the SIO when the batch was sent, outputs and peripheral pins are 0
+};
+
+/**
+ * @brief Ring buffer of input samples taken by the core0 loop in web config mode.
+ *
+ * The loop samples raw and debounced GPIO, the processed gamepad state and the ADC inputs that are set up
+ * for analog reads, at the interval the last client asked for. Clients poll for the frames after the
+ * sequence they have seen, so the HTTP handler never waits on inputs and the loop keeps running between
+ * polls. Everything runs on core0, the loop fills the buffer and the web server reads it from tud_task.
+ *
+ * A poll can also ask for ADC inputs to be set up (stick calibration) and for the unused pins to be pulled
+ * up (capturing a pin by holding its button), the pins go back to unused when the trace goes idle.
+ */
+class InputTrace {
+public:
+	InputTrace(InputTrace const&) = delete;
+	void operator=(InputTrace const&)  = delete;
+	static InputTrace& getInstance() {
+		static InputTrace instance;
+		return instance;
+	}
+
+	void poll(uint32_t intervalUs, uint8_t adcInputs, bool unusedPins);
+	bool due(uint32_t nowUs);
+	void record(uint32_t nowUs, uint32_t rawGpio, uint32_t debouncedGpio, const GamepadState& state);
+
+	uint32_t getSequence() const { return sequence; }
+	uint32_t getOldestSequence() const { return (sequence > INPUT_TRACE_FRAMES) ? (sequence - INPUT_TRACE_FRAMES) : 0; }
+	uint32_t getInterval() const { return interval; }
+	uint32_t getInputPins() const;
+	const InputTraceFrame& getFrame(uint32_t frameSequence) const { return frames[frameSequence % INPUT_TRACE_FRAMES]; }
+private:
+	InputTrace() {}
+
+	void setupAdcInputs(uint8_t adcInputs);
+	void pullUnusedPins();
+	void releasePins();
+
+	InputTraceFrame* frames = nullptr;
+	uint32_t sequence = 0;      // Sequence of the next frame
+	uint32_t interval = INPUT_TRACE_DEFAULT_INTERVAL_US;
+	uint32_t lastSampleUs = 0;
+	uint32_t lastPollUs = 0;
+	uint32_t pulledPins = 0;    // Unused pins set up as pulled up inputs for this trace
+	uint16_t loops = 0;
+	bool active = false;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef _LATENCYTRACKER_H_
+#define _LATENCYTRACKER_H_
+
+#include <stdint.h>
+
+#include "enums.pb.h"
+#include "loopprofiler.h"
+
+#include "pico/time.h"
+
+// Set to 1 (LATENCY_TRACKER=1 at configure time) to measure input latency, 0 compiles every hook out
+#ifndef LATENCY_TRACKER_ENABLED
+#define LATENCY_TRACKER_ENABLED 0
+#endif
+
+// Input modes with their own histogram, the config mode sends no reports and is not tracked
+#define LATENCY_TRACKER_MODES (INPUT_MODE_P5GENERAL + 1)
+
+/**
+ * @brief End-to-end input latency, from a raw GPIO edge to the completion of the USB IN
+ * transfer of the first report that carries it.
+ *
+ * An edge goes through three slots: seen (debounceGpioGetAll saw a raw pin change, kept while the
+ * debouncer holds it back), armed (the edge changed the processed buttons, so the next new report
+ * carries it) and in flight (a driver queued that report).
+ * Edges that do not change the processed buttons are dropped, later edges are coalesced into the
+ * oldest one in the same slot. Everything runs on core0, in the loop and in TinyUSB callbacks from tud_task.
+ *
+ * The statistics, in microseconds, are kept in uninitialized RAM so they survive the reboot into web
+ * config, where /api/getLatencyStats reads them.
+ */
+class LatencyTracker {
+public:
+	LatencyTracker(LatencyTracker const&) = delete;
+	void operator=(LatencyTracker const&)  = delete;
+	static LatencyTracker& getInstance() {
+		static LatencyTracker instance;
+		return instance;
+	}
+
+	void init(InputMode mode);
+	void reset();
+
+	void edge(uint32_t nowUs);
+	void processed(bool buttonsChanged, bool debouncing);
+	void reportSent();
+	void reportComplete(uint32_t nowUs);
+
+	const LoopProfileStat& getStat(InputMode mode) const;
+private:
+	LatencyTracker() {}
+
+	uint8_t mode = LATENCY_TRACKER_MODES;
+	bool seenValid = false;
+	bool armedValid = false;
+	bool inFlightValid = false;
+	uint32_t seenUs = 0;
+	uint32_t armedUs = 0;
+	uint32_t inFlightUs = 0;
+};
+
+#if LATENCY_TRACKER_ENABLED
+#define LATENCY_TRACK_EDGE(changed) do { if (changed) LatencyTracker::getInstance().edge(time_us_32()); } while (0)
+#define LATENCY_TRACK_PROCESSED(changed, debouncing) LatencyTracker::getInstance().processed(changed, debouncing)
+#define LATENCY_TRACK_REPORT_SENT() LatencyTracker::getInstance().reportSent()
+#define LATENCY_TRACK_REPORT_COMPLETE() LatencyTracker::getInstance().reportComplete(time_us_32())
+#else
+#define LATENCY_TRACK_EDGE(changed) ((void)0)
+#define LATENCY_TRACK_PROCESSED(changed, debouncing) ((void)0)
+#define LATENCY_TRACK_REPORT_SENT() ((void)0)
+#define LATENCY_TRACK_REPORT_COMPLETE() ((void)0)
+#endif
+
+#endif
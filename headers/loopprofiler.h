@@ -0,0 +1,137 @@
+#ifndef _LOOPPROFILER_H_
+#define _LOOPPROFILER_H_
+
+#include <stdint.h>
+
+#include "hardware/structs/systick.h"
+
+// Set to 1 (LOOP_PROFILER=1 at configure time) to instrument the core0 loop, 0 compiles every probe out
+#ifndef LOOP_PROFILER_ENABLED
+#define LOOP_PROFILER_ENABLED 0
+#endif
+
+// Addons tracked per phase, later addons are not profiled
+#ifndef LOOP_PROFILER_MAX_ADDONS
+#define LOOP_PROFILER_MAX_ADDONS 24
+#endif
+
+#define LOOP_PROFILER_ADDON_NAME_SIZE 24
+
+// Two buckets per power of two over a 24-bit range
+#define LOOP_PROFILER_BUCKETS 48
+
+enum LoopStage {
+	LOOP_STAGE_TOTAL,
+	LOOP_STAGE_REINIT,
+	LOOP_STAGE_DEBOUNCE,
+	LOOP_STAGE_READ,
+	LOOP_STAGE_RAW_EVENTS,
+	LOOP_STAGE_USB_HOST,
+	LOOP_STAGE_PREPROCESS,
+	LOOP_STAGE_HOTKEYS,
+	LOOP_STAGE_GAMEPAD_PROCESS,
+	LOOP_STAGE_PROCESS,
+	LOOP_STAGE_PROCESSED_EVENTS,
+	LOOP_STAGE_DRIVER,
+	LOOP_STAGE_TUD_TASK,
+	LOOP_STAGE_POSTPROCESS,
+	LOOP_STAGE_EVENTS,
+	LOOP_STAGE_SAVE,
+	LOOP_STAGE_COUNT
+};
+
+enum LoopAddonPhase {
+	LOOP_ADDON_PREPROCESS,
+	LOOP_ADDON_PROCESS,
+	LOOP_ADDON_POSTPROCESS,
+	LOOP_ADDON_PHASE_COUNT
+};
+
+/**
+ * @brief Fixed-memory duration statistics for a single profiled section.
+ *
+ * Durations are in whatever unit the recorder uses (CPU cycles for the loop profiler) and are clamped
+ * to 24 bits. The histogram buckets are log-spaced with two buckets per power of two, so percentiles are
+ * reported as the upper edge of their bucket (within ~50% of the real value).
+ */
+struct LoopProfileStat {
+	uint32_t count = 0;
+	uint32_t min = UINT32_MAX;
+	uint32_t max = 0;
+	uint64_t total = 0;
+	uint16_t histogram[LOOP_PROFILER_BUCKETS] = {};
+
+	void record(uint32_t cycles);
+	void reset();
+	uint32_t average() const { return count ? (uint32_t)(total / count) : 0; }
+	uint32_t percentile(uint32_t pct) const;
+};
+
+/**
+ * @brief Core0 loop-stage profiler.
+ *
+ * Durations come from core0's SysTick running at the system clock. It is a 24-bit down counter, so a
+ * single section longer than 2^24 cycles (~130ms at 125MHz, e.g. a flash save) wraps and is undercounted.
+ * Only core0 records, probes reached from core1 (its AddonManager) are ignored.
+ *
+ * Like the latency statistics, the recorded stages and add-on names are kept in uninitialized RAM so they
+ * survive the reboot into web config. A gamepad boot starts them over, a web config boot only reads them.
+ */
+class LoopProfiler {
+public:
+	LoopProfiler(LoopProfiler const&) = delete;
+	void operator=(LoopProfiler const&)  = delete;
+	static LoopProfiler& getInstance() {
+		static LoopProfiler instance;
+		return instance;
+	}
+
+	static constexpr uint32_t SYSTICK_MASK = 0x00FFFFFF;
+
+	void init(bool configMode);
+	void reset();
+
+	// Current SysTick value in cycles, counting up
+	static inline uint32_t now() {
+		return (~systick_hw->cvr) & SYSTICK_MASK;
+	}
+	static inline uint32_t elapsed(uint32_t since, uint32_t until) {
+		return (until - since) & SYSTICK_MASK;
+	}
+
+	// Record the time since mark against the stage, returns the new mark
+	uint32_t recordStage(LoopStage stage, uint32_t mark);
+	void recordAddon(uint8_t index, LoopAddonPhase phase, uint32_t mark);
+	void setAddonName(uint8_t index, const char * name);
+
+	const LoopProfileStat& getStage(LoopStage stage) const;
+	const LoopProfileStat& getAddon(uint8_t index, LoopAddonPhase phase) const;
+	const char * getAddonName(uint8_t index) const;
+	uint8_t getAddonCount() const;
+
+	static const char * getStageName(LoopStage stage);
+	static const char * getAddonPhaseName(LoopAddonPhase phase);
+private:
+	LoopProfiler() {}
+
+	bool recording = false;
+	// Names of this boot's add-ons, copied into the kept statistics when a gamepad boot starts them over
+	char addonNames[LOOP_PROFILER_MAX_ADDONS][LOOP_PROFILER_ADDON_NAME_SIZE] = {};
+	uint8_t addonCount = 0;
+};
+
+#if LOOP_PROFILER_ENABLED
+#define LOOP_PROFILE_BEGIN() uint32_t _loopProfileStart = LoopProfiler::now(); uint32_t _loopProfileMark = _loopProfileStart
+#define LOOP_PROFILE_STAGE(stage) _loopProfileMark = LoopProfiler::getInstance().recordStage(stage, _loopProfileMark)
+#define LOOP_PROFILE_END() LoopProfiler::getInstance().recordStage(LOOP_STAGE_TOTAL, _loopProfileStart)
+#define LOOP_PROFILE_ADDON_BEGIN() uint32_t _loopProfileAddonMark = LoopProfiler::now()
+#define LOOP_PROFILE_ADDON_END(index, phase) LoopProfiler::getInstance().recordAddon(index, phase, _loopProfileAddonMark)
+#else
+#define LOOP_PROFILE_BEGIN() ((void)0)
+#define LOOP_PROFILE_STAGE(stage) ((void)0)
+#define LOOP_PROFILE_END() ((void)0)
+#define LOOP_PROFILE_ADDON_BEGIN() ((void)0)
+#define LOOP_PROFILE_ADDON_END(index, phase) ((void)0)
+#endif
+
+#endif
@@ -31,22 +31,24 @@ public:
 		return instance;
 	}
 
-	Config& getConfig() { return config; }
+	Config& getConfig() { loadDeferredConfig(); return config; }
 	GamepadOptions& getGamepadOptions() { return config.gamepadOptions; }
 	HotkeyOptions& getHotkeyOptions() { return config.hotkeyOptions; }
 	ForcedSetupOptions& getForcedSetupOptions() { return config.forcedSetupOptions; }
 	PinMappings& getDeprecatedPinMappings() { return config.deprecatedPinMappings; }
 	GpioMappings& getGpioMappings() { return config.gpioMappings; }
 	KeyboardMapping& getKeyboardMapping() { return config.keyboardMapping; }
-	DisplayOptions& getDisplayOptions() { return config.displayOptions; }
-	LEDOptions& getLedOptions() { return config.ledOptions; }
+	DisplayOptions& getDisplayOptions() { loadDeferredConfig(); return config.displayOptions; }
+	LEDOptions& getLedOptions() { loadDeferredConfig(); return config.ledOptions; }
 	AddonOptions& getAddonOptions() { return config.addonOptions; }
-	AnimationOptions& getAnimationOptions() { return config.animationOptions; }
+	AnimationOptions& getAnimationOptions() { loadDeferredConfig(); return config.animationOptions; }
 	ProfileOptions& getProfileOptions() { return config.profileOptions; }
 	GpioMappingInfo* getProfilePinMappings() { return functionalPinMappings; }
 	PeripheralOptions& getPeripheralOptions() { return config.peripheralOptions; }
 
 	void init();
+	// Decode the config sections init() left out, if that has not happened yet
+	void loadDeferredConfig() { if (configDeferred) completeConfig(); }
 	bool save();
 	bool save(const bool force);
 
@@ -68,11 +70,13 @@ public:
 
 private:
 	Storage() {}
+	void completeConfig();
 	bool CONFIG_MODE = false; 			// Config mode (boot)
 	Gamepad * gamepad = nullptr;    		// Gamepad data
 	Gamepad * processedGamepad = nullptr; // Gamepad with ONLY processed data
 	uint8_t featureData[32]; // USB X-Input Feature Data
 	Config config;
+	volatile bool configDeferred = false;
 	GpioMappingInfo functionalPinMappings[NUM_BANK0_GPIOS];
 	uint32_t systemFlashSize;
 };
@@ -12,6 +12,27 @@
 // USB Host manager decides on TinyUSB Host driver
 usbh_class_driver_t const* usbh_app_driver_get_cb(uint8_t *driver_count);
 
+// Every HID and X-Input interface TinyUSB can have mounted at once
+#define USB_HOST_MAX_ROUTES (CFG_TUH_HID + CFG_TUH_DEVICE_MAX * CFG_TUH_XINPUT)
+
+typedef enum {
+    USB_HOST_ROUTE_NONE = 0,
+    USB_HOST_ROUTE_HID,
+    USB_HOST_ROUTE_XINPUT,
+} USBHostRouteType;
+
+// A mounted interface and the listener that claimed it, listener is nullptr when none did
+struct USBHostRoute {
+    USBListener * listener;
+    uint32_t reportsReceived;   // Reports handed to the listener
+    uint32_t reportsDropped;    // Reports that reached no listener, or could not be requested again
+    uint16_t vid;
+    uint16_t pid;
+    uint8_t type;               // USBHostRouteType
+    uint8_t dev_addr;
+    uint8_t instance;
+};
+
 class USBHostManager {
 public:
 	USBHostManager(USBHostManager const&) = delete;
@@ -22,21 +43,32 @@ public:
 	}
     void start();               // Start USB Host
     void shutdown();            // Called on system reboot
-    void pushListener(USBListener *); // If anything needs to update in the gpconfig driver
+    void pushListener(USBListener *, USBListenerPriority priority = USB_LISTENER_PRIORITY_INPUT); // If anything needs to update in the gpconfig driver
     void process();
-    void hid_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len);
+    bool hid_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len);
     void hid_umount_cb(uint8_t daddr, uint8_t instance);
     void hid_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len);
     void hid_set_report_complete_cb(uint8_t dev_addr, uint8_t instance, uint8_t report_id, uint8_t report_type, uint16_t len);
     void hid_get_report_complete_cb(uint8_t dev_addr, uint8_t instance, uint8_t report_id, uint8_t report_type, uint16_t len);
     void xinput_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype);
-    void xinput_umount_cb(uint8_t dev_addr);
+    void xinput_umount_cb(uint8_t dev_addr, uint8_t instance);
     void xinput_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len);
     void xinput_report_sent_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len);
-    
+
+    // Mounted interfaces, unused slots have type USB_HOST_ROUTE_NONE
+    const USBHostRoute& getRoute(uint8_t index) const { return routes[index]; }
 private:
     USBHostManager() : tuh_ready(false), core0Ready(false), core1Ready(false) {}
-    std::vector<USBListener*> listeners;
+    USBHostRoute* addRoute(USBHostRouteType type, uint8_t dev_addr, uint8_t instance);
+    USBHostRoute* findRoute(USBHostRouteType type, uint8_t dev_addr, uint8_t instance);
+    void removeRoute(USBHostRoute* route);
+
+    struct PrioritizedListener {
+        USBListener * listener;
+        USBListenerPriority priority;
+    };
+    std::vector<PrioritizedListener> listeners;
+    USBHostRoute routes[USB_HOST_MAX_ROUTES] = {};
     usb_device_t *usb_device;
     uint8_t dataPin;
     bool tuh_ready;
@@ -3,12 +3,26 @@
 
 #include <cstdint>
 
+// Order in which listeners are offered a newly mounted device, listeners of the same priority in the order they were added
+typedef enum {
+    USB_LISTENER_PRIORITY_AUTH = 0,     // Console authentication dongles
+    USB_LISTENER_PRIORITY_INPUT,        // Controllers, keyboards and mice passed through as input
+} USBListenerPriority;
+
+/**
+ * @brief Receives the USB host events of the devices it claimed.
+ *
+ * mount and xmount offer a new HID or X-Input interface, returning true claims it. The interface is then
+ * bound to this listener until it is unmounted: its reports and report callbacks go to this listener only,
+ * and listeners offered the interface later never see it. unmount is called once for every interface of
+ * the device the listener claimed.
+ */
 class USBListener
 {
 public:
     virtual void setup() = 0;
-    virtual void mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) = 0;
-    virtual void xmount(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype) = 0;
+    virtual bool mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) = 0;
+    virtual bool xmount(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype) = 0;
     virtual void unmount(uint8_t dev_addr) = 0;
     virtual void report_received(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) = 0;
     virtual void report_sent(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) = 0;
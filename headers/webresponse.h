@@ -0,0 +1,50 @@
+#ifndef _WEBRESPONSE_H_
+#define _WEBRESPONSE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+enum class HttpStatusCode
+{
+    _200,
+    _304,
+    _400,
+    _500,
+};
+
+/**
+ * @brief Response of one open custom file, read out piece by piece as httpd fills its send buffer.
+ *
+ * The headers are built up front with the Content-Length of the body and kept apart from it, so the
+ * body is held once, in the string it was serialized to, and never copied into a header+body string.
+ */
+class WebResponse
+{
+public:
+    WebResponse(std::string&& data, HttpStatusCode statusCode, const char* contentType = "application/json");
+
+    // Header only, the client's cached copy is current
+    explicit WebResponse(const char* etag);
+
+    void setETag(const char* value);
+
+    size_t getLength() const { return headerLength + body.length(); }
+
+    // Copies up to count bytes of the response from offset on, returns how many
+    size_t read(size_t offset, char* buffer, size_t count) const;
+private:
+    void setHeader(HttpStatusCode code, const char* type);
+
+    template <typename... Args>
+    void appendHeader(const char* format, Args... args);
+
+    HttpStatusCode statusCode = HttpStatusCode::_200;
+    const char* contentType = nullptr;
+    char etag[48] = "";
+    char header[320];
+    size_t headerLength = 0;
+    std::string body;
+};
+
+#endif
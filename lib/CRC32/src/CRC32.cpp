@@ -6,13 +6,62 @@
 
 #include "CRC32.h"
 
-static const uint32_t crc32_table[] = {
+#include <array>
+
+#if CRC32_SLICES != 0 && CRC32_SLICES != 1 && CRC32_SLICES != 4 && CRC32_SLICES != 8
+#error "CRC32_SLICES must be 0, 1, 4 or 8"
+#endif
+
+#if CRC32_SLICES >= 4 && defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "CRC32 slicing reads words as little endian"
+#endif
+
+#if CRC32_TABLE_IN_RAM
+#define CRC32_TABLE_STORAGE static
+#else
+#define CRC32_TABLE_STORAGE static const
+#endif
+
+static constexpr uint32_t CRC32_POLYNOMIAL = 0xedb88320;
+
+#if CRC32_SLICES == 0
+// via http://forum.arduino.cc/index.php?topic=91179.0
+CRC32_TABLE_STORAGE uint32_t crc32_table[] = {
 	0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
 	0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
 	0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
 	0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
 };
 
+static inline uint32_t updateByte(uint32_t state, uint8_t data) {
+	state = crc32_table[(state ^ data) & 0x0f] ^ (state >> 4);
+	state = crc32_table[(state ^ (data >> 4)) & 0x0f] ^ (state >> 4);
+	return state;
+}
+#else
+// Slice n advances the CRC of a byte by n further zero bytes, so n bytes can be folded in with independent lookups
+static constexpr std::array<std::array<uint32_t, 256>, CRC32_SLICES> makeTables() {
+	std::array<std::array<uint32_t, 256>, CRC32_SLICES> tables = {};
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; bit++)
+			crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLYNOMIAL : 0);
+		tables[0][i] = crc;
+	}
+	for (uint32_t i = 0; i < 256; i++) {
+		for (int slice = 1; slice < CRC32_SLICES; slice++)
+			tables[slice][i] = (tables[slice - 1][i] >> 8) ^ tables[0][tables[slice - 1][i] & 0xff];
+	}
+	return tables;
+}
+
+CRC32_TABLE_STORAGE std::array<std::array<uint32_t, 256>, CRC32_SLICES> crc32_table = makeTables();
+
+static inline uint32_t updateByte(uint32_t state, uint8_t data) {
+	return crc32_table[0][(state ^ data) & 0xff] ^ (state >> 8);
+}
+#endif
+
 CRC32::CRC32() {
 	reset();
 }
@@ -22,13 +71,46 @@ void CRC32::reset() {
 }
 
 void CRC32::update(const uint8_t &data) {
-	// via http://forum.arduino.cc/index.php?topic=91179.0
-	uint8_t tbl_idx = 0;
+	_state = updateByte(_state, data);
+}
+
+void CRC32::updateBlock(const void *data, size_t size) {
+	const uint8_t *pData = static_cast<const uint8_t *>(data);
+	uint32_t state = _state;
+
+#if CRC32_SLICES >= 4
+	// Word reads have to be aligned on Cortex-M0+
+	while (size > 0 && (reinterpret_cast<uintptr_t>(pData) & 3) != 0) {
+		state = updateByte(state, *pData++);
+		size--;
+	}
+
+	const uint32_t *pWords = reinterpret_cast<const uint32_t *>(pData);
+#if CRC32_SLICES == 8
+	while (size >= 8) {
+		const uint32_t low = *pWords++ ^ state;
+		const uint32_t high = *pWords++;
+		state = crc32_table[7][low & 0xff] ^ crc32_table[6][(low >> 8) & 0xff] ^
+			crc32_table[5][(low >> 16) & 0xff] ^ crc32_table[4][low >> 24] ^
+			crc32_table[3][high & 0xff] ^ crc32_table[2][(high >> 8) & 0xff] ^
+			crc32_table[1][(high >> 16) & 0xff] ^ crc32_table[0][high >> 24];
+		size -= 8;
+	}
+#endif
+	while (size >= 4) {
+		const uint32_t word = *pWords++ ^ state;
+		state = crc32_table[3][word & 0xff] ^ crc32_table[2][(word >> 8) & 0xff] ^
+			crc32_table[1][(word >> 16) & 0xff] ^ crc32_table[0][word >> 24];
+		size -= 4;
+	}
+	pData = reinterpret_cast<const uint8_t *>(pWords);
+#endif
+
+	while (size-- > 0) {
+		state = updateByte(state, *pData++);
+	}
 
-	tbl_idx = _state ^ (data >> (0 * 4));
-	_state = *(uint32_t *)(crc32_table + (tbl_idx & 0x0f)) ^ (_state >> 4);
-	tbl_idx = _state ^ (data >> (1 * 4));
-	_state = *(uint32_t *)(crc32_table + (tbl_idx & 0x0f)) ^ (_state >> 4);
+	_state = state;
 }
 
 uint32_t CRC32::finalize() const
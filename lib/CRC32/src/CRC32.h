@@ -6,8 +6,25 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
+/// \brief Lookup tables used by the block update.
+///
+///  - 0: 16 entry nibble table, two lookups per byte (64 bytes)
+///  - 1: 256 entry byte table, one lookup per byte (1 KB)
+///  - 4: slice-by-4, one lookup per byte, four bytes per step (4 KB)
+///  - 8: slice-by-8, one lookup per byte, eight bytes per step (8 KB)
+#ifndef CRC32_SLICES
+#define CRC32_SLICES 4
+#endif
+
+/// \brief Keep the lookup tables in RAM instead of flash, random table reads
+/// from flash go through the XIP cache and can stall on every miss.
+#ifndef CRC32_TABLE_IN_RAM
+#define CRC32_TABLE_IN_RAM 1
+#endif
+
 /// \brief A class for calculating the CRC32 checksum from arbitrary data.
 /// \sa http://forum.arduino.cc/index.php?topic=91179.0
 class CRC32 {
@@ -35,16 +52,15 @@ public:
 	/// \param data The array to add to the checksum.
 	/// \param size Size of the array to add.
 	template <typename Type>
-	void update(const Type *data, uint16_t size) {
-		uint16_t nBytes = size * sizeof(Type);
-		const uint8_t *pData = (const uint8_t *)data;
-
-		for (uint16_t i = 0; i < nBytes; i++)
-		{
-			update(pData[i]);
-		}
+	void update(const Type *data, size_t size) {
+		updateBlock(data, size * sizeof(Type));
 	}
 
+	/// \brief Update the current checksum caclulation with a block of bytes.
+	/// \param data The bytes to add to the checksum.
+	/// \param size The number of bytes to add.
+	void updateBlock(const void *data, size_t size);
+
 	/// \returns the caclulated checksum.
 	uint32_t finalize() const;
 
@@ -54,7 +70,7 @@ public:
 	/// \param size The size of the data to add to the checksum.
 	/// \returns the calculated checksum.
 	template <typename Type>
-	static uint32_t calculate(const Type *data, uint16_t size = 1) {
+	static uint32_t calculate(const Type *data, size_t size = 1) {
 		CRC32 crc;
 		crc.update(data, size);
 		return crc.finalize();
@@ -0,0 +1,184 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#include "FlashJournal.h"
+
+#include <string.h>
+
+#include "CRC32.h"
+
+static inline uint32_t alignDown(uint32_t value, uint32_t alignment) { return value - (value % alignment); }
+static inline uint32_t alignUp(uint32_t value, uint32_t alignment) { return alignDown(value + alignment - 1, alignment); }
+
+uint32_t FlashJournal::recordSize(uint32_t dataSize)
+{
+	return alignUp(dataSize + sizeof(FlashJournalFooter), FLASH_JOURNAL_PAGE_SIZE);
+}
+
+uint32_t FlashJournal::recordCrc(const uint8_t * data, uint32_t dataSize, uint32_t sequence)
+{
+	CRC32 crc;
+	crc.update(data, dataSize);
+	crc.update(sequence);
+	crc.update(dataSize);
+	return crc.finalize();
+}
+
+bool FlashJournal::isErased(uint32_t offset, uint32_t size) const
+{
+	for (uint32_t i = offset; i < offset + size; i++) {
+		if (medium.base[i] != 0xFF)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Erase the sectors in the range that are not blank already, one sector per medium call.
+ */
+void FlashJournal::eraseSectors(uint32_t offset, uint32_t size)
+{
+	for (uint32_t sector = offset; sector < offset + size; sector += FLASH_JOURNAL_SECTOR_SIZE) {
+		if (!isErased(sector, FLASH_JOURNAL_SECTOR_SIZE))
+			medium.erase(sector, FLASH_JOURNAL_SECTOR_SIZE);
+	}
+}
+
+/**
+ * @brief Program the range in pieces that do not cross a sector boundary.
+ */
+void FlashJournal::programSectors(uint32_t offset, const uint8_t * data, uint32_t size)
+{
+	while (size > 0) {
+		const uint32_t sectorEnd = alignDown(offset, FLASH_JOURNAL_SECTOR_SIZE) + FLASH_JOURNAL_SECTOR_SIZE;
+		const uint32_t length = (offset + size > sectorEnd) ? (sectorEnd - offset) : size;
+		medium.program(offset, data, length);
+		offset += length;
+		data += length;
+		size -= length;
+	}
+}
+
+/**
+ * @brief Find the newest valid record and the position of the next one.
+ */
+void FlashJournal::mount(const FlashJournalMedium & journalMedium)
+{
+	medium = journalMedium;
+	hasRecord = false;
+
+	const uint32_t pageCount = medium.size / FLASH_JOURNAL_PAGE_SIZE;
+	for (uint32_t page = 0; page < pageCount; page++) {
+		const uint32_t pageEnd = (page + 1) * FLASH_JOURNAL_PAGE_SIZE;
+		FlashJournalFooter footer;
+		memcpy(&footer, medium.base + pageEnd - sizeof(FlashJournalFooter), sizeof(FlashJournalFooter));
+
+		if (footer.magic != FLASH_JOURNAL_MAGIC || footer.dataSize > medium.size - sizeof(FlashJournalFooter))
+			continue;
+
+		// Records never wrap, the data starts at a page boundary within the region
+		const uint32_t size = recordSize(footer.dataSize);
+		if (size > pageEnd)
+			continue;
+
+		if (hasRecord && footer.sequence <= recordFooter.sequence)
+			continue;
+
+		const uint32_t offset = pageEnd - size;
+		if (recordCrc(medium.base + offset, footer.dataSize, footer.sequence) != footer.crc)
+			continue;
+
+		hasRecord = true;
+		recordOffset = offset;
+		recordFooter = footer;
+	}
+
+	if (!hasRecord) {
+		// Nothing journaled yet, the region may still hold data in another format
+		writeOffset = 0;
+		erasedEnd = 0;
+		return;
+	}
+
+	writeOffset = recordOffset + recordSize(recordFooter.dataSize);
+	erasedEnd = alignUp(writeOffset, FLASH_JOURNAL_SECTOR_SIZE);
+
+	// An append interrupted by a power loss can leave programmed pages behind the newest record, continue
+	// in the next sector instead of programming over them.
+	if (!isErased(writeOffset, erasedEnd - writeOffset))
+		writeOffset = erasedEnd;
+}
+
+/**
+ * @brief Write a new record and make it the current one.
+ */
+bool FlashJournal::append(const uint8_t * data, uint32_t size)
+{
+	const uint32_t length = recordSize(size);
+	if (medium.base == nullptr || length > medium.size)
+		return false;
+
+	uint32_t offset = writeOffset;
+	uint32_t knownErasedEnd = erasedEnd;
+	if (offset + length > medium.size) {
+		// Wrap around, the start of the region has not been erased since the last pass
+		offset = 0;
+		knownErasedEnd = 0;
+	}
+
+	// Reclaim the sectors the record reaches into, they only hold records older than the current one
+	// unless records take up more than a third of the region's sectors.
+	if (offset + length > knownErasedEnd) {
+		const uint32_t eraseStart = (offset > knownErasedEnd) ? alignDown(offset, FLASH_JOURNAL_SECTOR_SIZE) : knownErasedEnd;
+		const uint32_t eraseEnd = alignUp(offset + length, FLASH_JOURNAL_SECTOR_SIZE);
+		// Never erase the current record, a power loss before the new one is complete would leave nothing
+		if (hasRecord && eraseStart < recordOffset + recordSize(recordFooter.dataSize) && recordOffset < eraseEnd)
+			return false;
+		erasedEnd = eraseEnd;
+		eraseSectors(eraseStart, erasedEnd - eraseStart);
+	}
+
+	FlashJournalFooter footer;
+	footer.sequence = getSequence() + 1;
+	footer.dataSize = size;
+	footer.crc = recordCrc(data, size, footer.sequence);
+	footer.magic = FLASH_JOURNAL_MAGIC;
+
+	// Whole pages straight from the data, then the pages holding the tail of the data, the padding and,
+	// programmed last, the footer
+	const uint32_t lastPage = length - FLASH_JOURNAL_PAGE_SIZE;
+	const uint32_t direct = alignDown((size < lastPage) ? size : lastPage, FLASH_JOURNAL_PAGE_SIZE);
+	if (direct > 0)
+		programSectors(offset, data, direct);
+
+	uint8_t page[FLASH_JOURNAL_PAGE_SIZE];
+	for (uint32_t pageOffset = direct; pageOffset < length; pageOffset += FLASH_JOURNAL_PAGE_SIZE) {
+		memset(page, 0xFF, sizeof(page));
+		if (size > pageOffset) {
+			const uint32_t tail = size - pageOffset;
+			memcpy(page, data + pageOffset, (tail < FLASH_JOURNAL_PAGE_SIZE) ? tail : FLASH_JOURNAL_PAGE_SIZE);
+		}
+		if (pageOffset == lastPage)
+			memcpy(page + FLASH_JOURNAL_PAGE_SIZE - sizeof(FlashJournalFooter), &footer, sizeof(FlashJournalFooter));
+		medium.program(offset + pageOffset, page, FLASH_JOURNAL_PAGE_SIZE);
+	}
+
+	hasRecord = true;
+	recordOffset = offset;
+	recordFooter = footer;
+	writeOffset = offset + length;
+	return true;
+}
+
+/**
+ * @brief Erase the whole region, dropping all records.
+ */
+void FlashJournal::format()
+{
+	eraseSectors(0, medium.size);
+	hasRecord = false;
+	writeOffset = 0;
+	erasedEnd = medium.size;
+}
@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#ifndef FLASHJOURNAL_H_
+#define FLASHJOURNAL_H_
+
+#include <stdint.h>
+
+#define FLASH_JOURNAL_PAGE_SIZE   256      // Smallest programmable unit
+#define FLASH_JOURNAL_SECTOR_SIZE 4096     // Smallest erasable unit
+#define FLASH_JOURNAL_MAGIC       0x4c4e524a
+
+// Largest data a record can hold and still survive a power loss during any later append: the whole record has
+// to fit in a third of the region's sectors, as the erase ahead of a record is rounded up to whole sectors
+// (see FlashJournal)
+#define FLASH_JOURNAL_MAX_SAFE_DATA(regionSize) \
+	((regionSize) / FLASH_JOURNAL_SECTOR_SIZE / 3 * FLASH_JOURNAL_SECTOR_SIZE - sizeof(FlashJournalFooter))
+
+// Closes every record, in the last bytes of the record's last page. The magic is the final word so that
+// it lands in the same place as the magic of the pre-journal config footer.
+struct FlashJournalFooter
+{
+	uint32_t sequence;
+	uint32_t dataSize;
+	uint32_t crc;           // CRC32 over the data, then sequence and dataSize
+	uint32_t magic;
+};
+
+// Access to the flash region the journal lives in. Offsets are relative to the start of the region. The journal
+// never erases or programs across a sector boundary in one call, so every call can be a short exclusive window.
+struct FlashJournalMedium
+{
+	const uint8_t * base;   // Memory mapped view of the region
+	uint32_t size;          // Multiple of FLASH_JOURNAL_SECTOR_SIZE
+	void (*erase)(uint32_t offset, uint32_t size);
+	void (*program)(uint32_t offset, const uint8_t * data, uint32_t size);
+};
+
+/**
+ * @brief Log-structured record store over a ring of flash sectors.
+ *
+ * Every append writes a complete record (data padded to whole pages, footer last) to the pages after the
+ * previous record, erasing sectors ahead of the write position only once the record reaches them, and
+ * wrapping to the start of the region when the end is reached. A save therefore programs a few pages
+ * instead of erasing and programming the whole region, and the erase wear is spread over all sectors.
+ * Sectors that already read back blank are not erased again.
+ *
+ * Mounting scans the footers of all pages and picks the valid record with the highest sequence. A record
+ * interrupted by a power loss fails its CRC and the previous record stays current, and the erase ahead of
+ * the write position never reaches the current record as long as a record fits in a third of the region's
+ * sectors (the tail left over when a record does not fit before the end of the region is skipped). A larger
+ * record whose erase would reach the current record is refused.
+ */
+class FlashJournal
+{
+	public:
+		void mount(const FlashJournalMedium & medium);
+		bool append(const uint8_t * data, uint32_t size);
+		void format();
+
+		// Data of the newest record, nullptr if the journal is empty
+		const uint8_t * getData() const { return hasRecord ? medium.base + recordOffset : nullptr; }
+		uint32_t getDataSize() const { return hasRecord ? recordFooter.dataSize : 0; }
+		uint32_t getDataCrc() const { return hasRecord ? recordFooter.crc : 0; }
+		uint32_t getSequence() const { return hasRecord ? recordFooter.sequence : 0; }
+
+		static uint32_t recordSize(uint32_t dataSize);
+		static uint32_t recordCrc(const uint8_t * data, uint32_t dataSize, uint32_t sequence);
+	private:
+		bool isErased(uint32_t offset, uint32_t size) const;
+		void eraseSectors(uint32_t offset, uint32_t size);
+		void programSectors(uint32_t offset, const uint8_t * data, uint32_t size);
+
+		FlashJournalMedium medium = {};
+
+		bool hasRecord = false;
+		uint32_t recordOffset = 0;
+		FlashJournalFooter recordFooter = {};
+
+		uint32_t writeOffset = 0;   // First page after the newest record
+		uint32_t erasedEnd = 0;     // Pages in [writeOffset, erasedEnd) are known to be erased
+};
+
+#endif
@@ -5,24 +5,49 @@
 
 #include "FlashPROM.h"
 
-uint8_t FlashPROM::writeCache[EEPROM_SIZE_BYTES];
+uint8_t FlashPROM::writeCache[EEPROM_MAX_DATA_BYTES];
 volatile static alarm_id_t flashWriteAlarm = 0;
 volatile static spin_lock_t *flashLock = nullptr;
+volatile static uint32_t flashWriteSize = 0;
+volatile static bool flashFormatRequested = false;
 
-int64_t writeToFlash(alarm_id_t id, void *flashCache)
-{
-	while (is_spin_locked(flashLock));
+static FlashJournal journal;
 
+// The journal erases and programs at most one sector per call. Each call is its own lockout window, so core1
+// gets to run between the sectors of a write instead of being held for all of it.
+static void eraseFlash(uint32_t offset, uint32_t size)
+{
 	multicore_lockout_start_blocking();
 	uint32_t interrupts = spin_lock_blocking(flashLock);
 
-	flash_range_erase((intptr_t)EEPROM_ADDRESS_START - (intptr_t)XIP_BASE, EEPROM_SIZE_BYTES);
-	flash_range_program((intptr_t)EEPROM_ADDRESS_START - (intptr_t)XIP_BASE, reinterpret_cast<uint8_t *>(flashCache), EEPROM_SIZE_BYTES);
+	flash_range_erase((intptr_t)EEPROM_ADDRESS_START - (intptr_t)XIP_BASE + offset, size);
 
-	flashWriteAlarm = 0;
+	multicore_lockout_end_blocking();
+	spin_unlock(flashLock, interrupts);
+}
+
+static void programFlash(uint32_t offset, const uint8_t *data, uint32_t size)
+{
+	multicore_lockout_start_blocking();
+	uint32_t interrupts = spin_lock_blocking(flashLock);
+
+	flash_range_program((intptr_t)EEPROM_ADDRESS_START - (intptr_t)XIP_BASE + offset, data, size);
 
 	multicore_lockout_end_blocking();
 	spin_unlock(flashLock, interrupts);
+}
+
+int64_t writeToFlash(alarm_id_t id, void *flashCache)
+{
+	while (is_spin_locked(flashLock));
+
+	if (flashFormatRequested)
+		journal.format();
+	else
+		journal.append(reinterpret_cast<uint8_t *>(flashCache), flashWriteSize);
+
+	flashFormatRequested = false;
+	flashWriteAlarm = 0;
 
 	return 0;
 }
@@ -32,22 +57,55 @@ void FlashPROM::start()
 	if (flashLock == nullptr)
 		flashLock = spin_lock_instance(spin_lock_claim_unused(true));
 
-	memcpy(writeCache, reinterpret_cast<uint8_t *>(EEPROM_ADDRESS_START), EEPROM_SIZE_BYTES);
+	journal.mount({
+		.base = reinterpret_cast<const uint8_t *>(EEPROM_ADDRESS_START),
+		.size = EEPROM_SIZE_BYTES,
+		.erase = eraseFlash,
+		.program = programFlash,
+	});
 }
 
 /* We don't have an actual EEPROM, so we need to be extra careful about minimizing writes. Instead
 	of writing when a commit is requested, we update a time to actually commit. That way, if we receive multiple requests
 	to commit in that timeframe, we'll hold off until the user is done sending changes. */
-void FlashPROM::commit()
+bool FlashPROM::commit(uint32_t size)
 {
 	while (is_spin_locked(flashLock));
+	if (size > EEPROM_MAX_DATA_BYTES)
+		return false;
+
+	// Nothing pending and the data matches the newest record, don't spend a record on it
+	const uint8_t *stored = journal.getData();
+	if (flashWriteAlarm == 0 && stored != nullptr && journal.getDataSize() == size && memcmp(stored, writeCache, size) == 0)
+		return true;
+
 	if (flashWriteAlarm != 0)
 		cancel_alarm(flashWriteAlarm);
+	flashWriteSize = size;
 	flashWriteAlarm = add_alarm_in_ms(EEPROM_WRITE_WAIT, writeToFlash, writeCache, true);
+	return true;
 }
 
 void FlashPROM::reset()
 {
-	memset(writeCache, 0, EEPROM_SIZE_BYTES);
-	commit();
+	while (is_spin_locked(flashLock));
+	if (flashWriteAlarm != 0)
+		cancel_alarm(flashWriteAlarm);
+	flashFormatRequested = true;
+	flashWriteAlarm = add_alarm_in_ms(EEPROM_WRITE_WAIT, writeToFlash, writeCache, true);
+}
+
+const uint8_t * FlashPROM::getData(uint32_t &size) const
+{
+	size = journal.getDataSize();
+	return journal.getData();
+}
+
+const uint8_t * FlashPROM::getLatestData(uint32_t &size) const
+{
+	if (flashWriteAlarm != 0) {
+		size = flashFormatRequested ? 0 : flashWriteSize;
+		return flashFormatRequested ? nullptr : writeCache;
+	}
+	return getData(size);
 }
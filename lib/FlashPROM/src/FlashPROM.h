@@ -13,20 +13,45 @@
 #include <hardware/flash.h>
 #include <hardware/timer.h>
 
-#define EEPROM_SIZE_BYTES    0x8000           // Reserve 32k of flash memory (ensure this value is divisible by 256)
-#define EEPROM_ADDRESS_START _u(0x101F8000) // The arduino-pico EEPROM lib starts here, so we'll do the same
+#include "FlashJournal.h"
+
+#define EEPROM_SIZE_BYTES    0x10000          // Reserve 64k of flash memory (ensure this value is divisible by 4096)
+#define EEPROM_ADDRESS_START _u(0x101F0000) // Ends where the arduino-pico EEPROM lib ends
+
+// The 32k block used before the journal, where the arduino-pico EEPROM lib starts. Legacy and footer configs are
+// read from it, it is the second half of the journal region.
+#define EEPROM_LEGACY_SIZE_BYTES    0x8000
+#define EEPROM_LEGACY_ADDRESS_START _u(0x101F8000)
 
 // Warning: If the write wait is too long it can stall other processes
 #define EEPROM_WRITE_WAIT    50             // Amount of time in ms to wait before blocking core1 and committing to flash
 
+// Largest data a single commit can hold. Commits only survive a power loss mid-write while they fit in a third of
+// the reserved flash, past that the journal would have to erase the previous record to make room, so commit()
+// refuses them.
+#define EEPROM_MAX_DATA_BYTES FLASH_JOURNAL_MAX_SAFE_DATA(EEPROM_SIZE_BYTES)
+
+static_assert(EEPROM_LEGACY_ADDRESS_START + EEPROM_LEGACY_SIZE_BYTES == EEPROM_ADDRESS_START + EEPROM_SIZE_BYTES,
+	"The legacy config block must be the end of the journal region");
+
+/*
+ * The reserved flash is used as a journal (see FlashJournal): a commit appends a new record after the previous
+ * one instead of rewriting the whole block, so a save only erases a sector when the journal reaches it.
+ */
 class FlashPROM
 {
 	public:
 		void start();
-		void commit();
+		bool commit(uint32_t size);   // Journal the first size bytes of writeCache, false if they do not fit
 		void reset();
 
-		static uint8_t writeCache[EEPROM_SIZE_BYTES];
+		// Data of the last commit that reached flash, nullptr if nothing has been journaled yet
+		const uint8_t * getData(uint32_t & size) const;
+
+		// Data of the last commit, still in writeCache while it waits for the write to flash
+		const uint8_t * getLatestData(uint32_t & size) const;
+
+		static uint8_t writeCache[EEPROM_MAX_DATA_BYTES];
 };
 
 inline FlashPROM EEPROM;
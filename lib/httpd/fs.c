@@ -31,7 +31,11 @@
  */
 #include "lwip/opt.h"
 #include "lwip/def.h"
+#include "lwip/pbuf.h"
+#include "lwip/tcp.h"
+#include "lwip/apps/httpd_opts.h"
 #include "fs.h"
+#include "fscustom.h"
 #include "fsdata.h"
 #include <string.h>
 
@@ -52,39 +56,111 @@
 #if LWIP_HTTPD_CUSTOM_FILES
 int fs_open_custom(struct fs_file *file, const char *name);
 void fs_close_custom(struct fs_file *file);
+#if LWIP_HTTPD_DYNAMIC_FILE_READ
+int fs_read_custom(struct fs_file *file, char *buffer, int count);
+#endif /* LWIP_HTTPD_DYNAMIC_FILE_READ */
 #if LWIP_HTTPD_FS_ASYNC_READ
 u8_t fs_canread_custom(struct fs_file *file);
 u8_t fs_wait_read_custom(struct fs_file *file, fs_wait_cb callback_fn, void *callback_arg);
 #endif /* LWIP_HTTPD_FS_ASYNC_READ */
 #endif /* LWIP_HTTPD_CUSTOM_FILES */
 
+/** Longest If-None-Match value kept, longer ones never match */
+#ifndef FS_ETAG_MAX_LEN
+#define FS_ETAG_MAX_LEN 48
+#endif
+
+/* If-None-Match of the GET request that is about to be opened, empty if it had none */
+static char if_none_match[FS_ETAG_MAX_LEN];
+
 /*-----------------------------------------------------------------------------------*/
+/**
+ * LWIP_HOOK_TCP_INPACKET_PCB, sees every segment of an established connection before
+ * httpd does. httpd does not pass request headers to fs_open(), so the If-None-Match
+ * header is picked up here. httpd parses the request within the same tcp_input() call
+ * and opens the file right after.
+ */
 err_t
-fs_open(struct fs_file *file, const char *name)
+fs_tcp_inpacket(struct tcp_pcb *pcb, struct pbuf *p)
 {
-  const struct fsdata_file *f;
+  static const char header[] = "If-None-Match:";
+  u16_t start;
+  u16_t end;
 
-  if ((file == NULL) || (name == NULL)) {
-     return ERR_ARG;
+  if ((pcb->local_port != HTTPD_SERVER_PORT) || (p == NULL) || (p->tot_len == 0)) {
+    return ERR_OK;
   }
 
-  for (f = FS_ROOT; f != NULL; f = f->next) {
-    if (!strcmp(name, (char *)f->name)) {
-      file->data = (const char *)f->data;
-      file->len = f->len;
-      file->index = f->len;
-      file->pextension = NULL;
-      file->http_header_included = f->http_header_included;
-			file->is_custom_file = 0;
+  /* Every new request starts without one, only GET requests are answered from cache */
+  if ((pbuf_memcmp(p, 0, "GET ", 4) == 0) || (pbuf_memcmp(p, 0, "POST ", 5) == 0)) {
+    if_none_match[0] = '\0';
+    if (pbuf_memcmp(p, 0, "POST ", 5) == 0) {
+      return ERR_OK;
+    }
+  }
+
+  start = pbuf_memfind(p, header, sizeof(header) - 1, 0);
+  if (start == 0xFFFF) {
+    return ERR_OK;
+  }
+  start += sizeof(header) - 1;
+  while ((start < p->tot_len) && (pbuf_get_at(p, start) == ' ')) {
+    start++;
+  }
+  for (end = start; (end < p->tot_len) && (pbuf_get_at(p, end) != '\r') && (pbuf_get_at(p, end) != '\n'); end++) {
+  }
+
+  if ((end > start) && ((size_t)(end - start) < sizeof(if_none_match))) {
+    pbuf_copy_partial(p, if_none_match, end - start, start);
+    if_none_match[end - start] = '\0';
+  }
+  return ERR_OK;
+}
+
+int
+fs_if_none_match(const char *etag)
+{
+  return (if_none_match[0] != '\0') && (strcmp(if_none_match, etag) == 0);
+}
+
+void
+fs_open_fsdata(struct fs_file *file, const struct fsdata_file *f)
+{
+  if ((f->etag != NULL) && fs_if_none_match(f->etag)) {
+    /* Cached by the client, only the header goes out */
+    file->data = (const char *)f->not_modified;
+    file->len = f->not_modified_len;
+  } else {
+    file->data = (const char *)f->data;
+    file->len = f->len;
+  }
+  file->index = file->len;
+  file->pextension = NULL;
+  file->http_header_included = f->http_header_included;
+#if LWIP_HTTPD_CUSTOM_FILES
+  file->is_custom_file = 0;
+#endif /* LWIP_HTTPD_CUSTOM_FILES */
 #if HTTPD_PRECALCULATED_CHECKSUM
-      file->chksum_count = f->chksum_count;
-      file->chksum = f->chksum;
+  file->chksum_count = f->chksum_count;
+  file->chksum = f->chksum;
 #endif /* HTTPD_PRECALCULATED_CHECKSUM */
+}
+
+/*-----------------------------------------------------------------------------------*/
+static err_t
+fs_open_file(struct fs_file *file, const char *name)
+{
+  const struct fsdata_file *f;
+
+  for (f = FS_ROOT; f != NULL; f = f->next) {
+    if (!strcmp(name, (char *)f->name)) {
+      fs_open_fsdata(file, f);
 #if LWIP_HTTPD_FILE_STATE
       file->state = fs_state_init(file, name);
 #endif /* #if LWIP_HTTPD_FILE_STATE */
       return ERR_OK;
     }
+  }
 
 #if LWIP_HTTPD_CUSTOM_FILES
   if (fs_open_custom(file, name)) {
@@ -93,11 +169,25 @@ fs_open(struct fs_file *file, const char *name)
   }
 #endif /* LWIP_HTTPD_CUSTOM_FILES */
 
-  }
   /* file not found */
   return ERR_VAL;
 }
 
+err_t
+fs_open(struct fs_file *file, const char *name)
+{
+  err_t err;
+
+  if ((file == NULL) || (name == NULL)) {
+     return ERR_ARG;
+  }
+
+  /* The header belongs to this request only */
+  err = fs_open_file(file, name);
+  if_none_match[0] = '\0';
+  return err;
+}
+
 /*-----------------------------------------------------------------------------------*/
 void
 fs_close(struct fs_file *file)
@@ -140,6 +230,13 @@ fs_read(struct fs_file *file, char *buffer, int count)
 #endif /* LWIP_HTTPD_CUSTOM_FILES */
 #endif /* LWIP_HTTPD_FS_ASYNC_READ */
 
+#if LWIP_HTTPD_CUSTOM_FILES
+  /* custom files without data are generated as they are read */
+  if (file->is_custom_file && (file->data == NULL)) {
+    return fs_read_custom(file, buffer, count);
+  }
+#endif /* LWIP_HTTPD_CUSTOM_FILES */
+
   read = file->len - file->index;
   if(read > count) {
     read = count;
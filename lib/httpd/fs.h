@@ -41,6 +41,9 @@
  *    that are not included in fsdata(_custom).c
  * - "void fs_close_custom(struct fs_file *file)"
  *    Called to free resources allocated by fs_open_custom().
+ * - "int fs_read_custom(struct fs_file *file, char *buffer, int count)"
+ *    Called to read custom files opened without data (with
+ *    LWIP_HTTPD_DYNAMIC_FILE_READ), must advance file->index.
  */
 #ifndef LWIP_HTTPD_CUSTOM_FILES
 #define LWIP_HTTPD_CUSTOM_FILES       0
@@ -7,9 +7,16 @@
 extern "C" {
 #endif
 
+struct fsdata_file;
+
 int fs_open_custom(struct fs_file *file, const char *name);
 void fs_close_custom(struct fs_file *file);
 
+/* Serve an fsdata file, or its 304 response if the request already has it cached */
+void fs_open_fsdata(struct fs_file *file, const struct fsdata_file *f);
+/* Nonzero if the If-None-Match of the GET request being opened is etag */
+int fs_if_none_match(const char *etag);
+
 #ifdef __cplusplus
 }
 #endif
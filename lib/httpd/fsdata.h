@@ -41,6 +41,9 @@ struct fsdata_file {
   const unsigned char *data;
   int len;
   u8_t http_header_included;
+  const char *etag;                   /* Quoted strong ETag sent with the file, NULL if none */
+  const unsigned char *not_modified;  /* Complete 304 response for a matching If-None-Match */
+  int not_modified_len;
 #if HTTPD_PRECALCULATED_CHECKSUM
   u16_t chksum_count;
   const struct fsdata_chksum *chksum;
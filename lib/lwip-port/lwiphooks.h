@@ -0,0 +1,20 @@
+#ifndef __LWIPHOOKS_H__
+#define __LWIPHOOKS_H__
+
+#include "lwip/err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct tcp_pcb;
+struct pbuf;
+
+/* lib/httpd/fs.c */
+err_t fs_tcp_inpacket(struct tcp_pcb *pcb, struct pbuf *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LWIPHOOKS_H__ */
@@ -48,6 +48,7 @@
 
 #define TCP_MSS                         (1500 /*mtu*/ - 20 /*iphdr*/ - 20 /*tcphhr*/)
 #define TCP_SND_BUF                     (2 * TCP_MSS)
+#define MEM_SIZE                        (2 * TCP_SND_BUF + 1024) // httpd send buffer and the segments copied from it
 
 #define ETHARP_SUPPORT_STATIC_ENTRIES   1
 
@@ -56,11 +57,15 @@
 #define LWIP_HTTPD_CGI_SSI              0
 #define LWIP_HTTPD_SSI_INCLUDE_TAG      0
 #define LWIP_HTTPD_CUSTOM_FILES         1
+#define LWIP_HTTPD_DYNAMIC_FILE_READ    1 // Web config responses are generated while they are sent
 #define LWIP_HTTPD_SUPPORT_POST         1
 #define LWIP_HTTPD_SUPPORT_V09          0
 #define LWIP_HTTPD_SUPPORT_11_KEEPALIVE 0 // Causes lockups with CGI requests
 #define LWIP_HTTPD_ABORT_ON_CLOSE_MEM_ERROR 1
 
+#define LWIP_HOOK_FILENAME              "lwiphooks.h"
+#define LWIP_HOOK_TCP_INPACKET_PCB(pcb, hdr, optlen, opt1len, opt2, p) fs_tcp_inpacket(pcb, p) // If-None-Match for lib/httpd
+
 #define LWIP_SINGLE_NETIF               1
 
 #endif /* __LWIPOPTS_H__ */
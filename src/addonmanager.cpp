@@ -1,12 +1,27 @@
 #include "addonmanager.h"
 #include "usbhostmanager.h"
+#include "loopprofiler.h"
+
+#include "pico/platform.h"
 
 bool AddonManager::LoadAddon(GPAddon* addon) {
-    if (addon->available()) {
-        AddonBlock * block = new AddonBlock;
+    bool onThisCore = (addon->core() >= CORE1_ALWAYS) == (get_core_num() == 1);
+    if (onThisCore && addonCount < ADDON_MANAGER_MAX_ADDONS && addon->available()) {
+        uint8_t index = addonCount++;
         addon->setup();
-        block->ptr = addon;
-        addons.push_back(block);
+        addons[index] = addon;
+#if LOOP_PROFILER_ENABLED
+        LoopProfiler::getInstance().setAddonName(index, addon->name().c_str());
+#endif
+
+        // Only dispatch to the phases the addon does work in
+        uint8_t phases = addon->phases();
+        if (phases & ADDON_PHASE_PREPROCESS)
+            preprocessList.add(index);
+        if (phases & ADDON_PHASE_PROCESS)
+            processList.add(index);
+        if (phases & ADDON_PHASE_POSTPROCESS)
+            postprocessList.add(index);
         return true;
     } else {
         delete addon; // Don't use the memory if we don't have to   
@@ -24,37 +39,43 @@ bool AddonManager::LoadUSBAddon(GPAddon* addon) {
 
 void AddonManager::ReinitializeAddons() {
     // Loop through all addons and process any that match our type
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        (*it)->ptr->reinit();
+    for (uint8_t i = 0; i < addonCount; i++) {
+        addons[i]->reinit();
     }
 }
 
 void AddonManager::PreprocessAddons() {
-    // Loop through all addons and process any that match our type
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        (*it)->ptr->preprocess();
+    for (uint8_t i = 0; i < preprocessList.count; i++) {
+        uint8_t index = preprocessList.index[i];
+        LOOP_PROFILE_ADDON_BEGIN();
+        addons[index]->preprocess();
+        LOOP_PROFILE_ADDON_END(index, LOOP_ADDON_PREPROCESS);
     }
 }
 
 void AddonManager::ProcessAddons() {
-    // Loop through all addons and process any that match our type
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        (*it)->ptr->process();
+    for (uint8_t i = 0; i < processList.count; i++) {
+        uint8_t index = processList.index[i];
+        LOOP_PROFILE_ADDON_BEGIN();
+        addons[index]->process();
+        LOOP_PROFILE_ADDON_END(index, LOOP_ADDON_PROCESS);
     }
 }
 
 void AddonManager::PostprocessAddons(bool reportSent) {
-    // Loop through all addons and process any that match our type
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        (*it)->ptr->postprocess(reportSent);
+    for (uint8_t i = 0; i < postprocessList.count; i++) {
+        uint8_t index = postprocessList.index[i];
+        LOOP_PROFILE_ADDON_BEGIN();
+        addons[index]->postprocess(reportSent);
+        LOOP_PROFILE_ADDON_END(index, LOOP_ADDON_POSTPROCESS);
     }
 }
 
 // HACK : change this for NeoPicoLED
 GPAddon * AddonManager::GetAddon(std::string name) { // hack for NeoPicoLED
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        if ( (*it)->ptr->name() == name )
-            return (*it)->ptr;
+    for (uint8_t i = 0; i < addonCount; i++) {
+        if ( addons[i]->name() == name )
+            return addons[i];
     }
     return nullptr;
 }
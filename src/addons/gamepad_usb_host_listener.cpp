@@ -4,47 +4,98 @@
 #include "class/hid/hid.h"
 #include "class/hid/hid_host.h"
 
+#include <cstdlib>
+
+static bool stick_moved(uint16_t x, uint16_t y) {
+    return (abs(x - GAMEPAD_JOYSTICK_MID) > GAMEPAD_HOST_STICK_DEADZONE) || (abs(y - GAMEPAD_JOYSTICK_MID) > GAMEPAD_HOST_STICK_DEADZONE);
+}
+
 void GamepadUSBHostListener::setup() {
-    _controller_host_enabled = false;
+    for (uint8_t i = 0; i < GAMEPAD_HOST_MAX_DEVICES; i++) {
+        _devices[i] = {};
+    }
 #if GAMEPAD_HOST_DEBUG
     stdio_init_all();
 #endif
 }
 
+/**
+ * @brief Merge every mounted controller into the gamepad state.
+ *
+ * Buttons and dpad are combined and each trigger reads the controller pressing it furthest. Each stick
+ * comes from the first controller, in slot order, that moves it out of GAMEPAD_HOST_STICK_DEADZONE, or from
+ * the first controller when all of them rest, so an idle pad never pins another one's stick to center.
+ */
 void GamepadUSBHostListener::process() {
     Gamepad *gamepad = Storage::getInstance().GetGamepad();
     gamepad->hasAnalogTriggers = true;
     gamepad->hasLeftAnalogStick = true;
     gamepad->hasRightAnalogStick = true;
-    gamepad->state.dpad     |= _controller_host_state.dpad;
-    gamepad->state.buttons  |= _controller_host_state.buttons;
-    gamepad->state.lx       = _controller_host_state.lx;
-    gamepad->state.ly       = _controller_host_state.ly;
-    gamepad->state.rx       = _controller_host_state.rx;
-    gamepad->state.ry       = _controller_host_state.ry;
-    gamepad->state.rt       = _controller_host_state.rt;
-    gamepad->state.lt       = _controller_host_state.lt;
+
+    GamepadState const* leftStick = nullptr;
+    GamepadState const* rightStick = nullptr;
+    bool leftMoved = false;
+    bool rightMoved = false;
+    uint8_t lt = 0;
+    uint8_t rt = 0;
+    for (uint8_t i = 0; i < GAMEPAD_HOST_MAX_DEVICES; i++) {
+        if (!_devices[i].enabled) continue;
+
+        GamepadState const& state = _devices[i].state;
+        gamepad->state.dpad     |= state.dpad;
+        gamepad->state.buttons  |= state.buttons;
+        if (state.lt > lt) lt = state.lt;
+        if (state.rt > rt) rt = state.rt;
+
+        if (leftStick == nullptr || (!leftMoved && stick_moved(state.lx, state.ly))) {
+            leftStick = &state;
+            leftMoved = stick_moved(state.lx, state.ly);
+        }
+        if (rightStick == nullptr || (!rightMoved && stick_moved(state.rx, state.ry))) {
+            rightStick = &state;
+            rightMoved = stick_moved(state.rx, state.ry);
+        }
+    }
+
+    gamepad->state.lx       = (leftStick != nullptr) ? leftStick->lx : GAMEPAD_JOYSTICK_MID;
+    gamepad->state.ly       = (leftStick != nullptr) ? leftStick->ly : GAMEPAD_JOYSTICK_MID;
+    gamepad->state.rx       = (rightStick != nullptr) ? rightStick->rx : GAMEPAD_JOYSTICK_MID;
+    gamepad->state.ry       = (rightStick != nullptr) ? rightStick->ry : GAMEPAD_JOYSTICK_MID;
+    gamepad->state.rt       = rt;
+    gamepad->state.lt       = lt;
 }
 
-void GamepadUSBHostListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
-    _controller_host_enabled = true;
-    _controller_dev_addr = dev_addr;
-    _controller_instance = instance;
-    tuh_vid_pid_get(dev_addr, &controller_vid, &controller_pid);
+GamepadHostDevice* GamepadUSBHostListener::find_device(uint8_t dev_addr, uint8_t instance) {
+    for (uint8_t i = 0; i < GAMEPAD_HOST_MAX_DEVICES; i++) {
+        if (_devices[i].enabled && _devices[i].dev_addr == dev_addr && _devices[i].instance == instance) {
+            return &_devices[i];
+        }
+    }
+    return nullptr;
+}
+
+bool GamepadUSBHostListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
+    // keyboards and mice are left to the keyboard host
+    if (tuh_hid_interface_protocol(dev_addr, instance) != HID_ITF_PROTOCOL_NONE) return false;
+
+    GamepadHostDevice* free_device = nullptr;
+    for (uint8_t i = 0; i < GAMEPAD_HOST_MAX_DEVICES && free_device == nullptr; i++) {
+        if (!_devices[i].enabled) free_device = &_devices[i];
+    }
+    if (free_device == nullptr) return false;
+
+    GamepadHostDevice& device = *free_device;
+    device = {};
+    device.enabled = true;
+    device.dev_addr = dev_addr;
+    device.instance = instance;
+    tuh_vid_pid_get(dev_addr, &device.vid, &device.pid);
 
 #if GAMEPAD_HOST_DEBUG
-    //printf("Mount: VID_%04x PID_%04x\n", controller_vid, controller_pid);
+    //printf("Mount: VID_%04x PID_%04x\n", device.vid, device.pid);
 #endif
 
-    uint16_t joystick_mid = GAMEPAD_JOYSTICK_MID;
-    _controller_host_state.buttons = 0;
-    _controller_host_state.dpad = 0;
-    _controller_host_state.lx = joystick_mid;
-    _controller_host_state.ly = joystick_mid;
-    _controller_host_state.rx = joystick_mid;
-    _controller_host_state.ry = joystick_mid;
-
-    switch(controller_pid)
+    switch(device.pid)
     {
         /* PS4/5 */
         // these require initialization
@@ -52,23 +103,23 @@ void GamepadUSBHostListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t c
         case 0x00EE:               // Hori Minipad
         case PS4_WHEEL_PRODUCT_ID: // G29
         case 0xB67B:               // T-Flight
-            init_ds4(desc_report, desc_len);
+            init_ds4(device, desc_report, desc_len);
             break;
         // while these do not
         case DS4_ORG_PRODUCT_ID:   // Sony Dualshock 4 controller
         case DS4_PRODUCT_ID:       // Sony Dualshock 4 controller
-            isDS4Identified = true;
-            setup_ds4();
+            device.isDS4Identified = true;
+            setup_ds4(device);
             break;
         case 0x0CE6:               // DualSense
             break;
 
         case 0xC294:               // Driving Force or similar
-            isDFInit = false;
-            setup_df_wheel();
+            device.isDFInit = false;
+            setup_df_wheel(device);
             break;
         case 0xC29A:
-            isDFInit = true;
+            device.isDFInit = true;
             break;
 
         /* Other */
@@ -76,35 +127,36 @@ void GamepadUSBHostListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t c
         case 0x9400:               // Google Stadia controller
         case 0x0510:               // pre-2015 Ultrakstik 360
         case 0x0511:               // Ultrakstik 360
+            break;
+
+        // anything else is decoded from its report descriptor when it has a Joystick or Gamepad collection,
+        // other interfaces (mice, keyboards) are left alone
         default:
+            if (!device.plan.compile(desc_report, desc_len)) {
+                device = {};
+                return false;
+            }
             break;
     }
+    return true;
 }
 
 void GamepadUSBHostListener::unmount(uint8_t dev_addr) {
-    _controller_host_enabled = false;
-    controller_pid = 0x00;
-    controller_vid = 0x00;
-    _controller_dev_addr = 0;
-    _controller_instance = 0;
-    isDS4Identified = false;
-    hasDS4DefReport = false;
+    for (uint8_t i = 0; i < GAMEPAD_HOST_MAX_DEVICES; i++) {
+        if (_devices[i].enabled && _devices[i].dev_addr == dev_addr) {
+            _devices[i] = {};
+        }
+    }
 }
 
 void GamepadUSBHostListener::report_received(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {
-    // if a hid device hasn't been mounted
-    if ( _controller_host_enabled == false ) return;
-
-    // Interface protocol (hid_interface_protocol_enum_t)
-    uint8_t const itf_protocol = tuh_hid_interface_protocol(dev_addr, instance);
+    GamepadHostDevice* device = find_device(dev_addr, instance);
+    if (device == nullptr) return;
 
-    // stop execution if a keyboard or mouse is mounted
-    if ( itf_protocol == HID_ITF_PROTOCOL_KEYBOARD ) return;
-
-    process_ctrlr_report(dev_addr, report, len);
+    process_ctrlr_report(*device, report, len);
 }
 
-void GamepadUSBHostListener::process_ctrlr_report(uint8_t dev_addr, uint8_t const* report, uint16_t len) {
+void GamepadUSBHostListener::process_ctrlr_report(GamepadHostDevice& device, uint8_t const* report, uint16_t len) {
 #if GAMEPAD_HOST_DEBUG
     //printf("\033[1;0H\nHost (%d):\n", len);
     //for (uint8_t i = 0; i < len; i++) {
@@ -114,7 +166,7 @@ void GamepadUSBHostListener::process_ctrlr_report(uint8_t dev_addr, uint8_t cons
     //printf("----\n");
 #endif
 
-    switch(controller_pid)
+    switch(device.pid)
     {
         case DS4_ORG_PRODUCT_ID:   // Sony Dualshock 4 controller
         case DS4_PRODUCT_ID:       // Sony Dualshock 4 controller
@@ -122,64 +174,71 @@ void GamepadUSBHostListener::process_ctrlr_report(uint8_t dev_addr, uint8_t cons
         case PS4_WHEEL_PRODUCT_ID: // G29
         case 0xB67B:               // T-Flight
         case 0x00EE:               // Hori Minipad
-            if (isDS4Identified) {
-                update_ds4();
-                process_ds4(report, len);
+            if (device.isDS4Identified) {
+                update_ds4(device);
+                process_ds4(device, report, len);
             }
             break;
         case 0x0CE6:               // DualSense
-            process_ds(report, len);
+            process_ds(device, report, len);
             break;
         case 0x9400:               // Google Stadia controller
-            process_stadia(report, len);
+            process_stadia(device, report, len);
             break;
 
         case 0xC294:               // Driving Force
-            if (!isDFInit) setup_df_wheel();
+            if (!device.isDFInit) setup_df_wheel(device);
             break;
 
         case 0xC29A:
-            process_dfgt(report, len);
+            process_dfgt(device, report, len);
             break;
 
         case 0x0510:               // pre-2015 Ultrakstik 360
         case 0x0511:               // Ultrakstik 360
-            process_ultrastik360(report, len);
+            process_ultrastik360(device, report, len);
             break;
         default:
+            device.plan.decode(report, len, device.state);
             break;
     }
 }
 
-bool GamepadUSBHostListener::host_get_report(uint8_t report_id, void* report, uint16_t len) {
-    awaiting_cb = true;
-    return tuh_hid_get_report(_controller_dev_addr, _controller_instance, report_id, HID_REPORT_TYPE_FEATURE, report, len);
+bool GamepadUSBHostListener::host_get_report(GamepadHostDevice& device, uint8_t report_id, void* report, uint16_t len) {
+    device.awaiting_cb = true;
+    return tuh_hid_get_report(device.dev_addr, device.instance, report_id, HID_REPORT_TYPE_FEATURE, report, len);
 }
 
-bool GamepadUSBHostListener::host_set_report(uint8_t report_id, void* report, uint16_t len) {
-    awaiting_cb = true;
-    return tuh_hid_set_report(_controller_dev_addr, _controller_instance, report_id, HID_REPORT_TYPE_FEATURE, report, len);
+bool GamepadUSBHostListener::host_set_report(GamepadHostDevice& device, uint8_t report_id, void* report, uint16_t len) {
+    device.awaiting_cb = true;
+    return tuh_hid_set_report(device.dev_addr, device.instance, report_id, HID_REPORT_TYPE_FEATURE, report, len);
 }
 
 void GamepadUSBHostListener::set_report_complete(uint8_t dev_addr, uint8_t instance, uint8_t report_id, uint8_t report_type, uint16_t len) {
-    awaiting_cb = false;
+    GamepadHostDevice* device = find_device(dev_addr, instance);
+    if (device == nullptr) return;
+
+    device->awaiting_cb = false;
 }
 
 void GamepadUSBHostListener::get_report_complete(uint8_t dev_addr, uint8_t instance, uint8_t report_id, uint8_t report_type, uint16_t len) {
 #if GAMEPAD_HOST_DEBUG
     //printf("get_report_complete Report ID: %02x\n", report_id);
 #endif
-    if (!isDS4Identified) {
+    GamepadHostDevice* device = find_device(dev_addr, instance);
+    if (device == nullptr) return;
+
+    if (!device->isDS4Identified) {
         switch (report_id) {
             case PS4AuthReport::PS4_DEFINITION:
-                setup_ds4();
+                setup_ds4(*device);
                 break;
             default: 
                 break;
         }
     }
     //
-    awaiting_cb = false;
+    device->awaiting_cb = false;
 }
 
 uint16_t GamepadUSBHostListener::map(uint8_t x, uint8_t in_min, uint8_t in_max, uint16_t out_min, uint16_t out_max) {
@@ -206,30 +265,30 @@ bool GamepadUSBHostListener::diff_report(PS4Report const* rpt1, PS4Report const*
     return result;
 }
 
-void GamepadUSBHostListener::setup_ds4() {
-    if (hasDS4DefReport) {
+void GamepadUSBHostListener::setup_ds4(GamepadHostDevice& device) {
+    if (device.hasDS4DefReport) {
         // report came from the controller so copy the buffer
-        memcpy(&ds4Config, report_buffer+1, sizeof(PS4ControllerConfig));
+        memcpy(&device.ds4Config, device.report_buffer+1, sizeof(PS4ControllerConfig));
     }
-    if ((ds4Config.hidUsage == 0x2721) || (ds4Config.hidUsage == 0x2127)) {
-        isDS4Identified = true;
+    if ((device.ds4Config.hidUsage == 0x2721) || (device.ds4Config.hidUsage == 0x2127)) {
+        device.isDS4Identified = true;
 #if GAMEPAD_HOST_DEBUG
         //printf("PS4 controller details\n");
         //printf("----------------------\n");
-        //printf("enableController: %d\n", ds4Config.features.enableController);
-        //printf("enableMotion: %d\n", ds4Config.features.enableMotion);
-        //printf("enableLED: %d\n", ds4Config.features.enableLED);
-        //printf("enableRumble: %d\n", ds4Config.features.enableRumble);
-        //printf("enableAnalog: %d\n", ds4Config.features.enableAnalog);
-        //printf("enableUnknown0: %d\n", ds4Config.features.enableUnknown0);
-        //printf("enableTouchpad: %d\n", ds4Config.features.enableTouchpad);
-        //printf("enableUnknown1: %d\n", ds4Config.features.enableUnknown1);
+        //printf("enableController: %d\n", device.ds4Config.features.enableController);
+        //printf("enableMotion: %d\n", device.ds4Config.features.enableMotion);
+        //printf("enableLED: %d\n", device.ds4Config.features.enableLED);
+        //printf("enableRumble: %d\n", device.ds4Config.features.enableRumble);
+        //printf("enableAnalog: %d\n", device.ds4Config.features.enableAnalog);
+        //printf("enableUnknown0: %d\n", device.ds4Config.features.enableUnknown0);
+        //printf("enableTouchpad: %d\n", device.ds4Config.features.enableTouchpad);
+        //printf("enableUnknown1: %d\n", device.ds4Config.features.enableUnknown1);
 #endif
     }
 }
 
-void GamepadUSBHostListener::init_ds4(const uint8_t* descReport, uint16_t descLen) {
-    isDS4Identified = false;
+void GamepadUSBHostListener::init_ds4(GamepadHostDevice& device, const uint8_t* descReport, uint16_t descLen) {
+    device.isDS4Identified = false;
 
     tuh_hid_report_info_t report_info[4];
     uint8_t report_count = tuh_hid_parse_report_descriptor(report_info, 4, descReport, descLen);
@@ -239,21 +298,21 @@ void GamepadUSBHostListener::init_ds4(const uint8_t* descReport, uint16_t descLe
 #endif
         if (report_info[i].report_id == PS4AuthReport::PS4_DEFINITION) {
             // controller is some other type that's not a DS4, so parse the config
-            memset(report_buffer, 0, PS4_ENDPOINT_SIZE);
-            report_buffer[0] = PS4AuthReport::PS4_DEFINITION;
-            host_get_report(PS4AuthReport::PS4_DEFINITION, report_buffer, 48);
-            hasDS4DefReport = true;
+            memset(device.report_buffer, 0, PS4_ENDPOINT_SIZE);
+            device.report_buffer[0] = PS4AuthReport::PS4_DEFINITION;
+            host_get_report(device, PS4AuthReport::PS4_DEFINITION, device.report_buffer, 48);
+            device.hasDS4DefReport = true;
             break;
         }
     }
     
-    if (!hasDS4DefReport) {
+    if (!device.hasDS4DefReport) {
         // no report found, DS4 or clone assume. use struct default data.
-        //isDS4Identified = true;
+        //device.isDS4Identified = true;
     }
 }
 
-void GamepadUSBHostListener::update_ds4() {
+void GamepadUSBHostListener::update_ds4(GamepadHostDevice& device) {
 #if GAMEPAD_HOST_USE_FEATURES
     Gamepad * gamepad = Storage::getInstance().GetProcessedGamepad();
     PS4FeatureOutputReport controller_output;
@@ -262,7 +321,7 @@ void GamepadUSBHostListener::update_ds4() {
 
     controller_output.reportID = PS4AuthReport::PS4_SET_FEATURE_STATE;
 
-    if (ds4Config.features.enableLED && gamepad->auxState.sensors.statusLight.enabled) {
+    if (device.ds4Config.features.enableLED && gamepad->auxState.sensors.statusLight.enabled) {
         controller_output.enableUpdateLED = gamepad->auxState.sensors.statusLight.enabled;
         controller_output.ledRed = gamepad->auxState.sensors.statusLight.color.red;
         controller_output.ledGreen = gamepad->auxState.sensors.statusLight.color.green;
@@ -271,7 +330,7 @@ void GamepadUSBHostListener::update_ds4() {
         controller_output.ledBlinkOff = gamepad->auxState.playerID.ledBlinkOff;
     }
 
-    if (ds4Config.features.enableRumble) {
+    if (device.ds4Config.features.enableRumble) {
         gamepad->auxState.haptics.leftActuator.enabled = 1;
         gamepad->auxState.haptics.rightActuator.enabled = 1;
         controller_output.enableUpdateRumble = 1;
@@ -282,159 +341,153 @@ void GamepadUSBHostListener::update_ds4() {
     void * report = &controller_output;
     uint16_t report_size = sizeof(controller_output)-1;
 
-    tuh_hid_send_report(_controller_dev_addr, _controller_instance, 5, report+1, report_size);
+    tuh_hid_send_report(device.dev_addr, device.instance, 5, report+1, report_size);
 #endif
 }
 
-void GamepadUSBHostListener::process_ds4(uint8_t const* report, uint16_t len) {
+void GamepadUSBHostListener::process_ds4(GamepadHostDevice& device, uint8_t const* report, uint16_t len) {
     PS4Report controller_report;
 
-    // previous report used to compare for changes
-    static PS4Report prev_report = { 0 };
-
     uint8_t const report_id = report[0];
 
     if (report_id == 1) {
         memcpy(&controller_report, report, sizeof(controller_report));
 
-        if ( diff_report(&prev_report, &controller_report) ) {
-            _controller_host_state.lx = map(controller_report.leftStickX, 0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            _controller_host_state.ly = map(controller_report.leftStickY, 0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            _controller_host_state.rx = map(controller_report.rightStickX,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            _controller_host_state.ry = map(controller_report.rightStickY,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            _controller_host_state.lt = controller_report.leftTrigger;
-            _controller_host_state.rt = controller_report.rightTrigger;
-
-            _controller_host_state.buttons = 0;
-            if (controller_report.buttonTouchpad) _controller_host_state.buttons |= GAMEPAD_MASK_A2;
-            if (controller_report.buttonSelect) _controller_host_state.buttons |= GAMEPAD_MASK_S1;
-            if (controller_report.buttonR3) _controller_host_state.buttons |= GAMEPAD_MASK_R3;
-            if (controller_report.buttonL3) _controller_host_state.buttons |= GAMEPAD_MASK_L3;
-            if (controller_report.buttonHome) _controller_host_state.buttons |= GAMEPAD_MASK_A1;
-            if (controller_report.buttonStart) _controller_host_state.buttons |= GAMEPAD_MASK_S2;
-            if (controller_report.buttonR1) _controller_host_state.buttons |= GAMEPAD_MASK_R1;
-            if (controller_report.buttonL1) _controller_host_state.buttons |= GAMEPAD_MASK_L1;
-            if (controller_report.buttonNorth) _controller_host_state.buttons |= GAMEPAD_MASK_B4;
-            if (controller_report.buttonEast) _controller_host_state.buttons |= GAMEPAD_MASK_B2;
-            if (controller_report.buttonSouth) _controller_host_state.buttons |= GAMEPAD_MASK_B1;
-            if (controller_report.buttonWest) _controller_host_state.buttons |= GAMEPAD_MASK_B3;
-            if (controller_report.buttonR2) _controller_host_state.buttons |= GAMEPAD_MASK_R2;
-            if (controller_report.buttonL2) _controller_host_state.buttons |= GAMEPAD_MASK_L2;
-
-            _controller_host_state.dpad = 0;
-            if (controller_report.dpad == PS4_HAT_UP) _controller_host_state.dpad |= GAMEPAD_MASK_UP;
-            if (controller_report.dpad == PS4_HAT_UPRIGHT) _controller_host_state.dpad |= GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT;
-            if (controller_report.dpad == PS4_HAT_RIGHT) _controller_host_state.dpad |= GAMEPAD_MASK_RIGHT;
-            if (controller_report.dpad == PS4_HAT_DOWNRIGHT) _controller_host_state.dpad |= GAMEPAD_MASK_RIGHT | GAMEPAD_MASK_DOWN;
-            if (controller_report.dpad == PS4_HAT_DOWN) _controller_host_state.dpad |= GAMEPAD_MASK_DOWN;
-            if (controller_report.dpad == PS4_HAT_DOWNLEFT) _controller_host_state.dpad |= GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT;
-            if (controller_report.dpad == PS4_HAT_LEFT) _controller_host_state.dpad |= GAMEPAD_MASK_LEFT;
-            if (controller_report.dpad == PS4_HAT_UPLEFT) _controller_host_state.dpad |= GAMEPAD_MASK_LEFT | GAMEPAD_MASK_UP;
+        if ( diff_report(&device.prev_report.ds4, &controller_report) ) {
+            device.state.lx = map(controller_report.leftStickX, 0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+            device.state.ly = map(controller_report.leftStickY, 0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+            device.state.rx = map(controller_report.rightStickX,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+            device.state.ry = map(controller_report.rightStickY,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+            device.state.lt = controller_report.leftTrigger;
+            device.state.rt = controller_report.rightTrigger;
+
+            device.state.buttons = 0;
+            if (controller_report.buttonTouchpad) device.state.buttons |= GAMEPAD_MASK_A2;
+            if (controller_report.buttonSelect) device.state.buttons |= GAMEPAD_MASK_S1;
+            if (controller_report.buttonR3) device.state.buttons |= GAMEPAD_MASK_R3;
+            if (controller_report.buttonL3) device.state.buttons |= GAMEPAD_MASK_L3;
+            if (controller_report.buttonHome) device.state.buttons |= GAMEPAD_MASK_A1;
+            if (controller_report.buttonStart) device.state.buttons |= GAMEPAD_MASK_S2;
+            if (controller_report.buttonR1) device.state.buttons |= GAMEPAD_MASK_R1;
+            if (controller_report.buttonL1) device.state.buttons |= GAMEPAD_MASK_L1;
+            if (controller_report.buttonNorth) device.state.buttons |= GAMEPAD_MASK_B4;
+            if (controller_report.buttonEast) device.state.buttons |= GAMEPAD_MASK_B2;
+            if (controller_report.buttonSouth) device.state.buttons |= GAMEPAD_MASK_B1;
+            if (controller_report.buttonWest) device.state.buttons |= GAMEPAD_MASK_B3;
+            if (controller_report.buttonR2) device.state.buttons |= GAMEPAD_MASK_R2;
+            if (controller_report.buttonL2) device.state.buttons |= GAMEPAD_MASK_L2;
+
+            device.state.dpad = 0;
+            if (controller_report.dpad == PS4_HAT_UP) device.state.dpad |= GAMEPAD_MASK_UP;
+            if (controller_report.dpad == PS4_HAT_UPRIGHT) device.state.dpad |= GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT;
+            if (controller_report.dpad == PS4_HAT_RIGHT) device.state.dpad |= GAMEPAD_MASK_RIGHT;
+            if (controller_report.dpad == PS4_HAT_DOWNRIGHT) device.state.dpad |= GAMEPAD_MASK_RIGHT | GAMEPAD_MASK_DOWN;
+            if (controller_report.dpad == PS4_HAT_DOWN) device.state.dpad |= GAMEPAD_MASK_DOWN;
+            if (controller_report.dpad == PS4_HAT_DOWNLEFT) device.state.dpad |= GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT;
+            if (controller_report.dpad == PS4_HAT_LEFT) device.state.dpad |= GAMEPAD_MASK_LEFT;
+            if (controller_report.dpad == PS4_HAT_UPLEFT) device.state.dpad |= GAMEPAD_MASK_LEFT | GAMEPAD_MASK_UP;
         }
     }
 
-    prev_report = controller_report;
+    device.prev_report.ds4 = controller_report;
 }
 
-void GamepadUSBHostListener::process_ds(uint8_t const* report, uint16_t len) {
+void GamepadUSBHostListener::process_ds(GamepadHostDevice& device, uint8_t const* report, uint16_t len) {
     DSReport controller_report;
 
-    // previous report used to compare for changes
-    static DSReport prev_ds_report = { 0 };
-
     uint8_t const report_id = report[0];
 
     if (report_id == 1) {
         memcpy(&controller_report, report, sizeof(controller_report));
 
-        if ( prev_ds_report.reportCounter != controller_report.reportCounter ) {
-            _controller_host_state.lx = map(controller_report.leftStickX, 0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            _controller_host_state.ly = map(controller_report.leftStickY, 0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            _controller_host_state.rx = map(controller_report.rightStickX,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            _controller_host_state.ry = map(controller_report.rightStickY,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            _controller_host_state.lt = controller_report.leftTrigger;
-            _controller_host_state.rt = controller_report.rightTrigger;
-
-            _controller_host_state.buttons = 0;
-            if (controller_report.buttonTouchpad) _controller_host_state.buttons |= GAMEPAD_MASK_A2;
-            if (controller_report.buttonSelect) _controller_host_state.buttons |= GAMEPAD_MASK_S1;
-            if (controller_report.buttonR3) _controller_host_state.buttons |= GAMEPAD_MASK_R3;
-            if (controller_report.buttonL3) _controller_host_state.buttons |= GAMEPAD_MASK_L3;
-            if (controller_report.buttonHome) _controller_host_state.buttons |= GAMEPAD_MASK_A1;
-            if (controller_report.buttonStart) _controller_host_state.buttons |= GAMEPAD_MASK_S2;
-            if (controller_report.buttonR1) _controller_host_state.buttons |= GAMEPAD_MASK_R1;
-            if (controller_report.buttonL1) _controller_host_state.buttons |= GAMEPAD_MASK_L1;
-            if (controller_report.buttonNorth) _controller_host_state.buttons |= GAMEPAD_MASK_B4;
-            if (controller_report.buttonEast) _controller_host_state.buttons |= GAMEPAD_MASK_B2;
-            if (controller_report.buttonSouth) _controller_host_state.buttons |= GAMEPAD_MASK_B1;
-            if (controller_report.buttonWest) _controller_host_state.buttons |= GAMEPAD_MASK_B3;
-            if (controller_report.buttonR2) _controller_host_state.buttons |= GAMEPAD_MASK_R2;
-            if (controller_report.buttonL2) _controller_host_state.buttons |= GAMEPAD_MASK_L2;
-
-            _controller_host_state.dpad = 0;
-            if (controller_report.dpad == PS4_HAT_UP) _controller_host_state.dpad |= GAMEPAD_MASK_UP;
-            if (controller_report.dpad == PS4_HAT_UPRIGHT) _controller_host_state.dpad |= GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT;
-            if (controller_report.dpad == PS4_HAT_RIGHT) _controller_host_state.dpad |= GAMEPAD_MASK_RIGHT;
-            if (controller_report.dpad == PS4_HAT_DOWNRIGHT) _controller_host_state.dpad |= GAMEPAD_MASK_RIGHT | GAMEPAD_MASK_DOWN;
-            if (controller_report.dpad == PS4_HAT_DOWN) _controller_host_state.dpad |= GAMEPAD_MASK_DOWN;
-            if (controller_report.dpad == PS4_HAT_DOWNLEFT) _controller_host_state.dpad |= GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT;
-            if (controller_report.dpad == PS4_HAT_LEFT) _controller_host_state.dpad |= GAMEPAD_MASK_LEFT;
-            if (controller_report.dpad == PS4_HAT_UPLEFT) _controller_host_state.dpad |= GAMEPAD_MASK_LEFT | GAMEPAD_MASK_UP;
+        if ( device.prev_report.ds.reportCounter != controller_report.reportCounter ) {
+            device.state.lx = map(controller_report.leftStickX, 0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+            device.state.ly = map(controller_report.leftStickY, 0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+            device.state.rx = map(controller_report.rightStickX,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+            device.state.ry = map(controller_report.rightStickY,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+            device.state.lt = controller_report.leftTrigger;
+            device.state.rt = controller_report.rightTrigger;
+
+            device.state.buttons = 0;
+            if (controller_report.buttonTouchpad) device.state.buttons |= GAMEPAD_MASK_A2;
+            if (controller_report.buttonSelect) device.state.buttons |= GAMEPAD_MASK_S1;
+            if (controller_report.buttonR3) device.state.buttons |= GAMEPAD_MASK_R3;
+            if (controller_report.buttonL3) device.state.buttons |= GAMEPAD_MASK_L3;
+            if (controller_report.buttonHome) device.state.buttons |= GAMEPAD_MASK_A1;
+            if (controller_report.buttonStart) device.state.buttons |= GAMEPAD_MASK_S2;
+            if (controller_report.buttonR1) device.state.buttons |= GAMEPAD_MASK_R1;
+            if (controller_report.buttonL1) device.state.buttons |= GAMEPAD_MASK_L1;
+            if (controller_report.buttonNorth) device.state.buttons |= GAMEPAD_MASK_B4;
+            if (controller_report.buttonEast) device.state.buttons |= GAMEPAD_MASK_B2;
+            if (controller_report.buttonSouth) device.state.buttons |= GAMEPAD_MASK_B1;
+            if (controller_report.buttonWest) device.state.buttons |= GAMEPAD_MASK_B3;
+            if (controller_report.buttonR2) device.state.buttons |= GAMEPAD_MASK_R2;
+            if (controller_report.buttonL2) device.state.buttons |= GAMEPAD_MASK_L2;
+
+            device.state.dpad = 0;
+            if (controller_report.dpad == PS4_HAT_UP) device.state.dpad |= GAMEPAD_MASK_UP;
+            if (controller_report.dpad == PS4_HAT_UPRIGHT) device.state.dpad |= GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT;
+            if (controller_report.dpad == PS4_HAT_RIGHT) device.state.dpad |= GAMEPAD_MASK_RIGHT;
+            if (controller_report.dpad == PS4_HAT_DOWNRIGHT) device.state.dpad |= GAMEPAD_MASK_RIGHT | GAMEPAD_MASK_DOWN;
+            if (controller_report.dpad == PS4_HAT_DOWN) device.state.dpad |= GAMEPAD_MASK_DOWN;
+            if (controller_report.dpad == PS4_HAT_DOWNLEFT) device.state.dpad |= GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT;
+            if (controller_report.dpad == PS4_HAT_LEFT) device.state.dpad |= GAMEPAD_MASK_LEFT;
+            if (controller_report.dpad == PS4_HAT_UPLEFT) device.state.dpad |= GAMEPAD_MASK_LEFT | GAMEPAD_MASK_UP;
         }
     }
 
-    prev_ds_report = controller_report;
+    device.prev_report.ds = controller_report;
 }
 
-void GamepadUSBHostListener::process_stadia(uint8_t const* report, uint16_t len) {
+void GamepadUSBHostListener::process_stadia(GamepadHostDevice& device, uint8_t const* report, uint16_t len) {
     google_stadia_report_t controller_report;
 
     memcpy(&controller_report, report, sizeof(controller_report));
 
-    _controller_host_state.lx = map(controller_report.GD_GamePadPointerX ,1,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-    _controller_host_state.ly = map(controller_report.GD_GamePadPointerY,1 ,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-    _controller_host_state.rx = map(controller_report.GD_GamePadPointerZ,1 ,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-    _controller_host_state.ry = map(controller_report.GD_GamePadPointerRz,1 ,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-    _controller_host_state.lt = controller_report.SIM_GamePadBrake;
-    _controller_host_state.rt = controller_report.SIM_GamePadAccelerator;
-
-    if (controller_report.BTN_GamePadButton18 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_A2;
-    if (controller_report.BTN_GamePadButton17 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_A3;
-    if (controller_report.BTN_GamePadButton11 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_S1;
-    if (controller_report.BTN_GamePadButton15 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_R3;
-    if (controller_report.BTN_GamePadButton14 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_L3;
-    if (controller_report.BTN_GamePadButton13 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_A1;
-    if (controller_report.BTN_GamePadButton12 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_S2;
-    if (controller_report.BTN_GamePadButton8 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_R1;
-    if (controller_report.BTN_GamePadButton7 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_L1;
-    if (controller_report.BTN_GamePadButton5 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_B4;
-    if (controller_report.BTN_GamePadButton4 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_B3;
-    if (controller_report.BTN_GamePadButton2 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_B2;
-    if (controller_report.BTN_GamePadButton1 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_B1;
-    if (controller_report.BTN_GamePadButton19 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_R2;
-    if (controller_report.BTN_GamePadButton20 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_L2;
-
-    if (controller_report.GD_GamePadHatSwitch == 0) _controller_host_state.dpad |= GAMEPAD_MASK_UP;
-    if (controller_report.GD_GamePadHatSwitch == 1) _controller_host_state.dpad |= GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT;
-    if (controller_report.GD_GamePadHatSwitch == 2) _controller_host_state.dpad |= GAMEPAD_MASK_RIGHT;
-    if (controller_report.GD_GamePadHatSwitch == 3) _controller_host_state.dpad |= GAMEPAD_MASK_RIGHT | GAMEPAD_MASK_DOWN;
-    if (controller_report.GD_GamePadHatSwitch == 4) _controller_host_state.dpad |= GAMEPAD_MASK_DOWN;
-    if (controller_report.GD_GamePadHatSwitch == 5) _controller_host_state.dpad |= GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT;
-    if (controller_report.GD_GamePadHatSwitch == 6) _controller_host_state.dpad |= GAMEPAD_MASK_LEFT;
-    if (controller_report.GD_GamePadHatSwitch == 7) _controller_host_state.dpad |= GAMEPAD_MASK_LEFT | GAMEPAD_MASK_UP;
+    device.state.lx = map(controller_report.GD_GamePadPointerX ,1,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+    device.state.ly = map(controller_report.GD_GamePadPointerY,1 ,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+    device.state.rx = map(controller_report.GD_GamePadPointerZ,1 ,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+    device.state.ry = map(controller_report.GD_GamePadPointerRz,1 ,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+    device.state.lt = controller_report.SIM_GamePadBrake;
+    device.state.rt = controller_report.SIM_GamePadAccelerator;
+
+    if (controller_report.BTN_GamePadButton18 == 1) device.state.buttons |= GAMEPAD_MASK_A2;
+    if (controller_report.BTN_GamePadButton17 == 1) device.state.buttons |= GAMEPAD_MASK_A3;
+    if (controller_report.BTN_GamePadButton11 == 1) device.state.buttons |= GAMEPAD_MASK_S1;
+    if (controller_report.BTN_GamePadButton15 == 1) device.state.buttons |= GAMEPAD_MASK_R3;
+    if (controller_report.BTN_GamePadButton14 == 1) device.state.buttons |= GAMEPAD_MASK_L3;
+    if (controller_report.BTN_GamePadButton13 == 1) device.state.buttons |= GAMEPAD_MASK_A1;
+    if (controller_report.BTN_GamePadButton12 == 1) device.state.buttons |= GAMEPAD_MASK_S2;
+    if (controller_report.BTN_GamePadButton8 == 1) device.state.buttons |= GAMEPAD_MASK_R1;
+    if (controller_report.BTN_GamePadButton7 == 1) device.state.buttons |= GAMEPAD_MASK_L1;
+    if (controller_report.BTN_GamePadButton5 == 1) device.state.buttons |= GAMEPAD_MASK_B4;
+    if (controller_report.BTN_GamePadButton4 == 1) device.state.buttons |= GAMEPAD_MASK_B3;
+    if (controller_report.BTN_GamePadButton2 == 1) device.state.buttons |= GAMEPAD_MASK_B2;
+    if (controller_report.BTN_GamePadButton1 == 1) device.state.buttons |= GAMEPAD_MASK_B1;
+    if (controller_report.BTN_GamePadButton19 == 1) device.state.buttons |= GAMEPAD_MASK_R2;
+    if (controller_report.BTN_GamePadButton20 == 1) device.state.buttons |= GAMEPAD_MASK_L2;
+
+    if (controller_report.GD_GamePadHatSwitch == 0) device.state.dpad |= GAMEPAD_MASK_UP;
+    if (controller_report.GD_GamePadHatSwitch == 1) device.state.dpad |= GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT;
+    if (controller_report.GD_GamePadHatSwitch == 2) device.state.dpad |= GAMEPAD_MASK_RIGHT;
+    if (controller_report.GD_GamePadHatSwitch == 3) device.state.dpad |= GAMEPAD_MASK_RIGHT | GAMEPAD_MASK_DOWN;
+    if (controller_report.GD_GamePadHatSwitch == 4) device.state.dpad |= GAMEPAD_MASK_DOWN;
+    if (controller_report.GD_GamePadHatSwitch == 5) device.state.dpad |= GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT;
+    if (controller_report.GD_GamePadHatSwitch == 6) device.state.dpad |= GAMEPAD_MASK_LEFT;
+    if (controller_report.GD_GamePadHatSwitch == 7) device.state.dpad |= GAMEPAD_MASK_LEFT | GAMEPAD_MASK_UP;
 }
 
-void GamepadUSBHostListener::setup_df_wheel() {
+void GamepadUSBHostListener::setup_df_wheel(GamepadHostDevice& device) {
     // send commands to see if can be reset to Driving Force GT mode for more compatibility
     uint8_t command[8] = {0xF8, 0x09, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00};
     uint16_t commandSize = sizeof(command);
 
-    if (tuh_hid_send_report(_controller_dev_addr, _controller_instance, 0, command, commandSize)) {
-        isDFInit = true;
+    if (tuh_hid_send_report(device.dev_addr, device.instance, 0, command, commandSize)) {
+        device.isDFInit = true;
     }
 }
 
-void GamepadUSBHostListener::process_dfgt(uint8_t const* report, uint16_t len) {
+void GamepadUSBHostListener::process_dfgt(GamepadHostDevice& device, uint8_t const* report, uint16_t len) {
     PS3ReportAlt ps3Report;
     memcpy(&ps3Report, report, len);
 #if GAMEPAD_HOST_DEBUG
@@ -452,21 +505,21 @@ void GamepadUSBHostListener::process_dfgt(uint8_t const* report, uint16_t len) {
 #endif
 }
 
-void GamepadUSBHostListener::process_ultrastik360(uint8_t const* report, uint16_t len) {
+void GamepadUSBHostListener::process_ultrastik360(GamepadHostDevice& device, uint8_t const* report, uint16_t len) {
 
     ultrastik360_t controller_report;
 
     memcpy(&controller_report, report, sizeof(controller_report));
 
-    _controller_host_state.lx = map(controller_report.GD_GamePadPointerX, 0, 255, GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-    _controller_host_state.ly = map(controller_report.GD_GamePadPointerY, 0, 255, GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-
-    if (controller_report.BTN_GamePadButton1 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_B1;
-    if (controller_report.BTN_GamePadButton2 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_B2;
-    if (controller_report.BTN_GamePadButton3 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_B3;
-    if (controller_report.BTN_GamePadButton4 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_B4;
-    if (controller_report.BTN_GamePadButton5 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_L1;
-    if (controller_report.BTN_GamePadButton6 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_L2;
-    if (controller_report.BTN_GamePadButton7 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_R1;
-    if (controller_report.BTN_GamePadButton8 == 1) _controller_host_state.buttons |= GAMEPAD_MASK_R2;
+    device.state.lx = map(controller_report.GD_GamePadPointerX, 0, 255, GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+    device.state.ly = map(controller_report.GD_GamePadPointerY, 0, 255, GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+
+    if (controller_report.BTN_GamePadButton1 == 1) device.state.buttons |= GAMEPAD_MASK_B1;
+    if (controller_report.BTN_GamePadButton2 == 1) device.state.buttons |= GAMEPAD_MASK_B2;
+    if (controller_report.BTN_GamePadButton3 == 1) device.state.buttons |= GAMEPAD_MASK_B3;
+    if (controller_report.BTN_GamePadButton4 == 1) device.state.buttons |= GAMEPAD_MASK_B4;
+    if (controller_report.BTN_GamePadButton5 == 1) device.state.buttons |= GAMEPAD_MASK_L1;
+    if (controller_report.BTN_GamePadButton6 == 1) device.state.buttons |= GAMEPAD_MASK_L2;
+    if (controller_report.BTN_GamePadButton7 == 1) device.state.buttons |= GAMEPAD_MASK_R1;
+    if (controller_report.BTN_GamePadButton8 == 1) device.state.buttons |= GAMEPAD_MASK_R2;
 }
@@ -157,13 +157,13 @@ void HETriggerAddon::preprocess() {
                 case GpioAction::ANALOG_DIRECTION_RS_Y_NEG:	gamepad->state.ry = GAMEPAD_JOYSTICK_MIN; break;
                 case GpioAction::ANALOG_DIRECTION_RS_Y_POS:	gamepad->state.ry = GAMEPAD_JOYSTICK_MAX; break;
                 case GpioAction::BUTTON_PRESS_FN:	gamepad->state.aux |= AUX_MASK_FUNCTION; break;
-                case GpioAction::MENU_NAVIGATION_UP: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_UP)); break;
-                case GpioAction::MENU_NAVIGATION_DOWN: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_DOWN)); break;
-                case GpioAction::MENU_NAVIGATION_LEFT: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_LEFT)); break;
-                case GpioAction::MENU_NAVIGATION_RIGHT: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_RIGHT)); break;
-                case GpioAction::MENU_NAVIGATION_SELECT: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_SELECT)); break;
-                case GpioAction::MENU_NAVIGATION_BACK: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_BACK)); break;
-                case GpioAction::MENU_NAVIGATION_TOGGLE: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_TOGGLE)); break;
+                case GpioAction::MENU_NAVIGATION_UP: EventManager::getInstance().postEvent<GPMenuNavigateEvent>(GpioAction::MENU_NAVIGATION_UP); break;
+                case GpioAction::MENU_NAVIGATION_DOWN: EventManager::getInstance().postEvent<GPMenuNavigateEvent>(GpioAction::MENU_NAVIGATION_DOWN); break;
+                case GpioAction::MENU_NAVIGATION_LEFT: EventManager::getInstance().postEvent<GPMenuNavigateEvent>(GpioAction::MENU_NAVIGATION_LEFT); break;
+                case GpioAction::MENU_NAVIGATION_RIGHT: EventManager::getInstance().postEvent<GPMenuNavigateEvent>(GpioAction::MENU_NAVIGATION_RIGHT); break;
+                case GpioAction::MENU_NAVIGATION_SELECT: EventManager::getInstance().postEvent<GPMenuNavigateEvent>(GpioAction::MENU_NAVIGATION_SELECT); break;
+                case GpioAction::MENU_NAVIGATION_BACK: EventManager::getInstance().postEvent<GPMenuNavigateEvent>(GpioAction::MENU_NAVIGATION_BACK); break;
+                case GpioAction::MENU_NAVIGATION_TOGGLE: EventManager::getInstance().postEvent<GPMenuNavigateEvent>(GpioAction::MENU_NAVIGATION_TOGGLE); break;
                 default: break;
             }
         }
@@ -64,9 +64,10 @@ void KeyboardHostListener::setup() {
   joystickMid = DriverManager::getInstance().getDriver() != nullptr ?
       DriverManager::getInstance().getDriver()->GetJoystickMidValue() : GAMEPAD_JOYSTICK_MID;
 
-  _keyboard_host_mounted = false;
-  _keyboard_dev_addr = DEV_ADDR_NONE;
-  _keyboard_instance = 0;
+  for (uint8_t i = 0; i < KEYBOARD_HOST_MAX_KEYBOARDS; i++) {
+    _keyboards[i] = { .mounted = false, .dev_addr = DEV_ADDR_NONE, .instance = 0, .dpad = 0, .buttons = 0 };
+  }
+  _keyboards_mounted = 0;
 
   _mouse_host_mounted = false;
   _mouse_dev_addr = DEV_ADDR_NONE;
@@ -80,7 +81,14 @@ void KeyboardHostListener::setup() {
 
 void KeyboardHostListener::process() {
   Gamepad *gamepad = Storage::getInstance().GetGamepad();
-  if (_keyboard_host_mounted == true || _mouse_host_mounted == true) {
+  if (_keyboards_mounted > 0 || _mouse_host_mounted == true) {
+    // Every keyboard and the mouse add their held inputs, the mouse alone drives the sticks
+    for (uint8_t i = 0; i < KEYBOARD_HOST_MAX_KEYBOARDS; i++) {
+      if (_keyboards[i].mounted) {
+        gamepad->state.dpad     |= _keyboards[i].dpad;
+        gamepad->state.buttons  |= _keyboards[i].buttons;
+      }
+    }
     gamepad->state.dpad     |= _keyboard_host_state.dpad;
     gamepad->state.buttons  |= _keyboard_host_state.buttons;
     gamepad->state.lx       = _keyboard_host_state.lx;
@@ -112,30 +120,38 @@ void KeyboardHostListener::process() {
   }
 }
 
-void KeyboardHostListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
+bool KeyboardHostListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
     // Interface protocol (hid_interface_protocol_enum_t)
     uint8_t const itf_protocol = tuh_hid_interface_protocol(dev_addr, instance);
 
     // tuh_hid_report_received_cb() will be invoked when report is available
-    if (_keyboard_host_mounted == false && itf_protocol == HID_ITF_PROTOCOL_KEYBOARD) {
-        _keyboard_host_mounted = true;
-        _keyboard_dev_addr = dev_addr;
-        _keyboard_instance = instance;
+    if (itf_protocol == HID_ITF_PROTOCOL_KEYBOARD) {
+        for (uint8_t i = 0; i < KEYBOARD_HOST_MAX_KEYBOARDS; i++) {
+            if (_keyboards[i].mounted == false) {
+                _keyboards[i] = { .mounted = true, .dev_addr = dev_addr, .instance = instance, .dpad = 0, .buttons = 0 };
+                _keyboards_mounted++;
+                return true;
+            }
+        }
     } else if (_mouse_host_mounted == false && itf_protocol == HID_ITF_PROTOCOL_MOUSE) {
         Gamepad *gamepad = Storage::getInstance().GetGamepad();
         gamepad->auxState.sensors.mouse.enabled = true;
         _mouse_host_mounted = true;
         _mouse_dev_addr = dev_addr;
         _mouse_instance = instance;
+        return true;
     }
+    return false;
 }
 
 void KeyboardHostListener::unmount(uint8_t dev_addr) {
-    if ( _keyboard_host_mounted == true && _keyboard_dev_addr == dev_addr ) {
-        _keyboard_host_mounted = false;
-        _keyboard_dev_addr = DEV_ADDR_NONE;
-        _keyboard_instance = 0;
-    } else if ( _mouse_host_mounted == true && _mouse_dev_addr == dev_addr ) {
+    for (uint8_t i = 0; i < KEYBOARD_HOST_MAX_KEYBOARDS; i++) {
+        if (_keyboards[i].mounted == true && _keyboards[i].dev_addr == dev_addr) {
+            _keyboards[i] = { .mounted = false, .dev_addr = DEV_ADDR_NONE, .instance = 0, .dpad = 0, .buttons = 0 };
+            _keyboards_mounted--;
+        }
+    }
+    if ( _mouse_host_mounted == true && _mouse_dev_addr == dev_addr ) {
         Gamepad *gamepad = Storage::getInstance().GetGamepad();
         gamepad->auxState.sensors.mouse.enabled = false;
         _mouse_host_mounted = false;
@@ -145,15 +161,17 @@ void KeyboardHostListener::unmount(uint8_t dev_addr) {
 }
 
 void KeyboardHostListener::report_received(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len){
-  // do nothing if we haven't mounted
-if ( _keyboard_host_mounted == false && _mouse_host_mounted == false )
+  // only the interfaces this listener claimed are routed here
+  if ( _mouse_host_mounted == true && _mouse_dev_addr == dev_addr && _mouse_instance == instance) {
+    process_mouse_report(dev_addr, (hid_mouse_report_t const*) report );
     return;
+  }
 
-  // tuh_hid_report_received_cb() will be invoked when report is available
-  if ( _keyboard_host_mounted == true && _keyboard_dev_addr == dev_addr && _keyboard_instance == instance ) {
-    process_kbd_report(dev_addr, (hid_keyboard_report_t const*) report );
-  } else if ( _mouse_host_mounted == true && _mouse_dev_addr == dev_addr && _mouse_instance == instance) {
-    process_mouse_report(dev_addr, (hid_mouse_report_t const*) report );
+  for (uint8_t i = 0; i < KEYBOARD_HOST_MAX_KEYBOARDS; i++) {
+    if ( _keyboards[i].mounted == true && _keyboards[i].dev_addr == dev_addr && _keyboards[i].instance == instance ) {
+      process_kbd_report(_keyboards[i], (hid_keyboard_report_t const*) report );
+      return;
+    }
   }
 }
 
@@ -186,9 +204,10 @@ void KeyboardHostListener::preprocess_report()
 }
 
 // convert hid keycode to ascii and print via usb device CDC (ignore non-printable)
-void KeyboardHostListener::process_kbd_report(uint8_t dev_addr, hid_keyboard_report_t const *report)
+void KeyboardHostListener::process_kbd_report(KeyboardHostDevice& keyboard, hid_keyboard_report_t const *report)
 {
-  preprocess_report();
+  keyboard.dpad = 0;
+  keyboard.buttons = 0;
 
   // make this 13 instead of 7 to include modifier bitfields from hid_keyboard_modifier_bm_t
   for(uint8_t i=0; i<13; i++)
@@ -205,30 +224,30 @@ void KeyboardHostListener::process_kbd_report(uint8_t dev_addr, hid_keyboard_rep
     }
     if ( keycode )
     {
-      _keyboard_host_state.dpad |=
-            ((keycode == _keyboard_host_mapDpadUp.key)    ? _keyboard_host_mapDpadUp.buttonMask : _keyboard_host_state.dpad)
-          | ((keycode == _keyboard_host_mapDpadDown.key)  ? _keyboard_host_mapDpadDown.buttonMask : _keyboard_host_state.dpad)
-          | ((keycode == _keyboard_host_mapDpadLeft.key)  ? _keyboard_host_mapDpadLeft.buttonMask  : _keyboard_host_state.dpad)
-          | ((keycode == _keyboard_host_mapDpadRight.key) ? _keyboard_host_mapDpadRight.buttonMask : _keyboard_host_state.dpad)
+      keyboard.dpad |=
+            ((keycode == _keyboard_host_mapDpadUp.key)    ? _keyboard_host_mapDpadUp.buttonMask : keyboard.dpad)
+          | ((keycode == _keyboard_host_mapDpadDown.key)  ? _keyboard_host_mapDpadDown.buttonMask : keyboard.dpad)
+          | ((keycode == _keyboard_host_mapDpadLeft.key)  ? _keyboard_host_mapDpadLeft.buttonMask  : keyboard.dpad)
+          | ((keycode == _keyboard_host_mapDpadRight.key) ? _keyboard_host_mapDpadRight.buttonMask : keyboard.dpad)
         ;
 
-        _keyboard_host_state.buttons |=
-            ((keycode == _keyboard_host_mapButtonB1.key)  ? _keyboard_host_mapButtonB1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonB2.key)  ? _keyboard_host_mapButtonB2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonB3.key)  ? _keyboard_host_mapButtonB3.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonB4.key)  ? _keyboard_host_mapButtonB4.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonL1.key)  ? _keyboard_host_mapButtonL1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonR1.key)  ? _keyboard_host_mapButtonR1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonL2.key)  ? _keyboard_host_mapButtonL2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonR2.key)  ? _keyboard_host_mapButtonR2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonS1.key)  ? _keyboard_host_mapButtonS1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonS2.key)  ? _keyboard_host_mapButtonS2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonL3.key)  ? _keyboard_host_mapButtonL3.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonR3.key)  ? _keyboard_host_mapButtonR3.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonA1.key)  ? _keyboard_host_mapButtonA1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonA2.key)  ? _keyboard_host_mapButtonA2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonA3.key)  ? _keyboard_host_mapButtonA3.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonA4.key)  ? _keyboard_host_mapButtonA4.buttonMask  : _keyboard_host_state.buttons)
+        keyboard.buttons |=
+            ((keycode == _keyboard_host_mapButtonB1.key)  ? _keyboard_host_mapButtonB1.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonB2.key)  ? _keyboard_host_mapButtonB2.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonB3.key)  ? _keyboard_host_mapButtonB3.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonB4.key)  ? _keyboard_host_mapButtonB4.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonL1.key)  ? _keyboard_host_mapButtonL1.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonR1.key)  ? _keyboard_host_mapButtonR1.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonL2.key)  ? _keyboard_host_mapButtonL2.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonR2.key)  ? _keyboard_host_mapButtonR2.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonS1.key)  ? _keyboard_host_mapButtonS1.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonS2.key)  ? _keyboard_host_mapButtonS2.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonL3.key)  ? _keyboard_host_mapButtonL3.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonR3.key)  ? _keyboard_host_mapButtonR3.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonA1.key)  ? _keyboard_host_mapButtonA1.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonA2.key)  ? _keyboard_host_mapButtonA2.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonA3.key)  ? _keyboard_host_mapButtonA3.buttonMask  : keyboard.buttons)
+          | ((keycode == _keyboard_host_mapButtonA4.key)  ? _keyboard_host_mapButtonA4.buttonMask  : keyboard.buttons)
         ;
     }
   }
@@ -1124,7 +1124,7 @@ void NeoPicoLEDAddon::ambientHotkeys(Gamepad *gamepad)
 	}
 
 	if (reqSave) {
-		EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(false));
+		EventManager::getInstance().postEvent<GPStorageSaveEvent>(false);
 	}
 
 	lastAmbientAction = action;
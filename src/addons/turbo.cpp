@@ -246,7 +246,7 @@ void TurboInput::updateTurboShotCount(uint8_t shotCount, bool save) {
   lastShotCount = shotCount;
 
   if (save) {
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(false));
+    EventManager::getInstance().postEvent<GPStorageSaveEvent>(false);
   }
 
   uIntervalUS = (uint32_t)std::floor(1000000.0 / (shotCount * 2));
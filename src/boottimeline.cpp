@@ -0,0 +1,77 @@
+#include "boottimeline.h"
+
+#include <new>
+
+#include "pico/platform.h"
+
+#define BOOT_TIMELINE_MAGIC 0x544f4f42
+
+struct BootTimelineRecord {
+	uint32_t magic;
+	uint32_t stages[BOOT_STAGE_COUNT];
+};
+
+// Raw storage so static initialization does not clear what the last boot recorded
+static uint8_t __uninitialized_ram(bootTimelineStorage)[sizeof(BootTimelineRecord)] __attribute__((aligned(8)));
+
+static inline BootTimelineRecord* getRecord() {
+	return reinterpret_cast<BootTimelineRecord*>(bootTimelineStorage);
+}
+
+static const char* const stageNames[BOOT_STAGE_COUNT] = {
+	"storage",
+	"peripherals",
+	"gamepad",
+	"addons",
+	"bootAction",
+	"driver",
+	"core1Ready",
+	"usbInit",
+	"usbMounted",
+	"firstReport",
+	"core1Addons",
+};
+
+/**
+ * @brief Record the time a stage was reached, later calls for the same stage are ignored.
+ *
+ * Core1 only marks its own stage, every stage is a single word so the cores never share a write.
+ */
+void BootTimeline::mark(BootStage stage) {
+	if (stage >= BOOT_STAGE_COUNT || stages[stage] != 0)
+		return;
+
+	stages[stage] = time_us_32();
+	if (keepEnabled)
+		getRecord()->stages[stage] = stages[stage];
+}
+
+void BootTimeline::store() {
+	BootTimelineRecord* record = new (bootTimelineStorage) BootTimelineRecord();
+	for (uint8_t stage = 0; stage < BOOT_STAGE_COUNT; stage++)
+		record->stages[stage] = stages[stage];
+	record->magic = BOOT_TIMELINE_MAGIC ^ sizeof(BootTimelineRecord);
+}
+
+/**
+ * @brief Start (or stop) mirroring this boot into the kept timeline.
+ *
+ * Only gamepad mode boots are kept, so web config can still show the boot that led to it.
+ */
+void BootTimeline::keep(bool enabled) {
+	if (enabled && !keepEnabled)
+		store();
+	keepEnabled = enabled;
+}
+
+bool BootTimeline::hasKept() const {
+	return getRecord()->magic == (BOOT_TIMELINE_MAGIC ^ sizeof(BootTimelineRecord));
+}
+
+uint32_t BootTimeline::getKept(BootStage stage) const {
+	return (hasKept() && stage < BOOT_STAGE_COUNT) ? getRecord()->stages[stage] : 0;
+}
+
+const char* BootTimeline::getStageName(BootStage stage) {
+	return (stage < BOOT_STAGE_COUNT) ? stageNames[stage] : "";
+}
@@ -43,6 +43,7 @@
 
 #include <ArduinoJson.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <memory>
@@ -126,6 +127,14 @@
     #define DEFAULT_DEBOUNCE_DELAY 5
 #endif
 
+#ifndef DEFAULT_DEBOUNCE_MODE
+    #define DEFAULT_DEBOUNCE_MODE DEBOUNCE_MODE_EAGER
+#endif
+
+#ifndef DEFAULT_FAST_BOOT
+    #define DEFAULT_FAST_BOOT false
+#endif
+
 #ifndef DEFAULT_PS4_REPORTHACK
     #define DEFAULT_PS4_REPORTHACK false
 #endif
@@ -300,6 +309,8 @@ void ConfigUtils::initUnsetPropertiesWithDefaults(Config& config)
     INIT_UNSET_PROPERTY(config.gamepadOptions, profileNumber, 1);
     INIT_UNSET_PROPERTY(config.gamepadOptions, ps4ControllerType, DEFAULT_PS4CONTROLLER_TYPE);
     INIT_UNSET_PROPERTY(config.gamepadOptions, debounceDelay, DEFAULT_DEBOUNCE_DELAY);
+    INIT_UNSET_PROPERTY(config.gamepadOptions, debounceMode, DEFAULT_DEBOUNCE_MODE);
+    INIT_UNSET_PROPERTY(config.gamepadOptions, fastBoot, DEFAULT_FAST_BOOT);
     INIT_UNSET_PROPERTY(config.gamepadOptions, inputModeB1, DEFAULT_INPUT_MODE_B1);
     INIT_UNSET_PROPERTY(config.gamepadOptions, inputModeB2, DEFAULT_INPUT_MODE_B2);
     INIT_UNSET_PROPERTY(config.gamepadOptions, inputModeB3, DEFAULT_INPUT_MODE_B3);
@@ -1756,9 +1767,10 @@ void hotkeysMigration(Config& config)
 // Loading / Saving
 // -----------------------------------------------------
 
-// We put a ConfigFooter struct at the end of the flash area reserved for FlashPROM. It contains a magicvalue, the size
-// of the serialized config data and a CRC of that data. This information allows us to both locate and verify the stored
-// data. The serialized data is located directly before the footer:
+// The serialized config is saved as a record of the FlashPROM journal, which locates and verifies the newest record
+// itself. Before the journal, we put a ConfigFooter struct at the end of the flash area reserved for FlashPROM. It
+// contains a magicvalue, the size of the serialized config data and a CRC of that data. This information allows us to
+// both locate and verify the stored data. The serialized data is located directly before the footer:
 //
 //                       FlashPROM block
 // ┌────────────────────────────┴─────────────────────────────┐
@@ -1771,30 +1783,22 @@ struct ConfigFooter
     uint32_t dataSize;
     uint32_t dataCrc;
     uint32_t magic;
-
-    bool operator==(const ConfigFooter& other) const
-    {
-        return
-            dataSize == other.dataSize &&
-            dataCrc == other.dataCrc &&
-            magic == other.magic;
-    }
 };
 
 static const uint32_t FOOTER_MAGIC = 0xd2f1e365;
 
-// Verify that the maximum size of the serialized Config object fits into the allocated flash block
+// Verify that the maximum size of the serialized Config object fits into a journal record that a power loss cannot
+// take down with it, a third of the allocated flash block
 #if defined(Config_size)
-    static_assert(Config_size + sizeof(ConfigFooter) <= EEPROM_SIZE_BYTES, "Maximum size of Config exceeds the maximum size allocated for FlashPROM");
+    static_assert(Config_size <= EEPROM_MAX_DATA_BYTES, "Maximum size of Config exceeds a third of the flash allocated for FlashPROM");
 #else
     #error "Maximum size of Config cannot be determined statically, make sure that you do not use any dynamically sized arrays or strings"
 #endif
 
-static bool loadConfigInner(Config& config)
+// Config saved by firmware that predates the FlashPROM journal
+static bool loadFooterConfig(Config& config)
 {
-    config = Config Config_init_zero;
-
-    const uint8_t* flashEnd = reinterpret_cast<const uint8_t*>(EEPROM_ADDRESS_START) + EEPROM_SIZE_BYTES;
+    const uint8_t* flashEnd = reinterpret_cast<const uint8_t*>(EEPROM_LEGACY_ADDRESS_START) + EEPROM_LEGACY_SIZE_BYTES;
     const ConfigFooter& footer = *reinterpret_cast<const ConfigFooter*>(flashEnd - sizeof(ConfigFooter));
 
     // Check for presence of magic value
@@ -1804,7 +1808,7 @@ static bool loadConfigInner(Config& config)
     }
 
         // Check if dataSize exceeds the reserved space
-    if (footer.dataSize + sizeof(ConfigFooter) > EEPROM_SIZE_BYTES)
+    if (footer.dataSize + sizeof(ConfigFooter) > EEPROM_LEGACY_SIZE_BYTES)
     {
         return false;
     }
@@ -1822,8 +1826,164 @@ static bool loadConfigInner(Config& config)
     return pb_decode(&inputStream, Config_fields, &config);
 }
 
-void ConfigUtils::load(Config& config)
+// Bump whenever a migration is added to ConfigUtils::load. Configs stamped with an older version go through all
+// migrations again on their next boot.
+#define CONFIG_MIGRATION_VERSION 1
+
+// Top level fields that are not needed for the first input loop. They are decoded by ConfigUtils::loadDeferred, on
+// first access through Storage.
+static bool isDeferredField(uint32_t tag)
 {
+    return tag == Config_displayOptions_tag ||
+        tag == Config_ledOptions_tag ||
+        tag == Config_animationOptions_tag;
+}
+
+#define CONFIG_MAX_FIELD_SPANS 16
+
+// Byte ranges of a serialized Config that hold a subset of its top level fields, read as one stream
+struct ConfigFieldSpans
+{
+    const uint8_t* data;
+    uint32_t start[CONFIG_MAX_FIELD_SPANS];
+    uint32_t end[CONFIG_MAX_FIELD_SPANS];
+    uint8_t count;
+    uint8_t index;
+    uint32_t position;
+    uint32_t size;
+};
+
+static bool findConfigFields(const uint8_t* data, uint32_t size, bool deferred, ConfigFieldSpans& spans)
+{
+    spans = {};
+    spans.data = data;
+
+    pb_istream_t stream = pb_istream_from_buffer(data, size);
+    while (stream.bytes_left > 0)
+    {
+        const uint32_t start = size - stream.bytes_left;
+        pb_wire_type_t wireType;
+        uint32_t tag;
+        bool eof;
+        if (!pb_decode_tag(&stream, &wireType, &tag, &eof))
+        {
+            return eof;
+        }
+        if (!pb_skip_field(&stream, wireType))
+        {
+            return false;
+        }
+        const uint32_t end = size - stream.bytes_left;
+
+        if (isDeferredField(tag) != deferred)
+        {
+            continue;
+        }
+
+        if (spans.count > 0 && spans.end[spans.count - 1] == start)
+        {
+            spans.end[spans.count - 1] = end;
+        }
+        else if (spans.count < CONFIG_MAX_FIELD_SPANS)
+        {
+            spans.start[spans.count] = start;
+            spans.end[spans.count] = end;
+            spans.count++;
+        }
+        else
+        {
+            return false;
+        }
+        spans.size += end - start;
+    }
+    return true;
+}
+
+static bool readConfigFieldSpans(pb_istream_t* stream, pb_byte_t* buf, size_t count)
+{
+    ConfigFieldSpans& spans = *reinterpret_cast<ConfigFieldSpans*>(stream->state);
+    while (count > 0)
+    {
+        if (spans.index >= spans.count)
+        {
+            return false;
+        }
+
+        const uint32_t offset = spans.start[spans.index] + spans.position;
+        const uint32_t available = spans.end[spans.index] - offset;
+        const uint32_t length = (count < available) ? count : available;
+        memcpy(buf, spans.data + offset, length);
+        buf += length;
+        count -= length;
+        spans.position += length;
+
+        if (spans.position == spans.end[spans.index] - spans.start[spans.index])
+        {
+            spans.index++;
+            spans.position = 0;
+        }
+    }
+    return true;
+}
+
+static bool decodeConfigFields(const uint8_t* data, uint32_t size, bool deferred, Config& config)
+{
+    ConfigFieldSpans spans;
+    if (!findConfigFields(data, size, deferred, spans))
+    {
+        return false;
+    }
+
+    pb_istream_t stream = { &readConfigFieldSpans, &spans, spans.size };
+    return deferred ? pb_decode_noinit(&stream, Config_fields, &config) : pb_decode(&stream, Config_fields, &config);
+}
+
+// Fast boot path: only decodes the fields the first input loop needs. Only taken for configs that this firmware
+// version saved after running all migrations, anything else needs the full load.
+static bool loadBootConfig(Config& config)
+{
+    uint32_t dataSize = 0;
+    const uint8_t* dataPtr = EEPROM.getData(dataSize);
+    if (dataPtr == nullptr)
+    {
+        return false;
+    }
+
+    config = Config Config_init_zero;
+    if (!decodeConfigFields(dataPtr, dataSize, false, config))
+    {
+        return false;
+    }
+
+    return config.migrations.migrationVersion == CONFIG_MIGRATION_VERSION &&
+        strncmp(config.boardVersion, GP2040VERSION, sizeof(config.boardVersion)) == 0;
+}
+
+static bool loadConfigInner(Config& config)
+{
+    config = Config Config_init_zero;
+
+    // The journal has already verified the newest record
+    uint32_t dataSize = 0;
+    const uint8_t* dataPtr = EEPROM.getData(dataSize);
+    if (dataPtr == nullptr)
+    {
+        return loadFooterConfig(config);
+    }
+
+    pb_istream_t inputStream = pb_istream_from_buffer(dataPtr, dataSize);
+    return pb_decode(&inputStream, Config_fields, &config);
+}
+
+bool ConfigUtils::load(Config& config)
+{
+    if (loadBootConfig(config))
+    {
+        // Defaults for the decoded fields, the deferred ones get theirs again in loadDeferred()
+        initUnsetPropertiesWithDefaults(config);
+        return true;
+    }
+
     // First try to load from Protobuf storage, if that fails fall back to legacy storage.
     const bool loaded = loadConfigInner(config) | fromLegacyStorage(config);
 
@@ -1866,8 +2026,33 @@ void ConfigUtils::load(Config& config)
     config.boardVersion[sizeof(config.boardVersion) - 1] = '\0';
     config.has_boardVersion = true;
 
+    // All migrations ran, the next boot can take the fast path
+    config.migrations.migrationVersion = CONFIG_MIGRATION_VERSION;
+    config.migrations.has_migrationVersion = true;
+
     // Save, to make sure we persist any performed migration steps
     save(config);
+    return false;
+}
+
+void ConfigUtils::loadDeferred(Config& config)
+{
+    // Back to the state pb_decode would have left them in, then decode them from the same record
+    config.displayOptions = DisplayOptions DisplayOptions_init_default;
+    config.has_displayOptions = false;
+    config.ledOptions = LEDOptions LEDOptions_init_default;
+    config.has_ledOptions = false;
+    config.animationOptions = AnimationOptions AnimationOptions_init_default;
+    config.has_animationOptions = false;
+
+    uint32_t dataSize = 0;
+    const uint8_t* dataPtr = EEPROM.getData(dataSize);
+    if (dataPtr != nullptr)
+    {
+        decodeConfigFields(dataPtr, dataSize, true, config);
+    }
+
+    initUnsetPropertiesWithDefaults(config);
 }
 
 static void setHasFlags(const pb_msgdesc_t* fields, void* s)
@@ -1943,37 +2128,14 @@ bool ConfigUtils::save(Config& config)
     setHasFlags(Config_fields, &config);
 
     // Encode the data directly into the cache of FlashPROM
-    pb_ostream_t outputStream = pb_ostream_from_buffer(EEPROM.writeCache, EEPROM_SIZE_BYTES - sizeof(ConfigFooter));
+    pb_ostream_t outputStream = pb_ostream_from_buffer(EEPROM.writeCache, EEPROM_MAX_DATA_BYTES);
     if (!pb_encode(&outputStream, Config_fields, &config))
     {
         return false;
     }
 
-    // Create the new footer
-    ConfigFooter newFooter;
-    newFooter.dataSize = outputStream.bytes_written;
-    newFooter.dataCrc = CRC32::calculate(EEPROM.writeCache, newFooter.dataSize);
-    newFooter.magic = FOOTER_MAGIC;
-
-    // The data has changed when the footer content has changed. Only then do we acutally need to save.
-    const ConfigFooter& oldFooter = *reinterpret_cast<ConfigFooter*>(EEPROM.writeCache + EEPROM_SIZE_BYTES - sizeof(ConfigFooter));
-    if (newFooter == oldFooter)
-    {
-        // The data has not changed, no saving neccessary.
-        return true;
-    }
-
-    // Write the footer
-    ConfigFooter* cacheFooter = reinterpret_cast<ConfigFooter*>(EEPROM.writeCache + EEPROM_SIZE_BYTES - sizeof(ConfigFooter));
-    memcpy(cacheFooter, &newFooter, sizeof(ConfigFooter));
-
-    // Move the encoded data in memory down to the footer
-    memmove(EEPROM.writeCache + EEPROM_SIZE_BYTES - sizeof(ConfigFooter) - newFooter.dataSize, EEPROM.writeCache, newFooter.dataSize);
-    memset(EEPROM.writeCache, 0, EEPROM_SIZE_BYTES - sizeof(ConfigFooter) - newFooter.dataSize);
-
-    EEPROM.commit();
-
-    return true;
+    // Append a journal record. FlashPROM skips it when the data has not changed since the last save.
+    return EEPROM.commit(outputStream.bytes_written);
 }
 
 // -----------------------------------------------------
@@ -2497,3 +2659,123 @@ bool ConfigUtils::fromJSON(Config& config, const char* data, size_t dataLen)
 
     return true;
 }
+
+// -----------------------------------------------------
+// Patch
+// -----------------------------------------------------
+
+// Largest document a patch may take, patches only carry the fields they change
+#define CONFIG_PATCH_MAX_DOCUMENT_SIZE (1024 * 10)
+
+template <typename Section>
+static bool patchConfigSection(JsonVariantConst value, Section& section, bool& hasSection,
+                               bool (*fromJSONSection)(JsonObjectConst, Section&), bool apply)
+{
+    if (!value.is<JsonObjectConst>())
+    {
+        return false;
+    }
+
+    if (apply)
+    {
+        hasSection = true;
+        return fromJSONSection(value.as<JsonObjectConst>(), section);
+    }
+
+    // Dry run on a copy of this section only, so that a bad value cannot leave the config half patched
+    std::unique_ptr<Section> scratch(new Section(section));
+    return fromJSONSection(value.as<JsonObjectConst>(), *scratch.get());
+}
+
+// Only the sections of Config can be patched, the board identification strings are left alone
+#define PATCH_CONFIG_MESSAGE(fieldname, submessageType) \
+    if (strcmp(key, #fieldname) == 0) \
+    { \
+        return patchConfigSection(value, config.fieldname, config.PREPROCESSOR_JOIN(has_, fieldname), \
+            &PREPROCESSOR_JOIN(fromJSON, PREPROCESSOR_JOIN(submessageType, _MSGTYPE)), apply); \
+    }
+#define PATCH_CONFIG_STRING(fieldname, submessageType)
+
+#define PATCH_CONFIG_FIELD(parenttype, atype, htype, ltype, fieldname, tag, disallow_export) \
+    PREPROCESSOR_JOIN(PATCH_CONFIG_, ltype)(fieldname, parenttype ## _ ## fieldname)
+
+static bool patchConfigField(Config& config, const char* key, JsonVariantConst value, bool apply)
+{
+    Config_FIELDLIST(PATCH_CONFIG_FIELD, Config)
+    return false;
+}
+
+// Applies a sparse JSON object to the config in place: {"gamepadOptions": {"debounceDelay": 10}} only
+// sets gamepadOptions.debounceDelay. Repeated fields that appear in the patch are replaced as a whole.
+// Every section is checked before any is changed, so either the whole patch applies or nothing does.
+bool ConfigUtils::patchJSON(Config& config, const char* data, size_t dataLen)
+{
+    DynamicJsonDocument doc(std::min<size_t>(dataLen * 6 + 256, CONFIG_PATCH_MAX_DOCUMENT_SIZE));
+    if (deserializeJson(doc, data, dataLen) != DeserializationError::Ok || !doc.is<JsonObject>())
+    {
+        return false;
+    }
+
+    const JsonObjectConst patch = doc.as<JsonObjectConst>();
+    for (const bool apply : { false, true })
+    {
+        for (const JsonPairConst member : patch)
+        {
+            if (!patchConfigField(config, member.key().c_str(), member.value(), apply))
+            {
+                return false;
+            }
+        }
+    }
+
+    // Same as fromJSON, in case the patch changed pins or things derived from pins
+    gpioMappingsMigrationCore(config);
+    migrateTurboPinToGpio(config);
+    migrateAuthenticationMethods(config);
+    migrateMacroPinsToGpio(config);
+
+    return true;
+}
+
+// -----------------------------------------------------
+// Binary
+// -----------------------------------------------------
+
+std::string ConfigUtils::toBinary(Config& config)
+{
+    setHasFlags(Config_fields, &config);
+
+    size_t size = 0;
+    if (!pb_get_encoded_size(&size, Config_fields, &config))
+    {
+        return {};
+    }
+
+    std::string data(size, '\0');
+    pb_ostream_t outputStream = pb_ostream_from_buffer(reinterpret_cast<uint8_t*>(&data[0]), data.size());
+    if (!pb_encode(&outputStream, Config_fields, &config))
+    {
+        return {};
+    }
+
+    return data;
+}
+
+bool ConfigUtils::fromBinary(Config& config, const uint8_t* data, size_t dataLen)
+{
+    pb_istream_t inputStream = pb_istream_from_buffer(data, dataLen);
+    if (!pb_decode(&inputStream, Config_fields, &config))
+    {
+        return false;
+    }
+
+    initUnsetPropertiesWithDefaults(config);
+
+    // Same as fromJSON, the config may come from a board with other pins or an older firmware
+    gpioMappingsMigrationCore(config);
+    migrateTurboPinToGpio(config);
+    migrateAuthenticationMethods(config);
+    migrateMacroPinsToGpio(config);
+
+    return true;
+}
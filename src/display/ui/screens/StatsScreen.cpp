@@ -3,6 +3,9 @@
 #include "pico/stdlib.h"
 #include "version.h"
 #include "drivermanager.h"
+#include "loopprofiler.h"
+
+#include "hardware/clocks.h"
 
 void StatsScreen::init() {
     getRenderer()->clearScreen();
@@ -43,6 +46,13 @@ void StatsScreen::init() {
     arch->setPosition(0, 5); 
     addElement(arch);
 
+#if LOOP_PROFILER_ENABLED
+    loopTime = new GPLabel();
+    loopTime->setRenderer(getRenderer());
+    loopTime->setPosition(0, 6);
+    addElement(loopTime);
+#endif
+
     exit = new GPLabel();
     exit->setRenderer(getRenderer());
     exit->setText("B2 to Return");
@@ -58,6 +68,13 @@ void StatsScreen::drawScreen() {
 }
 
 int8_t StatsScreen::update() {
+#if LOOP_PROFILER_ENABLED
+    // Core0 loop time in microseconds, avg/p99
+    const LoopProfileStat& total = LoopProfiler::getInstance().getStage(LOOP_STAGE_TOTAL);
+    uint32_t cyclesPerUs = clock_get_hz(clk_sys) / 1000000;
+    loopTime->setText("Loop: " + std::to_string(total.average() / cyclesPerUs) + "/" + std::to_string(total.percentile(99) / cyclesPerUs) + "us");
+#endif
+
     if (DriverManager::getInstance().isConfigMode()) {
         uint16_t buttonState = getGamepad()->state.buttons;
         if (prevButtonState && !buttonState) {
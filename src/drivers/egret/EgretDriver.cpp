@@ -19,6 +19,8 @@ void EgretDriver::initialize() {
 		.xfer_cb = hidd_xfer_cb,
 		.sof = NULL
 	};
+
+	reportSender.init(ReportSender::transmitHID);
 }
 
 bool EgretDriver::process(Gamepad * gamepad) {
@@ -53,15 +55,7 @@ bool EgretDriver::process(Gamepad * gamepad) {
 
 	void * report = &egretReport;
 	uint16_t report_size = sizeof(egretReport);
-	if (memcmp(last_report, report, report_size) != 0)
-	{
-		// HID ready + report sent, copy previous report
-		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
-			memcpy(last_report, report, report_size);
-			return true;
-		}
-	}
-	return false;
+	return reportSender.send(report, report_size);
 }
 
 // tud_hid_get_report_cb
@@ -7,6 +7,46 @@
 #include "drivers/hid/HIDDescriptors.h"
 #include "drivers/shared/driverhelper.h"
 #include "storagemanager.h"
+#include "gamepad/GamepadReportPacker.h"
+
+// these first three buttons are in this unintuitive order to be compatible with
+// expectations, e.g. both PS3/4/5 modes and Switch modes map to HID as
+// B3 B4  ==  1 4
+// B1 B2  ==  2 3
+static constexpr GamepadReportBit hidButtonBits[] = {
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B1,    GAMEPAD_MASK_B2  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B2,    GAMEPAD_MASK_B3  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B3,    GAMEPAD_MASK_B1  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B4,    GAMEPAD_MASK_B4  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L1,    GAMEPAD_MASK_L1  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R1,    GAMEPAD_MASK_R1  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L2,    GAMEPAD_MASK_L2  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R2,    GAMEPAD_MASK_R2  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1,    GAMEPAD_MASK_S1  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2,    GAMEPAD_MASK_S2  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3,    GAMEPAD_MASK_L3  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3,    GAMEPAD_MASK_R3  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A1,    GAMEPAD_MASK_A1  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A2,    GAMEPAD_MASK_A2  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A3,    GAMEPAD_MASK_A3  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A4,    GAMEPAD_MASK_A4  },
+	{ GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_UP,    GAMEPAD_MASK_DU  },
+	{ GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_DOWN,  GAMEPAD_MASK_DD  },
+	{ GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_LEFT,  GAMEPAD_MASK_DL  },
+	{ GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_RIGHT, GAMEPAD_MASK_DR  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E1,    GAMEPAD_MASK_E1  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E2,    GAMEPAD_MASK_E2  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E3,    GAMEPAD_MASK_E3  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E4,    GAMEPAD_MASK_E4  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E5,    GAMEPAD_MASK_E5  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E6,    GAMEPAD_MASK_E6  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E7,    GAMEPAD_MASK_E7  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E8,    GAMEPAD_MASK_E8  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E9,    GAMEPAD_MASK_E9  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E10,   GAMEPAD_MASK_E10 },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E11,   GAMEPAD_MASK_E11 },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E12,   GAMEPAD_MASK_E12 },
+};
 
 static bool hid_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request)
 {
@@ -32,6 +72,8 @@ void HIDDriver::initialize() {
 		.xfer_cb = hidd_xfer_cb,
 		.sof = NULL
 	};
+
+	reportSender.init(ReportSender::transmitHID);
 }
 
 // Generate HID report from gamepad and send to TUSB Device
@@ -54,44 +96,7 @@ bool HIDDriver::process(Gamepad * gamepad) {
 	hidReport.r_x_axis = static_cast<uint8_t>(gamepad->state.rx >> 8);
 	hidReport.r_y_axis = static_cast<uint8_t>(gamepad->state.ry >> 8);
 
-	// these first three buttons are in this unintuitive order to be compatible with
-	// expectations, e.g. both PS3/4/5 modes and Switch modes map to HID as
-	// B3 B4  ==  1 4
-	// B1 B2  ==  2 3
-	hidReport.buttons = 0
-		| (gamepad->pressedB1()    ? GAMEPAD_MASK_B2     : 0)
-		| (gamepad->pressedB2()    ? GAMEPAD_MASK_B3     : 0)
-		| (gamepad->pressedB3()    ? GAMEPAD_MASK_B1     : 0)
-		| (gamepad->pressedB4()    ? GAMEPAD_MASK_B4     : 0)
-		| (gamepad->pressedL1()    ? GAMEPAD_MASK_L1     : 0)
-		| (gamepad->pressedR1()    ? GAMEPAD_MASK_R1     : 0)
-		| (gamepad->pressedL2()    ? GAMEPAD_MASK_L2     : 0)
-		| (gamepad->pressedR2()    ? GAMEPAD_MASK_R2     : 0)
-		| (gamepad->pressedS1()    ? GAMEPAD_MASK_S1     : 0)
-		| (gamepad->pressedS2()    ? GAMEPAD_MASK_S2     : 0)
-		| (gamepad->pressedL3()    ? GAMEPAD_MASK_L3     : 0)
-		| (gamepad->pressedR3()    ? GAMEPAD_MASK_R3     : 0)
-		| (gamepad->pressedA1()    ? GAMEPAD_MASK_A1     : 0)
-		| (gamepad->pressedA2()    ? GAMEPAD_MASK_A2     : 0)
-		| (gamepad->pressedA3()    ? GAMEPAD_MASK_A3     : 0)
-		| (gamepad->pressedA4()    ? GAMEPAD_MASK_A4     : 0)
-		| (gamepad->pressedUp()    ? GAMEPAD_MASK_DU     : 0)
-		| (gamepad->pressedDown()  ? GAMEPAD_MASK_DD     : 0)
-		| (gamepad->pressedLeft()  ? GAMEPAD_MASK_DL     : 0)
-		| (gamepad->pressedRight() ? GAMEPAD_MASK_DR     : 0)
-		| (gamepad->pressedE1()    ? GAMEPAD_MASK_E1     : 0)
-		| (gamepad->pressedE2()    ? GAMEPAD_MASK_E2     : 0)
-		| (gamepad->pressedE3()    ? GAMEPAD_MASK_E3     : 0)
-		| (gamepad->pressedE4()    ? GAMEPAD_MASK_E4     : 0)
-		| (gamepad->pressedE5()    ? GAMEPAD_MASK_E5     : 0)
-		| (gamepad->pressedE6()    ? GAMEPAD_MASK_E6     : 0)
-		| (gamepad->pressedE7()    ? GAMEPAD_MASK_E7     : 0)
-		| (gamepad->pressedE8()    ? GAMEPAD_MASK_E8     : 0)
-		| (gamepad->pressedE9()    ? GAMEPAD_MASK_E9     : 0)
-		| (gamepad->pressedE10()   ? GAMEPAD_MASK_E10    : 0)
-		| (gamepad->pressedE11()   ? GAMEPAD_MASK_E11    : 0)
-		| (gamepad->pressedE12()   ? GAMEPAD_MASK_E12    : 0)
-	;
+	hidReport.buttons = GamepadReportPacker<hidButtonBits>::pack(gamepad->state);
 
 	// Wake up TinyUSB device
 	if (tud_suspended())
@@ -99,16 +104,7 @@ bool HIDDriver::process(Gamepad * gamepad) {
 
 	void * report = &hidReport;
 	uint16_t report_size = sizeof(hidReport);
-	if (memcmp(last_report, report, report_size) != 0)
-	{
-		// HID ready + report sent, copy previous report
-		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
-			memcpy(last_report, report, report_size);
-			return true;
-		}
-	}
-	
-	return false;
+	return reportSender.send(report, report_size);
 }
 
 // tud_hid_get_report_cb
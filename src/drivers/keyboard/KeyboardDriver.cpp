@@ -23,6 +23,19 @@ void KeyboardDriver::initialize() {
 		.sof = NULL
 	};
 
+	reportSender.init([this](const uint8_t * report, uint16_t size) {
+		if (!tud_hid_ready() || !tud_hid_report(report[0], &report[1], size - 1))
+			return false;
+
+        // Adjust volume on success
+        if( volumeChange > 0 ) {
+            volumeChange--;
+        } else if ( volumeChange < 0 ) {
+            volumeChange++;
+        }
+		return true;
+	});
+
     // Handle Volume for Rotary Encoder
     EventManager::getInstance().registerEventHandler(GP_EVENT_ENCODER_CHANGE, GPEVENT_CALLBACK(this->handleEncoder(event)));
     volumeChange = 0; // no change
@@ -114,26 +127,12 @@ bool KeyboardDriver::process(Gamepad * gamepad) {
 		keyboard_report_size = sizeof(KeyboardReport::multimedia);
 	}
 
-	// If we had a keycode but now have a multimedia key OR report is different
-	if (keyboard_report_size != last_report_size || 
-			memcmp(last_report, &keyboardReport, last_report_size) != 0) {
-		if (tud_hid_ready()) {
-			if ( tud_hid_report(keyboardReport.reportId, keyboard_report_payload, keyboard_report_size) ) {
-				memcpy(last_report, keyboard_report_payload, keyboard_report_size);
-				last_report_size = keyboard_report_size;
-
-                // Adjust volume on success
-                if( volumeChange > 0 ) {
-                    volumeChange--;
-                } else if ( volumeChange < 0 ) {
-                    volumeChange++;
-                }
-				return true;
-			}
-		}
-	}
-	
-	return false;
+	// Stage as [report ID | payload] so a switch between keycode and multimedia reports is a change too
+	uint8_t staged[sizeof(KeyboardReport::keycode) + 1];
+	staged[0] = keyboardReport.reportId;
+	memcpy(&staged[1], keyboard_report_payload, keyboard_report_size);
+
+	return reportSender.send(staged, keyboard_report_size + 1);
 }
 
 void KeyboardDriver::pressKey(uint8_t code) {
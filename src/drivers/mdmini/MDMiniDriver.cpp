@@ -23,6 +23,8 @@ void MDMiniDriver::initialize() {
 		.xfer_cb = hidd_xfer_cb,
 		.sof = NULL
 	};
+
+	reportSender.init(ReportSender::transmitHID);
 }
 
 bool MDMiniDriver::process(Gamepad * gamepad) {
@@ -51,16 +53,7 @@ bool MDMiniDriver::process(Gamepad * gamepad) {
 
 	void * report = &mdminiReport;
 	uint16_t report_size = sizeof(mdminiReport);
-	if (memcmp(last_report, report, report_size) != 0)
-	{
-		// HID ready + report sent, copy previous report
-		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
-			memcpy(last_report, report, report_size);
-			return true;
-		}
-	}
-
-	return false;
+	return reportSender.send(report, report_size);
 }
 
 // tud_hid_get_report_cb
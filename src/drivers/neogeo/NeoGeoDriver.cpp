@@ -36,6 +36,8 @@ void NeoGeoDriver::initialize() {
 		.xfer_cb = hidd_xfer_cb,
 		.sof = NULL
 	};
+
+	reportSender.init(ReportSender::transmitHID);
 }
 
 bool NeoGeoDriver::process(Gamepad * gamepad) {
@@ -72,16 +74,7 @@ bool NeoGeoDriver::process(Gamepad * gamepad) {
 
 	void * report = &neogeoReport;
 	uint16_t report_size = sizeof(neogeoReport);
-	if (memcmp(last_report, report, report_size) != 0)
-	{
-		// HID ready + report sent, copy previous report
-		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
-			memcpy(last_report, report, report_size);
-			return true;
-		}
-	}
-
-	return false;
+	return reportSender.send(report, report_size);
 }
 
 // tud_hid_get_report_cb
@@ -81,11 +81,11 @@ bool P5GeneralAuthUSBListener::host_set_report(uint8_t report_id, void* report,
     return tuh_hid_set_report(ps_dev_addr, ps_instance, report_id, HID_REPORT_TYPE_FEATURE, report, len);
 }
 
-void P5GeneralAuthUSBListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
+bool P5GeneralAuthUSBListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
     P5LRPINTF("P5L:Try Mount\n");
     
     if ( p5GeneralAuthData->dongle_ready == true ) {
-        return;
+        return false;
     }
 
     uint16_t controller_pid, controller_vid;
@@ -96,7 +96,9 @@ void P5GeneralAuthUSBListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t
         ps_dev_addr = dev_addr;
         ps_instance = instance;
         p5GeneralAuthData->dongle_ready = true;
+        return true;
     }
+    return false;
 }
 
 void P5GeneralAuthUSBListener::unmount(uint8_t dev_addr) {
@@ -78,6 +78,16 @@ void P5GeneralDriver::initialize() {
     };
 
     last_report_us = to_us_since_boot(get_absolute_time());
+
+    // Reports go to the dongle for hashing first, process() sends the hashed report once it's back
+    reportSender.init([this](const uint8_t * report, uint16_t size) {
+        if (p5GeneralAuthData->hash_pending)
+            return false;
+        memcpy(p5GeneralAuthData->hash_pending_buffer, report, size);
+        p5GeneralAuthData->hash_pending = true;
+        return true;
+    });
+    reportSender.setFrameAligned(false);
 }
 
 void P5GeneralDriver::initializeAux() {
@@ -226,16 +236,12 @@ bool P5GeneralDriver::process(Gamepad * gamepad) {
     }
     p5GeneralReport.touchpad_data = touchpadData;
 
-    if (memcmp(&p5GeneralReport_last, &p5GeneralReport, sizeof(p5GeneralReport))) {
-        memcpy(&p5GeneralReport_last, &p5GeneralReport, sizeof(p5GeneralReport));
-        memcpy(p5GeneralAuthData->hash_pending_buffer, &p5GeneralReport, sizeof(p5GeneralReport));
-        p5GeneralAuthData->hash_pending = true;
+    // A changed report is hashed and sent a few more times after the change
+    if (reportSender.send(&p5GeneralReport, sizeof(p5GeneralReport))) {
         diff_report_repeat = 4;
         return true;
-    } else if (diff_report_repeat) {
+    } else if (diff_report_repeat && reportSender.repeat()) {
         diff_report_repeat--;
-        memcpy(p5GeneralAuthData->hash_pending_buffer, &p5GeneralReport, sizeof(p5GeneralReport));
-        p5GeneralAuthData->hash_pending = true;
         return true;
     } else {
         return false;
@@ -23,6 +23,8 @@ void PCEngineDriver::initialize() {
 		.xfer_cb = hidd_xfer_cb,
 		.sof = NULL
 	};
+
+	reportSender.init(ReportSender::transmitHID);
 }
 
 bool PCEngineDriver::process(Gamepad * gamepad) {
@@ -52,15 +54,7 @@ bool PCEngineDriver::process(Gamepad * gamepad) {
 
 	void * report = &pcengineReport;
 	uint16_t report_size = sizeof(pcengineReport);
-	if (memcmp(last_report, report, report_size) != 0)
-	{
-		// HID ready + report sent, copy previous report
-		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
-			memcpy(last_report, report, report_size);
-			return true;
-		}
-	}
-	return false;
+	return reportSender.send(report, report_size);
 }
 
 // tud_hid_get_report_cb
@@ -7,8 +7,30 @@
 #include "drivers/ps3/PS3Descriptors.h"
 #include "drivers/shared/driverhelper.h"
 #include "storagemanager.h"
+#include "gamepad/GamepadReportPacker.h"
 #include "pico/rand.h"
 
+static constexpr GamepadReportBit ps3ButtonBits[] = {
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_LEFT,  PS3_REPORT_MASK_LEFT   },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_DOWN,  PS3_REPORT_MASK_DOWN   },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_RIGHT, PS3_REPORT_MASK_RIGHT  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_UP,    PS3_REPORT_MASK_UP     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B1,    PS3_REPORT_MASK_SOUTH  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B2,    PS3_REPORT_MASK_EAST   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B3,    PS3_REPORT_MASK_WEST   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B4,    PS3_REPORT_MASK_NORTH  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L1,    PS3_REPORT_MASK_L1     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R1,    PS3_REPORT_MASK_R1     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L2,    PS3_REPORT_MASK_L2     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R2,    PS3_REPORT_MASK_R2     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1,    PS3_REPORT_MASK_SELECT },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2,    PS3_REPORT_MASK_START  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3,    PS3_REPORT_MASK_L3     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3,    PS3_REPORT_MASK_R3     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A1,    PS3_REPORT_MASK_PS     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A2,    PS3_REPORT_MASK_TP     },
+};
+
 void PS3Driver::initialize() {
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
     const GamepadOptions & options = gamepad->getOptions();
@@ -167,6 +189,8 @@ void PS3Driver::initialize() {
         .xfer_cb = hidd_xfer_cb,
         .sof = NULL
     };
+
+    reportSender.init(ReportSender::transmitHID);
 }
 
 // Generate PS3 report from gamepad and send to TUSB Device
@@ -178,41 +202,12 @@ bool PS3Driver::process(Gamepad * gamepad) {
     uint16_t report_size = 0;
 
     if (deviceType == InputModeDeviceType::INPUT_MODE_DEVICE_TYPE_GAMEPAD) {
-        // reset button states to false 
-        ps3Report.buttonSouth    = false;
-        ps3Report.buttonEast     = false;
-        ps3Report.buttonWest     = false;
-        ps3Report.buttonNorth    = false;
-        ps3Report.buttonL1       = false;
-        ps3Report.buttonR1       = false;
-        ps3Report.buttonL2       = false;
-        ps3Report.buttonR2       = false;
-        ps3Report.buttonSelect   = false;
-        ps3Report.buttonStart    = false;
-        ps3Report.buttonL3       = false;
-        ps3Report.buttonR3       = false;
-        ps3Report.buttonPS       = false;
-        ps3Report.buttonTP       = false;
-
-        ps3Report.dpadLeft    = gamepad->pressedLeft();
-        ps3Report.dpadDown    = gamepad->pressedDown();
-        ps3Report.dpadRight   = gamepad->pressedRight();
-        ps3Report.dpadUp      = gamepad->pressedUp();
-
-        ps3Report.buttonSouth    = gamepad->pressedB1();
-        ps3Report.buttonEast     = gamepad->pressedB2();
-        ps3Report.buttonWest     = gamepad->pressedB3();
-        ps3Report.buttonNorth    = gamepad->pressedB4();
-        ps3Report.buttonL1       = gamepad->pressedL1();
-        ps3Report.buttonR1       = gamepad->pressedR1();
-        ps3Report.buttonL2       = gamepad->pressedL2();
-        ps3Report.buttonR2       = gamepad->pressedR2();
-        ps3Report.buttonSelect   = gamepad->pressedS1();
-        ps3Report.buttonStart    = gamepad->pressedS2();
-        ps3Report.buttonL3       = gamepad->pressedL3();
-        ps3Report.buttonR3       = gamepad->pressedR3();
-        ps3Report.buttonPS       = gamepad->pressedA1();
-        ps3Report.buttonTP       = gamepad->pressedA2();
+        // writes all three bytes of digital buttons, so buttons released since the last report are cleared
+        const uint32_t buttons = GamepadReportPacker<ps3ButtonBits>::pack(gamepad->state);
+        uint8_t * buttonBytes = reinterpret_cast<uint8_t *>(&ps3Report) + PS3_REPORT_BUTTONS_OFFSET;
+        buttonBytes[0] = buttons;
+        buttonBytes[1] = buttons >> 8;
+        buttonBytes[2] = buttons >> 16;
 
         ps3Report.leftStickX = static_cast<uint8_t>(gamepad->state.lx >> 8);
         ps3Report.leftStickY = static_cast<uint8_t>(gamepad->state.ly >> 8);
@@ -459,16 +454,7 @@ bool PS3Driver::process(Gamepad * gamepad) {
     if (tud_suspended())
         tud_remote_wakeup();
 
-    bool reportSent = false;
-
-    if (memcmp(last_report, report, report_size) != 0)
-    {
-        // HID ready + report sent, copy previous report
-        if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
-            memcpy(last_report, report, report_size);
-            reportSent = true;
-        }
-    }
+    bool reportSent = reportSender.send(report, report_size);
 
     uint16_t featureSize = sizeof(PS3Features);
     if (memcmp(lastFeatures, &ps3Features, featureSize) != 0) {
@@ -11,8 +11,10 @@
 #include "enums.pb.h"
 
 #include "mbedtls/error.h"
+#include "mbedtls/platform_util.h"
 #include "mbedtls/rsa.h"
-#include "mbedtls/sha256.h"
+
+#include "pico/time.h"
 
 #define NEW_CONFIG_MPI(name, buf, size) \
     mbedtls_mpi_uint *bytes ## name = new mbedtls_mpi_uint[size / sizeof(mbedtls_mpi_uint)]; \
@@ -21,12 +23,6 @@
 
 #define DELETE_CONFIG_MPI(name) delete bytes ## name;
 
-static inline int rng(void*p_rng, unsigned char* p, size_t len) {
-    (void) p_rng;
-    p[0] = rand();
-    return 0;
-}
-
 void PS4Auth::initialize() {
     if ( !available() ) {
         return;
@@ -62,9 +58,9 @@ bool PS4Auth::available() {
     return false;
 }
 
-void PS4Auth::process() {
+void PS4Auth::process(uint32_t budgetUs) {
     if (authType == InputModeAuthType::INPUT_MODE_AUTH_TYPE_KEYS ) {
-        keyModeProcess();
+        keyModeProcess(budgetUs);
     } else if (authType == InputModeAuthType::INPUT_MODE_AUTH_TYPE_USB ) {
         ((PS4AuthUSBListener*)listener)->process(); 	// process HOST with client data
     }
@@ -88,35 +84,37 @@ void PS4Auth::keyModeInitialize() {
     DELETE_CONFIG_MPI(P)
     DELETE_CONFIG_MPI(Q)
 
-    // Reset our random seed
-    srand(0);
-}
-
-// Process if we are using ps4 keys
-void PS4Auth::keyModeProcess() {
-    // Do not run if RSA is invalid
-    if (!ps4AuthData.valid_rsa) {
-        return;
-    }
-
-    // Check to see if the PS4 Authentication needs work
-    if ( ps4AuthData.passthrough_state == GPAuthState::send_auth_console_to_dongle ) {
-        const PS4Options& options = Storage::getInstance().getAddonOptions().ps4Options;
-        int rss_error = 0;
-        uint8_t hashed_nonce[32];
-        // Sign our nonce into hashed_nonce
-        if ( mbedtls_sha256_ret(ps4AuthData.ps4_auth_buffer, 256, hashed_nonce, 0) < 0 ) {
-            return;
+    // Hand the CRT parameters to the signer once, it keeps them with their Montgomery constants
+    if (ps4AuthData.valid_rsa) {
+        if (signer == nullptr) {
+            signer = new PS4AuthSigner();
         }
-        rss_error = mbedtls_rsa_rsassa_pss_sign(&ps4AuthData.rsa_context, rng, nullptr,
-                MBEDTLS_RSA_PRIVATE, MBEDTLS_MD_SHA256,
-                32, hashed_nonce,
-                ps4AuthData.ps4_auth_buffer);
-        if ( rss_error < 0 ) {
-            return; // If we could not sign with our key, return (error)
+        mbedtls_mpi modulus;
+        mbedtls_mpi crt[5]; // P, Q, DP, DQ, QP
+        uint8_t crtBytes[5][PS4_AUTH_PRIME_SIZE];
+        mbedtls_mpi_init(&modulus);
+        for (uint8_t i = 0; i < 5; i++) {
+            mbedtls_mpi_init(&crt[i]);
         }
-        // copy the parts into our authentication buffer
-        size_t offset = 256;
+        ps4AuthData.valid_rsa = mbedtls_rsa_export(&ps4AuthData.rsa_context, &modulus, &crt[0], &crt[1], nullptr, nullptr) == 0 &&
+            mbedtls_rsa_export_crt(&ps4AuthData.rsa_context, &crt[2], &crt[3], &crt[4]) == 0 &&
+            mbedtls_mpi_bitlen(&modulus) == PS4_AUTH_SIGNATURE_SIZE * 8;
+        for (uint8_t i = 0; i < 5 && ps4AuthData.valid_rsa; i++) {
+            ps4AuthData.valid_rsa = mbedtls_mpi_write_binary(&crt[i], crtBytes[i], PS4_AUTH_PRIME_SIZE) == 0;
+        }
+        if (ps4AuthData.valid_rsa) {
+            ps4AuthData.valid_rsa = signer->setKey(crtBytes[0], crtBytes[1], crtBytes[2], crtBytes[3], crtBytes[4]);
+        }
+        mbedtls_platform_zeroize(crtBytes, sizeof(crtBytes));
+        mbedtls_mpi_free(&modulus);
+        for (uint8_t i = 0; i < 5; i++) {
+            mbedtls_mpi_free(&crt[i]);
+        }
+    }
+
+    // Everything after the signed nonce is the same for every nonce, fill it in now
+    if (ps4AuthData.valid_rsa) {
+        size_t offset = PS4_AUTH_SIGNATURE_SIZE;
         memcpy(&ps4AuthData.ps4_auth_buffer[offset], options.serial.bytes, 16);
         offset += 16;
         mbedtls_rsa_export_raw(
@@ -131,8 +129,39 @@ void PS4Auth::keyModeProcess() {
         memcpy(&ps4AuthData.ps4_auth_buffer[offset], options.signature.bytes, 256);
         offset += 256;
         memset(&ps4AuthData.ps4_auth_buffer[offset], 0, 24);
-        ps4AuthData.passthrough_state = GPAuthState::send_auth_dongle_to_console;
     }
+
+    // Reset our random seed
+    srand(0);
+}
+
+// Process if we are using ps4 keys
+void PS4Auth::keyModeProcess(uint32_t budgetUs) {
+    // Do not run if RSA is invalid
+    if (!ps4AuthData.valid_rsa) {
+        return;
+    }
+
+    // Drop a signature in progress if the console reset authentication or a nonce page was rejected
+    if ( ps4AuthData.passthrough_state != GPAuthState::send_auth_console_to_dongle ) {
+        signer->cancel();
+        return;
+    }
+
+    // Start on a new nonce, or over if the console sent another one while we were signing
+    if ( !signer->isBusy() || signingNonceId != ps4AuthData.nonce_id ) {
+        signingNonceId = ps4AuthData.nonce_id;
+        signer->start(ps4AuthData.ps4_auth_buffer, ps4AuthData.ps4_auth_buffer);
+    }
+
+    // Sign our nonce over the start of the buffer until the budget is spent, resuming on the next call
+    const uint32_t start = time_us_32();
+    while ( !signer->step() ) {
+        if ( (time_us_32() - start) >= budgetUs ) {
+            return;
+        }
+    }
+    ps4AuthData.passthrough_state = GPAuthState::send_auth_dongle_to_console;
 }
 
 void PS4Auth::resetAuth() {
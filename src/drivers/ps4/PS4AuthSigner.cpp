@@ -0,0 +1,338 @@
+#include "drivers/ps4/PS4AuthSigner.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define PS4_AUTH_HASH_SIZE 32
+#define PS4_AUTH_DB_SIZE (PS4_AUTH_SIGNATURE_SIZE - PS4_AUTH_HASH_SIZE - 1)     // EMSA-PSS masked data block
+#define PS4_AUTH_MASK_BLOCKS ((PS4_AUTH_DB_SIZE + PS4_AUTH_HASH_SIZE - 1) / PS4_AUTH_HASH_SIZE)
+
+// Exponentiation ops per prime: two to bring the message into Montgomery form, the rest of the window table,
+// then the squarings and multiplication of every window
+#define PS4_AUTH_EXPONENT_OPS (PS4_AUTH_WINDOW_TABLE + PS4_AUTH_WINDOWS * (PS4_AUTH_WINDOW_BITS + 1))
+
+// Combine ops: leave Montgomery form mod Q, bring the Q half mod P, multiply by QP, one per product row, store
+#define PS4_AUTH_COMBINE_ROWS 4
+#define PS4_AUTH_COMBINE_OPS (PS4_AUTH_COMBINE_ROWS + PS4_AUTH_PRIME_LIMBS + 1)
+
+static const uint32_t limbOne[PS4_AUTH_PRIME_LIMBS] = { 1 };
+
+static void loadBigEndian(uint32_t * limbs, const uint8_t * bytes, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        const uint8_t * b = &bytes[(count - 1 - i) * 4];
+        limbs[i] = ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+    }
+}
+
+static void storeBigEndian(uint8_t * bytes, const uint32_t * limbs, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t * b = &bytes[(count - 1 - i) * 4];
+        b[0] = limbs[i] >> 24;
+        b[1] = limbs[i] >> 16;
+        b[2] = limbs[i] >> 8;
+        b[3] = limbs[i];
+    }
+}
+
+static bool lessThan(const uint32_t * a, const uint32_t * b) {
+    for (int16_t i = PS4_AUTH_PRIME_LIMBS - 1; i >= 0; i--) {
+        if (a[i] != b[i])
+            return a[i] < b[i];
+    }
+    return false;
+}
+
+// a -= b, returns the borrow
+static uint32_t subtract(uint32_t * a, const uint32_t * b) {
+    uint32_t borrow = 0;
+    for (uint16_t i = 0; i < PS4_AUTH_PRIME_LIMBS; i++) {
+        const uint64_t v = (uint64_t)a[i] - b[i] - borrow;
+        a[i] = (uint32_t)v;
+        borrow = (v >> 32) ? 1 : 0;
+    }
+    return borrow;
+}
+
+// a += b, returns the carry
+static uint32_t add(uint32_t * a, const uint32_t * b) {
+    uint32_t carry = 0;
+    for (uint16_t i = 0; i < PS4_AUTH_PRIME_LIMBS; i++) {
+        const uint64_t v = (uint64_t)a[i] + b[i] + carry;
+        a[i] = (uint32_t)v;
+        carry = v >> 32;
+    }
+    return carry;
+}
+
+// a = 2a mod m, for a < m
+static void doubleMod(uint32_t * a, const uint32_t * m) {
+    uint32_t carry = 0;
+    for (uint16_t i = 0; i < PS4_AUTH_PRIME_LIMBS; i++) {
+        const uint32_t top = a[i] >> 31;
+        a[i] = (a[i] << 1) | carry;
+        carry = top;
+    }
+    if (carry || !lessThan(a, m))
+        subtract(a, m);
+}
+
+bool PS4AuthSigner::setKey(const uint8_t * p, const uint8_t * q, const uint8_t * dp, const uint8_t * dq, const uint8_t * qpBytes) {
+    stage = PS4_AUTH_SIGNER_IDLE;
+    const uint8_t * keyPrimes[2] = { p, q };
+    const uint8_t * keyExponents[2] = { dp, dq };
+    for (uint8_t i = 0; i < 2; i++) {
+        PS4AuthPrime & prime = primes[i];
+        loadBigEndian(prime.m, keyPrimes[i], PS4_AUTH_PRIME_LIMBS);
+        loadBigEndian(prime.exponent, keyExponents[i], PS4_AUTH_PRIME_LIMBS);
+        if ((prime.m[0] & 1) == 0 || prime.m[PS4_AUTH_PRIME_LIMBS - 1] == 0)
+            return false;
+
+        // Newton iteration doubles the correct low bits, m is its own inverse mod 8
+        uint32_t inverse = prime.m[0];
+        for (uint8_t k = 0; k < 4; k++)
+            inverse *= 2 - prime.m[0] * inverse;
+        prime.mInv = 0 - inverse;
+
+        memcpy(prime.one, limbOne, sizeof(prime.one));
+        for (uint16_t bit = 0; bit < PS4_AUTH_PRIME_LIMBS * 32; bit++)
+            doubleMod(prime.one, prime.m);
+        memcpy(prime.rr, prime.one, sizeof(prime.rr));
+        for (uint16_t bit = 0; bit < PS4_AUTH_PRIME_LIMBS * 32; bit++)
+            doubleMod(prime.rr, prime.m);
+        montMul(&prime, prime.rr, prime.rr, prime.rrr);
+    }
+    loadBigEndian(qp, qpBytes, PS4_AUTH_PRIME_LIMBS);
+    return lessThan(qp, primes[0].m);
+}
+
+void PS4AuthSigner::start(const uint8_t * inNonce, uint8_t * inSignature) {
+    nonce = inNonce;
+    signature = inSignature;
+    mulActive = false;
+    counter = 0;
+    for (uint8_t i = 0; i < sizeof(salt); i++)
+        salt[i] = rand();
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts_ret(&sha, 0);
+    stage = PS4_AUTH_SIGNER_HASH;
+}
+
+bool PS4AuthSigner::step() {
+    if (mulActive) {
+        stepMul();
+        return false;
+    }
+
+    switch (stage) {
+        case PS4_AUTH_SIGNER_HASH:
+            mbedtls_sha256_update_ret(&sha, &nonce[counter * 64], 64);
+            if (++counter == PS4_AUTH_NONCE_SIZE / 64) {
+                mbedtls_sha256_finish_ret(&sha, hash);
+                stage = PS4_AUTH_SIGNER_ENCODE;
+            }
+            return false;
+        case PS4_AUTH_SIGNER_ENCODE:
+        {
+            // H = SHA-256(8 zero bytes || nonce hash || salt), DB = zeros || 0x01 || salt, EM = maskedDB || H || 0xBC
+            const uint8_t zeros[8] = {};
+            uint8_t * h = &encoded[PS4_AUTH_DB_SIZE];
+            mbedtls_sha256_starts_ret(&sha, 0);
+            mbedtls_sha256_update_ret(&sha, zeros, sizeof(zeros));
+            mbedtls_sha256_update_ret(&sha, hash, sizeof(hash));
+            mbedtls_sha256_update_ret(&sha, salt, sizeof(salt));
+            mbedtls_sha256_finish_ret(&sha, h);
+            encoded[PS4_AUTH_SIGNATURE_SIZE - 1] = 0xBC;
+            memset(encoded, 0, PS4_AUTH_DB_SIZE);
+            encoded[PS4_AUTH_DB_SIZE - sizeof(salt) - 1] = 0x01;
+            memcpy(&encoded[PS4_AUTH_DB_SIZE - sizeof(salt)], salt, sizeof(salt));
+            counter = 0;
+            stage = PS4_AUTH_SIGNER_MASK;
+            return false;
+        }
+        case PS4_AUTH_SIGNER_MASK:
+        {
+            // MGF1(H), one SHA-256 of H || counter per block
+            const uint8_t block[4] = { 0, 0, 0, (uint8_t)counter };
+            uint8_t mask[PS4_AUTH_HASH_SIZE];
+            mbedtls_sha256_starts_ret(&sha, 0);
+            mbedtls_sha256_update_ret(&sha, &encoded[PS4_AUTH_DB_SIZE], PS4_AUTH_HASH_SIZE);
+            mbedtls_sha256_update_ret(&sha, block, sizeof(block));
+            mbedtls_sha256_finish_ret(&sha, mask);
+            const uint16_t offset = counter * PS4_AUTH_HASH_SIZE;
+            for (uint16_t i = 0; i < PS4_AUTH_HASH_SIZE && offset + i < PS4_AUTH_DB_SIZE; i++)
+                encoded[offset + i] ^= mask[i];
+            if (++counter == PS4_AUTH_MASK_BLOCKS) {
+                encoded[0] &= 0x7F;     // 2047-bit encoded message for the 2048-bit modulus
+                mbedtls_sha256_free(&sha);
+                loadBigEndian(message, encoded, PS4_AUTH_PRIME_LIMBS * 2);
+                counter = 0;
+                stage = PS4_AUTH_SIGNER_EXP_P;
+            }
+            return false;
+        }
+        case PS4_AUTH_SIGNER_EXP_P:
+        case PS4_AUTH_SIGNER_EXP_Q:
+            if (queueExponentOp()) {
+                stepMul();
+            } else {
+                memcpy((stage == PS4_AUTH_SIGNER_EXP_P) ? halfP : halfQ, acc, sizeof(acc));
+                counter = 0;
+                stage = (stage == PS4_AUTH_SIGNER_EXP_P) ? PS4_AUTH_SIGNER_EXP_Q : PS4_AUTH_SIGNER_COMBINE;
+            }
+            return false;
+        case PS4_AUTH_SIGNER_COMBINE:
+            if (queueCombineOp())
+                stepMul();
+            return stage == PS4_AUTH_SIGNER_DONE;
+        case PS4_AUTH_SIGNER_DONE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Queue the next multiplication of message ^ exponent mod the prime of the current stage.
+ *
+ * Non-multiplying ops (the first window, multiplications by a zero window) are run inline. False once
+ * every op ran and acc holds the result, in Montgomery form.
+ */
+bool PS4AuthSigner::queueExponentOp() {
+    const PS4AuthPrime * prime = &primes[(stage == PS4_AUTH_SIGNER_EXP_P) ? 0 : 1];
+    while (counter < PS4_AUTH_EXPONENT_OPS) {
+        const uint16_t op = counter++;
+        if (op == 0) {
+            startMul(prime, message, prime->rr, temp);
+            return true;
+        } else if (op == 1) {
+            startMul(prime, &message[PS4_AUTH_PRIME_LIMBS], prime->rrr, table[1]);
+            return true;
+        } else if (op < PS4_AUTH_WINDOW_TABLE) {
+            if (op == 2) {
+                // low * R + high * R^2 is the message in Montgomery form
+                if (add(table[1], temp) || !lessThan(table[1], prime->m))
+                    subtract(table[1], prime->m);
+                memcpy(table[0], prime->one, sizeof(table[0]));
+            }
+            startMul(prime, table[op - 1], table[1], table[op]);
+            return true;
+        }
+
+        const uint16_t windowOp = op - PS4_AUTH_WINDOW_TABLE;
+        const uint16_t window = PS4_AUTH_WINDOWS - 1 - windowOp / (PS4_AUTH_WINDOW_BITS + 1);
+        const uint8_t windowStep = windowOp % (PS4_AUTH_WINDOW_BITS + 1);
+        const uint8_t bits = (prime->exponent[window / (32 / PS4_AUTH_WINDOW_BITS)]
+            >> ((window % (32 / PS4_AUTH_WINDOW_BITS)) * PS4_AUTH_WINDOW_BITS)) & (PS4_AUTH_WINDOW_TABLE - 1);
+        if (window == PS4_AUTH_WINDOWS - 1) {
+            if (windowStep == 0)
+                memcpy(acc, table[bits], sizeof(acc));
+        } else if (windowStep < PS4_AUTH_WINDOW_BITS) {
+            startMul(prime, acc, acc, acc);
+            return true;
+        } else if (bits != 0) {
+            startMul(prime, acc, table[bits], acc);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Queue the next op of the Garner recombination s = m2 + Q * (QP * (m1 - m2) mod P).
+ *
+ * The product rows and the final store are run inline, one per call.
+ */
+bool PS4AuthSigner::queueCombineOp() {
+    const uint16_t op = counter++;
+    if (op == 0) {
+        startMul(&primes[1], halfQ, limbOne, halfQ);
+        return true;
+    } else if (op == 1) {
+        startMul(&primes[0], halfQ, primes[0].rr, temp);
+        return true;
+    } else if (op == 2) {
+        if (subtract(halfP, temp))
+            add(halfP, primes[0].m);
+        startMul(&primes[0], halfP, qp, temp);
+        return true;
+    } else if (op == 3) {
+        memcpy(message, halfQ, sizeof(halfQ));
+        memset(&message[PS4_AUTH_PRIME_LIMBS], 0, sizeof(halfQ));
+    } else if (op < PS4_AUTH_COMBINE_OPS - 1) {
+        const uint16_t row = op - PS4_AUTH_COMBINE_ROWS;
+        const uint32_t * m = primes[1].m;
+        uint32_t carry = 0;
+        for (uint16_t j = 0; j < PS4_AUTH_PRIME_LIMBS; j++) {
+            const uint64_t v = (uint64_t)temp[row] * m[j] + message[row + j] + carry;
+            message[row + j] = (uint32_t)v;
+            carry = v >> 32;
+        }
+        for (uint16_t j = row + PS4_AUTH_PRIME_LIMBS; carry != 0 && j < PS4_AUTH_PRIME_LIMBS * 2; j++) {
+            const uint64_t v = (uint64_t)message[j] + carry;
+            message[j] = (uint32_t)v;
+            carry = v >> 32;
+        }
+    } else {
+        storeBigEndian(signature, message, PS4_AUTH_PRIME_LIMBS * 2);
+        stage = PS4_AUTH_SIGNER_DONE;
+    }
+    return false;
+}
+
+void PS4AuthSigner::startMul(const PS4AuthPrime * prime, const uint32_t * a, const uint32_t * b, uint32_t * out) {
+    mulPrime = prime;
+    mulA = a;
+    mulB = b;
+    mulOut = out;
+    mulRow = 0;
+    mulActive = true;
+    memset(mulSum, 0, sizeof(mulSum));
+}
+
+/**
+ * @brief One row of a CIOS Montgomery multiplication: add a * b[row], then drop a limb after adding a multiple of m.
+ *
+ * The last row reduces the sum below m and writes it out. True once the multiplication is done.
+ */
+bool PS4AuthSigner::stepMul() {
+    const uint32_t * m = mulPrime->m;
+    uint32_t * t = mulSum;
+    const uint32_t b = mulB[mulRow];
+    uint32_t carry = 0;
+    uint64_t v;
+    for (uint16_t j = 0; j < PS4_AUTH_PRIME_LIMBS; j++) {
+        v = (uint64_t)mulA[j] * b + t[j] + carry;
+        t[j] = (uint32_t)v;
+        carry = v >> 32;
+    }
+    v = (uint64_t)t[PS4_AUTH_PRIME_LIMBS] + carry;
+    t[PS4_AUTH_PRIME_LIMBS] = (uint32_t)v;
+    t[PS4_AUTH_PRIME_LIMBS + 1] = v >> 32;
+
+    const uint32_t q = t[0] * mulPrime->mInv;
+    v = (uint64_t)q * m[0] + t[0];
+    carry = v >> 32;
+    for (uint16_t j = 1; j < PS4_AUTH_PRIME_LIMBS; j++) {
+        v = (uint64_t)q * m[j] + t[j] + carry;
+        t[j - 1] = (uint32_t)v;
+        carry = v >> 32;
+    }
+    v = (uint64_t)t[PS4_AUTH_PRIME_LIMBS] + carry;
+    t[PS4_AUTH_PRIME_LIMBS - 1] = (uint32_t)v;
+    t[PS4_AUTH_PRIME_LIMBS] = t[PS4_AUTH_PRIME_LIMBS + 1] + (uint32_t)(v >> 32);
+
+    if (++mulRow < PS4_AUTH_PRIME_LIMBS)
+        return false;
+
+    if (t[PS4_AUTH_PRIME_LIMBS] != 0 || !lessThan(t, m))
+        subtract(t, m);
+    memcpy(mulOut, t, sizeof(uint32_t) * PS4_AUTH_PRIME_LIMBS);
+    mulActive = false;
+    return true;
+}
+
+// Whole multiplication at once, for the constants computed by setKey
+void PS4AuthSigner::montMul(const PS4AuthPrime * prime, const uint32_t * a, const uint32_t * b, uint32_t * out) {
+    startMul(prime, a, b, out);
+    while (!stepMul());
+}
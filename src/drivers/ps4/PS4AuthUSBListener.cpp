@@ -81,10 +81,10 @@ bool PS4AuthUSBListener::host_set_report(uint8_t report_id, void* report, uint16
     return tuh_hid_set_report(ps_dev_addr, ps_instance, report_id, HID_REPORT_TYPE_FEATURE, report, len);
 }
 
-void PS4AuthUSBListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
+bool PS4AuthUSBListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
     // Prevent Magic-X double mount
     if ( ps4AuthData->dongle_ready == true ) {
-        return;
+        return false;
     }
 
     // Only a PS4 interface has vendor IDs F0, F1, F2, and F3
@@ -99,7 +99,7 @@ void PS4AuthUSBListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const
         }
     }
     if (isPS4Dongle == false )
-        return;
+        return false;
 
     ps_dev_addr = dev_addr;
     ps_instance = instance;
@@ -109,6 +109,7 @@ void PS4AuthUSBListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const
     memset(report_buffer, 0, PS4_ENDPOINT_SIZE);
     report_buffer[0] = PS4AuthReport::PS4_DEFINITION;
     host_get_report(PS4AuthReport::PS4_DEFINITION, report_buffer, 48);
+    return true;
 }
 
 void PS4AuthUSBListener::unmount(uint8_t dev_addr) {
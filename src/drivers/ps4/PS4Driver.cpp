@@ -386,7 +386,8 @@ void PS4Driver::initialize() {
 
     last_report_counter = 0; // PS4 Reports
     last_axis_counter = 0;
-    last_report_timer = to_ms_since_boot(get_absolute_time());
+    reportSender.init(ReportSender::transmitHID);
+    reportSender.setKeepalive(PS4_KEEPALIVE_TIMER);
     cur_nonce_id = 1; // PS4 Auth
     cur_nonce_chunk = 0;
 }
@@ -677,38 +678,22 @@ bool PS4Driver::process(Gamepad * gamepad) {
     if (tud_suspended())
         tud_remote_wakeup();
 
-    bool reportSent = false;
-
-    uint32_t now = to_ms_since_boot(get_absolute_time());
-    void * report = &ps4Report;
-    uint16_t report_size = sizeof(ps4Report);
-
-    if (memcmp(last_report, report, report_size) != 0)
-    {
-        // HID ready + report sent, copy previous report
-        if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
-            memcpy(last_report, report, report_size);
-            reportSent = true;
-        }
-        // keep track of our last successful report, for keepalive purposes
-        last_report_timer = now;
-    } else {
-        // some games apparently can miss reports, or they rely on official behavior of getting frequent
-        // updates. we normally only send a report when the value changes; if we increment the counters
-        // every time we generate the report (every GP2040::run loop), we apparently overburden
-        // TinyUSB and introduce roughly 1ms of latency. but we want to loop often and report on every
-        // true update in order to achieve our tight <1ms report timing when we *do* have a different
-        // report to send.
-        if ((now - last_report_timer) > PS4_KEEPALIVE_TIMER) {
-            last_report_counter = (last_report_counter+1) & 0x3F;
-            ps4Report.reportCounter = last_report_counter;		// report counter is 6 bits
-            if (deviceType == InputModeDeviceType::INPUT_MODE_DEVICE_TYPE_GAMEPAD) {
-                ps4Report.gamepad.axisTiming = now;		 		// axis counter is 16 bits
-            }
-            // the *next* process() will be a forced report (or real user input)
+    // some games apparently can miss reports, or they rely on official behavior of getting frequent
+    // updates. we normally only send a report when the value changes; if we increment the counters
+    // every time we generate the report (every GP2040::run loop), we apparently overburden
+    // TinyUSB and introduce roughly 1ms of latency. but we want to loop often and report on every
+    // true update in order to achieve our tight <1ms report timing when we *do* have a different
+    // report to send.
+    if (reportSender.keepaliveDue()) {
+        last_report_counter = (last_report_counter+1) & 0x3F;
+        ps4Report.reportCounter = last_report_counter;		// report counter is 6 bits
+        if (deviceType == InputModeDeviceType::INPUT_MODE_DEVICE_TYPE_GAMEPAD) {
+            ps4Report.gamepad.axisTiming = to_ms_since_boot(get_absolute_time());		 		// axis counter is 16 bits
         }
     }
 
+    bool reportSent = reportSender.send(&ps4Report, sizeof(ps4Report));
+
     uint16_t featureSize = sizeof(PS4FeatureOutputReport);
     if (memcmp(lastFeatures, &ps4Features, featureSize) != 0) {
         memcpy(lastFeatures, &ps4Features, featureSize);
@@ -757,11 +742,11 @@ bool PS4Driver::process(Gamepad * gamepad) {
     return reportSent;
 }
 
-// Called by Core1, PS4 key signing will lock the CPU
+// Called by Core1, PS4 key signing runs for at most a slice per call
 void PS4Driver::processAux() {
     // If authentication driver is set AND auth driver can load (usb enabled, i2c enabled, keys loaded, etc.)
     if ( ps4AuthDriver != nullptr && ps4AuthDriver->available() ) {
-        ps4AuthDriver->process();
+        ps4AuthDriver->process(PS4_AUTH_SIGN_SLICE_US);
     }
 }
 
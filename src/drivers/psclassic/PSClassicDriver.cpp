@@ -17,6 +17,8 @@ void PSClassicDriver::initialize() {
 		.xfer_cb = hidd_xfer_cb,
 		.sof = NULL
 	};
+
+	reportSender.init(ReportSender::transmitHID);
 }
 
 bool PSClassicDriver::process(Gamepad * gamepad) {
@@ -54,14 +56,7 @@ bool PSClassicDriver::process(Gamepad * gamepad) {
 
 	void * report = &psClassicReport;
 	uint16_t report_size = sizeof(psClassicReport);
-	if (memcmp(last_report, report, report_size) != 0) {
-		// HID ready + report sent, copy previous report
-		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
-			memcpy(last_report, report, report_size);
-			return true;
-		}
-	}
-	return false;
+	return reportSender.send(report, report_size);
 }
 
 // tud_hid_get_report_cb
@@ -0,0 +1,537 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#include "drivers/shared/hidreportplan.h"
+
+// Report descriptor items, HID 1.11 section 6.2.2
+#define HID_ITEM_TYPE_MAIN   0
+#define HID_ITEM_TYPE_GLOBAL 1
+#define HID_ITEM_TYPE_LOCAL  2
+#define HID_ITEM_LONG        0xFE
+
+#define HID_MAIN_INPUT          0x8
+#define HID_MAIN_COLLECTION     0xA
+#define HID_MAIN_END_COLLECTION 0xC
+
+#define HID_GLOBAL_USAGE_PAGE   0x0
+#define HID_GLOBAL_LOGICAL_MIN  0x1
+#define HID_GLOBAL_LOGICAL_MAX  0x2
+#define HID_GLOBAL_REPORT_SIZE  0x7
+#define HID_GLOBAL_REPORT_ID    0x8
+#define HID_GLOBAL_REPORT_COUNT 0x9
+#define HID_GLOBAL_PUSH         0xA
+#define HID_GLOBAL_POP          0xB
+
+#define HID_LOCAL_USAGE         0x0
+#define HID_LOCAL_USAGE_MIN     0x1
+#define HID_LOCAL_USAGE_MAX     0x2
+
+#define HID_INPUT_CONSTANT      0x01
+#define HID_INPUT_VARIABLE      0x02
+
+#define HID_COLLECTION_APPLICATION 0x01
+
+#define HID_USAGE(page, id) (((uint32_t)(page) << 16) | (id))
+
+#define HID_USAGE_PAGE_DESKTOP    0x01
+#define HID_USAGE_PAGE_SIMULATION 0x02
+#define HID_USAGE_PAGE_BUTTON     0x09
+
+// Parser limits, anything past them is ignored
+#define HID_PLAN_MAX_USAGES     16
+#define HID_PLAN_MAX_REPORTS    8
+#define HID_PLAN_MAX_PUSH       4
+
+// Usages the plan knows what to do with
+enum HIDUsageKind : uint8_t {
+	HID_USAGE_KIND_NONE,
+	HID_USAGE_KIND_BUTTON,
+	HID_USAGE_KIND_X,
+	HID_USAGE_KIND_Y,
+	HID_USAGE_KIND_Z,
+	HID_USAGE_KIND_RX,
+	HID_USAGE_KIND_RY,
+	HID_USAGE_KIND_RZ,
+	HID_USAGE_KIND_HAT,
+	HID_USAGE_KIND_DPAD_UP,
+	HID_USAGE_KIND_DPAD_DOWN,
+	HID_USAGE_KIND_DPAD_RIGHT,
+	HID_USAGE_KIND_DPAD_LEFT,
+	HID_USAGE_KIND_BRAKE,
+	HID_USAGE_KIND_ACCELERATOR,
+};
+
+#define HID_USAGE_KIND_BIT(kind) (1U << (kind))
+
+// Gamepad inputs of buttons 1 to 32, the order GP2040-CE sends them in HID mode
+static const uint32_t hidButtonMasks[] = {
+	GAMEPAD_MASK_B3,  GAMEPAD_MASK_B1,  GAMEPAD_MASK_B2,  GAMEPAD_MASK_B4,
+	GAMEPAD_MASK_L1,  GAMEPAD_MASK_R1,  GAMEPAD_MASK_L2,  GAMEPAD_MASK_R2,
+	GAMEPAD_MASK_S1,  GAMEPAD_MASK_S2,  GAMEPAD_MASK_L3,  GAMEPAD_MASK_R3,
+	GAMEPAD_MASK_A1,  GAMEPAD_MASK_A2,  GAMEPAD_MASK_A3,  GAMEPAD_MASK_A4,
+	GAMEPAD_MASK_UP,  GAMEPAD_MASK_DOWN, GAMEPAD_MASK_LEFT, GAMEPAD_MASK_RIGHT,
+	GAMEPAD_MASK_E1,  GAMEPAD_MASK_E2,  GAMEPAD_MASK_E3,  GAMEPAD_MASK_E4,
+	GAMEPAD_MASK_E5,  GAMEPAD_MASK_E6,  GAMEPAD_MASK_E7,  GAMEPAD_MASK_E8,
+	GAMEPAD_MASK_E9,  GAMEPAD_MASK_E10, GAMEPAD_MASK_E11, GAMEPAD_MASK_E12,
+};
+
+#define HID_BUTTON_COUNT (sizeof(hidButtonMasks) / sizeof(hidButtonMasks[0]))
+#define HID_BUTTON_DPAD_FIRST 16
+#define HID_BUTTON_DPAD_LAST  19
+
+// Hat switch positions, clockwise from up
+static const uint8_t hidHatDpad[] = {
+	GAMEPAD_MASK_UP,
+	GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT,
+	GAMEPAD_MASK_RIGHT,
+	GAMEPAD_MASK_RIGHT | GAMEPAD_MASK_DOWN,
+	GAMEPAD_MASK_DOWN,
+	GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT,
+	GAMEPAD_MASK_LEFT,
+	GAMEPAD_MASK_LEFT | GAMEPAD_MASK_UP,
+};
+
+// One variable input of the descriptor
+struct HIDReportItem {
+	uint32_t usage;             // Usage page in the upper 16 bits
+	int32_t logicalMin;
+	int32_t logicalMax;
+	uint16_t bitOffset;
+	uint8_t bitSize;
+	uint8_t reportId;
+	bool inGamepad;             // Inside a Joystick, Gamepad or Multi-axis application collection
+};
+
+struct HIDGlobalState {
+	uint16_t usagePage;
+	int32_t logicalMin;
+	int32_t logicalMax;
+	uint32_t reportSize;
+	uint32_t reportCount;
+	uint8_t reportId;
+};
+
+static uint32_t itemUnsigned(const uint8_t * data, uint8_t size) {
+	uint32_t value = 0;
+	for (uint8_t i = 0; i < size; i++)
+		value |= (uint32_t)data[i] << (8 * i);
+	return value;
+}
+
+static int32_t itemSigned(const uint8_t * data, uint8_t size) {
+	uint32_t value = itemUnsigned(data, size);
+	if (size > 0 && size < 4 && (value & (1U << (size * 8 - 1))))
+		value |= ~((1U << (size * 8)) - 1);
+	return (int32_t)value;
+}
+
+static uint8_t bitLength(uint32_t value) {
+	uint8_t length = 0;
+	while (value) {
+		value >>= 1;
+		length++;
+	}
+	return length;
+}
+
+static HIDUsageKind usageKind(uint32_t usage) {
+	const uint16_t page = usage >> 16;
+	const uint16_t id = usage & 0xFFFF;
+	if (page == HID_USAGE_PAGE_BUTTON)
+		return (id >= 1 && id <= HID_BUTTON_COUNT) ? HID_USAGE_KIND_BUTTON : HID_USAGE_KIND_NONE;
+	if (page == HID_USAGE_PAGE_SIMULATION) {
+		switch (id) {
+			case 0xC4: return HID_USAGE_KIND_ACCELERATOR;
+			case 0xC5: return HID_USAGE_KIND_BRAKE;
+			default:   return HID_USAGE_KIND_NONE;
+		}
+	}
+	if (page == HID_USAGE_PAGE_DESKTOP) {
+		switch (id) {
+			case 0x30: return HID_USAGE_KIND_X;
+			case 0x31: return HID_USAGE_KIND_Y;
+			case 0x32: return HID_USAGE_KIND_Z;
+			case 0x33: return HID_USAGE_KIND_RX;
+			case 0x34: return HID_USAGE_KIND_RY;
+			case 0x35: return HID_USAGE_KIND_RZ;
+			case 0x39: return HID_USAGE_KIND_HAT;
+			case 0x90: return HID_USAGE_KIND_DPAD_UP;
+			case 0x91: return HID_USAGE_KIND_DPAD_DOWN;
+			case 0x92: return HID_USAGE_KIND_DPAD_RIGHT;
+			case 0x93: return HID_USAGE_KIND_DPAD_LEFT;
+			default:   return HID_USAGE_KIND_NONE;
+		}
+	}
+	return HID_USAGE_KIND_NONE;
+}
+
+/**
+ * @brief Walk the descriptor and hand every variable, non-constant input usage to onInput.
+ *
+ * Keeps a running bit offset per report ID, follows Push/Pop and repeats the last usage of a main item
+ * for the remaining report count, as the HID spec asks. Output and Feature items do not move input offsets.
+ */
+template <typename OnInput>
+static void walkInputs(const uint8_t * descriptor, uint16_t length, OnInput onInput) {
+	HIDGlobalState global = {};
+	HIDGlobalState pushed[HID_PLAN_MAX_PUSH];
+	uint8_t pushDepth = 0;
+
+	uint32_t usages[HID_PLAN_MAX_USAGES];
+	uint8_t usageCount = 0;
+	uint32_t usageMin = 0;
+	uint32_t usageMax = 0;
+	bool hasUsageRange = false;
+
+	uint8_t collectionDepth = 0;
+	uint8_t gamepadDepth = 0;       // Depth of the enclosing gamepad application collection, 0 for none
+
+	struct { uint8_t id; uint32_t bits; } reports[HID_PLAN_MAX_REPORTS];
+	uint8_t reportCount = 0;
+
+	uint16_t pos = 0;
+	while (pos < length) {
+		const uint8_t prefix = descriptor[pos];
+		if (prefix == HID_ITEM_LONG) {
+			if (pos + 1 >= length) break;
+			pos += 3 + descriptor[pos + 1];
+			continue;
+		}
+
+		uint8_t size = prefix & 0x03;
+		if (size == 3) size = 4;
+		const uint8_t type = (prefix >> 2) & 0x03;
+		const uint8_t tag = prefix >> 4;
+		if (pos + 1 + size > length) break;
+		const uint8_t * data = &descriptor[pos + 1];
+		pos += 1 + size;
+
+		if (type == HID_ITEM_TYPE_GLOBAL) {
+			switch (tag) {
+				case HID_GLOBAL_USAGE_PAGE:   global.usagePage = itemUnsigned(data, size); break;
+				case HID_GLOBAL_LOGICAL_MIN:  global.logicalMin = itemSigned(data, size); break;
+				case HID_GLOBAL_LOGICAL_MAX:
+					// Devices commonly write 0..255 as 0x25 0xFF, read it unsigned when the minimum is not negative
+					global.logicalMax = itemSigned(data, size);
+					if (global.logicalMin >= 0 && global.logicalMax < global.logicalMin)
+						global.logicalMax = itemUnsigned(data, size);
+					break;
+				case HID_GLOBAL_REPORT_SIZE:  global.reportSize = itemUnsigned(data, size); break;
+				case HID_GLOBAL_REPORT_ID:    global.reportId = itemUnsigned(data, size); break;
+				case HID_GLOBAL_REPORT_COUNT: global.reportCount = itemUnsigned(data, size); break;
+				case HID_GLOBAL_PUSH:
+					if (pushDepth < HID_PLAN_MAX_PUSH) pushed[pushDepth++] = global;
+					break;
+				case HID_GLOBAL_POP:
+					if (pushDepth > 0) global = pushed[--pushDepth];
+					break;
+				default: break;
+			}
+			continue;
+		}
+
+		if (type == HID_ITEM_TYPE_LOCAL) {
+			// Usages shorter than 4 bytes take the current usage page
+			const uint32_t usage = (size == 4) ? itemUnsigned(data, size) : HID_USAGE(global.usagePage, itemUnsigned(data, size));
+			switch (tag) {
+				case HID_LOCAL_USAGE:
+					if (usageCount < HID_PLAN_MAX_USAGES) usages[usageCount++] = usage;
+					break;
+				case HID_LOCAL_USAGE_MIN: usageMin = usage; hasUsageRange = true; break;
+				case HID_LOCAL_USAGE_MAX: usageMax = usage; hasUsageRange = true; break;
+				default: break;
+			}
+			continue;
+		}
+
+		if (type != HID_ITEM_TYPE_MAIN)
+			continue;
+
+		if (tag == HID_MAIN_COLLECTION) {
+			collectionDepth++;
+			if (gamepadDepth == 0 && size > 0 && data[0] == HID_COLLECTION_APPLICATION && usageCount > 0) {
+				switch (usages[0]) {
+					case HID_USAGE(HID_USAGE_PAGE_DESKTOP, 0x04): // Joystick
+					case HID_USAGE(HID_USAGE_PAGE_DESKTOP, 0x05): // Gamepad
+					case HID_USAGE(HID_USAGE_PAGE_DESKTOP, 0x08): // Multi-axis controller
+						gamepadDepth = collectionDepth;
+						break;
+					default:
+						break;
+				}
+			}
+		} else if (tag == HID_MAIN_END_COLLECTION) {
+			if (collectionDepth == gamepadDepth)
+				gamepadDepth = 0;
+			if (collectionDepth > 0)
+				collectionDepth--;
+		} else if (tag == HID_MAIN_INPUT) {
+			uint8_t report = 0;
+			while (report < reportCount && reports[report].id != global.reportId)
+				report++;
+			if (report == reportCount && reportCount < HID_PLAN_MAX_REPORTS)
+				reports[reportCount++] = { global.reportId, 0 };
+
+			if (report < reportCount) {
+				const uint32_t flags = itemUnsigned(data, size);
+				if (!(flags & HID_INPUT_CONSTANT) && (flags & HID_INPUT_VARIABLE) && global.reportSize > 0) {
+					for (uint32_t i = 0; i < global.reportCount; i++) {
+						uint32_t usage = 0;
+						if (usageCount > 0)
+							usage = usages[(i < usageCount) ? i : (usageCount - 1)];
+						else if (hasUsageRange && usageMin + i <= usageMax)
+							usage = usageMin + i;
+						const uint32_t bitOffset = reports[report].bits + i * global.reportSize;
+						if (usage == 0 || bitOffset + global.reportSize > UINT16_MAX)
+							continue;
+
+						HIDReportItem item;
+						item.usage = usage;
+						item.logicalMin = global.logicalMin;
+						item.logicalMax = global.logicalMax;
+						item.bitOffset = bitOffset;
+						item.bitSize = (global.reportSize > 0xFF) ? 0xFF : global.reportSize;
+						item.reportId = global.reportId;
+						item.inGamepad = gamepadDepth != 0;
+						onInput(item);
+					}
+				}
+				reports[report].bits += global.reportSize * global.reportCount;
+			}
+		}
+
+		// Local items only apply to the main item that follows them
+		usageCount = 0;
+		usageMin = 0;
+		usageMax = 0;
+		hasUsageRange = false;
+	}
+}
+
+bool HIDReportPlan::addField(const HIDReportField & field) {
+	bool merged = false;
+	if (fieldCount > 0 && (field.target == HID_REPORT_TARGET_BUTTONS || field.target == HID_REPORT_TARGET_DPAD)) {
+		// Extend the previous run when both the report bits and the gamepad bits continue it
+		HIDReportField & last = fields[fieldCount - 1];
+		if (last.target == field.target && field.bitSize == 1 &&
+			last.bitOffset + last.bitSize == field.bitOffset &&
+			last.bitShift + last.bitSize == field.bitShift &&
+			last.bitSize < HID_REPORT_PLAN_MAX_BITS) {
+			last.bitSize++;
+			merged = true;
+		}
+	}
+
+	if (!merged) {
+		if (fieldCount >= HID_REPORT_PLAN_MAX_FIELDS)
+			return false;
+		fields[fieldCount++] = field;
+	}
+
+	// A merged run now ends where the new bit does, so the field's own end covers both cases
+	const uint16_t bytes = (field.bitOffset + field.bitSize + 7) / 8;
+	if (bytes > reportBytes)
+		reportBytes = bytes;
+	return true;
+}
+
+bool HIDReportPlan::compile(const uint8_t * descriptor, uint16_t length) {
+	fieldCount = 0;
+	reportId = 0;
+	reportBytes = 0;
+	if (descriptor == nullptr || length == 0)
+		return false;
+
+	// First pass: pick the input report that looks most like a gamepad
+	struct { uint8_t id; uint16_t score; uint32_t kinds; bool inGamepad; } candidates[HID_PLAN_MAX_REPORTS] = {};
+	uint8_t candidateCount = 0;
+	walkInputs(descriptor, length, [&](const HIDReportItem & item) {
+		const HIDUsageKind kind = usageKind(item.usage);
+		if (kind == HID_USAGE_KIND_NONE)
+			return;
+		uint8_t candidate = 0;
+		while (candidate < candidateCount && candidates[candidate].id != item.reportId)
+			candidate++;
+		if (candidate == candidateCount) {
+			if (candidateCount == HID_PLAN_MAX_REPORTS)
+				return;
+			candidates[candidateCount++] = { item.reportId, 0, 0, false };
+		}
+		candidates[candidate].score += item.inGamepad ? 0x100 : 1;
+		candidates[candidate].inGamepad |= item.inGamepad;
+		candidates[candidate].kinds |= HID_USAGE_KIND_BIT(kind);
+	});
+	if (candidateCount == 0)
+		return false;
+
+	uint8_t best = 0;
+	for (uint8_t candidate = 1; candidate < candidateCount; candidate++) {
+		if (candidates[candidate].score > candidates[best].score)
+			best = candidate;
+	}
+	// Only reports inside a gamepad application collection are planned, mice and keyboards are left alone
+	if (!candidates[best].inGamepad)
+		return false;
+	const uint8_t plannedId = candidates[best].id;
+	const uint32_t kinds = candidates[best].kinds;
+
+	// Axis layout: Z/Rz is the right stick when both are there (Rx/Ry then being triggers), else Rx/Ry is
+	const bool zRightStick = (kinds & HID_USAGE_KIND_BIT(HID_USAGE_KIND_Z)) && (kinds & HID_USAGE_KIND_BIT(HID_USAGE_KIND_RZ));
+	const bool hasBrake = kinds & HID_USAGE_KIND_BIT(HID_USAGE_KIND_BRAKE);
+	const bool hasAccelerator = kinds & HID_USAGE_KIND_BIT(HID_USAGE_KIND_ACCELERATOR);
+	uint32_t plannedAxes = 0;
+
+	// Second pass: compile the fields of that report
+	walkInputs(descriptor, length, [&](const HIDReportItem & item) {
+		if (item.reportId != plannedId || item.bitSize == 0 || item.bitSize > HID_REPORT_PLAN_MAX_BITS)
+			return;
+
+		HIDReportField field = {};
+		field.bitOffset = item.bitOffset;
+		field.bitSize = item.bitSize;
+		field.logicalMin = item.logicalMin;
+		field.isSigned = item.logicalMin < 0;
+		field.range = (item.logicalMax > item.logicalMin) ? (uint32_t)(item.logicalMax - item.logicalMin) : 0;
+
+		uint32_t outputRange = 0;
+		switch (usageKind(item.usage)) {
+			case HID_USAGE_KIND_BUTTON: {
+				if (item.bitSize != 1)
+					return;
+				const uint8_t button = (item.usage & 0xFFFF) - 1;
+				field.target = (button >= HID_BUTTON_DPAD_FIRST && button <= HID_BUTTON_DPAD_LAST) ? HID_REPORT_TARGET_DPAD : HID_REPORT_TARGET_BUTTONS;
+				field.bitShift = bitLength(hidButtonMasks[button]) - 1;
+				addField(field);
+				return;
+			}
+			case HID_USAGE_KIND_DPAD_UP:
+			case HID_USAGE_KIND_DPAD_DOWN:
+			case HID_USAGE_KIND_DPAD_RIGHT:
+			case HID_USAGE_KIND_DPAD_LEFT: {
+				static const uint8_t dpadMasks[] = { GAMEPAD_MASK_UP, GAMEPAD_MASK_DOWN, GAMEPAD_MASK_RIGHT, GAMEPAD_MASK_LEFT };
+				if (item.bitSize != 1)
+					return;
+				field.target = HID_REPORT_TARGET_DPAD;
+				field.bitShift = bitLength(dpadMasks[usageKind(item.usage) - HID_USAGE_KIND_DPAD_UP]) - 1;
+				addField(field);
+				return;
+			}
+			case HID_USAGE_KIND_HAT:
+				if (field.range != 3 && field.range != 7)
+					return;
+				field.target = HID_REPORT_TARGET_HAT;
+				addField(field);
+				return;
+			case HID_USAGE_KIND_X:  field.target = HID_REPORT_TARGET_LX; break;
+			case HID_USAGE_KIND_Y:  field.target = HID_REPORT_TARGET_LY; break;
+			case HID_USAGE_KIND_Z:
+				if (!zRightStick) return;
+				field.target = HID_REPORT_TARGET_RX;
+				break;
+			case HID_USAGE_KIND_RZ:
+				if (!zRightStick) return;
+				field.target = HID_REPORT_TARGET_RY;
+				break;
+			case HID_USAGE_KIND_RX:
+				if (zRightStick && hasBrake) return;
+				field.target = zRightStick ? HID_REPORT_TARGET_LT : HID_REPORT_TARGET_RX;
+				break;
+			case HID_USAGE_KIND_RY:
+				if (zRightStick && hasAccelerator) return;
+				field.target = zRightStick ? HID_REPORT_TARGET_RT : HID_REPORT_TARGET_RY;
+				break;
+			case HID_USAGE_KIND_BRAKE:       field.target = HID_REPORT_TARGET_LT; break;
+			case HID_USAGE_KIND_ACCELERATOR: field.target = HID_REPORT_TARGET_RT; break;
+			default:
+				return;
+		}
+
+		// Axes: the first usage for a target wins, the logical range is scaled onto the gamepad's
+		if (field.range == 0 || (plannedAxes & (1U << field.target)))
+			return;
+		outputRange = (field.target == HID_REPORT_TARGET_LT || field.target == HID_REPORT_TARGET_RT) ?
+			(GAMEPAD_TRIGGER_MAX - GAMEPAD_TRIGGER_MIN) : (GAMEPAD_JOYSTICK_MAX - GAMEPAD_JOYSTICK_MIN);
+		field.bitShift = 32 - bitLength(outputRange);
+		field.scale = ((uint64_t)outputRange << field.bitShift) / field.range;
+		if (addField(field))
+			plannedAxes |= (1U << field.target);
+	});
+
+	if (fieldCount == 0)
+		return false;
+	reportId = plannedId;
+	return true;
+}
+
+static inline uint32_t readBits(const uint8_t * data, uint16_t bitOffset, uint8_t bitSize) {
+	const uint8_t * bytes = &data[bitOffset >> 3];
+	const uint8_t shift = bitOffset & 0x07;
+	const uint8_t byteCount = (shift + bitSize + 7) >> 3;
+	uint32_t value = bytes[0];
+	for (uint8_t i = 1; i < byteCount; i++)
+		value |= (uint32_t)bytes[i] << (8 * i);
+	return (value >> shift) & ((1U << bitSize) - 1);
+}
+
+bool HIDReportPlan::decode(const uint8_t * report, uint16_t length, GamepadState & state) const {
+	if (fieldCount == 0)
+		return false;
+	if (reportId != 0) {
+		if (length == 0 || report[0] != reportId)
+			return false;
+		report++;
+		length--;
+	}
+	if (length < reportBytes)
+		return false;
+
+	uint32_t buttons = 0;
+	uint8_t dpad = 0;
+	for (uint8_t i = 0; i < fieldCount; i++) {
+		const HIDReportField & field = fields[i];
+		const uint32_t raw = readBits(report, field.bitOffset, field.bitSize);
+		switch (field.target) {
+			case HID_REPORT_TARGET_BUTTONS:
+				buttons |= raw << field.bitShift;
+				continue;
+			case HID_REPORT_TARGET_DPAD:
+				dpad |= raw << field.bitShift;
+				continue;
+			case HID_REPORT_TARGET_HAT: {
+				// Out of range is the null state, centered
+				const uint32_t position = raw - field.logicalMin;
+				if (position <= field.range)
+					dpad |= hidHatDpad[(field.range == 3) ? (position * 2) : position];
+				continue;
+			}
+			default:
+				break;
+		}
+
+		int32_t value = raw;
+		if (field.isSigned && (raw & (1U << (field.bitSize - 1))))
+			value = (int32_t)(raw | ~((1U << field.bitSize) - 1));
+		value -= field.logicalMin;
+		if (value < 0)
+			value = 0;
+		else if ((uint32_t)value > field.range)
+			value = field.range;
+		const uint32_t scaled = ((uint32_t)value * field.scale) >> field.bitShift;
+
+		switch (field.target) {
+			case HID_REPORT_TARGET_LX: state.lx = scaled; break;
+			case HID_REPORT_TARGET_LY: state.ly = scaled; break;
+			case HID_REPORT_TARGET_RX: state.rx = scaled; break;
+			case HID_REPORT_TARGET_RY: state.ry = scaled; break;
+			case HID_REPORT_TARGET_LT: state.lt = scaled; break;
+			case HID_REPORT_TARGET_RT: state.rt = scaled; break;
+			default: break;
+		}
+	}
+
+	state.buttons = buttons;
+	state.dpad = dpad;
+	return true;
+}
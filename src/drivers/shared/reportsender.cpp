@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#include "drivers/shared/reportsender.h"
+#include "latencytracker.h"
+
+#include <new>
+#include <string.h>
+
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "tusb.h"
+
+#define REPORT_SENDER_STATS_MAGIC 0x52505453
+
+struct ReportSenderStats {
+	uint32_t magic;
+	ReportSenderCounters modes[REPORT_SENDER_MODES + 1];   // The last one counts a boot in an untracked mode
+};
+
+// Raw storage so static initialization does not clear what the last boot counted
+static uint8_t __uninitialized_ram(reportSenderStatsStorage)[sizeof(ReportSenderStats)] __attribute__((aligned(4)));
+static uint8_t counterMode = REPORT_SENDER_MODES;
+
+static inline ReportSenderCounters& counters() {
+	return reinterpret_cast<ReportSenderStats*>(reportSenderStatsStorage)->modes[counterMode];
+}
+
+static inline bool sameReport(const uint8_t * a, uint16_t sizeA, const uint8_t * b, uint16_t sizeB, uint16_t offset) {
+	return (sizeA == sizeB) && (sizeA <= offset || memcmp(a + offset, b + offset, sizeA - offset) == 0);
+}
+
+void ReportSender::initCounters(InputMode mode) {
+	// Keep the counts of a previous boot (e.g. gamepad mode before rebooting into web config)
+	if (reinterpret_cast<ReportSenderStats*>(reportSenderStatsStorage)->magic != (REPORT_SENDER_STATS_MAGIC ^ sizeof(ReportSenderStats)))
+		resetCounters();
+	counterMode = (mode < REPORT_SENDER_MODES) ? mode : REPORT_SENDER_MODES;
+}
+
+void ReportSender::resetCounters() {
+	ReportSenderStats* stats = new (reportSenderStatsStorage) ReportSenderStats();
+	stats->magic = REPORT_SENDER_STATS_MAGIC ^ sizeof(ReportSenderStats);
+}
+
+const ReportSenderCounters& ReportSender::getCounters(InputMode mode) {
+	return reinterpret_cast<const ReportSenderStats*>(reportSenderStatsStorage)->modes[(mode < REPORT_SENDER_MODES) ? mode : REPORT_SENDER_MODES];
+}
+
+void ReportSender::init(TransmitFunction transmitFunction) {
+	transmit = transmitFunction;
+	lastSize = 0;
+	pending = false;
+	lastChangeMs = to_ms_since_boot(get_absolute_time());
+	lastTransmitMs = lastChangeMs;
+}
+
+bool ReportSender::send(const void * report, uint16_t size) {
+	if (size > REPORT_SENDER_MAX_SIZE)
+		size = REPORT_SENDER_MAX_SIZE;
+
+	uint32_t now = to_ms_since_boot(get_absolute_time());
+	const uint8_t * data = (const uint8_t *)report;
+
+	if (sameReport(data, size, lastReport, lastSize, compareOffset)) {
+		// Back to what the host already has, whatever was pending never needs to go out
+		if (pending) {
+			pending = false;
+			counters().dropped++;
+		}
+		return false;
+	}
+
+	lastChangeMs = now;
+	if (!pending || !sameReport(data, size, pendingReport, pendingSize, 0)) {
+		if (pending)
+			counters().coalesced++;
+		memcpy(pendingReport, data, size);
+		pendingSize = size;
+		pending = true;
+	}
+
+	if (frameAligned) {
+		// tud_sof_cb can only be enabled once the device stack is up
+		if (!frameCallbackEnabled) {
+			tud_sof_cb_enable(true);
+			frameCallbackEnabled = true;
+		}
+		return false;
+	}
+
+	return transmitPending(now);
+}
+
+void ReportSender::onFrame() {
+	if (pending)
+		transmitPending(to_ms_since_boot(get_absolute_time()));
+}
+
+bool ReportSender::repeat() {
+	if (!pending) {
+		if (lastSize == 0)
+			return false;
+		memcpy(pendingReport, lastReport, lastSize);
+		pendingSize = lastSize;
+		pending = true;
+	}
+
+	if (frameAligned)
+		return false;
+
+	return transmitPending(to_ms_since_boot(get_absolute_time()));
+}
+
+void ReportSender::markTransmit() {
+	lastTransmitMs = to_ms_since_boot(get_absolute_time());
+	lastChangeMs = lastTransmitMs;
+}
+
+bool ReportSender::keepaliveDue() const {
+	return keepaliveMs != 0 && (to_ms_since_boot(get_absolute_time()) - lastChangeMs) > keepaliveMs;
+}
+
+bool ReportSender::transmitHID(const uint8_t * report, uint16_t size) {
+	return tud_hid_ready() && tud_hid_report(0, report, size);
+}
+
+bool ReportSender::transmitPending(uint32_t nowMs) {
+	if (minIntervalMs != 0 && (nowMs - lastTransmitMs) <= minIntervalMs)
+		return false;
+
+	if (!transmit || !transmit(pendingReport, pendingSize))
+		return false;
+
+	memcpy(lastReport, pendingReport, pendingSize);
+	lastSize = pendingSize;
+	pending = false;
+	lastTransmitMs = nowMs;
+	lastChangeMs = nowMs;
+	counters().sent++;
+	LATENCY_TRACK_REPORT_SENT();
+	return true;
+}
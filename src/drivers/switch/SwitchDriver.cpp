@@ -1,5 +1,23 @@
 #include "drivers/switch/SwitchDriver.h"
 #include "drivers/shared/driverhelper.h"
+#include "gamepad/GamepadReportPacker.h"
+
+static constexpr GamepadReportBit switchButtonBits[] = {
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B1, SWITCH_MASK_B       },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B2, SWITCH_MASK_A       },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B3, SWITCH_MASK_Y       },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B4, SWITCH_MASK_X       },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L1, SWITCH_MASK_L       },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R1, SWITCH_MASK_R       },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L2, SWITCH_MASK_ZL      },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R2, SWITCH_MASK_ZR      },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1, SWITCH_MASK_MINUS   },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2, SWITCH_MASK_PLUS    },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3, SWITCH_MASK_L3      },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3, SWITCH_MASK_R3      },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A1, SWITCH_MASK_HOME    },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A2, SWITCH_MASK_CAPTURE },
+};
 
 void SwitchDriver::initialize() {
 	switchReport = {
@@ -23,6 +41,8 @@ void SwitchDriver::initialize() {
 		.xfer_cb = hidd_xfer_cb,
 		.sof = NULL
 	};
+
+	reportSender.init(ReportSender::transmitHID);
 }
 
 bool SwitchDriver::process(Gamepad * gamepad) {
@@ -39,22 +59,7 @@ bool SwitchDriver::process(Gamepad * gamepad) {
 		default:                                     switchReport.hat = SWITCH_HAT_NOTHING;   break;
 	}
 
-	switchReport.buttons = 0
-		| (gamepad->pressedB1() ? SWITCH_MASK_B       : 0)
-		| (gamepad->pressedB2() ? SWITCH_MASK_A       : 0)
-		| (gamepad->pressedB3() ? SWITCH_MASK_Y       : 0)
-		| (gamepad->pressedB4() ? SWITCH_MASK_X       : 0)
-		| (gamepad->pressedL1() ? SWITCH_MASK_L       : 0)
-		| (gamepad->pressedR1() ? SWITCH_MASK_R       : 0)
-		| (gamepad->pressedL2() ? SWITCH_MASK_ZL      : 0)
-		| (gamepad->pressedR2() ? SWITCH_MASK_ZR      : 0)
-		| (gamepad->pressedS1() ? SWITCH_MASK_MINUS   : 0)
-		| (gamepad->pressedS2() ? SWITCH_MASK_PLUS    : 0)
-		| (gamepad->pressedL3() ? SWITCH_MASK_L3      : 0)
-		| (gamepad->pressedR3() ? SWITCH_MASK_R3      : 0)
-		| (gamepad->pressedA1() ? SWITCH_MASK_HOME    : 0)
-		| (gamepad->pressedA2() ? SWITCH_MASK_CAPTURE : 0)
-	;
+	switchReport.buttons = GamepadReportPacker<switchButtonBits>::pack(gamepad->state);
 
 	switchReport.lx = static_cast<uint8_t>(gamepad->state.lx >> 8);
 	switchReport.ly = static_cast<uint8_t>(gamepad->state.ly >> 8);
@@ -67,14 +72,7 @@ bool SwitchDriver::process(Gamepad * gamepad) {
 
 	void * report = &switchReport;
 	uint16_t report_size = sizeof(switchReport);
-	if (memcmp(last_report, report, report_size) != 0) {
-		// HID ready + report sent, copy previous report
-		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
-			memcpy(last_report, report, report_size);
-			return true;
-		}
-	}
-	return false;
+	return reportSender.send(report, report_size);
 }
 
 // tud_hid_get_report_cb
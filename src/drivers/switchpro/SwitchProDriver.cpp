@@ -1,6 +1,7 @@
 #include "drivers/switchpro/SwitchProDriver.h"
 #include "drivers/shared/driverhelper.h"
 #include "storagemanager.h"
+#include "latencytracker.h"
 #include "pico/rand.h"
 
 // force a report to be sent every X ms
@@ -72,6 +73,19 @@ void SwitchProDriver::initialize() {
 
     last_report_timer = to_ms_since_boot(get_absolute_time());
 
+    // The timestamp is stamped on the way out, so unchanged inputs compare equal and go out as keepalive repeats
+    reportSender.init([this](const uint8_t * inputReport, uint16_t size) {
+        SwitchProReport stamped;
+        memcpy(&stamped, inputReport, size);
+        stamped.timestamp = last_report_counter;
+        if ( !tud_hid_ready() || sendReport(0, &stamped, size) == false )
+            return false;
+        last_report_timer = to_ms_since_boot(get_absolute_time());
+        return true;
+    });
+    reportSender.setMinInterval(SWITCH_PRO_KEEPALIVE_TIMER);
+    reportSender.setKeepalive(SWITCH_PRO_KEEPALIVE_TIMER);
+
     factoryConfig->leftStickCalibration.getRealMin(leftMinX, leftMinY);
     factoryConfig->leftStickCalibration.getCenter(leftCenX, leftCenY);
     factoryConfig->leftStickCalibration.getRealMax(leftMaxX, leftMaxY);
@@ -146,6 +160,7 @@ bool SwitchProDriver::process(Gamepad * gamepad) {
             }
             isReportQueued = false;
             last_report_timer = now;
+            reportSender.markTransmit();
         }
         reportSent = true;
     }
@@ -156,20 +171,10 @@ bool SwitchProDriver::process(Gamepad * gamepad) {
     processedGamepad->auxState.playerID.value = playerID;
 
     if (isReady && !reportSent) {
-        if ((now - last_report_timer) > SWITCH_PRO_KEEPALIVE_TIMER) {
-            switchReport.timestamp = last_report_counter;
-            void * inputReport = &switchReport;
-            uint16_t report_size = sizeof(switchReport);
-            if (memcmp(last_report, inputReport, report_size) != 0) {
-                // HID ready + report sent, copy previous report
-                if (tud_hid_ready() && sendReport(0, inputReport, report_size) == true ) {
-                    memcpy(last_report, inputReport, report_size);
-                    reportSent = true;
-                }
-
-                last_report_timer = now;
-            }
-        }
+        // Only changes go out, and the last report again every keepalive interval
+        reportSent = reportSender.send(&switchReport, sizeof(switchReport));
+        if (!reportSent && reportSender.keepaliveDue())
+            reportSent = reportSender.repeat();
     } else {
         if (!isInitialized) {
             // send identification
@@ -69,14 +69,16 @@ void XBOneAuthUSBListener::process() {
 
 }
 
-void XBOneAuthUSBListener::xmount(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype) {
+bool XBOneAuthUSBListener::xmount(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype) {
     if ( controllerType == xinput_type_t::XBOXONE) {
         xbone_dev_addr = dev_addr;
         xbone_instance = instance;
         incomingXGIP.reset();
         outgoingXGIP.reset();
         mounted = true;
+        return true;
     }
+    return false;
 }
 
 void XBOneAuthUSBListener::unmount(uint8_t dev_addr) {
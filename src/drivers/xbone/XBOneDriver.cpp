@@ -4,6 +4,7 @@
 #include "drivers/xbone/XBOneAuth.h"
 #include "peripheralmanager.h"
 #include "storagemanager.h"
+#include "latencytracker.h"
 
 #define XBONE_KEEPALIVE_TIMER 15000
 
@@ -243,6 +244,9 @@ bool xbone_vendor_control_xfer_cb(uint8_t rhport, uint8_t stage,
 
 bool xbone_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result,
                      uint32_t xferred_bytes) {
+    if (tu_edpt_dir(ep_addr) == TUSB_DIR_IN)
+        LATENCY_TRACK_REPORT_COMPLETE();
+
     // Do nothing if we couldn't setup our auth listener
     if ( xboxOneAuthData == nullptr || incomingXGIP == nullptr ||
             outgoingXGIP == nullptr) {
@@ -353,12 +357,21 @@ void XBOneDriver::initialize() {
         .sof = NULL
     };
 
-    keep_alive_timer = to_ms_since_boot(get_absolute_time());
     keep_alive_sequence = 1; // sequence starts at 1?
     virtual_keycode_sequence = 0;
     xb1_guide_pressed = false;
     last_report_counter = 0;
 
+    // Input reports are compared without the GIP header, the sequence only moves once a report went out
+    reportSender.init([this](const uint8_t * report, uint16_t size) {
+        if ( send_xbone_usb(report, size) == false )
+            return false;
+        last_report_counter = ((const GipHeader_t *)report)->sequence;
+        return true;
+    });
+    reportSender.setCompareOffset(sizeof(GipHeader_t));
+    reportSender.setKeepalive(XBONE_KEEPALIVE_TIMER);
+
     incomingXGIP = new XGIPProtocol();
     outgoingXGIP = new XGIPProtocol();
 
@@ -413,9 +426,8 @@ bool XBOneDriver::process(Gamepad * gamepad) {
         return true;
     }
 
-    uint32_t now = to_ms_since_boot(get_absolute_time());
-    // Send Keep-Alive every 15 seconds (keep_alive_timer updates if send is successful)
-    if ( (now - keep_alive_timer) > XBONE_KEEPALIVE_TIMER) {
+    // Send Keep-Alive after 15 seconds without a report (the sender's timer restarts if send is successful)
+    if ( reportSender.keepaliveDue() ) {
         memset(&xboneReport.Header, 0, sizeof(GipHeader_t));
         GIP_HEADER((&xboneReport), GIP_KEEPALIVE, 1, keep_alive_sequence);
         xboneReport.Header.length = 4;
@@ -424,7 +436,7 @@ bool XBOneDriver::process(Gamepad * gamepad) {
         xboneReportSize = sizeof(GipHeader_t) + sizeof(keepAlive);
         // If successful, update our keep alive timer/sequence
         if ( send_xbone_usb((uint8_t*)&xboneReport, xboneReportSize) == true ) {
-            keep_alive_timer = to_ms_since_boot(get_absolute_time());
+            reportSender.markTransmit();
             keep_alive_sequence++; // will rollover
             if ( keep_alive_sequence == 0 )
                 keep_alive_sequence = 1;
@@ -459,16 +471,19 @@ bool XBOneDriver::process(Gamepad * gamepad) {
             // On success, update our guide pressed state and virtual key code state
             virtual_keycode_sequence = new_sequence;
             xb1_guide_pressed = !xb1_guide_pressed;
+            reportSender.markTransmit();
         }
         return true;
     }
 
-    // Only change xbox one input report if we have different inputs!
+    // The sender only sends the input report if we have different inputs!
     XboxOneGamepad_Data_t newInputReport;
 
-    // This is due to our tusb_driver.cpp checking memcmp(last_report, report, size)
+    // Cleared so that padding compares equal
     memset(&newInputReport, 0, sizeof(XboxOneGamepad_Data_t));
-    GIP_HEADER((&newInputReport), GIP_INPUT_REPORT, false, last_report_counter);
+    GIP_HEADER((&newInputReport), GIP_INPUT_REPORT, false, last_report_counter + 1);
+    if ( newInputReport.Header.sequence == 0 )
+        newInputReport.Header.sequence = 1;
 
     newInputReport.a = gamepad->pressedB1();
     newInputReport.b = gamepad->pressedB2();
@@ -503,27 +518,7 @@ bool XBOneDriver::process(Gamepad * gamepad) {
         newInputReport.rightTrigger = gamepad->pressedR2() ? 0x03FF : 0;
     }
 
-    // We changed inputs since generating our last report, increment last report counter (but don't update until success)
-    if ( memcmp(&last_report[4], &((uint8_t*)&newInputReport)[4], sizeof(XboxOneGamepad_Data_t)-4) != 0 ) {
-        xboneReportSize = sizeof(XboxOneGamepad_Data_t);
-        memcpy(&xboneReport, &newInputReport, xboneReportSize);
-        xboneReport.Header.sequence = last_report_counter + 1;
-        if ( xboneReport.Header.sequence == 0 )
-            xboneReport.Header.sequence = 1;
-
-        // Successfully sent report, actually increment last report counter!
-        if ( send_xbone_usb((uint8_t*)&xboneReport, xboneReportSize) == true ) {
-            if ( memcmp(&last_report[4], &((uint8_t*)&xboneReport)[4], xboneReportSize-4) != 0) {
-                last_report_counter++;
-                if (last_report_counter == 0)
-                    last_report_counter = 1;
-                memcpy(last_report, &xboneReport, xboneReportSize);
-                return true;
-            }
-        }
-    }
-    
-    return false;
+    return reportSender.send(&newInputReport, sizeof(XboxOneGamepad_Data_t));
 }
 
 void XBOneDriver::processAux() {
@@ -689,7 +684,6 @@ void XBOneDriver::update() {
 void XBOneDriver::process_report_queue(uint32_t now) {
     if ( !report_queue.empty() && (now - lastReportQueue) > REPORT_QUEUE_INTERVAL ) {
         if ( send_xbone_usb(report_queue.front().report, report_queue.front().len) ) {
-            memcpy(last_report, &report_queue.front().report, report_queue.front().len);
             report_queue.pop();
             lastReportQueue = now;
         } else {
@@ -1,6 +1,18 @@
 #include "drivers/xboxog/XboxOriginalDriver.h"
 #include "drivers/xboxog/xid/xid.h"
 #include "drivers/shared/driverhelper.h"
+#include "gamepad/GamepadReportPacker.h"
+
+static constexpr GamepadReportBit xboxOriginalButtonBits[] = {
+	{ GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_UP,    XID_DUP    },
+	{ GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_DOWN,  XID_DDOWN  },
+	{ GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_LEFT,  XID_DLEFT  },
+	{ GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_RIGHT, XID_DRIGHT },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2,    XID_START  },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1,    XID_BACK   },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3,    XID_LS     },
+	{ GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3,    XID_RS     },
+};
 
 void XboxOriginalDriver::initialize() {
     xboxOriginalReport = {
@@ -21,20 +33,15 @@ void XboxOriginalDriver::initialize() {
 
     // Copy XID driver to local class driver
     memcpy(&class_driver, xid_get_driver(), sizeof(usbd_class_driver_t));
+
+    reportSender.init([](const uint8_t * report, uint16_t size) {
+        return xid_send_report(xid_get_index_by_type(0, XID_TYPE_GAMECONTROLLER), (void *)report, size);
+    });
 }
 
 bool XboxOriginalDriver::process(Gamepad * gamepad) {
 	// digital buttons
-	xboxOriginalReport.dButtons = 0
-		| (gamepad->pressedUp()    ? XID_DUP    : 0)
-		| (gamepad->pressedDown()  ? XID_DDOWN  : 0)
-		| (gamepad->pressedLeft()  ? XID_DLEFT  : 0)
-		| (gamepad->pressedRight() ? XID_DRIGHT : 0)
-		| (gamepad->pressedS2()    ? XID_START  : 0)
-		| (gamepad->pressedS1()    ? XID_BACK   : 0)
-		| (gamepad->pressedL3()    ? XID_LS     : 0)
-		| (gamepad->pressedR3()    ? XID_RS     : 0)
-	;
+	xboxOriginalReport.dButtons = GamepadReportPacker<xboxOriginalButtonBits>::pack(gamepad->state);
 
     // analog buttons - convert to digital
     xboxOriginalReport.A     = (gamepad->pressedB1() ? 0xFF : 0);
@@ -62,14 +69,8 @@ bool XboxOriginalDriver::process(Gamepad * gamepad) {
 	if (tud_suspended())
 		tud_remote_wakeup();
 
-    bool reportSent = false;
     uint8_t xIndex = xid_get_index_by_type(0, XID_TYPE_GAMECONTROLLER);
-	if (memcmp(last_report, &xboxOriginalReport, sizeof(XboxOriginalReport)) != 0) {
-        if ( xid_send_report(xIndex, &xboxOriginalReport, sizeof(XboxOriginalReport)) == true ) {
-            memcpy(last_report, &xboxOriginalReport, sizeof(XboxOriginalReport));
-            reportSent = true;
-        }
-    }
+    bool reportSent = reportSender.send(&xboxOriginalReport, sizeof(XboxOriginalReport));
 
     if (xid_get_report(xIndex, &xboxOriginalReportOut, sizeof(xboxOriginalReportOut)))
     {
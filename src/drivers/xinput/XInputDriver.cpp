@@ -5,7 +5,9 @@
 
 #include "drivers/xinput/XInputDriver.h"
 #include "drivers/shared/driverhelper.h"
+#include "gamepad/GamepadReportPacker.h"
 #include "storagemanager.h"
+#include "latencytracker.h"
 
 #define USB_SETUP_DEVICE_TO_HOST 0x80
 #define USB_SETUP_HOST_TO_DEVICE 0x00
@@ -26,6 +28,27 @@
 #define XINPUT_DESC_TYPE_RESERVED 0x21
 #define XINPUT_SECURITY_DESC_TYPE_RESERVED 0x41
 
+static constexpr GamepadReportBit xinputButtons1Bits[] = {
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_UP,    XBOX_MASK_UP    },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_DOWN,  XBOX_MASK_DOWN  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_LEFT,  XBOX_MASK_LEFT  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_RIGHT, XBOX_MASK_RIGHT },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2,    XBOX_MASK_START },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1,    XBOX_MASK_BACK  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3,    XBOX_MASK_LS    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3,    XBOX_MASK_RS    },
+};
+
+static constexpr GamepadReportBit xinputButtons2Bits[] = {
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L1, XBOX_MASK_LB   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R1, XBOX_MASK_RB   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A1, XBOX_MASK_HOME },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B1, XBOX_MASK_A    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B2, XBOX_MASK_B    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B3, XBOX_MASK_X    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B4, XBOX_MASK_Y    },
+};
+
 static uint8_t endpoint_in = 0;
 static uint8_t endpoint_out = 0;
 static uint8_t xinput_out_buffer[XINPUT_OUT_SIZE] = {};
@@ -119,10 +142,25 @@ static bool xinput_xfer_callback(uint8_t rhport, uint8_t ep_addr, xfer_result_t
 
     if (ep_addr == endpoint_out)
         usbd_edpt_xfer(0, endpoint_out, xinput_out_buffer, XINPUT_OUT_SIZE);
+    else if (ep_addr == endpoint_in)
+        LATENCY_TRACK_REPORT_COMPLETE();
 
     return true;
 }
 
+static bool xinput_transmit_report(const uint8_t * report, uint16_t size)
+{
+    if ( tud_ready() &&											// Is the device ready?
+        (endpoint_in != 0) && (!usbd_edpt_busy(0, endpoint_in)) ) // Is the IN endpoint available?
+    {
+        usbd_edpt_claim(0, endpoint_in);								// Take control of IN endpoint
+        usbd_edpt_xfer(0, endpoint_in, (uint8_t *)report, size);		// Send report buffer
+        usbd_edpt_release(0, endpoint_in);								// Release control of IN endpoint
+        return true;
+    }
+    return false;
+}
+
 void XInputDriver::initialize() {
     xinputReport = {
         .report_id = 0,
@@ -224,6 +262,8 @@ void XInputDriver::initialize() {
         .sof = NULL
     };
 
+    reportSender.init(xinput_transmit_report);
+
     xAuthDriver = nullptr;
     xAuthSent = false;
 }
@@ -254,26 +294,8 @@ bool XInputDriver::process(Gamepad * gamepad) {
     Gamepad * processedGamepad = Storage::getInstance().GetProcessedGamepad();
     Mask_t values = Storage::getInstance().GetGamepad()->debouncedGpio;
 
-    xinputReport.buttons1 = 0
-        | (gamepad->pressedUp()    ? XBOX_MASK_UP    : 0)
-        | (gamepad->pressedDown()  ? XBOX_MASK_DOWN  : 0)
-        | (gamepad->pressedLeft()  ? XBOX_MASK_LEFT  : 0)
-        | (gamepad->pressedRight() ? XBOX_MASK_RIGHT : 0)
-        | (gamepad->pressedS2()    ? XBOX_MASK_START : 0)
-        | (gamepad->pressedS1()    ? XBOX_MASK_BACK  : 0)
-        | (gamepad->pressedL3()    ? XBOX_MASK_LS    : 0)
-        | (gamepad->pressedR3()    ? XBOX_MASK_RS    : 0)
-    ;
-
-    xinputReport.buttons2 = 0
-        | (gamepad->pressedL1() ? XBOX_MASK_LB   : 0)
-        | (gamepad->pressedR1() ? XBOX_MASK_RB   : 0)
-        | (gamepad->pressedA1() ? XBOX_MASK_HOME : 0)
-        | (gamepad->pressedB1() ? XBOX_MASK_A    : 0)
-        | (gamepad->pressedB2() ? XBOX_MASK_B    : 0)
-        | (gamepad->pressedB3() ? XBOX_MASK_X    : 0)
-        | (gamepad->pressedB4() ? XBOX_MASK_Y    : 0)
-    ;
+    xinputReport.buttons1 = GamepadReportPacker<xinputButtons1Bits>::pack(gamepad->state);
+    xinputReport.buttons2 = GamepadReportPacker<xinputButtons2Bits>::pack(gamepad->state);
 
     xinputReport.lx = static_cast<int16_t>(gamepad->state.lx) + INT16_MIN;
     xinputReport.ly = static_cast<int16_t>(~gamepad->state.ly) + INT16_MIN;
@@ -330,20 +352,8 @@ bool XInputDriver::process(Gamepad * gamepad) {
         // assume gamepad if not special cased
     }
 
-    bool reportSent = false;
-
     // compare against previous report and send new
-    if ( memcmp(last_report, &xinputReport, sizeof(XInputReport)) != 0) {
-        if ( tud_ready() &&											// Is the device ready?
-            (endpoint_in != 0) && (!usbd_edpt_busy(0, endpoint_in)) ) // Is the IN endpoint available?
-        {
-            usbd_edpt_claim(0, endpoint_in);								// Take control of IN endpoint
-            usbd_edpt_xfer(0, endpoint_in, (uint8_t *)&xinputReport, sizeof(XInputReport)); // Send report buffer
-            usbd_edpt_release(0, endpoint_in);								// Release control of IN endpoint
-            memcpy(last_report, &xinputReport, sizeof(XInputReport)); // save if we sent it
-            reportSent = true;
-        }
-    }
+    bool reportSent = reportSender.send(&xinputReport, sizeof(XInputReport));
 
     // clear potential initial uncaught data in endpoint_out from before registration of xfer_cb
     if (tud_ready() &&
@@ -2,51 +2,85 @@
 #include "storagemanager.h"
 #include "enums.pb.h"
 
+void* EventQueue::reserve() {
+    uint32_t currHead = head.load(std::memory_order_relaxed);
+    if (currHead - tail.load(std::memory_order_acquire) >= EVENTMGR_QUEUE_SIZE) {
+        dropped++;
+        return nullptr;
+    }
+    return slots[currHead & (EVENTMGR_QUEUE_SIZE - 1)].data;
+}
+
+void EventQueue::commit() {
+    head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+GPEvent* EventQueue::front() {
+    uint32_t currTail = tail.load(std::memory_order_relaxed);
+    if (currTail == head.load(std::memory_order_acquire))
+        return nullptr;
+    return reinterpret_cast<GPEvent*>(slots[currTail & (EVENTMGR_QUEUE_SIZE - 1)].data);
+}
+
+void EventQueue::pop() {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
 void EventManager::init() {
     clearEventHandlers();
 }
 
 void EventManager::registerEventHandler(GPEventType eventType, EventFunction handler) {
-    typename std::vector<EventEntry>::iterator it = std::find_if(eventList.begin(), eventList.end(), [&eventType](const EventEntry& entry) { return entry.first == eventType; });
-
-    if (it != eventList.end()) {
-        // If the event already exists, add the handler to its vector
-        it->second.push_back(handler);
-    } else {
-        // If the event does not exist, create a new entry with the handler
-        eventList.emplace_back(eventType, std::vector<EventFunction>{handler});
-    }
+    if (eventType < 0 || eventType >= _GPEventType_ARRAYSIZE)
+        return;
+
+    eventHandlers[eventType].push_back(handler);
 }
 
 void EventManager::unregisterEventHandler(GPEventType eventType, EventFunction handler) {
-    typename std::vector<EventEntry>::iterator it = std::find_if(eventList.begin(), eventList.end(), [&eventType](const EventEntry& entry) { return entry.first == eventType; });
-
-    // Verify we have this event in our pair list
-    if (it != eventList.end()) {
-        // Verify we have this function in our function vector
-        for(std::vector<EventFunction>::iterator funcIt = it->second.begin(); funcIt != it->second.end(); it++){
-            if(*(uint32_t *)(uint8_t *)&handler == *(uint32_t *)(uint8_t *)&(*funcIt)) {
-                it->second.erase(funcIt);
-                break;
-            }
+    if (eventType < 0 || eventType >= _GPEventType_ARRAYSIZE)
+        return;
+
+    // Verify we have this function in our function vector
+    std::vector<EventFunction>& handlers = eventHandlers[eventType];
+    for (std::vector<EventFunction>::iterator funcIt = handlers.begin(); funcIt != handlers.end(); funcIt++) {
+        if(*(uint32_t *)(uint8_t *)&handler == *(uint32_t *)(uint8_t *)&(*funcIt)) {
+            handlers.erase(funcIt);
+            break;
         }
     }
 }
 
-void EventManager::triggerEvent(GPEvent* event) {
+void EventManager::dispatchEvent(GPEvent* event) {
     GPEventType eventType = event->eventType();
-    for (typename std::vector<EventEntry>::const_iterator it = eventList.begin(); it != eventList.end(); ++it) {
-        if (it->first == eventType) {
-            // Call all event handlers for the specified event
-            const std::vector<EventFunction>& handlers = it->second;
-            for (typename std::vector<EventFunction>::const_iterator handler = handlers.begin(); handler != handlers.end(); ++handler) {
-                (*handler)(event);
-            }
-        }
+    if (eventType < 0 || eventType >= _GPEventType_ARRAYSIZE)
+        return;
+
+    // Call all event handlers for the specified event
+    const std::vector<EventFunction>& handlers = eventHandlers[eventType];
+    for (typename std::vector<EventFunction>::const_iterator handler = handlers.begin(); handler != handlers.end(); ++handler) {
+        (*handler)(event);
     }
+}
+
+void EventManager::triggerEvent(GPEvent* event) {
+    dispatchEvent(event);
     delete event;
 }
 
+void EventManager::drainEvents() {
+    // At most one queue's worth per core, so handlers that post events cannot keep us here
+    for (EventQueue& queue : eventQueues) {
+        GPEvent* event;
+        uint32_t pending = EVENTMGR_QUEUE_SIZE;
+        while (pending-- > 0 && (event = queue.front()) != nullptr) {
+            dispatchEvent(event);
+            event->~GPEvent();
+            queue.pop();
+        }
+    }
+}
+
 void EventManager::clearEventHandlers() {
 
 }
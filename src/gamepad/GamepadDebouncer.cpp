@@ -0,0 +1,108 @@
+#include "GamepadDebouncer.h"
+
+/**
+ * @brief Start debouncing from a known state, e.g. after the button GPIO have been (re)initialized.
+ *
+ * @param initialState The debounced state to start from, 1 = active.
+ * @param debounceMode Which transitions are reported eagerly and which are deferred.
+ * @param delayMs The lockout/stability window in milliseconds.
+ * @param nowUs The current time from the 32-bit microsecond timer.
+ */
+void GamepadDebouncer::reset(Mask_t initialState, DebounceMode debounceMode, uint32_t delayMs, uint32_t nowUs)
+{
+	state = initialState;
+	mode = debounceMode;
+	delay = (delayMs > DEBOUNCE_COUNTER_MAX) ? DEBOUNCE_COUNTER_MAX : delayMs;
+	lastUs = nowUs;
+
+	for (uint32_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+		counter[bit] = 0;
+	}
+	loadCounters(~eagerPins(state), delay);
+}
+
+Mask_t GamepadDebouncer::update(Mask_t raw, uint32_t nowUs)
+{
+	if (delay == 0) {
+		state = raw;
+		return state;
+	}
+
+	// only whole milliseconds are taken off the counters, the remainder carries over to the next pass
+	uint32_t elapsedMs = (nowUs - lastUs) / 1000;
+	if (elapsedMs != 0) {
+		lastUs += elapsedMs * 1000;
+		elapseCounters((elapsedMs > DEBOUNCE_COUNTER_MAX) ? DEBOUNCE_COUNTER_MAX : elapsedMs);
+	}
+
+	// any pin that differs and isn't locked out or still settling takes its new level
+	Mask_t eager = eagerPins(state);
+	Mask_t changed = raw ^ state;
+	Mask_t flip = changed & ~activeCounters();
+	state ^= flip;
+
+	// eager edges start their lockout, pins sitting ahead of a deferred edge restart their stability window
+	Mask_t stable = ~(raw ^ state);
+	loadCounters((flip & eager) | (stable & ~eagerPins(state)), delay);
+
+	return state;
+}
+
+/**
+ * @brief Pins whose next transition, away from the given debounced state, is reported eagerly.
+ */
+Mask_t GamepadDebouncer::eagerPins(Mask_t debounced) const
+{
+	switch (mode) {
+		case DEBOUNCE_MODE_EAGER:
+			return ~(Mask_t)0;
+		case DEBOUNCE_MODE_EAGER_PRESS:
+			return ~debounced;
+		case DEBOUNCE_MODE_DEFERRED:
+		default:
+			return 0;
+	}
+}
+
+/**
+ * @brief Pins with a counter that hasn't run out yet.
+ */
+Mask_t GamepadDebouncer::activeCounters() const
+{
+	Mask_t active = 0;
+	for (uint32_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+		active |= counter[bit];
+	}
+	return active;
+}
+
+/**
+ * @brief Set the counters of the given pins to a value, leaving the other pins untouched.
+ */
+void GamepadDebouncer::loadCounters(Mask_t pins, uint32_t value)
+{
+	for (uint32_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+		counter[bit] = (counter[bit] & ~pins) | (((value >> bit) & 1) ? pins : 0);
+	}
+}
+
+/**
+ * @brief Subtract elapsed time from every counter at once, stopping at zero.
+ */
+void GamepadDebouncer::elapseCounters(uint32_t elapsedMs)
+{
+	Mask_t borrow = 0;
+	for (uint32_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+		Mask_t subtrahend = ((elapsedMs >> bit) & 1) ? ~(Mask_t)0 : 0;
+		Mask_t current = counter[bit];
+		counter[bit] = current ^ subtrahend ^ borrow;
+		borrow = (~current & (subtrahend | borrow)) | (subtrahend & borrow);
+	}
+
+	// a borrow out of the top plane means the counter went below zero, clamp those pins to zero
+	if (borrow != 0) {
+		for (uint32_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+			counter[bit] &= ~borrow;
+		}
+	}
+}
@@ -0,0 +1,134 @@
+#include "GamepadHotkeyMatcher.h"
+
+static inline uint32_t highestBit(uint32_t mask)
+{
+	return (mask == 0) ? 0 : (1U << (31 - __builtin_clz(mask)));
+}
+
+void GamepadHotkeyMatcher::clear()
+{
+	entryCount = 0;
+	keyCount = 0;
+	groupCount = 0;
+	gateButtons = 0;
+	gateAux = 0;
+	gateDpad = 0;
+}
+
+/**
+ * @brief Queue a config hotkey for the next compile(), in config slot order.
+ *
+ * @return false if the entry is unassigned or the matcher is full.
+ */
+bool GamepadHotkeyMatcher::add(const HotkeyEntry & entry)
+{
+	// Unassigned, or without any input to hold
+	if (entry.action == HOTKEY_NONE || (entry.buttonsMask == 0 && entry.auxMask == 0 && (entry.dpadMask & 0xFF) == 0))
+		return false;
+
+	if (entryCount >= HOTKEY_MATCHER_MAX_ENTRIES)
+		return false;
+
+	entries[entryCount] = {
+		.buttonsMask = entry.buttonsMask,
+		.auxMask = static_cast<uint16_t>(entry.auxMask),
+		.dpadMask = static_cast<uint8_t>(entry.dpadMask),
+		.slot = entryCount,
+		.action = entry.action,
+	};
+	entryCount++;
+	return true;
+}
+
+/**
+ * @brief Build the group index from the added entries.
+ */
+void GamepadHotkeyMatcher::compile()
+{
+	keyCount = 0;
+	groupCount = 0;
+	gateButtons = 0;
+	gateAux = 0;
+	gateDpad = 0;
+
+	// One group per distinct modifier, remembering the first slot that uses it
+	for (uint8_t i = 0; i < entryCount; i++) {
+		uint8_t g = 0;
+		while (g < groupCount && (groups[g].buttonsMask != entries[i].buttonsMask || groups[g].auxMask != entries[i].auxMask))
+			g++;
+		if (g == groupCount) {
+			groups[groupCount++] = {
+				.buttonsMask = entries[i].buttonsMask,
+				.auxMask = entries[i].auxMask,
+				.first = 0,
+				.count = 0,
+				.slot = entries[i].slot,
+			};
+		}
+	}
+
+	// Most specific modifier first, then slot order
+	auto groupBefore = [](const Group & a, const Group & b) {
+		uint32_t bitsA = __builtin_popcount(a.buttonsMask) + __builtin_popcount(a.auxMask);
+		uint32_t bitsB = __builtin_popcount(b.buttonsMask) + __builtin_popcount(b.auxMask);
+		return (bitsA != bitsB) ? (bitsA > bitsB) : (a.slot < b.slot);
+	};
+	for (uint8_t i = 1; i < groupCount; i++) {
+		Group group = groups[i];
+		uint8_t j = i;
+		for (; j > 0 && groupBefore(group, groups[j - 1]); j--)
+			groups[j] = groups[j - 1];
+		groups[j] = group;
+	}
+
+	for (uint8_t g = 0; g < groupCount; g++) {
+		Group & group = groups[g];
+		group.first = keyCount;
+
+		// Most specific dpad combination first, then slot order
+		for (uint8_t i = 0; i < entryCount; i++) {
+			const Entry & entry = entries[i];
+			if (entry.buttonsMask != group.buttonsMask || entry.auxMask != group.auxMask)
+				continue;
+
+			Key key = { .dpadMask = entry.dpadMask, .group = g, .action = entry.action };
+			uint8_t j = keyCount;
+			for (; j > group.first && __builtin_popcount(key.dpadMask) > __builtin_popcount(keys[j - 1].dpadMask); j--)
+				keys[j] = keys[j - 1];
+			keys[j] = key;
+			keyCount++;
+		}
+		group.count = keyCount - group.first;
+
+		// Gate on a single input every hotkey in the group needs. Aux and the high button bits (function
+		// and extra buttons) are the ones least likely to be held during regular play.
+		if (group.auxMask != 0) {
+			gateAux |= highestBit(group.auxMask);
+		} else if (group.buttonsMask != 0) {
+			gateButtons |= highestBit(group.buttonsMask);
+		} else {
+			for (uint8_t k = group.first; k < keyCount; k++)
+				gateDpad |= highestBit(keys[k].dpadMask);
+		}
+	}
+}
+
+GamepadHotkey GamepadHotkeyMatcher::next(GamepadState & state, uint8_t & cursor) const
+{
+	while (cursor < keyCount) {
+		const Group & group = groups[keys[cursor].group];
+		if ((state.buttons & group.buttonsMask) != group.buttonsMask || (state.aux & group.auxMask) != group.auxMask) {
+			// Modifier not held, none of the group's hotkeys can match
+			cursor = group.first + group.count;
+			continue;
+		}
+
+		const Key & key = keys[cursor++];
+		if ((state.dpad & key.dpadMask) == key.dpadMask) {
+			state.buttons &= ~(group.buttonsMask);
+			state.dpad &= ~(key.dpadMask);
+			return key.action;
+		}
+	}
+	return HOTKEY_NONE;
+}
@@ -44,45 +44,43 @@ uint8_t getMaskFromDirection(DpadDirection direction)
 	return dpadMasks[direction-1];
 }
 
-uint8_t updateDpad(uint8_t dpad, DpadDirection direction)
+/**
+ * @brief Update the press order for one direction and return the most recently pressed direction.
+ */
+uint8_t DpadFilter::updateDpad(uint8_t dpad, DpadDirection direction)
 {
-	static bool inList[] = {false, false, false, false, false}; // correspond to DpadDirection: none, up, down, left, right
-	static list<DpadDirection> dpadList;
+	uint8_t directionMask = getMaskFromDirection(direction);
 
-	if(dpad & getMaskFromDirection(direction))
+	if(dpad & directionMask)
 	{
-		if(!inList[direction])
+		if(!(heldMask & directionMask))
 		{
-			dpadList.push_back(direction);
-			inList[direction] = true;
+			pressOrder[pressCount++] = direction;
+			heldMask |= directionMask;
 		}
 	}
 	else
 	{
-		if(inList[direction])
+		if(heldMask & directionMask)
 		{
-			dpadList.remove(direction);
-			inList[direction] = false;
+			// close the gap, the remaining directions keep their press order
+			uint8_t i = 0;
+			while (pressOrder[i] != direction) i++;
+			for (; i + 1 < pressCount; i++) pressOrder[i] = pressOrder[i + 1];
+			pressCount--;
+			heldMask &= ~directionMask;
 		}
 	}
 
-	if(dpadList.empty()) {
+	if(pressCount == 0) {
 		return 0;
 	}
 	else {
-		return getMaskFromDirection(dpadList.back());
+		return getMaskFromDirection(pressOrder[pressCount - 1]);
 	}
 }
 
-/**
- * @brief Filter diagonals out of the dpad, making the device work as a 4-way lever.
- *
- * The most recent cardinal direction wins.
- *
- * @param dpad The GameState.dpad value.
- * @return uint8_t The new dpad value.
- */
-uint8_t filterToFourWayMode(uint8_t dpad)
+uint8_t DpadFilter::filterToFourWayMode(uint8_t dpad)
 {
 	updateDpad(dpad, DIRECTION_UP);
 	updateDpad(dpad, DIRECTION_DOWN);
@@ -90,21 +88,12 @@ uint8_t filterToFourWayMode(uint8_t dpad)
 	return updateDpad(dpad, DIRECTION_RIGHT);
 }
 
-/**
- * @brief Run SOCD cleaning against a D-pad value.
- *
- * @param mode The SOCD cleaning mode.
- * @param dpad The GamepadState.dpad value.
- * @return uint8_t The clean D-pad value.
- */
-uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad)
+uint8_t DpadFilter::runSOCDCleaner(SOCDMode mode, uint8_t dpad)
 {
 	if (mode == SOCD_MODE_BYPASS) {
 		return dpad;
 	}
 
-	static DpadDirection lastUD = DIRECTION_NONE;
-	static DpadDirection lastLR = DIRECTION_NONE;
 	uint8_t newDpad = 0;
 
 	switch (dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN))
@@ -10,6 +10,10 @@
 #include "addonmanager.h"
 #include "types.h"
 #include "usbhostmanager.h"
+#include "loopprofiler.h"
+#include "latencytracker.h"
+#include "boottimeline.h"
+#include "inputtrace.h"
 
 // Inputs for Core0
 #include "addons/analog.h"
@@ -52,7 +56,10 @@ const static uint32_t rebootDelayMs = 500;
 static absolute_time_t rebootDelayTimeout = nil_time;
 
 void GP2040::setup() {
+	BootTimeline& bootTimeline = BootTimeline::getInstance();
+
 	Storage::getInstance().init();
+	bootTimeline.mark(BOOT_STAGE_STORAGE);
 
 	// Reduce CPU if USB host is enabled
 	PeripheralManager::getInstance().initUSB();
@@ -63,6 +70,7 @@ void GP2040::setup() {
 	// I2C & SPI rely on the system clock
 	PeripheralManager::getInstance().initSPI();
 	PeripheralManager::getInstance().initI2C();
+	bootTimeline.mark(BOOT_STAGE_PERIPHERALS);
 
 	Gamepad * gamepad = new Gamepad();
 	Gamepad * processedGamepad = new Gamepad();
@@ -86,6 +94,7 @@ void GP2040::setup() {
 	// now we can load the latest configured profile, which will map the
 	// new set of GPIOs to use...
 	this->initializeStandardGpio();
+	bootTimeline.mark(BOOT_STAGE_GAMEPAD);
 
 	const GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
 
@@ -125,9 +134,11 @@ void GP2040::setup() {
 	addons.LoadAddon(new ReverseInput());
 	addons.LoadAddon(new TurboInput()); // Turbo overrides button states and should be close to the end
 	addons.LoadAddon(new InputMacro());
+	bootTimeline.mark(BOOT_STAGE_ADDONS);
 
 	InputMode inputMode = gamepad->getOptions().inputMode;
 	const BootAction bootAction = getBootAction();
+	bootTimeline.mark(BOOT_STAGE_BOOT_ACTION);
 	switch (bootAction) {
 		case BootAction::ENTER_WEBCONFIG_MODE:
 			inputMode = INPUT_MODE_CONFIG;
@@ -193,6 +204,10 @@ void GP2040::setup() {
 
 	// Setup USB Driver
 	DriverManager::getInstance().setup(inputMode);
+	bootTimeline.mark(BOOT_STAGE_DRIVER);
+
+	// Keep the timeline of gamepad boots for web config, a web config boot leaves the last one in place
+	bootTimeline.keep(inputMode != INPUT_MODE_CONFIG);
 
 	// save to match user expectations on choosing mode at boot, and this is
 	// before USB host will be used so we can force it to ignore the check
@@ -223,6 +238,12 @@ void GP2040::initializeStandardGpio() {
 			buttonGpios |= 1 << pin;    // mark this pin as mattering for GPIO debouncing
 		}
 	}
+
+	// restart debouncing from the current state of the (new) button pins
+	const GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
+	Gamepad* gamepad = Storage::getInstance().GetGamepad();
+	gamepad->debouncedGpio &= buttonGpios;
+	debouncer.reset(gamepad->debouncedGpio, gamepadOptions.debounceMode, gamepadOptions.debounceDelay, time_us_32());
 }
 
 /**
@@ -249,44 +270,60 @@ void GP2040::deinitializeStandardGpio() {
  * For ease of use this provides the mask bitwise NOTed so that callers don't have to. To avoid misuse
  * and to simplify this method, non-button GPIO IS NOT PRESENT in this result. Use gpio_get_all directly
  * instead, if you don't want debounced data.
+ *
+ * All button GPIO are debounced together by GamepadDebouncer, see GamepadOptions.debounceMode for
+ * which edges are reported immediately and which have to settle first.
  */
 void GP2040::debounceGpioGetAll() {
 	Mask_t raw_gpio = ~gpio_get_all();
+	// Timestamped on the raw edge, so the debounce delay counts towards the latency
+	LATENCY_TRACK_EDGE(((raw_gpio ^ rawGpio) & buttonGpios) != 0);
+	rawGpio = raw_gpio;
 	Gamepad* gamepad = Storage::getInstance().GetGamepad();
-	// return if state isn't different than the actual
-	if (gamepad->debouncedGpio == (raw_gpio & buttonGpios)) return;
 
-	uint32_t debounceDelay = Storage::getInstance().getGamepadOptions().debounceDelay;
 	// abort if no delay is configured
-	if (debounceDelay == 0) {
+	if (Storage::getInstance().getGamepadOptions().debounceDelay == 0) {
 		gamepad->debouncedGpio = raw_gpio;
-		return;
+	} else {
+		gamepad->debouncedGpio = debouncer.update(raw_gpio & buttonGpios, time_us_32());
 	}
+}
 
-	uint32_t now = getMillis();
-	// check each button use case GPIO for state
-	for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++) {
-		Mask_t pin_mask = 1 << pin;
-		if (buttonGpios & pin_mask) {
-			// Allow debouncer to change state if button state changed and debounce delay threshold met
-			if ((gamepad->debouncedGpio & pin_mask) != \
-					(raw_gpio & pin_mask) && ((now - gpioDebounceTime[pin]) > debounceDelay)) {
-				gamepad->debouncedGpio ^= pin_mask;
-				gpioDebounceTime[pin] = now;
-			}
-		}
-	}
+/**
+ * @brief Record a frame for /api/getInputTrace when a client is tracing and the interval elapsed.
+ *
+ * The config loop does not process the gamepad, it is processed here for the frame and restored after.
+ */
+void GP2040::traceInput(Gamepad* gamepad) {
+	InputTrace& inputTrace = InputTrace::getInstance();
+	const uint32_t nowUs = time_us_32();
+	if (!inputTrace.due(nowUs))
+		return;
+
+	GamepadState readState = gamepad->state;
+	gamepad->process();
+	inputTrace.record(nowUs, rawGpio, gamepad->debouncedGpio, gamepad->state);
+	gamepad->state = readState;
 }
 
 void GP2040::run() {
-	bool configMode = DriverManager::getInstance().isConfigMode();
-	GPDriver * inputDriver = DriverManager::getInstance().getDriver();
-	Gamepad * gamepad = Storage::getInstance().GetGamepad();
-	Gamepad * processedGamepad = Storage::getInstance().GetProcessedGamepad();
-	GamepadState prevState;
+	this->start();
+
+	while (1) { // LOOP
+		this->loop();
+	}
+}
+
+/**
+ * @brief Bring up USB and the core0 instrumentation, everything the input loop needs after setup().
+ */
+void GP2040::start() {
+	configMode = DriverManager::getInstance().isConfigMode();
+	inputDriver = DriverManager::getInstance().getDriver();
 
 	// Start the TinyUSB Device functionality
 	tud_init(TUD_OPT_RHPORT);
+	BootTimeline::getInstance().mark(BOOT_STAGE_USB_INIT);
 
 	// Initialize our USB manager
 	USBHostManager::getInstance().start();
@@ -295,57 +332,114 @@ void GP2040::run() {
 		rndis_init();
 	}
 
-	while (1) { // LOOP
-		this->getReinitGamepad(gamepad);
-
-		memcpy(&prevState, &gamepad->state, sizeof(GamepadState));
+#if LOOP_PROFILER_ENABLED
+	LoopProfiler::getInstance().init(configMode);
+#endif
+#if LATENCY_TRACKER_ENABLED
+	LatencyTracker::getInstance().init(DriverManager::getInstance().getInputMode());
+#endif
+	ReportSender::initCounters(DriverManager::getInstance().getInputMode());
+}
 
-		// Debounce
-		debounceGpioGetAll();
-		// Read Gamepad
-		gamepad->read();
+/**
+ * @brief Run a single pass of the core0 input loop.
+ *
+ * Every pass is self-contained (read, process, report, save) so that the loop can be stepped
+ * one input sample at a time, e.g. when replaying recorded input or timing individual stages.
+ */
+void GP2040::loop() {
+	Gamepad * gamepad = Storage::getInstance().GetGamepad();
+	Gamepad * processedGamepad = Storage::getInstance().GetProcessedGamepad();
+	GamepadState prevState;
 
-		checkRawState(prevState, gamepad->state);
+	LOOP_PROFILE_BEGIN();
 
-		// Process USB Host on Core0
-		USBHostManager::getInstance().process();
+	this->getReinitGamepad(gamepad);
+	LOOP_PROFILE_STAGE(LOOP_STAGE_REINIT);
 
-		// Config Loop (Web-Config skips Core0 add-ons)
-		if (configMode == true) {
-			inputDriver->process(gamepad);
-			rebootHotkeys.process(gamepad, configMode);
-			checkSaveRebootState();
-			continue;
-		}
+	memcpy(&prevState, &gamepad->state, sizeof(GamepadState));
 
-		// Pre-Process add-ons for MPGS
-		addons.PreprocessAddons();
+	// Debounce
+	debounceGpioGetAll();
+	LOOP_PROFILE_STAGE(LOOP_STAGE_DEBOUNCE);
+	// Read Gamepad
+	gamepad->read();
+	LOOP_PROFILE_STAGE(LOOP_STAGE_READ);
 
-		gamepad->hotkey(); 	// check for MPGS hotkeys
-		rebootHotkeys.process(gamepad, configMode);
+	checkRawState(prevState, gamepad->state);
+	LOOP_PROFILE_STAGE(LOOP_STAGE_RAW_EVENTS);
 
-		gamepad->process(); // process through MPGS
+	// Process USB Host on Core0
+	USBHostManager::getInstance().process();
+	LOOP_PROFILE_STAGE(LOOP_STAGE_USB_HOST);
 
-		// (Post) Process for add-ons
-		addons.ProcessAddons();
+	// Config Loop (Web-Config skips Core0 add-ons)
+	if (configMode == true) {
+		traceInput(gamepad);
+		inputDriver->process(gamepad);
+		LOOP_PROFILE_STAGE(LOOP_STAGE_DRIVER);
+		rebootHotkeys.process(gamepad, configMode);
+		LOOP_PROFILE_STAGE(LOOP_STAGE_HOTKEYS);
+		EventManager::getInstance().drainEvents();
+		LOOP_PROFILE_STAGE(LOOP_STAGE_EVENTS);
+		checkSaveRebootState();
+		LOOP_PROFILE_STAGE(LOOP_STAGE_SAVE);
+		LOOP_PROFILE_END();
+		return;
+	}
 
-		checkProcessedState(processedGamepad->state, gamepad->state);
+	// Pre-Process add-ons for MPGS
+	addons.PreprocessAddons();
+	LOOP_PROFILE_STAGE(LOOP_STAGE_PREPROCESS);
+
+	gamepad->hotkey(); 	// check for MPGS hotkeys
+	rebootHotkeys.process(gamepad, configMode);
+	LOOP_PROFILE_STAGE(LOOP_STAGE_HOTKEYS);
+
+	gamepad->process(); // process through MPGS
+	LOOP_PROFILE_STAGE(LOOP_STAGE_GAMEPAD_PROCESS);
+
+	// (Post) Process for add-ons
+	addons.ProcessAddons();
+	LOOP_PROFILE_STAGE(LOOP_STAGE_PROCESS);
+
+	checkProcessedState(processedGamepad->state, gamepad->state);
+	LATENCY_TRACK_PROCESSED(
+		(processedGamepad->state.dpad != gamepad->state.dpad) ||
+		(processedGamepad->state.buttons != gamepad->state.buttons) ||
+		(processedGamepad->state.aux != gamepad->state.aux),
+		((rawGpio ^ gamepad->debouncedGpio) & buttonGpios) != 0
+	);
+	LOOP_PROFILE_STAGE(LOOP_STAGE_PROCESSED_EVENTS);
+
+	// Copy Processed Gamepad for Core1 (race condition otherwise)
+	memcpy(&processedGamepad->state, &gamepad->state, sizeof(GamepadState));
+
+	// Process Input Driver
+	bool processed = inputDriver->process(gamepad);
+	if (processed && !firstReportSent) {
+		firstReportSent = true;
+		BootTimeline::getInstance().mark(BOOT_STAGE_FIRST_REPORT);
+	}
+	LOOP_PROFILE_STAGE(LOOP_STAGE_DRIVER);
 
-		// Copy Processed Gamepad for Core1 (race condition otherwise)
-		memcpy(&processedGamepad->state, &gamepad->state, sizeof(GamepadState));
+	// TinyUSB Task update
+	tud_task();
+	LOOP_PROFILE_STAGE(LOOP_STAGE_TUD_TASK);
 
-		// Process Input Driver
-		bool processed = inputDriver->process(gamepad);
+	// Post-Process Add-ons with USB Report Processed Sent
+	addons.PostprocessAddons(processed);
+	LOOP_PROFILE_STAGE(LOOP_STAGE_POSTPROCESS);
 
-		// TinyUSB Task update
-		tud_task();
+	// Dispatch events queued by core1 (and core0 when deferred)
+	EventManager::getInstance().drainEvents();
+	LOOP_PROFILE_STAGE(LOOP_STAGE_EVENTS);
 
-		// Post-Process Add-ons with USB Report Processed Sent
-		addons.PostprocessAddons(processed);
+	// Check if we have a pending save
+	checkSaveRebootState();
+	LOOP_PROFILE_STAGE(LOOP_STAGE_SAVE);
 
-		// Check if we have a pending save
-		checkSaveRebootState();
-	}
+	LOOP_PROFILE_END();
 }
 
 void GP2040::getReinitGamepad(Gamepad * gamepad) {
@@ -396,7 +490,12 @@ GP2040::BootAction GP2040::getBootAction() {
 				Gamepad * gamepad = Storage::getInstance().GetGamepad();
 				Gamepad * processedGamepad = Storage::getInstance().GetProcessedGamepad();
 
-				debounceGpioGetAll();
+				// Start debouncing from the pins as they are: a button held through boot has settled long
+				// ago, and a deferred debounce mode would hold it back for the whole delay otherwise
+				rawGpio = ~gpio_get_all();
+				gamepad->debouncedGpio = rawGpio & buttonGpios;
+				const GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
+				debouncer.reset(gamepad->debouncedGpio, gamepadOptions.debounceMode, gamepadOptions.debounceDelay, time_us_32());
 				gamepad->read();
 
 				// Pre-Process add-ons for MPGS
@@ -524,7 +623,7 @@ void GP2040::checkRawState(GamepadState prevState, GamepadState currState) {
         ((currState.dpad & ~prevState.dpad) != 0) ||
         ((currState.buttons & ~prevState.buttons) != 0)
     ) {
-        EventManager::getInstance().triggerEvent(new GPButtonDownEvent((currState.dpad & ~prevState.dpad), (currState.buttons & ~prevState.buttons), (currState.aux & ~prevState.aux)));
+        EventManager::getInstance().postEvent<GPButtonDownEvent>((currState.dpad & ~prevState.dpad), (currState.buttons & ~prevState.buttons), (currState.aux & ~prevState.aux));
     }
 
     // buttons released
@@ -533,7 +632,7 @@ void GP2040::checkRawState(GamepadState prevState, GamepadState currState) {
         ((prevState.dpad & ~currState.dpad) != 0) ||
         ((prevState.buttons & ~currState.buttons) != 0)
     ) {
-        EventManager::getInstance().triggerEvent(new GPButtonUpEvent((prevState.dpad & ~currState.dpad), (prevState.buttons & ~currState.buttons), (prevState.aux & ~currState.aux)));
+        EventManager::getInstance().postEvent<GPButtonUpEvent>((prevState.dpad & ~currState.dpad), (prevState.buttons & ~currState.buttons), (prevState.aux & ~currState.aux));
     }
 }
 
@@ -544,7 +643,7 @@ void GP2040::checkProcessedState(GamepadState prevState, GamepadState currState)
         ((currState.dpad & ~prevState.dpad) != 0) ||
         ((currState.buttons & ~prevState.buttons) != 0)
     ) {
-        EventManager::getInstance().triggerEvent(new GPButtonProcessedDownEvent((currState.dpad & ~prevState.dpad), (currState.buttons & ~prevState.buttons), (currState.aux & ~prevState.aux)));
+        EventManager::getInstance().postEvent<GPButtonProcessedDownEvent>((currState.dpad & ~prevState.dpad), (currState.buttons & ~prevState.buttons), (currState.aux & ~prevState.aux));
     }
 
     // buttons released
@@ -553,7 +652,7 @@ void GP2040::checkProcessedState(GamepadState prevState, GamepadState currState)
         ((prevState.dpad & ~currState.dpad) != 0) ||
         ((prevState.buttons & ~currState.buttons) != 0)
     ) {
-        EventManager::getInstance().triggerEvent(new GPButtonProcessedUpEvent((prevState.dpad & ~currState.dpad), (prevState.buttons & ~currState.buttons), (prevState.aux & ~currState.aux)));
+        EventManager::getInstance().postEvent<GPButtonProcessedUpEvent>((prevState.dpad & ~currState.dpad), (prevState.buttons & ~currState.buttons), (prevState.aux & ~currState.aux));
     }
 
     if (
@@ -564,7 +663,7 @@ void GP2040::checkProcessedState(GamepadState prevState, GamepadState currState)
         (currState.lt != prevState.lt) ||
         (currState.rt != prevState.rt)
     ) {
-        EventManager::getInstance().triggerEvent(new GPAnalogProcessedMoveEvent(currState.lx, currState.ly, currState.rx, currState.ry, currState.lt, currState.rt));
+        EventManager::getInstance().postEvent<GPAnalogProcessedMoveEvent>(currState.lx, currState.ly, currState.rx, currState.ry, currState.lt, currState.rt);
     }
 }
 
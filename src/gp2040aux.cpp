@@ -5,6 +5,7 @@
 #include "drivermanager.h"
 #include "storagemanager.h"
 #include "usbhostmanager.h"
+#include "boottimeline.h"
 
 #include "addons/board_led.h"  // Add-Ons
 #include "addons/buzzerspeaker.h"
@@ -16,7 +17,10 @@
 
 #include <iterator>
 
-GP2040Aux::GP2040Aux() : isReady(false), inputDriver(nullptr) {
+// Fast boot brings up the output add-ons no later than this, even if no host ever takes a report
+static const uint32_t FAST_BOOT_DEFER_TIMEOUT_MS = 500;
+
+GP2040Aux::GP2040Aux() : isReady(false), inputDriver(nullptr), deferredAddons(false), deferTimeout(nil_time) {
 }
 
 GP2040Aux::~GP2040Aux() {
@@ -25,6 +29,14 @@ GP2040Aux::~GP2040Aux() {
 // GP2040Aux will always come after GP2040 setup(), so we can rely on the
 // GP2040 setup function for certain setup functions.
 void GP2040Aux::setup() {
+	// Fast boot releases core0 (and USB enumeration) before the display and LED add-ons are set up,
+	// they follow in run() once the first report is out. Web config always boots the regular way.
+	deferredAddons = Storage::getInstance().getGamepadOptions().fastBoot && !DriverManager::getInstance().isConfigMode();
+
+	// Decode the display, LED and animation config while core0 waits for us
+	if (!deferredAddons)
+		Storage::getInstance().loadDeferredConfig();
+
 	// Initialize our input driver's auxilliary functions
 	inputDriver = DriverManager::getInstance().getDriver();
 	if ( inputDriver != nullptr ) {
@@ -33,25 +45,42 @@ void GP2040Aux::setup() {
 		// Check if we have a USB listener
 		USBListener * listener = inputDriver->get_usb_auth_listener();
 		if (listener != nullptr) {
-			USBHostManager::getInstance().pushListener(listener);
+			USBHostManager::getInstance().pushListener(listener, USB_LISTENER_PRIORITY_AUTH);
 		}
 	}
 
 	// Setup Add-ons
-	addons.LoadAddon(new DisplayAddon());
-	addons.LoadAddon(new NeoPicoLEDAddon());
-	addons.LoadAddon(new PlayerLEDAddon());
+	if (!deferredAddons)
+		loadOutputAddons();
 	addons.LoadAddon(new BoardLedAddon());
-	addons.LoadAddon(new BuzzerSpeakerAddon());
 	addons.LoadAddon(new DRV8833RumbleAddon());
 	addons.LoadAddon(new ReactiveLEDAddon());
+	if (deferredAddons)
+		deferTimeout = make_timeout_time_ms(FAST_BOOT_DEFER_TIMEOUT_MS);
 
 	// Ready to sync Core0 and Core1
 	isReady = true;
 }
 
+/**
+ * @brief Load the add-ons that only drive outputs (display, LEDs, buzzer) and take the longest to set up.
+ */
+void GP2040Aux::loadOutputAddons() {
+	addons.LoadAddon(new DisplayAddon());
+	addons.LoadAddon(new NeoPicoLEDAddon());
+	addons.LoadAddon(new PlayerLEDAddon());
+	addons.LoadAddon(new BuzzerSpeakerAddon());
+}
+
 void GP2040Aux::run() {
 	while (1) {
+		if (deferredAddons && (BootTimeline::getInstance().reached(BOOT_STAGE_FIRST_REPORT) || time_reached(deferTimeout))) {
+			deferredAddons = false;
+			Storage::getInstance().loadDeferredConfig();
+			loadOutputAddons();
+			BootTimeline::getInstance().mark(BOOT_STAGE_CORE1_ADDONS);
+		}
+
 		// Pre, Process, and Post
 		addons.PreprocessAddons();
 		addons.ProcessAddons();
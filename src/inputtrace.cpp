@@ -0,0 +1,150 @@
+#include "inputtrace.h"
+
+#include "hardware/adc.h"
+#include "hardware/gpio.h"
+#include "hardware/structs/padsbank0.h"
+
+// Pins nothing set up since boot, the ones an analog input leaves with function NULL have input disabled
+static bool isUnusedPin(uint pin) {
+	return gpio_get_function(pin) == GPIO_FUNC_NULL && (padsbank0_hw->io[pin] & PADS_BANK0_GPIO0_IE_BITS);
+}
+
+static bool isAnalogPin(uint pin) {
+	return gpio_get_function(pin) == GPIO_FUNC_NULL && !(padsbank0_hw->io[pin] & PADS_BANK0_GPIO0_IE_BITS);
+}
+
+/**
+ * @brief Keep sampling, at the given interval, until no client polled for INPUT_TRACE_IDLE_TIMEOUT_US.
+ *
+ * The buffer is only allocated by the first poll, boots that never open the trace do not pay for it.
+ * adcInputs are set up for analog reads the first time they are asked for, unusedPins keeps the unused
+ * pins pulled up for as long as the client asks for them.
+ */
+void InputTrace::poll(uint32_t intervalUs, uint8_t adcInputs, bool unusedPins) {
+	if (frames == nullptr)
+		frames = new InputTraceFrame[INPUT_TRACE_FRAMES]();
+
+	if (intervalUs < INPUT_TRACE_MIN_INTERVAL_US)
+		intervalUs = INPUT_TRACE_MIN_INTERVAL_US;
+	else if (intervalUs > INPUT_TRACE_MAX_INTERVAL_US)
+		intervalUs = INPUT_TRACE_MAX_INTERVAL_US;
+
+	interval = intervalUs;
+	lastPollUs = time_us_32();
+	if (!active) {
+		active = true;
+		lastSampleUs = lastPollUs - interval;
+		loops = 0;
+	}
+
+	if (adcInputs != 0)
+		setupAdcInputs(adcInputs);
+	if (unusedPins)
+		pullUnusedPins();
+	else if (pulledPins != 0)
+		releasePins();
+}
+
+/**
+ * @brief GPIO inputs read by the SIO, the pins a held button can show up on.
+ */
+uint32_t InputTrace::getInputPins() const {
+	uint32_t inputPins = 0;
+	for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+		if (gpio_get_function(pin) == GPIO_FUNC_SIO && !gpio_is_dir_out(pin))
+			inputPins |= (1 << pin);
+	}
+	return inputPins;
+}
+
+// Stays set up after the trace, as the analog add-on leaves its pins. Pins in use for anything else are left alone.
+void InputTrace::setupAdcInputs(uint8_t adcInputs) {
+	for (uint8_t input = 0; input < INPUT_TRACE_ADC_INPUTS; input++) {
+		const uint pin = INPUT_TRACE_ADC_FIRST_PIN + input;
+		if (!(adcInputs & (1 << input)) || isAnalogPin(pin) || !isUnusedPin(pin))
+			continue;
+		if (!(adc_hw->cs & ADC_CS_EN_BITS))
+			adc_init();
+		adc_gpio_init(pin);
+	}
+}
+
+void InputTrace::pullUnusedPins() {
+	for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+		if (!isUnusedPin(pin))
+			continue;
+		gpio_init(pin);
+		gpio_set_dir(pin, GPIO_IN);
+		gpio_pull_up(pin);
+		pulledPins |= (1 << pin);
+	}
+}
+
+void InputTrace::releasePins() {
+	for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+		if (!(pulledPins & (1 << pin)))
+			continue;
+		gpio_disable_pulls(pin);
+		gpio_deinit(pin);
+	}
+	pulledPins = 0;
+}
+
+/**
+ * @brief Check whether the loop pass at nowUs should record a frame.
+ */
+bool InputTrace::due(uint32_t nowUs) {
+	if (!active)
+		return false;
+
+	if ((nowUs - lastPollUs) > INPUT_TRACE_IDLE_TIMEOUT_US) {
+		active = false;
+		if (pulledPins != 0)
+			releasePins();
+		return false;
+	}
+
+	if (loops < UINT16_MAX)
+		loops++;
+	return (nowUs - lastSampleUs) >= interval;
+}
+
+void InputTrace::record(uint32_t nowUs, uint32_t rawGpio, uint32_t debouncedGpio, const GamepadState& state) {
+	InputTraceFrame& frame = frames[sequence % INPUT_TRACE_FRAMES];
+	frame = {};
+	frame.timeUs = nowUs;
+	frame.rawGpio = rawGpio;
+	frame.debouncedGpio = debouncedGpio;
+	frame.buttons = state.buttons;
+	frame.aux = state.aux;
+	frame.dpad = state.dpad;
+	frame.lt = state.lt;
+	frame.rt = state.rt;
+	frame.loops = loops;
+	frame.lx = state.lx;
+	frame.ly = state.ly;
+	frame.rx = state.rx;
+	frame.ry = state.ry;
+
+	// Only inputs set up for analog reads (the analog addon, HE trigger calibration or a poll's adcInputs),
+	// pins in use for anything else are never sampled. With an HE trigger mux this is the channel selected last.
+	if (adc_hw->cs & ADC_CS_EN_BITS) {
+		const uint selectedInput = adc_get_selected_input();
+		for (uint8_t input = 0; input < INPUT_TRACE_ADC_INPUTS; input++) {
+			const uint pin = INPUT_TRACE_ADC_FIRST_PIN + input;
+			if (!isAnalogPin(pin))
+				continue;
+			adc_select_input(input);
+			frame.adc[input] = adc_read();
+			frame.adcMask |= (1 << input);
+		}
+		adc_select_input(selectedInput);
+	}
+
+	// Keep the phase instead of drifting by the loop time, unless the loop fell more than an interval behind
+	lastSampleUs += interval;
+	if ((nowUs - lastSampleUs) >= interval)
+		lastSampleUs = nowUs;
+	loops = 0;
+	sequence++;
+}
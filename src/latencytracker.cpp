@@ -0,0 +1,81 @@
+#include "latencytracker.h"
+
+#include <new>
+
+#include "pico/platform.h"
+
+#define LATENCY_STATS_MAGIC 0x4c415459
+
+struct LatencyStats {
+	uint32_t magic;
+	LoopProfileStat modes[LATENCY_TRACKER_MODES];
+};
+
+// Raw storage so static initialization does not clear what the last boot recorded
+static uint8_t __uninitialized_ram(latencyStatsStorage)[sizeof(LatencyStats)] __attribute__((aligned(8)));
+
+static inline LatencyStats* getStats() {
+	return reinterpret_cast<LatencyStats*>(latencyStatsStorage);
+}
+
+void LatencyTracker::init(InputMode inputMode) {
+	mode = (inputMode < LATENCY_TRACKER_MODES) ? inputMode : LATENCY_TRACKER_MODES;
+
+	// Keep the stats of a previous boot (e.g. gamepad mode before rebooting into web config)
+	if (getStats()->magic != (LATENCY_STATS_MAGIC ^ sizeof(LatencyStats)))
+		reset();
+}
+
+void LatencyTracker::reset() {
+	LatencyStats* stats = new (latencyStatsStorage) LatencyStats();
+	stats->magic = LATENCY_STATS_MAGIC ^ sizeof(LatencyStats);
+
+	seenValid = false;
+	armedValid = false;
+	inFlightValid = false;
+}
+
+void LatencyTracker::edge(uint32_t nowUs) {
+	if (!seenValid) {
+		seenUs = nowUs;
+		seenValid = true;
+	}
+}
+
+void LatencyTracker::processed(bool buttonsChanged, bool debouncing) {
+	if (!seenValid)
+		return;
+
+	if (buttonsChanged) {
+		if (!armedValid) {
+			armedUs = seenUs;
+			armedValid = true;
+		}
+	} else if (debouncing) {
+		// The debouncer has not let the edge through yet
+		return;
+	}
+	seenValid = false;
+}
+
+void LatencyTracker::reportSent() {
+	if (!armedValid || inFlightValid)
+		return;
+
+	inFlightUs = armedUs;
+	inFlightValid = true;
+	armedValid = false;
+}
+
+void LatencyTracker::reportComplete(uint32_t nowUs) {
+	if (!inFlightValid)
+		return;
+
+	inFlightValid = false;
+	if (mode < LATENCY_TRACKER_MODES)
+		getStats()->modes[mode].record(nowUs - inFlightUs);
+}
+
+const LoopProfileStat& LatencyTracker::getStat(InputMode inputMode) const {
+	return getStats()->modes[inputMode];
+}
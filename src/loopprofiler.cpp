@@ -0,0 +1,175 @@
+#include "loopprofiler.h"
+
+#include <new>
+#include <string.h>
+
+#include "pico/platform.h"
+
+#define LOOP_PROFILE_MAGIC 0x4c4f4f50
+
+struct LoopProfileData {
+	uint32_t magic;
+	LoopProfileStat stages[LOOP_STAGE_COUNT];
+	LoopProfileStat addons[LOOP_PROFILER_MAX_ADDONS][LOOP_ADDON_PHASE_COUNT];
+	char addonNames[LOOP_PROFILER_MAX_ADDONS][LOOP_PROFILER_ADDON_NAME_SIZE];
+	uint8_t addonCount;
+};
+
+// Raw storage so static initialization does not clear what the last boot recorded
+static uint8_t __uninitialized_ram(loopProfileStorage)[sizeof(LoopProfileData)] __attribute__((aligned(8)));
+
+static inline LoopProfileData* getData() {
+	return reinterpret_cast<LoopProfileData*>(loopProfileStorage);
+}
+
+// SysTick control bits, identical on the M0+ and M33 cores
+#define SYSTICK_CSR_ENABLE        (1U << 0)
+#define SYSTICK_CSR_CLKSOURCE_CPU (1U << 2)
+
+static const char * const stageNames[LOOP_STAGE_COUNT] = {
+	"total",
+	"reinit",
+	"debounce",
+	"read",
+	"rawEvents",
+	"usbHost",
+	"preprocess",
+	"hotkeys",
+	"gamepadProcess",
+	"process",
+	"processedEvents",
+	"driver",
+	"tudTask",
+	"postprocess",
+	"events",
+	"save",
+};
+
+static const char * const addonPhaseNames[LOOP_ADDON_PHASE_COUNT] = {
+	"preprocess",
+	"process",
+	"postprocess",
+};
+
+static inline uint8_t bucketIndex(uint32_t cycles) {
+	if (cycles < 2)
+		return cycles;
+	uint8_t msb = 31 - __builtin_clz(cycles);
+	return (msb << 1) | ((cycles >> (msb - 1)) & 1);
+}
+
+static inline uint32_t bucketUpperEdge(uint8_t index) {
+	if (index < 2)
+		return index;
+	uint8_t msb = index >> 1;
+	uint32_t lower = (1U << msb) | ((uint32_t)(index & 1) << (msb - 1));
+	return lower + (1U << (msb - 1)) - 1;
+}
+
+void LoopProfileStat::record(uint32_t cycles) {
+	if (cycles > LoopProfiler::SYSTICK_MASK)
+		cycles = LoopProfiler::SYSTICK_MASK;
+
+	count++;
+	total += cycles;
+	if (cycles < min)
+		min = cycles;
+	if (cycles > max)
+		max = cycles;
+
+	uint8_t index = bucketIndex(cycles);
+	if (histogram[index] == UINT16_MAX) {
+		// Decay instead of saturating so percentiles keep tracking recent behaviour
+		for (uint8_t i = 0; i < LOOP_PROFILER_BUCKETS; i++)
+			histogram[i] >>= 1;
+	}
+	histogram[index]++;
+}
+
+void LoopProfileStat::reset() {
+	*this = LoopProfileStat();
+}
+
+uint32_t LoopProfileStat::percentile(uint32_t pct) const {
+	uint32_t samples = 0;
+	for (uint8_t i = 0; i < LOOP_PROFILER_BUCKETS; i++)
+		samples += histogram[i];
+	if (samples == 0)
+		return 0;
+
+	uint32_t target = (samples * pct + 99) / 100;
+	uint32_t seen = 0;
+	for (uint8_t i = 0; i < LOOP_PROFILER_BUCKETS; i++) {
+		seen += histogram[i];
+		if (seen >= target)
+			return bucketUpperEdge(i) < max ? bucketUpperEdge(i) : max;
+	}
+	return max;
+}
+
+void LoopProfiler::init(bool configMode) {
+	// Free-running SysTick at the processor clock
+	systick_hw->csr = 0;
+	systick_hw->rvr = SYSTICK_MASK;
+	systick_hw->cvr = 0;
+	systick_hw->csr = SYSTICK_CSR_CLKSOURCE_CPU | SYSTICK_CSR_ENABLE;
+
+	// Web config shows what the gamepad boot before it recorded, its own loop is not profiled
+	recording = !configMode;
+	if (recording || getData()->magic != (LOOP_PROFILE_MAGIC ^ sizeof(LoopProfileData)))
+		reset();
+}
+
+void LoopProfiler::reset() {
+	LoopProfileData* data = new (loopProfileStorage) LoopProfileData();
+	data->magic = LOOP_PROFILE_MAGIC ^ sizeof(LoopProfileData);
+	memcpy(data->addonNames, addonNames, sizeof(addonNames));
+	data->addonCount = addonCount;
+}
+
+uint32_t LoopProfiler::recordStage(LoopStage stage, uint32_t mark) {
+	uint32_t curr = now();
+	if (recording)
+		getData()->stages[stage].record(elapsed(mark, curr));
+	return curr;
+}
+
+void LoopProfiler::recordAddon(uint8_t index, LoopAddonPhase phase, uint32_t mark) {
+	uint32_t curr = now();
+	if (!recording || get_core_num() != 0 || index >= LOOP_PROFILER_MAX_ADDONS)
+		return;
+	getData()->addons[index][phase].record(elapsed(mark, curr));
+}
+
+void LoopProfiler::setAddonName(uint8_t index, const char * name) {
+	if (get_core_num() != 0 || index >= LOOP_PROFILER_MAX_ADDONS)
+		return;
+	strncpy(addonNames[index], name, LOOP_PROFILER_ADDON_NAME_SIZE - 1);
+	addonNames[index][LOOP_PROFILER_ADDON_NAME_SIZE - 1] = '\0';
+	if (index >= addonCount)
+		addonCount = index + 1;
+}
+
+const LoopProfileStat& LoopProfiler::getStage(LoopStage stage) const {
+	return getData()->stages[stage];
+}
+
+const LoopProfileStat& LoopProfiler::getAddon(uint8_t index, LoopAddonPhase phase) const {
+	return getData()->addons[index][phase];
+}
+
+const char * LoopProfiler::getAddonName(uint8_t index) const {
+	return getData()->addonNames[index];
+}
+
+uint8_t LoopProfiler::getAddonCount() const {
+	return getData()->addonCount;
+}
+
+const char * LoopProfiler::getStageName(LoopStage stage) {
+	return stageNames[stage];
+}
+
+const char * LoopProfiler::getAddonPhaseName(LoopAddonPhase phase) {
+	return addonPhaseNames[phase];
+}
@@ -9,6 +9,7 @@
 // GP2040 includes
 #include "gp2040.h"
 #include "gp2040aux.h"
+#include "boottimeline.h"
 
 #include <cstdlib>
 
@@ -47,6 +48,7 @@ int main() {
 	while(gp2040Core1->ready() == false ) {
 		__asm volatile ("nop\n");
 	}
+	BootTimeline::getInstance().mark(BOOT_STAGE_CORE1_READY);
 	gp2040Core0->run();
 
 	return 0;
@@ -21,10 +21,25 @@
 
 #include "config_utils.h"
 
+#include "pico/mutex.h"
+
+auto_init_mutex(deferredConfigMutex);
+
 void Storage::init() {
 	systemFlashSize = System::getPhysicalFlash(); // System Flash Size must be called once
 	EEPROM.start();
-	ConfigUtils::load(config);
+	configDeferred = ConfigUtils::load(config);
+}
+
+void Storage::completeConfig()
+{
+	// Either core can get here first
+	mutex_enter_blocking(&deferredConfigMutex);
+	if (configDeferred) {
+		ConfigUtils::loadDeferred(config);
+		configDeferred = false;
+	}
+	mutex_exit(&deferredConfigMutex);
 }
 
 /**
@@ -51,6 +66,8 @@ bool Storage::save(const bool force) {
 		return false;
 	}
 
+	// Never save defaults over sections that have not been decoded yet
+	loadDeferredConfig();
 	return ConfigUtils::save(config);
 }
 
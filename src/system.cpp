@@ -45,7 +45,7 @@ uint32_t System::getPhysicalFlash() {
 }
 
 uint32_t System::getStaticAllocs() {
-    const uint32_t inMemorySegmentsSize = reinterpret_cast<uint32_t>(&__bss_end__) - SRAM_BASE;
+    const uint32_t inMemorySegmentsSize = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&__bss_end__)) - SRAM_BASE;
     const uint32_t stackSize = &__StackTop - &__StackLimit;
     return inMemorySegmentsSize + stackSize;
 }
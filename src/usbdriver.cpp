@@ -8,6 +8,8 @@
 
 #include "tusb.h"
 #include "drivermanager.h"
+#include "latencytracker.h"
+#include "boottimeline.h"
 
 static bool usb_mounted;
 static bool usb_suspended;
@@ -35,11 +37,26 @@ void tud_hid_set_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t rep
 	DriverManager::getInstance().getDriver()->set_report(report_id, report_type, buffer, bufsize);
 }
 
+// Invoked when a report queued with tud_hid_report() has been read by the host
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report, uint16_t len) {
+	(void)instance;
+	(void)report;
+	(void)len;
+	LATENCY_TRACK_REPORT_COMPLETE();
+}
+
+// Invoked on every USB start-of-frame once a frame aligned report sender enables it
+void tud_sof_cb(uint32_t frame_count) {
+	(void)frame_count;
+	DriverManager::getInstance().getDriver()->getReportSender().onFrame();
+}
+
 // Invoked when device is mounted
 void tud_mount_cb(void)
 {
 	usb_mounted = true;
 	usb_suspended = false;
+	BootTimeline::getInstance().mark(BOOT_STAGE_USB_MOUNTED);
 }
 
 // Invoked when device is unmounted
@@ -31,8 +31,12 @@ void USBHostManager::shutdown() {
     }
 }
 
-void USBHostManager::pushListener(USBListener * usbListener) { // If anything needs to update in the gpconfig driver
-    listeners.push_back(usbListener);
+void USBHostManager::pushListener(USBListener * usbListener, USBListenerPriority priority) { // If anything needs to update in the gpconfig driver
+    // Keep the list ordered by priority, in the order listeners were added within a priority
+    std::vector<PrioritizedListener>::iterator it = listeners.begin();
+    while ( it != listeners.end() && it->priority <= priority )
+        it++;
+    listeners.insert(it, { usbListener, priority });
 }
 
 // Host manager should call tuh_task as fast as possible
@@ -42,74 +46,126 @@ void USBHostManager::process() {
     }
 }
 
-void USBHostManager::hid_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
-    if ( listeners.size() == 0 ) return;
-    for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
-        (*it)->mount(dev_addr, instance, desc_report, desc_len);
+USBHostRoute* USBHostManager::addRoute(USBHostRouteType type, uint8_t dev_addr, uint8_t instance) {
+    USBHostRoute* route = findRoute(type, dev_addr, instance);
+    if ( route == nullptr )
+        route = findRoute(USB_HOST_ROUTE_NONE, 0, 0);
+    if ( route == nullptr )
+        return nullptr;
+
+    *route = {};
+    route->type = type;
+    route->dev_addr = dev_addr;
+    route->instance = instance;
+    if (!tuh_vid_pid_get(dev_addr, &route->vid, &route->pid)) {
+        route->vid = 0xFFFF;
+        route->pid = 0xFFFF;
     }
+    return route;
 }
 
-void USBHostManager::hid_umount_cb(uint8_t dev_addr, uint8_t instance) {
-    if ( listeners.size() == 0 ) return;
-    for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
-        (*it)->unmount(dev_addr);
+USBHostRoute* USBHostManager::findRoute(USBHostRouteType type, uint8_t dev_addr, uint8_t instance) {
+    for (uint8_t i = 0; i < USB_HOST_MAX_ROUTES; i++) {
+        USBHostRoute& route = routes[i];
+        if ( route.type == type && (type == USB_HOST_ROUTE_NONE || (route.dev_addr == dev_addr && route.instance == instance)) )
+            return &route;
+    }
+    return nullptr;
+}
+
+void USBHostManager::removeRoute(USBHostRoute* route) {
+    if ( route == nullptr ) return;
+    if ( route->listener != nullptr ) {
+        route->listener->unmount(route->dev_addr);
+    }
+    *route = {};
+}
+
+// Offer the interface to the listeners by priority, the first one to claim it gets all of its events
+bool USBHostManager::hid_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
+    USBHostRoute* route = addRoute(USB_HOST_ROUTE_HID, dev_addr, instance);
+    if ( route == nullptr ) return false;
+    for( std::vector<PrioritizedListener>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
+        if ( it->listener->mount(dev_addr, instance, desc_report, desc_len) ) {
+            route->listener = it->listener;
+            return true;
+        }
     }
+    return false;
+}
+
+void USBHostManager::hid_umount_cb(uint8_t dev_addr, uint8_t instance) {
+    removeRoute(findRoute(USB_HOST_ROUTE_HID, dev_addr, instance));
 }
 
 void USBHostManager::hid_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {
-    if ( listeners.size() == 0 ) return;
-    for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
-        (*it)->report_received(dev_addr, instance, report, len);
+    USBHostRoute* route = findRoute(USB_HOST_ROUTE_HID, dev_addr, instance);
+    if ( route == nullptr ) return;
+    if ( route->listener == nullptr ) {
+        route->reportsDropped++;
+        return;
+    }
+
+    route->reportsReceived++;
+    route->listener->report_received(dev_addr, instance, report, len);
+
+    if ( !tuh_hid_receive_report(dev_addr, instance) ) {
+        route->reportsDropped++;
     }
 }
 
 void USBHostManager::hid_set_report_complete_cb(uint8_t dev_addr, uint8_t instance, uint8_t report_id, uint8_t report_type, uint16_t len) {
-    if ( listeners.size() == 0 ) return;
-    for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
-        (*it)->set_report_complete(dev_addr, instance, report_id, report_type, len);
-    }
+    USBHostRoute* route = findRoute(USB_HOST_ROUTE_HID, dev_addr, instance);
+    if ( route == nullptr || route->listener == nullptr ) return;
+    route->listener->set_report_complete(dev_addr, instance, report_id, report_type, len);
 }
 
 void USBHostManager::hid_get_report_complete_cb(uint8_t dev_addr, uint8_t instance, uint8_t report_id, uint8_t report_type, uint16_t len) {
-    if ( listeners.size() == 0 ) return;
-    for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
-        (*it)->get_report_complete(dev_addr, instance, report_id, report_type, len);
-    }
+    USBHostRoute* route = findRoute(USB_HOST_ROUTE_HID, dev_addr, instance);
+    if ( route == nullptr || route->listener == nullptr ) return;
+    route->listener->get_report_complete(dev_addr, instance, report_id, report_type, len);
 }
 
 void USBHostManager::xinput_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t controllerType, uint8_t subtype) {
-    if ( listeners.size() == 0 ) return;
-    for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
-        (*it)->xmount(dev_addr, instance, controllerType, subtype);
+    USBHostRoute* route = addRoute(USB_HOST_ROUTE_XINPUT, dev_addr, instance);
+    if ( route == nullptr ) return;
+    for( std::vector<PrioritizedListener>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
+        if ( it->listener->xmount(dev_addr, instance, controllerType, subtype) ) {
+            route->listener = it->listener;
+            return;
+        }
     }
 }
 
-void USBHostManager::xinput_umount_cb(uint8_t dev_addr) {
-    if ( listeners.size() == 0 ) return;
-    for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
-        (*it)->unmount(dev_addr);
-    }
+void USBHostManager::xinput_umount_cb(uint8_t dev_addr, uint8_t instance) {
+    removeRoute(findRoute(USB_HOST_ROUTE_XINPUT, dev_addr, instance));
 }
 
 void USBHostManager::xinput_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {
-    if ( listeners.size() == 0 ) return;
-    for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
-        (*it)->report_received(dev_addr, instance, report, len);
+    USBHostRoute* route = findRoute(USB_HOST_ROUTE_XINPUT, dev_addr, instance);
+    if ( route == nullptr ) return;
+    if ( route->listener == nullptr ) {
+        route->reportsDropped++;
+        return;
     }
+
+    route->reportsReceived++;
+    route->listener->report_received(dev_addr, instance, report, len);
 }
 
 void USBHostManager::xinput_report_sent_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {
-    if ( listeners.size() == 0 ) return;
-    for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
-        (*it)->report_sent(dev_addr, instance, report, len);
-    }
+    USBHostRoute* route = findRoute(USB_HOST_ROUTE_XINPUT, dev_addr, instance);
+    if ( route == nullptr || route->listener == nullptr ) return;
+    route->listener->report_sent(dev_addr, instance, report, len);
 }
 
 void tuh_hid_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len)
 {
-    USBHostManager::getInstance().hid_mount_cb(dev_addr, instance, desc_report, desc_len);
-    if ( !tuh_hid_receive_report(dev_addr, instance) ) {
-        // Error: cannot request report
+    // Interfaces no listener claimed are never polled
+    if ( USBHostManager::getInstance().hid_mount_cb(dev_addr, instance, desc_report, desc_len) ) {
+        if ( !tuh_hid_receive_report(dev_addr, instance) ) {
+            // Error: cannot request report
+        }
     }
 }
 
@@ -140,11 +196,8 @@ void tuh_hid_umount_cb(uint8_t daddr, uint8_t instance)
 // Invoked when received report from device via interrupt endpoint
 void tuh_hid_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len)
 {
+    // Requests the next report once the listener handled this one
     USBHostManager::getInstance().hid_report_received_cb(dev_addr, instance, report, len);
-
-    if ( !tuh_hid_receive_report(dev_addr, instance) ) {
-        //Error: cannot request report
-    }
 }
 
 // On IN/OUT/FEATURE set report callback
@@ -168,7 +221,7 @@ void tuh_xinput_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t controllerT
 
 void tuh_xinput_umount_cb(uint8_t dev_addr, uint8_t instance) {
     // send to xinput_unmount_cb in usb host manager
-    USBHostManager::getInstance().xinput_umount_cb(dev_addr);
+    USBHostManager::getInstance().xinput_umount_cb(dev_addr, instance);
 }
 
 void tuh_xinput_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const *report, uint16_t len) {
@@ -1,26 +1,41 @@
 #include "config.pb.h"
 #include "base64.h"
 #include "hardware/adc.h"
+#include "hardware/clocks.h"
 #include "helper.h"
 
 #include "drivermanager.h"
 #include "storagemanager.h"
 #include "eventmanager.h"
+#include "loopprofiler.h"
+#include "latencytracker.h"
+#include "drivers/shared/reportsender.h"
+#include "boottimeline.h"
+#include "inputtrace.h"
+#include "webresponse.h"
+#include "FlashPROM.h"
+#include "CRC32.h"
 #include "layoutmanager.h"
 #include "peripheralmanager.h"
+#include "usbhostmanager.h"
 #include "animationstorage.h"
 #include "system.h"
 #include "config_utils.h"
 #include "types.h"
 #include "version.h"
 
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdio>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
-#include <set>
 
 #include <pico/types.h>
+#include "pico/rand.h"
 
 // for hall-effect calibration
 #include "hardware/adc.h"
@@ -42,12 +57,48 @@
 
 extern struct fsdata_file file__index_html[];
 
-const static char* spaPaths[] = { "/backup", "/display-config", "/led-config", "/pin-mapping", "/settings", "/reset-settings", "/add-ons", "/custom-theme", "/macro", "/peripheral-mapping" };
-const static char* excludePaths[] = { "/css", "/images", "/js", "/static" };
 const static uint32_t rebootDelayMs = 500;
 static string http_post_uri;
 static char http_post_payload[LWIP_HTTPD_POST_MAX_PAYLOAD_LEN];
 static uint16_t http_post_payload_len = 0;
+static bool http_post_opening = false;
+
+// Routes of the web server, other than the files from fsdata. Declared in one list at the end of the file
+// with their methods, flags and POST size limit, and looked up by binary search in a copy sorted at build time.
+enum ApiMethod : uint8_t
+{
+    API_GET  = 0x01,
+    API_POST = 0x02,
+    API_ANY  = API_GET | API_POST,
+};
+
+enum ApiRouteFlags : uint8_t
+{
+    API_WRITES_CONFIG = 0x01,   // Changes the config, the handler triggers the save
+    API_CONFIG_ETAG   = 0x02,   // Only depends on the config, the client's copy stays valid until it changes
+    API_PREFIX        = 0x04,   // Matches every path below it, the path ends with a '/'
+};
+
+#define API_PAYLOAD_SMALL 1024
+#define API_PAYLOAD_MAX LWIP_HTTPD_POST_MAX_PAYLOAD_LEN
+
+struct ApiRoute
+{
+    std::string_view path;
+    uint8_t methods;
+    uint8_t flags;
+    uint16_t maxPayload;        // Largest POST body accepted
+    int (*open)(struct fs_file* file, const char* name);
+};
+
+#define API_ROUTE(methods, path, handler, flags, maxPayload) \
+    ApiRoute{ path, methods, flags, maxPayload, [](struct fs_file* file, const char*) { return set_file_data(file, handler()); } }
+
+// Client side routes of the web config app, all served by index.html
+#define SPA_ROUTE(path) \
+    ApiRoute{ path, API_GET, 0, 0, [](struct fs_file* file, const char*) { fs_open_fsdata(file, file__index_html); return 1; } }
+
+static const ApiRoute* findRoute(std::string_view path);
 
 // Don't inline this function, we do not want to consume stack space in the calling function
 template <typename T, typename K>
@@ -213,13 +264,6 @@ static void __attribute__((noinline)) writeDoc(DynamicJsonDocument& doc, const K
 
 static int32_t cleanPin(int32_t pin) { return isValidPin(pin) ? pin : -1; }
 
-enum class HttpStatusCode
-{
-    _200,
-    _400,
-    _500,
-};
-
 struct DataAndStatusCode
 {
     DataAndStatusCode(string&& data, HttpStatusCode statusCode) :
@@ -232,41 +276,24 @@ struct DataAndStatusCode
 };
 
 // **** WEB SERVER Overrides and Special Functionality ****
-int set_file_data(fs_file* file, const DataAndStatusCode& dataAndStatusCode)
-{
-    static string returnData;
 
-    const char* statusCodeStr = "";
-    switch (dataAndStatusCode.statusCode)
-    {
-        case HttpStatusCode::_200: statusCodeStr = "200 OK"; break;
-        case HttpStatusCode::_400: statusCodeStr = "400 Bad Request"; break;
-        case HttpStatusCode::_500: statusCodeStr = "500 Internal Server Error"; break;
-    }
-
-    returnData.clear();
-    returnData.append("HTTP/1.0 ");
-    returnData.append(statusCodeStr);
-    returnData.append("\r\n");
-    returnData.append(
-        "Server: GP2040-CE " GP2040VERSION "\r\n"
-        "Content-Type: application/json\r\n"
-        "Access-Control-Allow-Origin: *\r\n"
-        "Content-Length: "
-    );
-    returnData.append(std::to_string(dataAndStatusCode.data.length()));
-    returnData.append("\r\n\r\n");
-    returnData.append(dataAndStatusCode.data);
-
-    file->data = returnData.c_str();
-    file->len = returnData.size();
-    file->index = file->len;
-    file->http_header_included = file->http_header_included;
-    file->pextension = NULL;
+static int set_file_data(fs_file* file, WebResponse* response)
+{
+    // No file data, httpd pulls the response through fs_read_custom() and fs_close_custom() frees it
+    file->data = NULL;
+    file->len = response->getLength();
+    file->index = 0;
+    file->http_header_included = 1;
+    file->pextension = response;
 
     return 1;
 }
 
+int set_file_data(fs_file* file, DataAndStatusCode&& dataAndStatusCode)
+{
+    return set_file_data(file, new WebResponse(std::move(dataAndStatusCode.data), dataAndStatusCode.statusCode));
+}
+
 int set_file_data(fs_file *file, string&& data)
 {
     if (data.empty())
@@ -274,6 +301,18 @@ int set_file_data(fs_file *file, string&& data)
     return set_file_data(file, DataAndStatusCode(std::move(data), HttpStatusCode::_200));
 }
 
+int set_file_data(fs_file *file, DynamicJsonDocument&& doc)
+{
+    // A document without any capacity means there is nothing to respond with
+    if (doc.capacity() == 0)
+        return 0;
+    // Serialized once, into a body of exactly its size, the document goes as soon as this returns
+    string body;
+    body.reserve(measureJson(doc));
+    serializeJson(doc, body);
+    return set_file_data(file, new WebResponse(std::move(body), HttpStatusCode::_200));
+}
+
 DynamicJsonDocument get_post_data()
 {
     DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
@@ -331,12 +370,12 @@ err_t httpd_post_begin(void *connection, const char *uri, const char *http_reque
 {
     LWIP_UNUSED_ARG(http_request);
     LWIP_UNUSED_ARG(http_request_len);
-    LWIP_UNUSED_ARG(content_len);
     LWIP_UNUSED_ARG(response_uri);
     LWIP_UNUSED_ARG(response_uri_len);
     LWIP_UNUSED_ARG(post_auto_wnd);
 
-    if (!uri || strncmp(uri, "/api", 4) != 0) {
+    const ApiRoute* route = uri ? findRoute(uri) : nullptr;
+    if (!route || !(route->methods & API_POST) || content_len < 0 || content_len > route->maxPayload) {
         return ERR_ARG;
     }
 
@@ -387,6 +426,7 @@ void httpd_post_finished(void *connection, char *response_uri, uint16_t response
     if (http_post_payload_len != 0xffff) {
         strncpy(response_uri, http_post_uri.c_str(), response_uri_len);
         response_uri[response_uri_len - 1] = '\0';
+        http_post_opening = true;
     }
 }
 
@@ -405,22 +445,15 @@ void addUsedPinsArray(DynamicJsonDocument& doc)
     }
 }
 
-std::string serialize_json(DynamicJsonDocument &doc)
-{
-    std::string data;
-    serializeJson(doc, data);
-    return data;
-}
-
-std::string getUsedPins()
+DynamicJsonDocument getUsedPins()
 {
     const size_t capacity = JSON_OBJECT_SIZE(100);
     DynamicJsonDocument doc(capacity);
     addUsedPinsArray(doc);
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setDisplayOptions(DisplayOptions& displayOptions)
+DynamicJsonDocument setDisplayOptions(DisplayOptions& displayOptions)
 {
     DynamicJsonDocument doc = get_post_data();
     readDoc(displayOptions.enabled, doc, "enabled");
@@ -458,23 +491,23 @@ std::string setDisplayOptions(DisplayOptions& displayOptions)
     readDoc(displayOptions.buttonLayoutCustomOptions.paramsRight.common.buttonRadius, doc, "buttonLayoutCustomOptions", "paramsRight", "buttonRadius");
     readDoc(displayOptions.buttonLayoutCustomOptions.paramsRight.common.buttonPadding, doc, "buttonLayoutCustomOptions", "paramsRight", "buttonPadding");
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setDisplayOptions()
+DynamicJsonDocument setDisplayOptions()
 {
-    std::string response = setDisplayOptions(Storage::getInstance().getDisplayOptions());
+    DynamicJsonDocument response = setDisplayOptions(Storage::getInstance().getDisplayOptions());
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
     return response;
 }
 
-std::string setPreviewDisplayOptions()
+DynamicJsonDocument setPreviewDisplayOptions()
 {
-    std::string response = setDisplayOptions(Storage::getInstance().getDisplayOptions());
+    DynamicJsonDocument response = setDisplayOptions(Storage::getInstance().getDisplayOptions());
     return response;
 }
 
-std::string getDisplayOptions() // Manually set Document Attributes for the display
+DynamicJsonDocument getDisplayOptions() // Manually set Document Attributes for the display
 {
     const size_t capacity = JSON_OBJECT_SIZE(100);
     DynamicJsonDocument doc(capacity);
@@ -514,20 +547,20 @@ std::string getDisplayOptions() // Manually set Document Attributes for the disp
     writeDoc(doc, "buttonLayoutCustomOptions", "paramsRight", "buttonRadius", displayOptions.buttonLayoutCustomOptions.paramsRight.common.buttonRadius);
     writeDoc(doc, "buttonLayoutCustomOptions", "paramsRight", "buttonPadding", displayOptions.buttonLayoutCustomOptions.paramsRight.common.buttonPadding);
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getSplashImage()
+DynamicJsonDocument getSplashImage()
 {
     const DisplayOptions& displayOptions = Storage::getInstance().getDisplayOptions();
     const size_t capacity = JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(displayOptions.splashImage.size);
     DynamicJsonDocument doc(capacity);
     JsonArray splashImageArray = doc.createNestedArray("splashImage");
     copyArray(displayOptions.splashImage.bytes, displayOptions.splashImage.size, splashImageArray);
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setSplashImage()
+DynamicJsonDocument setSplashImage()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -543,10 +576,10 @@ std::string setSplashImage()
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setProfileOptions()
+DynamicJsonDocument setProfileOptions()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -587,10 +620,10 @@ std::string setProfileOptions()
     }
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getProfileOptions()
+DynamicJsonDocument getProfileOptions()
 {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
@@ -647,10 +680,10 @@ std::string getProfileOptions()
         doc["alternativePinMappings"][i]["enabled"] = profileOptions.gpioMappingsSets[i].enabled;
     }
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setGamepadOptions()
+DynamicJsonDocument setGamepadOptions()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -665,6 +698,7 @@ std::string setGamepadOptions()
     readDoc(gamepadOptions.fourWayMode, doc, "fourWayMode");
     readDoc(gamepadOptions.profileNumber, doc, "profileNumber");
     readDoc(gamepadOptions.debounceDelay, doc, "debounceDelay");
+    readDoc(gamepadOptions.debounceMode, doc, "debounceMode");
     readDoc(gamepadOptions.inputModeB1, doc, "inputModeB1");
     readDoc(gamepadOptions.inputModeB2, doc, "inputModeB2");
     readDoc(gamepadOptions.inputModeB3, doc, "inputModeB3");
@@ -679,6 +713,7 @@ std::string setGamepadOptions()
     readDoc(gamepadOptions.ps4ControllerIDMode, doc, "ps4ControllerIDMode");
     readDoc(gamepadOptions.usbDescOverride, doc, "usbDescOverride");
     readDoc(gamepadOptions.miniMenuGamepadInput, doc, "miniMenuGamepadInput");
+    readDoc(gamepadOptions.fastBoot, doc, "fastBoot");
     // Copy USB descriptor strings
     size_t strSize = sizeof(gamepadOptions.usbDescManufacturer);
     strncpy(gamepadOptions.usbDescManufacturer, doc["usbDescManufacturer"], strSize - 1);
@@ -717,10 +752,10 @@ std::string setGamepadOptions()
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getGamepadOptions()
+DynamicJsonDocument getGamepadOptions()
 {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
@@ -735,6 +770,7 @@ std::string getGamepadOptions()
     writeDoc(doc, "fourWayMode", gamepadOptions.fourWayMode ? 1 : 0);
     writeDoc(doc, "profileNumber", gamepadOptions.profileNumber);
     writeDoc(doc, "debounceDelay", gamepadOptions.debounceDelay);
+    writeDoc(doc, "debounceMode", gamepadOptions.debounceMode);
     writeDoc(doc, "inputModeB1", gamepadOptions.inputModeB1);
     writeDoc(doc, "inputModeB2", gamepadOptions.inputModeB2);
     writeDoc(doc, "inputModeB3", gamepadOptions.inputModeB3);
@@ -753,6 +789,7 @@ std::string getGamepadOptions()
     writeDoc(doc, "usbDescVersion", gamepadOptions.usbDescVersion);
     writeDoc(doc, "usbOverrideID", gamepadOptions.usbOverrideID);
     writeDoc(doc, "miniMenuGamepadInput", gamepadOptions.miniMenuGamepadInput);
+    writeDoc(doc, "fastBoot", gamepadOptions.fastBoot ? 1 : 0);
     // Write USB Vendor ID and Product ID as 4 character hex strings with 0 padding
     char usbVendorStr[5];
     snprintf(usbVendorStr, 5, "%04X", gamepadOptions.usbVendorID);
@@ -788,10 +825,10 @@ std::string getGamepadOptions()
 
     ForcedSetupOptions& forcedSetupOptions = Storage::getInstance().getForcedSetupOptions();
     writeDoc(doc, "forcedSetupMode", forcedSetupOptions.mode);
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setLedOptions()
+DynamicJsonDocument setLedOptions()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -845,10 +882,10 @@ std::string setLedOptions()
     readDoc(ledOptions.caseRGBCount, doc, "caseRGBCount");
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getLedOptions()
+DynamicJsonDocument getLedOptions()
 {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
@@ -904,10 +941,10 @@ std::string getLedOptions()
     writeDoc(doc, "caseRGBIndex", ledOptions.caseRGBIndex);
     writeDoc(doc, "caseRGBCount", ledOptions.caseRGBCount);
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getButtonLayoutDefs()
+DynamicJsonDocument getButtonLayoutDefs()
 {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
@@ -923,10 +960,10 @@ std::string getButtonLayoutDefs()
         if ((rightLayout.size() > 0) || (layoutCtr == ButtonLayoutRight::BUTTON_LAYOUT_BLANKB)) writeDoc(doc, "buttonLayoutRight", LayoutManager::getInstance().getButtonLayoutRightName((ButtonLayoutRight)layoutCtr), layoutCtr);
     }
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getButtonLayouts()
+DynamicJsonDocument getButtonLayouts()
 {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
@@ -997,10 +1034,10 @@ std::string getButtonLayouts()
         writeDoc(doc, "displayLayouts", "buttonLayoutRight", std::to_string(elementCtr), ele);
     }
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setCustomTheme()
+DynamicJsonDocument setCustomTheme()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -1059,10 +1096,10 @@ std::string setCustomTheme()
     options.buttonPressColorCooldownTimeInMs = pressCooldown;
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getCustomTheme()
+DynamicJsonDocument getCustomTheme()
 {
     const size_t capacity = JSON_OBJECT_SIZE(100);
     DynamicJsonDocument doc(capacity);
@@ -1107,10 +1144,10 @@ std::string getCustomTheme()
     writeDoc(doc, "R3", "d", options.customThemeR3Pressed);
     writeDoc(doc, "buttonPressColorCooldownTimeInMs", options.buttonPressColorCooldownTimeInMs);
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setPinMappings()
+DynamicJsonDocument setPinMappings()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -1136,10 +1173,10 @@ std::string setPinMappings()
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getPinMappings()
+DynamicJsonDocument getPinMappings()
 {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
@@ -1187,10 +1224,10 @@ std::string getPinMappings()
     writeDoc(doc, "profileLabel", gpioMappings.profileLabel);
     doc["enabled"] = gpioMappings.enabled;
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setKeyMappings()
+DynamicJsonDocument setKeyMappings()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -1231,10 +1268,10 @@ std::string setKeyMappings()
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getKeyMappings()
+DynamicJsonDocument getKeyMappings()
 {
     const size_t capacity = JSON_OBJECT_SIZE(100);
     DynamicJsonDocument doc(capacity);
@@ -1273,10 +1310,10 @@ std::string getKeyMappings()
     writeDoc(doc, "E11", keyboardMapping.keyButtonE11);
     writeDoc(doc, "E12", keyboardMapping.keyButtonE12);
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getPeripheralOptions()
+DynamicJsonDocument getPeripheralOptions()
 {
     const size_t capacity = JSON_OBJECT_SIZE(100);
     DynamicJsonDocument doc(capacity);
@@ -1309,10 +1346,10 @@ std::string getPeripheralOptions()
     writeDoc(doc, "peripheral", "usb0", "enable5v",peripheralOptions.blockUSB0.enable5v);
     writeDoc(doc, "peripheral", "usb0", "order",   peripheralOptions.blockUSB0.order);
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getI2CPeripheralMap() {
+DynamicJsonDocument getI2CPeripheralMap() {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
 
@@ -1332,10 +1369,10 @@ std::string getI2CPeripheralMap() {
         }
     }
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setPeripheralOptions()
+DynamicJsonDocument setPeripheralOptions()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -1393,10 +1430,10 @@ std::string setPeripheralOptions()
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getExpansionPins()
+DynamicJsonDocument getExpansionPins()
 {
     const size_t capacity = JSON_OBJECT_SIZE(100);
     DynamicJsonDocument doc(capacity);
@@ -1433,10 +1470,10 @@ std::string getExpansionPins()
     writeDoc(doc, "pins", "pcf8575", 0, "pin14", "direction", gpioMappings[14].direction);
     writeDoc(doc, "pins", "pcf8575", 0, "pin15", "option", gpioMappings[15].action);
     writeDoc(doc, "pins", "pcf8575", 0, "pin15", "direction", gpioMappings[15].direction);
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setExpansionPins()
+DynamicJsonDocument setExpansionPins()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -1458,7 +1495,7 @@ std::string setExpansionPins()
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
 
-    return serialize_json(doc);
+    return doc;
 }
 
 static uint32_t calibrationMuxChannels = 0;
@@ -1470,7 +1507,7 @@ static float ema_smoothing;
 static uint32_t smoothingRead = 0;
 
 // Get the HE Trigger Calibration using our manual GPIO input and everything
-std::string setHETriggerCalibration()
+DynamicJsonDocument setHETriggerCalibration()
 {
     DynamicJsonDocument doc = get_post_data();
     calibrationMuxChannels = doc["muxChannels"];
@@ -1503,7 +1540,7 @@ std::string setHETriggerCalibration()
         }
     }
 
-    return serialize_json(doc);
+    return doc;
 }
 
 #define ADC_MAX ((1 << 12) - 1) // 4095
@@ -1514,7 +1551,7 @@ uint16_t emaCalculation(uint16_t value, uint16_t previous) {
 }
 
 // Get the HE Trigger Calibration using our manual GPIO input and everything
-std::string getHETriggerCalibration()
+DynamicJsonDocument getHETriggerCalibration()
 {
     DynamicJsonDocument postDoc = get_post_data();
     uint32_t id = postDoc["targetId"];
@@ -1526,7 +1563,7 @@ std::string getHETriggerCalibration()
     if (calibrationMuxChannels == 1) {
         if ( id > 3 ) {
             doc["error"] = "id out of range";
-            return serialize_json(doc);
+            return doc;
         }
         adcSelectPin = calibrationADCPins[id];
     } else if ( calibrationMuxChannels == 4) {
@@ -1534,7 +1571,7 @@ std::string getHETriggerCalibration()
         uint32_t channel = (id % 4);
         if ( adcNum > 3 ) {
             doc["error"] = "id out of 4-channel mux range";
-            return serialize_json(doc);
+            return doc;
         }
         adcSelectPin = calibrationADCPins[adcNum];
         gpio_put(calibrationSelectPins[0], channel & 0x01);
@@ -1544,7 +1581,7 @@ std::string getHETriggerCalibration()
         uint32_t channel = (id % 8);
         if ( adcNum > 2 ) {
             doc["error"] = "id out of 8-channel mux range";
-            return serialize_json(doc);
+            return doc;
         }
         adcSelectPin = calibrationADCPins[adcNum];
         gpio_put(calibrationSelectPins[0], channel & 0x01);
@@ -1555,7 +1592,7 @@ std::string getHETriggerCalibration()
         uint32_t channel = (id % 16);
         if ( adcNum > 1 ) {
             doc["error"] = "id out of 16-channel mux range";
-            return serialize_json(doc);
+            return doc;
         }
         adcSelectPin = calibrationADCPins[adcNum];
         gpio_put(calibrationSelectPins[0], channel & 0x01);
@@ -1564,12 +1601,12 @@ std::string getHETriggerCalibration()
         gpio_put(calibrationSelectPins[3], (channel >> 3) & 0x01);
     } else {
         doc["error"] = "mux channels incorrect";
-        return serialize_json(doc);
+        return doc;
     }
 
     if ( adcSelectPin < 26 || adcSelectPin > 29) {
         doc["error"] = "adc pin out of range";
-        return serialize_json(doc);
+        return doc;
     }
     adc_select_input(adcSelectPin-26);
     // Web-Config triggers getHECalibration every 50ms, game controller triggers <1ms
@@ -1584,10 +1621,10 @@ std::string getHETriggerCalibration()
     } else {
         doc["voltage"] = adc_read();
     }
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getHETriggerOptions()
+DynamicJsonDocument getHETriggerOptions()
 {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
@@ -1604,11 +1641,11 @@ std::string getHETriggerOptions()
         trigger["polarity"] = heTriggers[i].polarity;
     }
 
-    return serialize_json(doc);
+    return doc;
 }
 
 // Set Hall Effect Trigger Options
-std::string setHETriggerOptions()
+DynamicJsonDocument setHETriggerOptions()
 {
     DynamicJsonDocument doc = get_post_data();
     HETriggerInfo * heTriggers = Storage::getInstance().getAddonOptions().heTriggerOptions.triggers;
@@ -1624,11 +1661,11 @@ std::string setHETriggerOptions()
     Storage::getInstance().getAddonOptions().heTriggerOptions.triggers_count = 32;
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
 
-    return serialize_json(doc);
+    return doc;
 }
 
 
-std::string getReactiveLEDs()
+DynamicJsonDocument getReactiveLEDs()
 {
     const size_t capacity = JSON_OBJECT_SIZE(100);
     DynamicJsonDocument doc(capacity);
@@ -1641,10 +1678,10 @@ std::string getReactiveLEDs()
         writeDoc(doc, "leds", led, "modeUp", ledInfo[led].modeUp);
     }
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setReactiveLEDs()
+DynamicJsonDocument setReactiveLEDs()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -1660,10 +1697,10 @@ std::string setReactiveLEDs()
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setAddonOptions()
+DynamicJsonDocument setAddonOptions()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -1881,7 +1918,7 @@ std::string setAddonOptions()
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
 
-    return serialize_json(doc);
+    return doc;
 }
 
 std::string setPS4Options()
@@ -2040,7 +2077,7 @@ std::string setWiiControls()
     return "{\"success\":true}";
 }
 
-std::string getWiiControls()
+DynamicJsonDocument getWiiControls()
 {
     const size_t capacity = JSON_OBJECT_SIZE(100);
     DynamicJsonDocument doc(capacity);
@@ -2119,10 +2156,10 @@ std::string getWiiControls()
     writeDoc(doc, "turntable.analogEffects.axisType", wiiOptions.controllers.turntable.effects.axisType);
     writeDoc(doc, "turntable.analogFader.axisType", wiiOptions.controllers.turntable.fader.axisType);
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getAddonOptions()
+DynamicJsonDocument getAddonOptions()
 {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
@@ -2337,10 +2374,10 @@ std::string getAddonOptions()
     writeDoc(doc, "heTriggerSmoothing", heTriggerOptions.emaSmoothing);
     writeDoc(doc, "heTriggerSmoothingFactor", heTriggerOptions.smoothingFactor);
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string setMacroAddonOptions()
+DynamicJsonDocument setMacroAddonOptions()
 {
     DynamicJsonDocument doc = get_post_data();
 
@@ -2380,10 +2417,10 @@ std::string setMacroAddonOptions()
     macroOptions.macroList_count = MAX_MACRO_LIMIT;
 
     EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getMacroAddonOptions()
+DynamicJsonDocument getMacroAddonOptions()
 {
     const size_t capacity = JSON_OBJECT_SIZE(500);
     DynamicJsonDocument doc(capacity);
@@ -2413,10 +2450,10 @@ std::string getMacroAddonOptions()
         }
     }
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getFirmwareVersion()
+DynamicJsonDocument getFirmwareVersion()
 {
     const size_t capacity = JSON_OBJECT_SIZE(10);
     DynamicJsonDocument doc(capacity);
@@ -2427,10 +2464,10 @@ std::string getFirmwareVersion()
     writeDoc(doc, "boardConfigLabel", BOARD_CONFIG_LABEL);
     writeDoc(doc, "boardConfigFileName", BOARD_CONFIG_FILE_NAME);
     writeDoc(doc, "boardConfig", GP2040_BOARDCONFIG);
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string getMemoryReport()
+DynamicJsonDocument getMemoryReport()
 {
     const size_t capacity = JSON_OBJECT_SIZE(10);
     DynamicJsonDocument doc(capacity);
@@ -2440,73 +2477,189 @@ std::string getMemoryReport()
     writeDoc(doc, "staticAllocs", System::getStaticAllocs());
     writeDoc(doc, "totalHeap", System::getTotalHeap());
     writeDoc(doc, "usedHeap", System::getUsedHeap());
-    return serialize_json(doc);
+    return doc;
 }
 
-static bool _abortGetHeldPins = false;
+#if LOOP_PROFILER_ENABLED || LATENCY_TRACKER_ENABLED
+static void writeLoopProfileStat(JsonObject o, const LoopProfileStat& stat)
+{
+    o["count"] = stat.count;
+    o["min"] = stat.count ? stat.min : 0;
+    o["avg"] = stat.average();
+    o["max"] = stat.max;
+    o["p99"] = stat.percentile(99);
+}
+#endif
 
-std::string getHeldPins()
+DynamicJsonDocument getLoopProfile()
 {
-    DynamicJsonDocument doc(JSON_OBJECT_SIZE(100));
+#if LOOP_PROFILER_ENABLED
+    const LoopProfiler& profiler = LoopProfiler::getInstance();
+    const size_t capacity = JSON_OBJECT_SIZE(4) + JSON_ARRAY_SIZE(LOOP_STAGE_COUNT) + LOOP_STAGE_COUNT * JSON_OBJECT_SIZE(6)
+        + JSON_ARRAY_SIZE(LOOP_PROFILER_MAX_ADDONS) + LOOP_PROFILER_MAX_ADDONS * (JSON_OBJECT_SIZE(4) + LOOP_ADDON_PHASE_COUNT * JSON_OBJECT_SIZE(5));
+    DynamicJsonDocument doc(capacity);
+
+    writeDoc(doc, "enabled", true);
+    writeDoc(doc, "clockHz", clock_get_hz(clk_sys));
 
-    // Initialize unassigned pins for reading
-    std::vector<uint> uninitPins;
-    for (uint32_t pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
-        if (gpio_get_function(pin) == GPIO_FUNC_NULL) {
-            uninitPins.push_back(pin);
-            gpio_init(pin);
-            gpio_set_dir(pin, GPIO_IN);
-            gpio_pull_up(pin);
+    JsonArray stages = doc.createNestedArray("stages");
+    for (uint8_t stage = 0; stage < LOOP_STAGE_COUNT; stage++) {
+        JsonObject o = stages.createNestedObject();
+        o["name"] = LoopProfiler::getStageName((LoopStage)stage);
+        writeLoopProfileStat(o, profiler.getStage((LoopStage)stage));
+    }
+
+    JsonArray addons = doc.createNestedArray("addons");
+    for (uint8_t index = 0; index < profiler.getAddonCount(); index++) {
+        JsonObject o = addons.createNestedObject();
+        o["name"] = profiler.getAddonName(index);
+        for (uint8_t phase = 0; phase < LOOP_ADDON_PHASE_COUNT; phase++) {
+            writeLoopProfileStat(o.createNestedObject(LoopProfiler::getAddonPhaseName((LoopAddonPhase)phase)), profiler.getAddon(index, (LoopAddonPhase)phase));
         }
     }
+#else
+    DynamicJsonDocument doc(JSON_OBJECT_SIZE(1));
+    writeDoc(doc, "enabled", false);
+#endif
+    return doc;
+}
 
-    std::set<uint> heldPinsSet;
-    uint32_t startTime = getMillis();
-    uint32_t oldState = ~gpio_get_all();
-    uint32_t debounceTime = 0;
-    bool isAnyPinHeld = false;
+DynamicJsonDocument getLatencyStats()
+{
+#if LATENCY_TRACKER_ENABLED
+    const LatencyTracker& tracker = LatencyTracker::getInstance();
+    const size_t capacity = JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(LATENCY_TRACKER_MODES) + LATENCY_TRACKER_MODES * JSON_OBJECT_SIZE(6);
+    DynamicJsonDocument doc(capacity);
 
-    // Monitor pins for 5 seconds or until released
-    while (!_abortGetHeldPins && (isAnyPinHeld || (getMillis() - startTime) < 5000)) {
-        rndis_task();
+    writeDoc(doc, "enabled", true);
+
+    // Microseconds from GPIO edge to USB IN completion, for every input mode that has samples
+    JsonArray modes = doc.createNestedArray("modes");
+    for (uint8_t mode = 0; mode < LATENCY_TRACKER_MODES; mode++) {
+        const LoopProfileStat& stat = tracker.getStat((InputMode)mode);
+        if (stat.count == 0)
+            continue;
+        JsonObject o = modes.createNestedObject();
+        o["inputMode"] = mode;
+        writeLoopProfileStat(o, stat);
+    }
+#else
+    DynamicJsonDocument doc(JSON_OBJECT_SIZE(1));
+    writeDoc(doc, "enabled", false);
+#endif
+    return doc;
+}
 
-        uint32_t newState = ~gpio_get_all();
-        if (isAnyPinHeld && newState == oldState) break; // Pins released
+DynamicJsonDocument getReportStats()
+{
+    const size_t capacity = JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(REPORT_SENDER_MODES) + REPORT_SENDER_MODES * JSON_OBJECT_SIZE(4);
+    DynamicJsonDocument doc(capacity);
 
-        uint32_t changedPins = newState ^ oldState;
-        uint32_t currentTime = getMillis();
+    // ReportSender counters of every input mode that sent reports: reports handed to USB, pending reports
+    // replaced by a newer one and pending reports withdrawn because the state went back before they went out
+    JsonArray modes = doc.createNestedArray("modes");
+    for (uint8_t mode = 0; mode < REPORT_SENDER_MODES; mode++) {
+        const ReportSenderCounters& counters = ReportSender::getCounters((InputMode)mode);
+        if (counters.sent == 0 && counters.coalesced == 0 && counters.dropped == 0)
+            continue;
+        JsonObject o = modes.createNestedObject();
+        o["inputMode"] = mode;
+        o["sent"] = counters.sent;
+        o["coalesced"] = counters.coalesced;
+        o["dropped"] = counters.dropped;
+    }
+    return doc;
+}
 
-        for (uint32_t pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
-            if ((changedPins & (1 << pin)) &&
-                gpio_get_function(pin) == GPIO_FUNC_SIO &&
-                !gpio_is_dir_out(pin)) {
+static void writeBootTimeline(JsonObject o, uint32_t (*getStage)(BootStage))
+{
+    for (uint8_t stage = 0; stage < BOOT_STAGE_COUNT; stage++)
+        o[BootTimeline::getStageName((BootStage)stage)] = getStage((BootStage)stage);
+}
 
-                if (debounceTime == 0) debounceTime = currentTime;
-                if ((currentTime - debounceTime) > 5) { // 5ms debounce
-                    heldPinsSet.insert(pin);
-                    isAnyPinHeld = true;
-                }
-            }
-        }
-    }
+DynamicJsonDocument getBootTimeline()
+{
+    const BootTimeline& timeline = BootTimeline::getInstance();
+    const size_t capacity = JSON_OBJECT_SIZE(2) + 2 * JSON_OBJECT_SIZE(BOOT_STAGE_COUNT);
+    DynamicJsonDocument doc(capacity);
 
-    for (uint32_t pin : uninitPins) gpio_deinit(pin);
+    // Microseconds since reset for every stage, 0 for stages that were not reached. "current" is this
+    // (web config) boot, "last" the last gamepad mode boot, if the RAM holding it survived the reboot.
+    writeBootTimeline(doc.createNestedObject("current"), [](BootStage stage) { return BootTimeline::getInstance().get(stage); });
+    if (timeline.hasKept())
+        writeBootTimeline(doc.createNestedObject("last"), [](BootStage stage) { return BootTimeline::getInstance().getKept(stage); });
 
-    if (_abortGetHeldPins) {
-        _abortGetHeldPins = false;
-        return {};
-    }
+    return doc;
+}
 
-    auto heldPins = doc.createNestedArray("heldPins");
-    for (uint32_t pin : heldPinsSet) heldPins.add(pin);
+DynamicJsonDocument getUSBHostDevices()
+{
+    const USBHostManager& usbHostManager = USBHostManager::getInstance();
+    const size_t capacity = JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(USB_HOST_MAX_ROUTES) + USB_HOST_MAX_ROUTES * JSON_OBJECT_SIZE(8);
+    DynamicJsonDocument doc(capacity);
+
+    // Every mounted HID and X-Input interface, whether a listener claimed it and what its reports did
+    JsonArray devices = doc.createNestedArray("devices");
+    for (uint8_t i = 0; i < USB_HOST_MAX_ROUTES; i++) {
+        const USBHostRoute& route = usbHostManager.getRoute(i);
+        if (route.type == USB_HOST_ROUTE_NONE)
+            continue;
+        JsonObject o = devices.createNestedObject();
+        o["address"] = route.dev_addr;
+        o["instance"] = route.instance;
+        o["type"] = (route.type == USB_HOST_ROUTE_XINPUT) ? "xinput" : "hid";
+        o["vid"] = route.vid;
+        o["pid"] = route.pid;
+        o["claimed"] = route.listener != nullptr;
+        o["received"] = route.reportsReceived;
+        o["dropped"] = route.reportsDropped;
+    }
 
-    return serialize_json(doc);
+    return doc;
 }
 
-std::string abortGetHeldPins()
+WebResponse* getInputTrace()
 {
-    _abortGetHeldPins = true;
-    return {};
+    // POST { "since": <first sequence the client has not seen>, "intervalUs": <sample interval>,
+    // "adcInputs": <ADC inputs to set up for the stick view>, "unusedPins": <pull up the unused pins to capture
+    // a held button> }, every poll keeps the trace running. Never waits for new frames, an empty batch means
+    // none were recorded yet. A small body, parsed on the stack so a fast poller does not churn the heap
+    uint32_t since = 0;
+    uint32_t intervalUs = INPUT_TRACE_DEFAULT_INTERVAL_US;
+    uint8_t adcInputs = 0;
+    bool unusedPins = false;
+    if (http_post_payload_len != 0xffff)
+    {
+        StaticJsonDocument<JSON_OBJECT_SIZE(4)> postDoc;
+        deserializeJson(postDoc, http_post_payload, http_post_payload_len);
+        since = postDoc["since"] | since;
+        intervalUs = postDoc["intervalUs"] | intervalUs;
+        adcInputs = postDoc["adcInputs"] | adcInputs;
+        unusedPins = postDoc["unusedPins"] | unusedPins;
+    }
+
+    InputTrace& inputTrace = InputTrace::getInstance();
+    inputTrace.poll(intervalUs, adcInputs, unusedPins);
+
+    const uint32_t first = std::max(since, inputTrace.getOldestSequence());
+    const uint32_t last = inputTrace.getSequence();
+    const uint16_t frameCount = (first < last) ? (last - first) : 0;
+
+    InputTraceBatchHeader header;
+    header.firstSequence = (first < last) ? first : last;
+    header.frameCount = frameCount;
+    header.frameSize = sizeof(InputTraceFrame);
+    header.intervalUs = inputTrace.getInterval();
+    header.inputPins = inputTrace.getInputPins();
+
+    // Copied out, the loop keeps overwriting the ring while httpd sends the response
+    string body;
+    body.reserve(sizeof(header) + frameCount * sizeof(InputTraceFrame));
+    body.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (uint32_t sequence = header.firstSequence; sequence < last; sequence++)
+        body.append(reinterpret_cast<const char*>(&inputTrace.getFrame(sequence)), sizeof(InputTraceFrame));
+
+    return new WebResponse(std::move(body), HttpStatusCode::_200, "application/octet-stream");
 }
 
 std::string getConfig()
@@ -2538,21 +2691,90 @@ DataAndStatusCode setConfig()
     }
 }
 
+// Sparse JSON holding only the changed fields, see ConfigUtils::patchJSON
+DataAndStatusCode patchConfig()
+{
+    if (http_post_payload_len == 0xffff ||
+        !ConfigUtils::patchJSON(Storage::getInstance().getConfig(), http_post_payload, http_post_payload_len))
+    {
+        return DataAndStatusCode("{ \"error\": \"invalid config patch\" }", HttpStatusCode::_400);
+    }
+
+    // One save for the whole patch, the core0 loop merges it with other saves requested before it runs
+    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    return DataAndStatusCode("{ \"success\": true }", HttpStatusCode::_200);
+}
+
+// The encoded config (the same bytes as in flash) followed by their CRC32, little endian
+WebResponse* getConfigBinary()
+{
+    // The latest record of the journal in flash, or of the write cache while a save is pending. Copied, a save or a
+    // journal reclaim can replace either while httpd is still sending the response.
+    uint32_t size = 0;
+    const uint8_t* data = EEPROM.getLatestData(size);
+    if (data == nullptr)
+    {
+        // Nothing journaled yet (first boot, or still in the pre-journal format), encode what was loaded
+        std::string encoded = ConfigUtils::toBinary(Storage::getInstance().getConfig());
+        const uint32_t crc = CRC32::calculate(reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size());
+        encoded.append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+        return new WebResponse(std::move(encoded), HttpStatusCode::_200, "application/octet-stream");
+    }
+
+    std::string record(reinterpret_cast<const char*>(data), size);
+    const uint32_t crc = CRC32::calculate(data, size);
+    record.append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+    return new WebResponse(std::move(record), HttpStatusCode::_200, "application/octet-stream");
+}
+
+DataAndStatusCode setConfigBinary()
+{
+    uint32_t crc = 0;
+    if (http_post_payload_len == 0xffff || http_post_payload_len <= sizeof(crc))
+    {
+        return DataAndStatusCode("{ \"error\": \"invalid config data\" }", HttpStatusCode::_400);
+    }
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(http_post_payload);
+    const size_t size = http_post_payload_len - sizeof(crc);
+    memcpy(&crc, data + size, sizeof(crc));
+    if (CRC32::calculate(data, size) != crc)
+    {
+        return DataAndStatusCode("{ \"error\": \"config CRC mismatch\" }", HttpStatusCode::_400);
+    }
+
+    // Store config struct on the heap to avoid stack overflow
+    std::unique_ptr<Config> config(new Config);
+    *config.get() = Config Config_init_default;
+    if (!ConfigUtils::fromBinary(*config.get(), data, size))
+    {
+        return DataAndStatusCode("{ \"error\": \"invalid config data\" }", HttpStatusCode::_400);
+    }
+
+    Storage::getInstance().getConfig() = *config.get();
+    config.reset();
+    if (!Storage::getInstance().save(true))
+    {
+        return DataAndStatusCode("{ \"error\": \"internal error while saving config\" }", HttpStatusCode::_500);
+    }
+    return DataAndStatusCode("{ \"success\": true }", HttpStatusCode::_200);
+}
+
 // This should be a storage feature
-std::string resetSettings()
+DynamicJsonDocument resetSettings()
 {
     Storage::getInstance().ResetSettings();
     const size_t capacity = JSON_OBJECT_SIZE(10);
     DynamicJsonDocument doc(capacity);
     doc["success"] = true;
-    return serialize_json(doc);
+    return doc;
 }
 
 #if !defined(NDEBUG)
-std::string echo()
+DynamicJsonDocument echo()
 {
     DynamicJsonDocument doc = get_post_data();
-    return serialize_json(doc);
+    return doc;
 }
 #endif
 
@@ -2563,7 +2785,7 @@ enum BOOT_MODES {
 	BOOTSEL = 2,
 };
 
-std::string reboot() {
+DynamicJsonDocument reboot() {
     DynamicJsonDocument doc = get_post_data();
     uint32_t bootMode = doc["bootMode"];
     System::BootMode systemBootMode = System::BootMode::DEFAULT;
@@ -2576,202 +2798,213 @@ std::string reboot() {
     }
     EventManager::getInstance().triggerEvent(new GPRestartEvent((System::BootMode)systemBootMode));
     doc["success"] = true;
-    return serialize_json(doc);
+    return doc;
 }
 
-// NEW API: return current raw ADC reading for the configured analog pins
-std:: string getJoystickCenter() {
-    const size_t capacity = JSON_OBJECT_SIZE(10);
-    DynamicJsonDocument doc(capacity);
-    const AnalogOptions& analogOptions = Storage::getInstance().getAddonOptions().analogOptions;
-    
-    uint16_t x = 0, y = 0;
-    bool success = true;
-    std::string error_msg = "";
-    
-    // Check if analog input is enabled
-    if (!analogOptions.enabled) {
-        success = false;
-        error_msg = "Analog input is not enabled";
-    } else {
-        // Initialize ADC if not already initialized
-        adc_init();
-        
-        // Check if specific stick is requested via query parameter
-        // For now, we'll read both sticks and return the appropriate one
-        // In a more sophisticated implementation, we could parse query parameters
-        
-        // Read first stick X/Y
-        if (isValidPin(analogOptions.analogAdc1PinX)) {
-            adc_gpio_init(analogOptions.analogAdc1PinX);
-            adc_select_input(analogOptions.analogAdc1PinX - 26);
-            x = adc_read();
-        }
-        if (isValidPin(analogOptions.analogAdc1PinY)) {
-            adc_gpio_init(analogOptions.analogAdc1PinY);
-            adc_select_input(analogOptions.analogAdc1PinY - 26);
-            y = adc_read();
-        }
-    }
-    
-    JsonObject o = doc.to<JsonObject>();
-    o["success"] = success;
-    if (!success) {
-        o["error"] = error_msg;
-    } else {
-        o["x"] = x;
-        o["y"] = y;
+// **** API routes ****
+
+// In any order, sorted at build time
+static constexpr ApiRoute apiRouteList[] =
+{
+    API_ROUTE(API_POST, "/api/setDisplayOptions", setDisplayOptions, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setPreviewDisplayOptions", setPreviewDisplayOptions, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setGamepadOptions", setGamepadOptions, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setLedOptions", setLedOptions, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setCustomTheme", setCustomTheme, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_GET, "/api/getCustomTheme", getCustomTheme, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_POST, "/api/setPinMappings", setPinMappings, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setProfileOptions", setProfileOptions, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setPeripheralOptions", setPeripheralOptions, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_GET, "/api/getPeripheralOptions", getPeripheralOptions, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getI2CPeripheralMap", getI2CPeripheralMap, 0, 0),
+    API_ROUTE(API_POST, "/api/setExpansionPins", setExpansionPins, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_GET, "/api/getExpansionPins", getExpansionPins, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_POST, "/api/setHETriggerOptions", setHETriggerOptions, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_GET, "/api/getHETriggerOptions", getHETriggerOptions, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_POST, "/api/getHETriggerCalibration", getHETriggerCalibration, 0, API_PAYLOAD_SMALL),
+    API_ROUTE(API_POST, "/api/setHETriggerCalibration", setHETriggerCalibration, 0, API_PAYLOAD_SMALL),
+    API_ROUTE(API_POST, "/api/setReactiveLEDs", setReactiveLEDs, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_GET, "/api/getReactiveLEDs", getReactiveLEDs, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_POST, "/api/setKeyMappings", setKeyMappings, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setAddonsOptions", setAddonOptions, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setMacroAddonOptions", setMacroAddonOptions, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setSplashImage", setSplashImage, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_ANY, "/api/reboot", reboot, 0, API_PAYLOAD_SMALL),
+    API_ROUTE(API_GET, "/api/getDisplayOptions", getDisplayOptions, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getGamepadOptions", getGamepadOptions, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getButtonLayoutDefs", getButtonLayoutDefs, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getButtonLayouts", getButtonLayouts, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getLedOptions", getLedOptions, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getPinMappings", getPinMappings, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getProfileOptions", getProfileOptions, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getKeyMappings", getKeyMappings, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getAddonsOptions", getAddonOptions, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getWiiControls", getWiiControls, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getMacroAddonOptions", getMacroAddonOptions, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/resetSettings", resetSettings, API_WRITES_CONFIG, 0),
+    API_ROUTE(API_GET, "/api/getSplashImage", getSplashImage, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getFirmwareVersion", getFirmwareVersion, 0, 0),
+    API_ROUTE(API_GET, "/api/getMemoryReport", getMemoryReport, 0, 0),
+    API_ROUTE(API_GET, "/api/getLoopProfile", getLoopProfile, 0, 0),
+    API_ROUTE(API_GET, "/api/getLatencyStats", getLatencyStats, 0, 0),
+    API_ROUTE(API_GET, "/api/getReportStats", getReportStats, 0, 0),
+    API_ROUTE(API_GET, "/api/getBootTimeline", getBootTimeline, 0, 0),
+    API_ROUTE(API_GET, "/api/getUSBHostDevices", getUSBHostDevices, 0, 0),
+    API_ROUTE(API_GET, "/api/getUsedPins", getUsedPins, API_CONFIG_ETAG, 0),
+#if !defined(NDEBUG)
+    API_ROUTE(API_ANY, "/api/echo", echo, 0, API_PAYLOAD_MAX),
+#endif
+    API_ROUTE(API_POST, "/api/setPS4Options", setPS4Options, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setWiiControls", setWiiControls, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_GET, "/api/getConfig", getConfig, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_GET, "/api/getConfigBinary", getConfigBinary, API_CONFIG_ETAG, 0),
+    API_ROUTE(API_POST, "/api/getInputTrace", getInputTrace, 0, API_PAYLOAD_SMALL),
+    API_ROUTE(API_POST, "/api/setConfig", setConfig, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/setConfigBinary", setConfigBinary, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    API_ROUTE(API_POST, "/api/patchConfig", patchConfig, API_WRITES_CONFIG, API_PAYLOAD_MAX),
+    SPA_ROUTE("/backup"),
+    SPA_ROUTE("/display-config"),
+    SPA_ROUTE("/led-config"),
+    SPA_ROUTE("/pin-mapping"),
+    SPA_ROUTE("/settings"),
+    SPA_ROUTE("/reset-settings"),
+    SPA_ROUTE("/add-ons"),
+    SPA_ROUTE("/custom-theme"),
+    SPA_ROUTE("/macro"),
+    SPA_ROUTE("/peripheral-mapping"),
+};
+
+template <size_t N>
+static constexpr std::array<ApiRoute, N> sortApiRoutes(const ApiRoute (&routes)[N])
+{
+    std::array<ApiRoute, N> sorted = {};
+    for (size_t i = 0; i < N; i++) {
+        size_t j = i;
+        for (; j > 0 && routes[i].path < sorted[j - 1].path; j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = routes[i];
     }
-    return serialize_json(doc);
+    return sorted;
 }
 
-// NEW API: return current raw ADC reading for stick 2
-std:: string getJoystickCenter2() {
-    const size_t capacity = JSON_OBJECT_SIZE(10);
-    DynamicJsonDocument doc(capacity);
-    const AnalogOptions& analogOptions = Storage::getInstance().getAddonOptions().analogOptions;
-    
-    uint16_t x = 0, y = 0;
-    bool success = true;
-    std::string error_msg = "";
-    
-    // Check if analog input is enabled
-    if (!analogOptions.enabled) {
-        success = false;
-        error_msg = "Analog input is not enabled";
-    } else {
-        // Initialize ADC if not already initialized
-        adc_init();
-        
-        // Read second stick X/Y
-        if (isValidPin(analogOptions.analogAdc2PinX)) {
-            adc_gpio_init(analogOptions.analogAdc2PinX);
-            adc_select_input(analogOptions.analogAdc2PinX - 26);
-            x = adc_read();
-        }
-        if (isValidPin(analogOptions.analogAdc2PinY)) {
-            adc_gpio_init(analogOptions.analogAdc2PinY);
-            adc_select_input(analogOptions.analogAdc2PinY - 26);
-            y = adc_read();
-        }
+template <size_t N>
+static constexpr bool validApiRoutes(const std::array<ApiRoute, N>& routes)
+{
+    for (size_t i = 0; i < N; i++) {
+        if (i > 0 && routes[i].path == routes[i - 1].path)
+            return false;
+        if ((routes[i].flags & API_PREFIX) && (routes[i].path.empty() || routes[i].path.back() != '/'))
+            return false;
     }
-    
-    JsonObject o = doc.to<JsonObject>();
-    o["success"] = success;
-    if (!success) {
-        o["error"] = error_msg;
-    } else {
-        o["x"] = x;
-        o["y"] = y;
-    }
-    return serialize_json(doc);
-}
-
-typedef std::string (*HandlerFuncPtr)();
-static const std::pair<const char*, HandlerFuncPtr> handlerFuncs[] =
-{
-    { "/api/setDisplayOptions", setDisplayOptions },
-    { "/api/setPreviewDisplayOptions", setPreviewDisplayOptions },
-    { "/api/setGamepadOptions", setGamepadOptions },
-    { "/api/setLedOptions", setLedOptions },
-    { "/api/setCustomTheme", setCustomTheme },
-    { "/api/getCustomTheme", getCustomTheme },
-    { "/api/setPinMappings", setPinMappings },
-    { "/api/setProfileOptions", setProfileOptions },
-    { "/api/setPeripheralOptions", setPeripheralOptions },
-    { "/api/getPeripheralOptions", getPeripheralOptions },
-    { "/api/getI2CPeripheralMap", getI2CPeripheralMap },
-    { "/api/setExpansionPins", setExpansionPins },
-    { "/api/getExpansionPins", getExpansionPins },
-    { "/api/setHETriggerOptions", setHETriggerOptions },
-    { "/api/getHETriggerOptions", getHETriggerOptions },
-    { "/api/getHETriggerCalibration", getHETriggerCalibration },
-    { "/api/setHETriggerCalibration", setHETriggerCalibration },
-    { "/api/setReactiveLEDs", setReactiveLEDs },
-    { "/api/getReactiveLEDs", getReactiveLEDs },
-    { "/api/setKeyMappings", setKeyMappings },
-    { "/api/setAddonsOptions", setAddonOptions },
-    { "/api/setMacroAddonOptions", setMacroAddonOptions },
-    { "/api/setPS4Options", setPS4Options },
-    { "/api/setWiiControls", setWiiControls },
-    { "/api/setSplashImage", setSplashImage },
-    { "/api/reboot", reboot },
-    { "/api/getDisplayOptions", getDisplayOptions },
-    { "/api/getGamepadOptions", getGamepadOptions },
-    { "/api/getButtonLayoutDefs", getButtonLayoutDefs },
-    { "/api/getButtonLayouts", getButtonLayouts },
-    { "/api/getLedOptions", getLedOptions },
-    { "/api/getPinMappings", getPinMappings },
-    { "/api/getProfileOptions", getProfileOptions },
-    { "/api/getKeyMappings", getKeyMappings },
-    { "/api/getAddonsOptions", getAddonOptions },
-    { "/api/getWiiControls", getWiiControls },
-    { "/api/getMacroAddonOptions", getMacroAddonOptions },
-    { "/api/resetSettings", resetSettings },
-    { "/api/getSplashImage", getSplashImage },
-    { "/api/getFirmwareVersion", getFirmwareVersion },
-    { "/api/getMemoryReport", getMemoryReport },
-    { "/api/getHeldPins", getHeldPins },
-    { "/api/abortGetHeldPins", abortGetHeldPins },
-    { "/api/getUsedPins", getUsedPins },
-    { "/api/getConfig", getConfig },
-    { "/api/getJoystickCenter", getJoystickCenter },
-    { "/api/getJoystickCenter2", getJoystickCenter2 },
-#if !defined(NDEBUG)
-    { "/api/echo", echo },
-#endif
-};
+    return true;
+}
+
+static constexpr auto apiRoutes = sortApiRoutes(apiRouteList);
+static_assert(validApiRoutes(apiRoutes), "API routes must be unique, prefix routes must end with a '/'");
 
-typedef DataAndStatusCode (*HandlerFuncStatusCodePtr)();
-static const std::pair<const char*, HandlerFuncStatusCodePtr> handlerFuncsWithStatusCode[] =
+static const ApiRoute* findExactRoute(std::string_view path)
 {
-    { "/api/setConfig", setConfig },
-};
+    const auto it = std::lower_bound(apiRoutes.begin(), apiRoutes.end(), path,
+        [](const ApiRoute& route, std::string_view value) { return route.path < value; });
+    return (it != apiRoutes.end() && it->path == path) ? &*it : nullptr;
+}
 
-int fs_open_custom(struct fs_file *file, const char *name)
+/**
+ * @brief Binary search for the route of a path, falling back to the longest prefix route above it.
+ */
+static const ApiRoute* findRoute(std::string_view path)
 {
-    for (const auto& handlerFunc : handlerFuncs)
+    const ApiRoute* route = findExactRoute(path);
+    if (route != nullptr)
+        return route;
+
+    for (size_t slash = path.rfind('/'); slash != std::string_view::npos && slash > 0; slash = path.rfind('/', slash - 1)) {
+        route = findExactRoute(path.substr(0, slash + 1));
+        if (route != nullptr && (route->flags & API_PREFIX))
+            return route;
+    }
+    return nullptr;
+}
+
+// Bumped by every request that may change the config
+static uint32_t configGeneration = 0;
+
+/**
+ * @brief Tag of the config the config endpoints answer from.
+ *
+ * Until a request changes the config it is the one loaded from flash, tagged by its CRC so a reload after
+ * a reboot still hits the browser cache. Changes (including previews that are never saved) get a tag that
+ * is unique to this boot.
+ */
+static void getConfigETag(char* etag, size_t size)
+{
+    static uint32_t bootConfigCrc = 0;
+    static bool hasBootConfigCrc = false;
+    static const uint32_t buildCrc = CRC32::calculate(reinterpret_cast<const uint8_t*>(GP2040VERSION), strlen(GP2040VERSION));
+    static const uint32_t bootNonce = get_rand_32();
+
+    if (!hasBootConfigCrc)
     {
-        if (strcmp(handlerFunc.first, name) == 0)
-        {
-            return set_file_data(file, handlerFunc.second());
-        }
+        uint32_t dataSize = 0;
+        const uint8_t* data = EEPROM.getLatestData(dataSize);
+        bootConfigCrc = (data != nullptr) ? CRC32::calculate(data, dataSize) : 0;
+        hasBootConfigCrc = true;
     }
 
-    for (const auto& handlerFunc : handlerFuncsWithStatusCode)
+    if (configGeneration == 0)
+        snprintf(etag, size, "\"%08" PRIx32 "-%08" PRIx32 "\"", bootConfigCrc, buildCrc);
+    else
+        snprintf(etag, size, "\"%08" PRIx32 "-%08" PRIx32 "-%08" PRIx32 "-%" PRIu32 "\"", bootConfigCrc, buildCrc, bootNonce, configGeneration);
+}
+
+int fs_open_custom(struct fs_file *file, const char *name)
+{
+    // httpd opens the response of a POST right after httpd_post_finished()
+    const uint8_t method = http_post_opening ? API_POST : API_GET;
+    http_post_opening = false;
+
+    const ApiRoute* route = findRoute(name);
+    if (route == nullptr || !(route->methods & method))
+        return 0;
+
+    char etag[48] = "";
+    if (route->flags & API_CONFIG_ETAG)
     {
-        if (strcmp(handlerFunc.first, name) == 0)
-        {
-            return set_file_data(file, handlerFunc.second());
-        }
+        getConfigETag(etag, sizeof(etag));
+        if (method == API_GET && fs_if_none_match(etag))
+            return set_file_data(file, new WebResponse(etag));
     }
+    if (route->flags & API_WRITES_CONFIG)
+        configGeneration++;
 
-    for (const char* excludePath : excludePaths)
-        if (strcmp(excludePath, name) == 0)
-            return 0;
+    if (!route->open(file, name))
+        return 0;
 
-    for (const char* spaPath : spaPaths)
+    if (etag[0] != '\0' && file->pextension != nullptr)
     {
-        if (strcmp(spaPath, name) == 0)
-        {
-            file->data = (const char *)file__index_html[0].data;
-            file->len = file__index_html[0].len;
-            file->index = file__index_html[0].len;
-            file->http_header_included = file__index_html[0].http_header_included;
-            file->pextension = NULL;
-            file->is_custom_file = 0;
-            return 1;
-        }
+        WebResponse* response = static_cast<WebResponse*>(file->pextension);
+        response->setETag(etag);
+        file->len = response->getLength();
     }
+    return 1;
+}
+
+int fs_read_custom(struct fs_file *file, char *buffer, int count)
+{
+    WebResponse* response = static_cast<WebResponse*>(file->pextension);
+    if (response == NULL)
+        return FS_READ_EOF;
 
-    return 0;
+    int length = response->read(file->index, buffer, count);
+    file->index += length;
+    return length;
 }
 
 void fs_close_custom(struct fs_file *file)
 {
     if (file && file->is_custom_file && file->pextension)
     {
-        mem_free(file->pextension);
+        delete static_cast<WebResponse*>(file->pextension);
         file->pextension = NULL;
     }
 }
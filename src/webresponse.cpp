@@ -0,0 +1,83 @@
+#include "webresponse.h"
+#include "version.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static size_t readSpan(size_t offset, char* buffer, size_t count, const char* data, size_t size)
+{
+    if (offset >= size)
+        return 0;
+    const size_t length = std::min(size - offset, count);
+    memcpy(buffer, data + offset, length);
+    return length;
+}
+
+WebResponse::WebResponse(std::string&& data, HttpStatusCode code, const char* type) :
+    body(std::move(data))
+{
+    setHeader(code, type);
+}
+
+WebResponse::WebResponse(const char* value)
+{
+    snprintf(etag, sizeof(etag), "%s", value);
+    setHeader(HttpStatusCode::_304, nullptr);
+}
+
+void WebResponse::setETag(const char* value)
+{
+    snprintf(etag, sizeof(etag), "%s", value);
+    setHeader(statusCode, contentType);
+}
+
+size_t WebResponse::read(size_t offset, char* buffer, size_t count) const
+{
+    size_t length = readSpan(offset, buffer, count, header, headerLength);
+    if (length < count && offset + length >= headerLength)
+        length += readSpan(offset + length - headerLength, buffer + length, count - length, body.data(), body.length());
+    return length;
+}
+
+void WebResponse::setHeader(HttpStatusCode code, const char* type)
+{
+    const char* statusCodeStr = "";
+    switch (code)
+    {
+        case HttpStatusCode::_200: statusCodeStr = "200 OK"; break;
+        case HttpStatusCode::_304: statusCodeStr = "304 Not Modified"; break;
+        case HttpStatusCode::_400: statusCodeStr = "400 Bad Request"; break;
+        case HttpStatusCode::_500: statusCodeStr = "500 Internal Server Error"; break;
+    }
+
+    statusCode = code;
+    contentType = type;
+    headerLength = 0;
+    appendHeader("HTTP/1.0 %s\r\n"
+        "Server: GP2040-CE " GP2040VERSION "\r\n"
+        "Access-Control-Allow-Origin: *\r\n",
+        statusCodeStr);
+    if (etag[0] != '\0')
+    {
+        // Revalidated on every request, the tag changes with the config
+        appendHeader("ETag: %s\r\n"
+            "Cache-Control: no-cache\r\n",
+            etag);
+    }
+    if (code != HttpStatusCode::_304)
+    {
+        appendHeader("Content-Type: %s\r\n"
+            "Content-Length: %u\r\n",
+            contentType, (unsigned)body.length());
+    }
+    appendHeader("%s", "\r\n");
+}
+
+template <typename... Args>
+void WebResponse::appendHeader(const char* format, Args... args)
+{
+    const int written = snprintf(header + headerLength, sizeof(header) - headerLength, format, args...);
+    if (written > 0)
+        headerLength = std::min<size_t>(headerLength + written, sizeof(header) - 1);
+}
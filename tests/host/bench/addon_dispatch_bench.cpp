@@ -0,0 +1,154 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Add-on dispatch benchmark: every core0 add-on that runs without an external device is enabled and loaded into
+// an AddonManager, which only calls the phases each add-on declares, against calling all three phases of every
+// add-on through a vector of heap-allocated blocks, as the manager did before the phase lists. Both wrap every
+// call in the loop profiler's add-on probes, as the manager does when the profiler is built in. Usage:
+//   addon_dispatch_bench [--check]
+// --check runs a short pass and fails unless the phase lists skip calls, for ctest.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <random>
+#include <vector>
+
+#include "harness.h"
+#include "addonmanager.h"
+#include "loopprofiler.h"
+#include "storagemanager.h"
+
+#include "addons/analog.h"
+#include "addons/bootsel_button.h"
+#include "addons/dualdirectional.h"
+#include "addons/focus_mode.h"
+#include "addons/input_macro.h"
+#include "addons/reverse.h"
+#include "addons/rotaryencoder.h"
+#include "addons/slider_socd.h"
+#include "addons/tilt.h"
+#include "addons/turbo.h"
+
+static uint64_t wallNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// What AddonManager kept per add-on before the phase lists
+struct VectorBlock {
+    GPAddon * ptr;
+};
+
+static uint32_t heldMasks[1024];
+static volatile uint32_t sink;
+
+template <typename Dispatch>
+static double nsPerLoop(Gamepad * gamepad, uint32_t count, Dispatch dispatch) {
+    const uint64_t start = wallNs();
+    for (uint32_t n = 0; n < count; n++) {
+        gamepad->state.buttons = heldMasks[n & 1023];
+        gamepad->state.dpad = heldMasks[n & 1023] >> 24;
+        dispatch();
+        sink = sink + gamepad->state.buttons;
+    }
+    return (double)(wallNs() - start) / count;
+}
+
+int main(int argc, char ** argv) {
+    const bool check = argc > 1 && strcmp(argv[1], "--check") == 0;
+    const uint32_t count = check ? 100000 : 5000000;
+
+    provisionConfig([](Config & config) {
+        AddonOptions & options = config.addonOptions;
+        options.analogOptions.enabled = true;
+        options.analogOptions.analogAdc1PinX = 26;
+        options.analogOptions.analogAdc1PinY = 27;
+        options.bootselButtonOptions.enabled = true;
+        options.bootselButtonOptions.buttonMap = GAMEPAD_MASK_A2;
+        options.focusModeOptions.enabled = true;
+        options.focusModeOptions.buttonLockEnabled = true;
+        options.focusModeOptions.buttonLockMask = GAMEPAD_MASK_S1 | GAMEPAD_MASK_S2;
+        options.dualDirectionalOptions.enabled = true;
+        options.reverseOptions.enabled = true;
+        options.socdSliderOptions.enabled = true;
+        options.socdSliderOptions.modeDefault = SOCD_MODE_SECOND_INPUT_PRIORITY;
+        options.tiltOptions.enabled = true;
+        options.rotaryOptions.enabled = true;
+        options.rotaryOptions.encoderOne.enabled = true;
+        options.rotaryOptions.encoderOne.pinA = 23;
+        options.rotaryOptions.encoderOne.pinB = 24;
+        options.rotaryOptions.encoderOne.mode = ENCODER_MODE_LEFT_ANALOG_X;
+        options.rotaryOptions.encoderOne.pulsesPerRevolution = 24;
+
+        config.gpioMappings.pins[18].action = GpioAction::DIGITAL_DIRECTION_UP;
+        config.gpioMappings.pins[19].action = GpioAction::BUTTON_PRESS_TURBO;
+        config.gpioMappings.pins[20].action = GpioAction::BUTTON_PRESS_MACRO;
+        config.gpioMappings.pins[21].action = GpioAction::BUTTON_PRESS_INPUT_REVERSE;
+        config.gpioMappings.pins[22].action = GpioAction::SUSTAIN_SOCD_MODE_NEUTRAL;
+    });
+    bootFirmware();
+    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+
+    // Same load order as GP2040::setup
+    GPAddon * candidates[] = {
+        new AnalogInput(), new BootselButtonAddon(), new DualDirectionalInput(), new FocusModeAddon(),
+        new SliderSOCDInput(), new TiltInput(), new RotaryEncoderInput(), new ReverseInput(), new TurboInput(),
+        new InputMacro(),
+    };
+    AddonManager manager;
+    std::vector<VectorBlock *> blocks;
+    uint32_t phaseCalls = 0;
+    for (GPAddon * addon : candidates) {
+        const std::string name = addon->name();
+        const uint8_t phases = addon->phases();
+        if (!manager.LoadAddon(addon)) {
+            printf("  %-20s not available\n", name.c_str());
+            continue;
+        }
+        blocks.push_back(new VectorBlock { addon });
+        phaseCalls += __builtin_popcount(phases);
+        printf("  %-20s %s%s%s\n", name.c_str(), (phases & ADDON_PHASE_PREPROCESS) ? " preprocess" : "",
+            (phases & ADDON_PHASE_PROCESS) ? " process" : "", (phases & ADDON_PHASE_POSTPROCESS) ? " postprocess" : "");
+    }
+
+    std::mt19937 rng(2040);
+    for (uint32_t & mask : heldMasks)
+        mask = rng() & rng();
+
+    const double phaseNs = nsPerLoop(gamepad, count, [&]() {
+        manager.PreprocessAddons();
+        manager.ProcessAddons();
+        manager.PostprocessAddons(true);
+    });
+    const double vectorNs = nsPerLoop(gamepad, count, [&]() {
+        for (uint8_t i = 0; i < blocks.size(); i++) {
+            LOOP_PROFILE_ADDON_BEGIN();
+            blocks[i]->ptr->preprocess();
+            LOOP_PROFILE_ADDON_END(i, LOOP_ADDON_PREPROCESS);
+        }
+        for (uint8_t i = 0; i < blocks.size(); i++) {
+            LOOP_PROFILE_ADDON_BEGIN();
+            blocks[i]->ptr->process();
+            LOOP_PROFILE_ADDON_END(i, LOOP_ADDON_PROCESS);
+        }
+        for (uint8_t i = 0; i < blocks.size(); i++) {
+            LOOP_PROFILE_ADDON_BEGIN();
+            blocks[i]->ptr->postprocess(true);
+            LOOP_PROFILE_ADDON_END(i, LOOP_ADDON_POSTPROCESS);
+        }
+    });
+
+    printf("%zu add-ons, %u of %zu phase calls per loop\n", blocks.size(), phaseCalls, blocks.size() * 3);
+    printf("phase lists                    %7.1f ns/loop\n", phaseNs);
+    printf("every phase of every add-on    %7.1f ns/loop\n", vectorNs);
+
+    if (check && (blocks.size() < 8 || phaseCalls >= blocks.size() * 3)) {
+        fprintf(stderr, "the add-ons did not load, or the phase lists skip no calls\n");
+        return 1;
+    }
+    return 0;
+}
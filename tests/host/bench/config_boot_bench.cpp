@@ -0,0 +1,100 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Boot config load benchmark: ConfigUtils::load on a config without a migration stamp, which decodes everything,
+// runs the migrations and saves, against the same config once stamped, which only decodes what the first input
+// loop needs and leaves display, LED and animation options for loadDeferred(). Every load starts from a snapshot
+// of the config region, remounted as at boot. Usage:
+//   config_boot_bench [--check]
+// --check runs a short pass and fails unless the fast path is taken and ends in the same config as the full load
+// once the deferred sections are in, for ctest. The times are only printed, they depend on the machine and its load.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+
+#include "harness.h"
+#include "config_utils.h"
+#include "FlashPROM.h"
+
+static uint64_t wallNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint8_t * configRegion() {
+    return host_flash_image() + (EEPROM_ADDRESS_START - XIP_BASE);
+}
+
+static std::vector<uint8_t> snapshotRegion() {
+    return std::vector<uint8_t>(configRegion(), configRegion() + EEPROM_SIZE_BYTES);
+}
+
+static void restoreRegion(const std::vector<uint8_t> & snapshot) {
+    memcpy(configRegion(), snapshot.data(), snapshot.size());
+    EEPROM.start();
+}
+
+static Config config;
+
+// Times load() from the snapshot, after the untimed prepare()
+template <typename Prepare, typename Load>
+static double nsPerLoad(const std::vector<uint8_t> & snapshot, uint32_t count, Prepare prepare, Load load) {
+    uint64_t total = 0;
+    for (uint32_t n = 0; n < count; n++) {
+        restoreRegion(snapshot);
+        prepare();
+        const uint64_t start = wallNs();
+        load();
+        total += wallNs() - start;
+    }
+    return (double)total / count;
+}
+
+int main(int argc, char ** argv) {
+    const bool check = argc > 1 && strcmp(argv[1], "--check") == 0;
+    const uint32_t count = check ? 200 : 5000;
+
+    // A config as older firmware saved it, before the migration stamp
+    provisionConfig([](Config & edited) {
+        edited.migrations.has_migrationVersion = false;
+        edited.migrations.migrationVersion = 0;
+    });
+    const std::vector<uint8_t> unstamped = snapshotRegion();
+
+    // One full load stamps it, and its save falls due
+    restoreRegion(unstamped);
+    const bool fullDeferred = ConfigUtils::load(config);
+    const std::string fullBinary = ConfigUtils::toBinary(config);
+    host_time_advance_us(EEPROM_WRITE_WAIT * 1000 * 2);
+    const std::vector<uint8_t> stamped = snapshotRegion();
+
+    restoreRegion(stamped);
+    const bool fastDeferred = ConfigUtils::load(config);
+    if (fastDeferred)
+        ConfigUtils::loadDeferred(config);
+    const bool sameConfig = ConfigUtils::toBinary(config) == fullBinary;
+
+    const double fullNs = nsPerLoad(unstamped, count, []() {}, []() { ConfigUtils::load(config); });
+    const double fastNs = nsPerLoad(stamped, count, []() {}, []() { ConfigUtils::load(config); });
+    const double deferredNs = nsPerLoad(stamped, count, []() { ConfigUtils::load(config); },
+        []() { ConfigUtils::loadDeferred(config); });
+
+    printf("Config record %zu bytes\n", fullBinary.size());
+    printf("full load (decode, migrations, save) %9.1f us\n", fullNs / 1000.0);
+    printf("boot fast path                       %9.1f us\n", fastNs / 1000.0);
+    printf("deferred sections, later             %9.1f us\n", deferredNs / 1000.0);
+    printf("fast path taken: %s, same config after loadDeferred: %s\n", fastDeferred ? "yes" : "no",
+        sameConfig ? "yes" : "no");
+
+    if (check && (fullDeferred || !fastDeferred || !sameConfig)) {
+        fprintf(stderr, "the boot fast path was not taken or lost fields\n");
+        return 1;
+    }
+    return 0;
+}
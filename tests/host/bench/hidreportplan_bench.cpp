@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Report decode benchmark: the compiled HIDReportPlan against parsing the descriptor for every report, and what a
+// compile costs at mount. Usage:
+//   hidreportplan_bench [--check]
+// --check runs a short pass and fails unless the plan decodes every report as parsing does, for ctest. The times
+// are only printed, they depend on the machine and its load.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <random>
+
+#include "drivers/shared/hidreportplan.h"
+
+#include "../corpus/hid_descriptors.h"
+
+static uint64_t wallNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint8_t reports[1024][64];
+static volatile uint32_t sink;
+
+template <typename Decode>
+static double nsPerReport(uint32_t count, Decode decode) {
+    const uint64_t start = wallNs();
+    for (uint32_t n = 0; n < count; n++) {
+        GamepadState state;
+        decode(reports[n & 1023], state);
+        sink = sink + state.buttons + state.dpad + state.lx;
+    }
+    return (double)(wallNs() - start) / count;
+}
+
+int main(int argc, char ** argv) {
+    const bool check = argc > 1 && strcmp(argv[1], "--check") == 0;
+    const uint32_t count = check ? 100000 : 2000000;
+
+    std::mt19937 rng(2040);
+    for (auto & report : reports) {
+        for (uint8_t & byte : report)
+            byte = rng();
+        report[0] = 1;
+    }
+
+    int failures = 0;
+    for (const HIDDescriptorEntry & entry : hidDescriptorCorpus) {
+        if (!entry.planned)
+            continue;
+        HIDReportPlan plan;
+        plan.compile(entry.descriptor, entry.length);
+        const uint8_t id = plan.getReportId();
+        const HIDReferenceLayout layout = referenceLayout(entry.descriptor, entry.length);
+        // Reports in the table carry ID 1, other IDs are patched into a copy
+        for (const auto & report : reports) {
+            uint8_t copy[64];
+            memcpy(copy, report, sizeof(copy));
+            if (id != 0)
+                copy[0] = id;
+            GamepadState decoded;
+            GamepadState expected;
+            plan.decode(copy, sizeof(copy), decoded);
+            refDecode(entry.descriptor, entry.length, id, layout, copy, expected);
+            if (!refSameState(decoded, expected)) {
+                failures++;
+                break;
+            }
+        }
+
+        const double planned = nsPerReport(count, [&](const uint8_t * report, GamepadState & state) {
+            uint8_t copy[64];
+            memcpy(copy, report, sizeof(copy));
+            if (id != 0)
+                copy[0] = id;
+            plan.decode(copy, sizeof(copy), state);
+        });
+        const double parsed = nsPerReport(count / 10, [&](const uint8_t * report, GamepadState & state) {
+            uint8_t copy[64];
+            memcpy(copy, report, sizeof(copy));
+            if (id != 0)
+                copy[0] = id;
+            refDecode(entry.descriptor, entry.length, id, layout, copy, state);
+        });
+
+        const uint64_t start = wallNs();
+        for (uint32_t n = 0; n < count / 100; n++) {
+            HIDReportPlan compiled;
+            compiled.compile(entry.descriptor, entry.length);
+            sink = sink + compiled.getFieldCount();
+        }
+        const double compileUs = (double)(wallNs() - start) / (count / 100) / 1000.0;
+
+        printf("%-32s plan %7.1f ns/report, parse %8.1f ns/report, compile %6.2f us\n",
+            entry.name, planned, parsed, compileUs);
+    }
+    printf("sizeof(HIDReportPlan) = %zu bytes\n", sizeof(HIDReportPlan));
+
+    if (check && failures) {
+        fprintf(stderr, "the compiled plan decoded differently from parsing for %d descriptors\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Core0 loop benchmark: boots the firmware in one input mode, replays traces through GP2040::loop() and prints
+// what each stage costs on this machine, plus loops per second. Usage:
+//   loop_bench [--mode xinput|switch|ps3|ps4|ps5|hid|keyboard|xbone|...] [--repeat N] [--check] trace...
+// --check runs every trace once and fails unless the driver sent reports, for ctest.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "harness.h"
+#include "loopprofiler.h"
+
+#include "enums.pb.h"
+
+static const struct {
+    const char * name;
+    InputMode mode;
+} inputModes[] = {
+    { "xinput", INPUT_MODE_XINPUT },
+    { "switch", INPUT_MODE_SWITCH },
+    { "ps3", INPUT_MODE_PS3 },
+    { "keyboard", INPUT_MODE_KEYBOARD },
+    { "ps4", INPUT_MODE_PS4 },
+    { "xbone", INPUT_MODE_XBONE },
+    { "mdmini", INPUT_MODE_MDMINI },
+    { "neogeo", INPUT_MODE_NEOGEO },
+    { "pcemini", INPUT_MODE_PCEMINI },
+    { "egret", INPUT_MODE_EGRET },
+    { "astro", INPUT_MODE_ASTRO },
+    { "psclassic", INPUT_MODE_PSCLASSIC },
+    { "xboxoriginal", INPUT_MODE_XBOXORIGINAL },
+    { "ps5", INPUT_MODE_PS5 },
+    { "hid", INPUT_MODE_GENERIC },
+    { "switchpro", INPUT_MODE_SWITCH_PRO },
+};
+
+static uint64_t wallNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+#if LOOP_PROFILER_ENABLED
+// Stages the benchmark reports, add-ons are the sum of their three phases
+static void printStage(const char * name, uint64_t total, uint32_t count) {
+    printf("  %-16s %10.1f ns/loop\n", name, count ? (double)total / count : 0.0);
+}
+
+static void printStages() {
+    const LoopProfiler & profiler = LoopProfiler::getInstance();
+    const uint32_t count = profiler.getStage(LOOP_STAGE_TOTAL).count;
+    const uint64_t addons = profiler.getStage(LOOP_STAGE_PREPROCESS).total +
+        profiler.getStage(LOOP_STAGE_PROCESS).total + profiler.getStage(LOOP_STAGE_POSTPROCESS).total;
+
+    printStage("debounce", profiler.getStage(LOOP_STAGE_DEBOUNCE).total, count);
+    printStage("read", profiler.getStage(LOOP_STAGE_READ).total, count);
+    printStage("addons", addons, count);
+    printStage("hotkey", profiler.getStage(LOOP_STAGE_HOTKEYS).total, count);
+    printStage("process", profiler.getStage(LOOP_STAGE_GAMEPAD_PROCESS).total, count);
+    printStage("driver", profiler.getStage(LOOP_STAGE_DRIVER).total, count);
+    printStage("tud_task", profiler.getStage(LOOP_STAGE_TUD_TASK).total, count);
+    printStage("total", profiler.getStage(LOOP_STAGE_TOTAL).total, count);
+    printf("  %-16s %10u ns\n", "p99 total", profiler.getStage(LOOP_STAGE_TOTAL).percentile(99));
+}
+#endif
+
+int main(int argc, char ** argv) {
+    InputMode mode = INPUT_MODE_XINPUT;
+    uint32_t repeat = 200;
+    bool check = false;
+    std::vector<Trace> traces;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--check") == 0) {
+            check = true;
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            const char * name = argv[++i];
+            bool found = false;
+            for (const auto & entry : inputModes) {
+                if (strcmp(entry.name, name) == 0) {
+                    mode = entry.mode;
+                    found = true;
+                }
+            }
+            if (!found) {
+                fprintf(stderr, "unknown mode %s\n", name);
+                return 2;
+            }
+        } else {
+            traces.emplace_back();
+            if (!loadTrace(argv[i], traces.back()) || traces.back().empty())
+                return 2;
+        }
+    }
+    if (traces.empty()) {
+        fprintf(stderr, "usage: %s [--mode name] [--repeat n] [--check] trace...\n", argv[0]);
+        return 2;
+    }
+    if (check)
+        repeat = 1;
+
+    provisionConfig([mode](Config & config) { config.gamepadOptions.inputMode = mode; });
+    GP2040 * gp2040 = bootFirmware();
+
+    // Let the host enumerate before timing anything
+    host_time_advance_us(100 * 1000);
+    gp2040->loop();
+#if LOOP_PROFILER_ENABLED
+    LoopProfiler::getInstance().reset();
+#endif
+    host_usb_reset_reports();
+
+    uint64_t loops = 0;
+    uint64_t elapsedNs = 0;
+    for (uint32_t pass = 0; pass < repeat; pass++) {
+        for (const Trace & trace : traces) {
+            // Every pass continues where the previous one left off on the virtual clock
+            const uint64_t offset = host_time_us() + 1000 - trace.front().timeUs;
+            const uint64_t start = wallNs();
+            for (TraceSample sample : trace) {
+                sample.timeUs += offset;
+                replaySample(gp2040, sample);
+            }
+            elapsedNs += wallNs() - start;
+            loops += trace.size();
+        }
+    }
+
+    printf("%llu loops, %.0f loops/sec, %u reports (hash %08x)\n", (unsigned long long)loops,
+        elapsedNs ? loops * 1e9 / elapsedNs : 0.0, host_usb_report_count(), host_usb_report_hash());
+#if LOOP_PROFILER_ENABLED
+    printStages();
+#endif
+
+    if (check && host_usb_report_count() == 0) {
+        fprintf(stderr, "no reports were sent\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Gamepad::read benchmark: the nibble lookup tables compiled from the pin mappings against testing every mapping
+// in turn, as read() did before the tables. Every pin is mapped, a few of them to button combos. Usage:
+//   pin_lookup_bench [--check]
+// --check runs a short pass and fails unless both agree on every GPIO mask, for ctest.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <random>
+
+#include "harness.h"
+#include "storagemanager.h"
+
+static const GpioAction pinActions[] = {
+    GpioAction::BUTTON_PRESS_UP, GpioAction::BUTTON_PRESS_DOWN, GpioAction::BUTTON_PRESS_LEFT,
+    GpioAction::BUTTON_PRESS_RIGHT, GpioAction::BUTTON_PRESS_B1, GpioAction::BUTTON_PRESS_B2,
+    GpioAction::BUTTON_PRESS_B3, GpioAction::BUTTON_PRESS_B4, GpioAction::BUTTON_PRESS_L1,
+    GpioAction::BUTTON_PRESS_R1, GpioAction::BUTTON_PRESS_L2, GpioAction::BUTTON_PRESS_R2,
+    GpioAction::BUTTON_PRESS_S1, GpioAction::BUTTON_PRESS_S2, GpioAction::BUTTON_PRESS_A1,
+    GpioAction::BUTTON_PRESS_A2, GpioAction::BUTTON_PRESS_L3, GpioAction::BUTTON_PRESS_R3,
+    GpioAction::BUTTON_PRESS_FN, GpioAction::BUTTON_PRESS_DDI_UP, GpioAction::BUTTON_PRESS_DDI_LEFT,
+    GpioAction::BUTTON_PRESS_A3, GpioAction::BUTTON_PRESS_E1, GpioAction::BUTTON_PRESS_E6,
+    GpioAction::BUTTON_PRESS_E12, GpioAction::BUTTON_PRESS_B1,
+};
+
+static uint64_t wallNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+struct PinState {
+    uint32_t buttons;
+    uint16_t aux;
+    uint8_t dpad;
+};
+
+// One test per mapping, the way Gamepad::read combined them before the lookup tables
+static PinState readByMapping(const Gamepad & gamepad, Mask_t values) {
+    PinState state;
+    state.dpad = 0
+        | ((values & gamepad.mapDpadUp.pinMask)      ? gamepad.mapDpadUp.buttonMask : 0)
+        | ((values & gamepad.mapDpadDown.pinMask)    ? gamepad.mapDpadDown.buttonMask : 0)
+        | ((values & gamepad.mapDpadLeft.pinMask)    ? gamepad.mapDpadLeft.buttonMask : 0)
+        | ((values & gamepad.mapDpadRight.pinMask)   ? gamepad.mapDpadRight.buttonMask : 0)
+        | ((values & gamepad.mapDigitalUp.pinMask)   ? (gamepad.mapDigitalUp.buttonMask << 4) : 0)
+        | ((values & gamepad.mapDigitalDown.pinMask) ? (gamepad.mapDigitalDown.buttonMask << 4) : 0)
+        | ((values & gamepad.mapDigitalLeft.pinMask) ? (gamepad.mapDigitalLeft.buttonMask << 4) : 0)
+        | ((values & gamepad.mapDigitalRight.pinMask) ? (gamepad.mapDigitalRight.buttonMask << 4) : 0)
+    ;
+    state.aux = ((values & gamepad.mapButtonFn.pinMask) ? gamepad.mapButtonFn.buttonMask : 0);
+    state.buttons = 0
+        | ((values & gamepad.mapButtonB1.pinMask)  ? gamepad.mapButtonB1.buttonMask : 0)
+        | ((values & gamepad.mapButtonB2.pinMask)  ? gamepad.mapButtonB2.buttonMask : 0)
+        | ((values & gamepad.mapButtonB3.pinMask)  ? gamepad.mapButtonB3.buttonMask : 0)
+        | ((values & gamepad.mapButtonB4.pinMask)  ? gamepad.mapButtonB4.buttonMask : 0)
+        | ((values & gamepad.mapButtonL1.pinMask)  ? gamepad.mapButtonL1.buttonMask : 0)
+        | ((values & gamepad.mapButtonR1.pinMask)  ? gamepad.mapButtonR1.buttonMask : 0)
+        | ((values & gamepad.mapButtonL2.pinMask)  ? gamepad.mapButtonL2.buttonMask : 0)
+        | ((values & gamepad.mapButtonR2.pinMask)  ? gamepad.mapButtonR2.buttonMask : 0)
+        | ((values & gamepad.mapButtonS1.pinMask)  ? gamepad.mapButtonS1.buttonMask : 0)
+        | ((values & gamepad.mapButtonS2.pinMask)  ? gamepad.mapButtonS2.buttonMask : 0)
+        | ((values & gamepad.mapButtonL3.pinMask)  ? gamepad.mapButtonL3.buttonMask : 0)
+        | ((values & gamepad.mapButtonR3.pinMask)  ? gamepad.mapButtonR3.buttonMask : 0)
+        | ((values & gamepad.mapButtonA1.pinMask)  ? gamepad.mapButtonA1.buttonMask : 0)
+        | ((values & gamepad.mapButtonA2.pinMask)  ? gamepad.mapButtonA2.buttonMask : 0)
+        | ((values & gamepad.mapButtonA3.pinMask)  ? gamepad.mapButtonA3.buttonMask : 0)
+        | ((values & gamepad.mapButtonA4.pinMask)  ? gamepad.mapButtonA4.buttonMask : 0)
+        | ((values & gamepad.mapButtonE1.pinMask)  ? gamepad.mapButtonE1.buttonMask : 0)
+        | ((values & gamepad.mapButtonE2.pinMask)  ? gamepad.mapButtonE2.buttonMask : 0)
+        | ((values & gamepad.mapButtonE3.pinMask)  ? gamepad.mapButtonE3.buttonMask : 0)
+        | ((values & gamepad.mapButtonE4.pinMask)  ? gamepad.mapButtonE4.buttonMask : 0)
+        | ((values & gamepad.mapButtonE5.pinMask)  ? gamepad.mapButtonE5.buttonMask : 0)
+        | ((values & gamepad.mapButtonE6.pinMask)  ? gamepad.mapButtonE6.buttonMask : 0)
+        | ((values & gamepad.mapButtonE7.pinMask)  ? gamepad.mapButtonE7.buttonMask : 0)
+        | ((values & gamepad.mapButtonE8.pinMask)  ? gamepad.mapButtonE8.buttonMask : 0)
+        | ((values & gamepad.mapButtonE9.pinMask)  ? gamepad.mapButtonE9.buttonMask : 0)
+        | ((values & gamepad.mapButtonE10.pinMask) ? gamepad.mapButtonE10.buttonMask : 0)
+        | ((values & gamepad.mapButtonE11.pinMask) ? gamepad.mapButtonE11.buttonMask : 0)
+        | ((values & gamepad.mapButtonE12.pinMask) ? gamepad.mapButtonE12.buttonMask : 0)
+    ;
+    return state;
+}
+
+static Mask_t masks[4096];
+static volatile uint32_t sink;
+
+int main(int argc, char ** argv) {
+    const bool check = argc > 1 && strcmp(argv[1], "--check") == 0;
+    const uint32_t count = check ? 100000 : 10000000;
+
+    provisionConfig([](Config & config) {
+        config.has_gpioMappings = true;
+        config.gpioMappings.pins_count = NUM_BANK0_GPIOS;
+        for (uint32_t pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+            GpioMappingInfo & info = config.gpioMappings.pins[pin];
+            info = GpioMappingInfo_init_default;
+            if (pin < sizeof(pinActions) / sizeof(pinActions[0])) {
+                info.action = pinActions[pin];
+            } else {
+                info.action = GpioAction::CUSTOM_BUTTON_COMBO;
+                info.customButtonMask = (GAMEPAD_MASK_B1 | GAMEPAD_MASK_R2) << (pin % 3);
+                info.customDpadMask = GAMEPAD_MASK_DOWN >> (pin % 2);
+            }
+            info.has_customButtonMask = true;
+            info.has_customDpadMask = true;
+        }
+    });
+    bootFirmware();
+    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+    if (gamepad->mapButtonE12.pinMask == 0 || gamepad->mapDigitalUp.pinMask == 0) {
+        fprintf(stderr, "the provisioned pin mappings were not loaded\n");
+        return 1;
+    }
+
+    std::mt19937 rng(2040);
+    for (Mask_t & mask : masks) {
+        // Mostly a few buttons held, now and then everything mashed
+        mask = (rng() % 8 == 0) ? rng() : (rng() & rng() & rng());
+        mask &= (1u << NUM_BANK0_GPIOS) - 1;
+    }
+
+    int mismatches = 0;
+    for (const Mask_t mask : masks) {
+        gamepad->debouncedGpio = mask;
+        gamepad->read();
+        const PinState expected = readByMapping(*gamepad, mask);
+        if (gamepad->state.buttons != expected.buttons || gamepad->state.dpad != expected.dpad ||
+            gamepad->state.aux != expected.aux) {
+            if (mismatches++ < 3)
+                fprintf(stderr, "gpio %08x: buttons %08x/%08x dpad %02x/%02x aux %04x/%04x\n", mask,
+                    gamepad->state.buttons, expected.buttons, gamepad->state.dpad, expected.dpad,
+                    gamepad->state.aux, expected.aux);
+        }
+    }
+
+    uint64_t start = wallNs();
+    for (uint32_t n = 0; n < count; n++) {
+        gamepad->debouncedGpio = masks[n & 4095];
+        gamepad->read();
+        sink = sink + gamepad->state.buttons;
+    }
+    const double lookupNs = (double)(wallNs() - start) / count;
+
+    start = wallNs();
+    for (uint32_t n = 0; n < count; n++) {
+        const PinState state = readByMapping(*gamepad, masks[n & 4095]);
+        sink = sink + state.buttons;
+    }
+    const double mappingNs = (double)(wallNs() - start) / count;
+
+    printf("Gamepad::read() with lookup tables %7.1f ns\n", lookupNs);
+    printf("one test per mapping (pins only)   %7.1f ns\n", mappingNs);
+    printf("%d mismatches over %zu GPIO masks\n", mismatches, sizeof(masks) / sizeof(masks[0]));
+    return mismatches != 0;
+}
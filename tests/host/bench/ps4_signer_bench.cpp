@@ -0,0 +1,169 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// PS4 auth signing benchmark: PS4AuthSigner's stepped RSASSA-PSS signature of a nonce against the single
+// mbedtls_rsa_rsassa_pss_sign() call PS4Auth made before, with a 2048-bit key generated here. Reports the total
+// sign time run straight through, the longest single step of each stage, and for a few per-call budgets how many
+// calls a signature takes and how long a slice runs, timed the way PS4Auth::keyModeProcess spends its budget. Every
+// signature is checked with mbedtls_rsa_rsassa_pss_verify(). Usage:
+//   ps4_signer_bench [--check]
+// --check signs a few nonces and fails unless every signature verifies and the signer splits the modular
+// exponentiations, nearly all of a signature's work, into at least one step per bit of the primes, for ctest. The
+// times are only printed, they depend on the machine and its load.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "drivers/ps4/PS4AuthSigner.h"
+
+#include "mbedtls/rsa.h"
+
+static uint64_t wallNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int randomBytes(void * rng, unsigned char * output, size_t size) {
+    for (size_t i = 0; i < size; i++)
+        output[i] = (*(std::mt19937 *)rng)();
+    return 0;
+}
+
+static mbedtls_rsa_context rsa;
+static PS4AuthSigner signer;
+
+static bool verify(const uint8_t * nonce, const uint8_t * signature) {
+    uint8_t hash[32];
+    mbedtls_sha256_ret(nonce, PS4_AUTH_NONCE_SIZE, hash, 0);
+    return mbedtls_rsa_rsassa_pss_verify(&rsa, nullptr, nullptr, MBEDTLS_RSA_PUBLIC, MBEDTLS_MD_SHA256,
+        sizeof(hash), hash, signature) == 0;
+}
+
+int main(int argc, char ** argv) {
+    const bool check = argc > 1 && strcmp(argv[1], "--check") == 0;
+    const uint32_t signs = check ? 4 : 50;
+    static const uint32_t budgetsUs[] = { 20, 100, 500 };
+
+    std::mt19937 rng(2040);
+    mbedtls_rsa_init(&rsa, MBEDTLS_RSA_PKCS_V21, MBEDTLS_MD_SHA256);
+    if (mbedtls_rsa_gen_key(&rsa, randomBytes, &rng, PS4_AUTH_SIGNATURE_SIZE * 8, 65537) != 0) {
+        fprintf(stderr, "key generation failed\n");
+        return 1;
+    }
+
+    // As PS4Auth::keyModeInitialize hands the key over
+    mbedtls_mpi crt[5]; // P, Q, DP, DQ, QP
+    uint8_t crtBytes[5][PS4_AUTH_PRIME_SIZE];
+    for (mbedtls_mpi & value : crt)
+        mbedtls_mpi_init(&value);
+    mbedtls_rsa_export(&rsa, nullptr, &crt[0], &crt[1], nullptr, nullptr);
+    mbedtls_rsa_export_crt(&rsa, &crt[2], &crt[3], &crt[4]);
+    for (uint8_t i = 0; i < 5; i++)
+        mbedtls_mpi_write_binary(&crt[i], crtBytes[i], PS4_AUTH_PRIME_SIZE);
+    const uint64_t keyStart = wallNs();
+    const bool keyValid = signer.setKey(crtBytes[0], crtBytes[1], crtBytes[2], crtBytes[3], crtBytes[4]);
+    const double keyUs = (wallNs() - keyStart) / 1000.0;
+
+    uint8_t nonce[PS4_AUTH_NONCE_SIZE];
+    uint8_t signature[PS4_AUTH_SIGNATURE_SIZE];
+    uint32_t failures = keyValid ? 0 : 1;
+
+    // The one call PS4Auth used to make
+    uint64_t oneShotNs = 0;
+    for (uint32_t n = 0; n < signs; n++) {
+        randomBytes(&rng, nonce, sizeof(nonce));
+        const uint64_t start = wallNs();
+        uint8_t hash[32];
+        mbedtls_sha256_ret(nonce, sizeof(nonce), hash, 0);
+        mbedtls_rsa_rsassa_pss_sign(&rsa, randomBytes, &rng, MBEDTLS_RSA_PRIVATE, MBEDTLS_MD_SHA256, sizeof(hash),
+            hash, signature);
+        oneShotNs += wallNs() - start;
+        failures += !verify(nonce, signature);
+    }
+
+    // Straight through, timing every step. Each signature runs the same sequence of steps, so the shortest time
+    // seen for a step across signatures is its cost without the scheduler's interruptions of this process.
+    uint64_t steppedNs = 0;
+    uint32_t steps = 0;
+    std::vector<uint64_t> stepNs;
+    std::vector<uint8_t> stepStages;
+    for (uint32_t n = 0; n < signs && keyValid; n++) {
+        randomBytes(&rng, nonce, sizeof(nonce));
+        signer.start(nonce, signature);
+        bool done = false;
+        for (size_t i = 0; !done; i++) {
+            const PS4AuthSignerStage stage = signer.getStage();
+            const uint64_t start = wallNs();
+            done = signer.step();
+            const uint64_t ns = wallNs() - start;
+            steppedNs += ns;
+            if (i == stepNs.size()) {
+                stepNs.push_back(ns);
+                stepStages.push_back(stage);
+            } else if (ns < stepNs[i]) {
+                stepNs[i] = ns;
+            }
+            steps++;
+        }
+        failures += !verify(nonce, signature);
+    }
+    uint64_t worstStepNs[PS4_AUTH_SIGNER_DONE] = {};
+    uint32_t stageSteps[PS4_AUTH_SIGNER_DONE] = {};
+    uint64_t worstNs = 0;
+    for (size_t i = 0; i < stepNs.size(); i++) {
+        worstStepNs[stepStages[i]] = std::max(worstStepNs[stepStages[i]], stepNs[i]);
+        stageSteps[stepStages[i]]++;
+        worstNs = std::max(worstNs, stepNs[i]);
+    }
+
+    printf("setKey (once, at initialize)       %9.1f us\n", keyUs);
+    printf("mbedtls_rsa_rsassa_pss_sign        %9.1f us/signature\n", oneShotNs / 1000.0 / signs);
+    printf("PS4AuthSigner, straight through    %9.1f us/signature, %u steps\n", steppedNs / 1000.0 / signs,
+        steps / signs);
+    static const char * stageNames[] = { "", "hash", "encode", "mask", "exponent P", "exponent Q", "combine" };
+    for (uint8_t stage = PS4_AUTH_SIGNER_HASH; stage < PS4_AUTH_SIGNER_DONE; stage++)
+        printf("  longest %-10s step            %9.2f us, %5u steps\n", stageNames[stage],
+            worstStepNs[stage] / 1000.0, stageSteps[stage]);
+
+    // Sliced as keyModeProcess does, a call ends at the first step that finishes past the budget. A slice can
+    // overrun its budget by one step, the longest slice shown is the 99th percentile, above it are interruptions.
+    for (uint32_t budgetUs : budgetsUs) {
+        std::vector<uint64_t> sliceNs;
+        for (uint32_t n = 0; n < signs && keyValid; n++) {
+            randomBytes(&rng, nonce, sizeof(nonce));
+            signer.start(nonce, signature);
+            bool done = false;
+            while (!done) {
+                const uint64_t start = wallNs();
+                while (!(done = signer.step()) && (wallNs() - start) < budgetUs * 1000ull) {}
+                sliceNs.push_back(wallNs() - start);
+            }
+            failures += !verify(nonce, signature);
+        }
+        std::sort(sliceNs.begin(), sliceNs.end());
+        printf("budget %3u us: %5zu calls/signature, longest slice %7.1f us, at most %7.1f us\n", budgetUs,
+            sliceNs.size() / signs, sliceNs[sliceNs.size() * 99 / 100] / 1000.0, budgetUs + worstNs / 1000.0);
+    }
+
+    if (failures)
+        fprintf(stderr, "%u signatures did not verify\n", failures);
+    mbedtls_rsa_free(&rsa);
+    for (mbedtls_mpi & value : crt)
+        mbedtls_mpi_free(&value);
+
+    // Counted over the straight through signatures, which all take the same steps
+    const uint32_t primeBits = PS4_AUTH_PRIME_SIZE * 8;
+    const bool split = stageSteps[PS4_AUTH_SIGNER_EXP_P] >= primeBits && stageSteps[PS4_AUTH_SIGNER_EXP_Q] >= primeBits;
+    if (check && (failures || !split)) {
+        fprintf(stderr, "a signature was wrong, or an exponentiation took fewer steps than its prime has bits\n");
+        return 1;
+    }
+    return 0;
+}
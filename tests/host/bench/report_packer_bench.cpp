@@ -0,0 +1,210 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Report button packing benchmark, per mode: GamepadReportPacker over the mode's mapping table against the
+// pressedX() ternaries the drivers used before, from corpus/legacy_reports.h. The tables are copies of the
+// drivers' own, which report_packer_test checks against the same reference through the drivers. Usage:
+//   report_packer_bench [--check]
+// --check runs a short pass and fails unless packer and ternaries agree on every state, for ctest.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <random>
+
+#include "harness.h"
+#include "storagemanager.h"
+#include "gamepad/GamepadReportPacker.h"
+
+#include "../corpus/legacy_reports.h"
+
+static constexpr GamepadReportBit xinputButtons1Bits[] = {
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_UP,    XBOX_MASK_UP    },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_DOWN,  XBOX_MASK_DOWN  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_LEFT,  XBOX_MASK_LEFT  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_RIGHT, XBOX_MASK_RIGHT },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2,    XBOX_MASK_START },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1,    XBOX_MASK_BACK  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3,    XBOX_MASK_LS    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3,    XBOX_MASK_RS    },
+};
+
+static constexpr GamepadReportBit xinputButtons2Bits[] = {
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L1, XBOX_MASK_LB   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R1, XBOX_MASK_RB   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A1, XBOX_MASK_HOME },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B1, XBOX_MASK_A    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B2, XBOX_MASK_B    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B3, XBOX_MASK_X    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B4, XBOX_MASK_Y    },
+};
+
+static constexpr GamepadReportBit xboxOriginalButtonBits[] = {
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_UP,    XID_DUP    },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_DOWN,  XID_DDOWN  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_LEFT,  XID_DLEFT  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_RIGHT, XID_DRIGHT },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2,    XID_START  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1,    XID_BACK   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3,    XID_LS     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3,    XID_RS     },
+};
+
+static constexpr GamepadReportBit switchButtonBits[] = {
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B1, SWITCH_MASK_B       },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B2, SWITCH_MASK_A       },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B3, SWITCH_MASK_Y       },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B4, SWITCH_MASK_X       },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L1, SWITCH_MASK_L       },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R1, SWITCH_MASK_R       },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L2, SWITCH_MASK_ZL      },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R2, SWITCH_MASK_ZR      },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1, SWITCH_MASK_MINUS   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2, SWITCH_MASK_PLUS    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3, SWITCH_MASK_L3      },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3, SWITCH_MASK_R3      },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A1, SWITCH_MASK_HOME    },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A2, SWITCH_MASK_CAPTURE },
+};
+
+static constexpr GamepadReportBit hidButtonBits[] = {
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B1,    GAMEPAD_MASK_B2  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B2,    GAMEPAD_MASK_B3  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B3,    GAMEPAD_MASK_B1  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B4,    GAMEPAD_MASK_B4  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L1,    GAMEPAD_MASK_L1  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R1,    GAMEPAD_MASK_R1  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L2,    GAMEPAD_MASK_L2  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R2,    GAMEPAD_MASK_R2  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1,    GAMEPAD_MASK_S1  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2,    GAMEPAD_MASK_S2  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3,    GAMEPAD_MASK_L3  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3,    GAMEPAD_MASK_R3  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A1,    GAMEPAD_MASK_A1  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A2,    GAMEPAD_MASK_A2  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A3,    GAMEPAD_MASK_A3  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A4,    GAMEPAD_MASK_A4  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_UP,    GAMEPAD_MASK_DU  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_DOWN,  GAMEPAD_MASK_DD  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_LEFT,  GAMEPAD_MASK_DL  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_RIGHT, GAMEPAD_MASK_DR  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E1,    GAMEPAD_MASK_E1  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E2,    GAMEPAD_MASK_E2  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E3,    GAMEPAD_MASK_E3  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E4,    GAMEPAD_MASK_E4  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E5,    GAMEPAD_MASK_E5  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E6,    GAMEPAD_MASK_E6  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E7,    GAMEPAD_MASK_E7  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E8,    GAMEPAD_MASK_E8  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E9,    GAMEPAD_MASK_E9  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E10,   GAMEPAD_MASK_E10 },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E11,   GAMEPAD_MASK_E11 },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_E12,   GAMEPAD_MASK_E12 },
+};
+
+static constexpr GamepadReportBit ps3ButtonBits[] = {
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_LEFT,  PS3_REPORT_MASK_LEFT   },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_DOWN,  PS3_REPORT_MASK_DOWN   },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_RIGHT, PS3_REPORT_MASK_RIGHT  },
+    { GAMEPAD_REPORT_SOURCE_DPAD,    GAMEPAD_MASK_UP,    PS3_REPORT_MASK_UP     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B1,    PS3_REPORT_MASK_SOUTH  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B2,    PS3_REPORT_MASK_EAST   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B3,    PS3_REPORT_MASK_WEST   },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_B4,    PS3_REPORT_MASK_NORTH  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L1,    PS3_REPORT_MASK_L1     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R1,    PS3_REPORT_MASK_R1     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L2,    PS3_REPORT_MASK_L2     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R2,    PS3_REPORT_MASK_R2     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S1,    PS3_REPORT_MASK_SELECT },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_S2,    PS3_REPORT_MASK_START  },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_L3,    PS3_REPORT_MASK_L3     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_R3,    PS3_REPORT_MASK_R3     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A1,    PS3_REPORT_MASK_PS     },
+    { GAMEPAD_REPORT_SOURCE_BUTTONS, GAMEPAD_MASK_A2,    PS3_REPORT_MASK_TP     },
+};
+
+static uint64_t wallNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint32_t packXInput(const GamepadState & state) {
+    return GamepadReportPacker<xinputButtons1Bits>::pack(state) | (GamepadReportPacker<xinputButtons2Bits>::pack(state) << 8);
+}
+
+static uint32_t packXboxOriginal(const GamepadState & state) {
+    return GamepadReportPacker<xboxOriginalButtonBits>::pack(state);
+}
+
+static uint32_t packSwitch(const GamepadState & state) {
+    return GamepadReportPacker<switchButtonBits>::pack(state);
+}
+
+static uint32_t packHID(const GamepadState & state) {
+    return GamepadReportPacker<hidButtonBits>::pack(state);
+}
+
+static uint32_t packPS3(const GamepadState & state) {
+    return GamepadReportPacker<ps3ButtonBits>::pack(state);
+}
+
+static GamepadState states[1024];
+static volatile uint32_t sink;
+
+// Both sides are template arguments, so each inlines into its own timing loop as it would into process()
+template <uint32_t (*Pack)(const GamepadState &), uint32_t (*Legacy)(Gamepad &)>
+static bool benchMode(const char * name, Gamepad * gamepad, uint32_t count) {
+    uint32_t mismatches = 0;
+    for (const GamepadState & state : states) {
+        gamepad->state = state;
+        if (Pack(state) != Legacy(*gamepad))
+            mismatches++;
+    }
+
+    uint64_t start = wallNs();
+    for (uint32_t n = 0; n < count; n++) {
+        gamepad->state = states[n & 1023];
+        sink = sink + Pack(gamepad->state);
+    }
+    const double packNs = (double)(wallNs() - start) / count;
+
+    start = wallNs();
+    for (uint32_t n = 0; n < count; n++) {
+        gamepad->state = states[n & 1023];
+        sink = sink + Legacy(*gamepad);
+    }
+    const double legacyNs = (double)(wallNs() - start) / count;
+
+    printf("%-14s packer %6.2f ns/report, ternaries %6.2f ns/report\n", name, packNs, legacyNs);
+    if (mismatches)
+        fprintf(stderr, "%s: packer and ternaries disagree on %u states\n", name, mismatches);
+    return mismatches == 0;
+}
+
+int main(int argc, char ** argv) {
+    const bool check = argc > 1 && strcmp(argv[1], "--check") == 0;
+    const uint32_t count = check ? 200000 : 20000000;
+
+    bootFirmware();
+    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+
+    std::mt19937 rng(2040);
+    for (GamepadState & state : states) {
+        state.buttons = rng() & rng();
+        state.dpad = rng() & 0xF;
+    }
+
+    int failures = 0;
+    failures += !benchMode<packXInput, legacyXInput>("xinput", gamepad, count);
+    failures += !benchMode<packXboxOriginal, legacyXboxOriginal>("xboxoriginal", gamepad, count);
+    failures += !benchMode<packSwitch, legacySwitch>("switch", gamepad, count);
+    failures += !benchMode<packHID, legacyHID>("hid", gamepad, count);
+    failures += !benchMode<packPS3, legacyPS3>("ps3", gamepad, count);
+
+    if (check && failures)
+        return 1;
+    return 0;
+}
@@ -0,0 +1,373 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Report descriptor corpus of the HIDReportPlan tests: the descriptors GP2040-CE itself presents in each mode,
+// a few third party layouts (report IDs, signed and 10-bit axes, usage ranges, dpad usages), and interfaces
+// that must not be planned. refDecode() is an independent reference that walks the descriptor item by item for
+// every report and reads each field bit by bit.
+
+#ifndef _HOST_HID_DESCRIPTORS_H_
+#define _HOST_HID_DESCRIPTORS_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "gamepad/GamepadState.h"
+
+#include "drivers/hid/HIDDescriptors.h"
+#undef LSB
+#undef MSB
+namespace ps4 {
+#include "drivers/ps4/PS4Descriptors.h"
+}
+namespace sw {
+#include "drivers/switch/SwitchDescriptors.h"
+}
+namespace ps3 {
+#include "drivers/ps3/PS3Descriptors.h"
+}
+namespace md {
+#include "drivers/mdmini/MDMiniDescriptors.h"
+}
+namespace astro {
+#include "drivers/astro/AstroDescriptors.h"
+}
+namespace neogeo {
+#include "drivers/neogeo/NeoGeoDescriptors.h"
+}
+namespace pce {
+#include "drivers/pcengine/PCEngineDescriptors.h"
+}
+namespace egret {
+#include "drivers/egret/EgretDescriptors.h"
+}
+
+// Boot keyboard (HID 1.11 appendix B.1)
+static const uint8_t boot_keyboard_descriptor[] = {
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01, 0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01,
+    0x75, 0x01, 0x95, 0x08, 0x81, 0x02, 0x95, 0x01, 0x75, 0x08, 0x81, 0x01, 0x95, 0x05, 0x75, 0x01,
+    0x05, 0x08, 0x19, 0x01, 0x29, 0x05, 0x91, 0x02, 0x95, 0x01, 0x75, 0x03, 0x91, 0x01, 0x95, 0x06,
+    0x75, 0x08, 0x15, 0x00, 0x25, 0x65, 0x05, 0x07, 0x19, 0x00, 0x29, 0x65, 0x81, 0x00, 0xC0,
+};
+
+// Boot mouse (HID 1.11 appendix B.2): buttons and X/Y, but no gamepad collection
+static const uint8_t boot_mouse_descriptor[] = {
+    0x05, 0x01, 0x09, 0x02, 0xA1, 0x01, 0x09, 0x01, 0xA1, 0x00,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x03, 0x15, 0x00, 0x25, 0x01, 0x95, 0x03, 0x75, 0x01, 0x81, 0x02,
+    0x95, 0x01, 0x75, 0x05, 0x81, 0x01,
+    0x05, 0x01, 0x09, 0x30, 0x09, 0x31, 0x15, 0x81, 0x25, 0x7F, 0x75, 0x08, 0x95, 0x02, 0x81, 0x06,
+    0xC0, 0xC0,
+};
+
+// Stadia style: report ID 3, hat, 15 buttons, X Y Z Rz 1..255, Brake, Accelerator, plus a vendor report
+static const uint8_t stadia_like_descriptor[] = {
+    0x05, 0x01, 0x09, 0x05, 0xA1, 0x01,
+    0x85, 0x03,
+    0x05, 0x01, 0x75, 0x04, 0x95, 0x01, 0x25, 0x07, 0x46, 0x3B, 0x01, 0x65, 0x14, 0x09, 0x39, 0x81, 0x42,
+    0x45, 0x00, 0x65, 0x00,
+    0x75, 0x01, 0x95, 0x04, 0x81, 0x01,
+    0x05, 0x09, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x0F, 0x09, 0x12, 0x09, 0x11, 0x09, 0x14,
+    0x09, 0x13, 0x09, 0x0D, 0x09, 0x0C, 0x09, 0x0B, 0x09, 0x0F, 0x09, 0x0E, 0x09, 0x08, 0x09, 0x07,
+    0x09, 0x05, 0x09, 0x04, 0x09, 0x02, 0x09, 0x01, 0x81, 0x02,
+    0x75, 0x01, 0x95, 0x01, 0x81, 0x01,
+    0x05, 0x01, 0x15, 0x01, 0x26, 0xFF, 0x00, 0x09, 0x01, 0xA1, 0x00, 0x09, 0x30, 0x09, 0x31, 0x75,
+    0x08, 0x95, 0x02, 0x81, 0x02, 0xC0,
+    0x09, 0x01, 0xA1, 0x00, 0x09, 0x32, 0x09, 0x35, 0x75, 0x08, 0x95, 0x02, 0x81, 0x02, 0xC0,
+    0x05, 0x02, 0x75, 0x08, 0x95, 0x02, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x09, 0xC5, 0x09, 0xC4, 0x81, 0x02,
+    0xC0,
+    0x06, 0x00, 0xFF, 0x09, 0x01, 0xA1, 0x01, 0x85, 0x05, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08,
+    0x95, 0x3F, 0x09, 0x01, 0x81, 0x02, 0xC0,
+};
+
+// DirectInput pad: signed 16-bit X Y Rx Ry inside Push/Pop, 10 buttons via usage range, 4 position hat 1..4
+static const uint8_t signed16_descriptor[] = {
+    0x05, 0x01, 0x09, 0x04, 0xA1, 0x01,
+    0xA4,
+    0x16, 0x00, 0x80, 0x26, 0xFF, 0x7F, 0x75, 0x10, 0x95, 0x04, 0x09, 0x30, 0x09, 0x31, 0x09, 0x33,
+    0x09, 0x34, 0x81, 0x02,
+    0xB4,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x0A, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x0A, 0x81, 0x02,
+    0x75, 0x02, 0x95, 0x01, 0x81, 0x03,
+    0x05, 0x01, 0x09, 0x39, 0x15, 0x01, 0x25, 0x04, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42,
+    0x75, 0x04, 0x95, 0x01, 0x81, 0x03,
+    0xC0,
+};
+
+// Arcade stick: 10-bit X/Y, dpad usages, 12 buttons
+static const uint8_t tenbit_descriptor[] = {
+    0x05, 0x01, 0x09, 0x04, 0xA1, 0x01,
+    0x15, 0x00, 0x26, 0xFF, 0x03, 0x75, 0x0A, 0x95, 0x02, 0x09, 0x30, 0x09, 0x31, 0x81, 0x02,
+    0x75, 0x04, 0x95, 0x01, 0x81, 0x01,
+    0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x04, 0x09, 0x90, 0x09, 0x91, 0x09, 0x92, 0x09, 0x93,
+    0x81, 0x02,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x0C, 0x95, 0x0C, 0x81, 0x02,
+    0xC0,
+};
+
+// 4-bit X/Y then 16 buttons: a 3 byte report whose last two bytes are one merged button run
+static const uint8_t merged_run_descriptor[] = {
+    0x05, 0x01, 0x09, 0x05, 0xA1, 0x01,
+    0x15, 0x00, 0x25, 0x0F, 0x75, 0x04, 0x95, 0x02, 0x09, 0x30, 0x09, 0x31, 0x81, 0x02,
+    0x05, 0x09, 0x19, 0x01, 0x29, 0x10, 0x25, 0x01, 0x75, 0x01, 0x95, 0x10, 0x81, 0x02,
+    0xC0,
+};
+
+struct HIDDescriptorEntry {
+    const char * name;
+    const uint8_t * descriptor;
+    uint16_t length;
+    bool planned;                   // Whether HIDReportPlan must find a gamepad report in it
+};
+
+#define HID_DESCRIPTOR_ENTRY(name, descriptor, planned) { name, descriptor, sizeof(descriptor), planned }
+
+static const HIDDescriptorEntry hidDescriptorCorpus[] = {
+    HID_DESCRIPTOR_ENTRY("GP2040-CE HID (DirectInput)", hid_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("DualShock 4", ps4::ps4_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("HORI Pokken (Switch)", sw::switch_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("DualShock 3", ps3::ps3_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("DualShock 3 (alt)", ps3::ps3_alt_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("Mega Drive Mini", md::mdmini_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("Astro City Mini", astro::astro_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("NeoGeo Mini", neogeo::neogeo_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("PC Engine Mini", pce::pcengine_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("Egret II Mini", egret::egret_report_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("Stadia style (report ID 3)", stadia_like_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("Signed 16-bit, 4-way hat", signed16_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("10-bit axes, dpad usages", tenbit_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("4-bit axes, merged buttons", merged_run_descriptor, true),
+    HID_DESCRIPTOR_ENTRY("Boot keyboard", boot_keyboard_descriptor, false),
+    HID_DESCRIPTOR_ENTRY("Boot mouse", boot_mouse_descriptor, false),
+};
+
+// Reference decoder
+
+// Usage presence in the whole descriptor, which decides where Z/Rz/Rx/Ry and Brake/Accelerator go
+struct HIDReferenceLayout {
+    bool zAndRz;
+    bool brake;
+    bool accelerator;
+};
+
+static inline bool hasDesktopUsage(const uint8_t * descriptor, uint16_t length, uint8_t usage) {
+    for (uint16_t i = 0; i + 1 < length; i++) {
+        if (descriptor[i] == 0x09 && descriptor[i + 1] == usage)
+            return true;
+    }
+    return false;
+}
+
+static inline HIDReferenceLayout referenceLayout(const uint8_t * descriptor, uint16_t length) {
+    HIDReferenceLayout layout;
+    layout.zAndRz = hasDesktopUsage(descriptor, length, 0x32) && hasDesktopUsage(descriptor, length, 0x35);
+    layout.brake = hasDesktopUsage(descriptor, length, 0xC5);
+    layout.accelerator = hasDesktopUsage(descriptor, length, 0xC4);
+    return layout;
+}
+
+static inline uint32_t refUnsigned(const uint8_t * data, int size) {
+    uint32_t value = 0;
+    for (int i = 0; i < size; i++)
+        value |= data[i] << (8 * i);
+    return value;
+}
+
+static inline int32_t refSigned(const uint8_t * data, int size) {
+    uint32_t value = refUnsigned(data, size);
+    if (size > 0 && size < 4 && ((value >> (size * 8 - 1)) & 1))
+        value |= ~((1u << (size * 8)) - 1);
+    return (int32_t)value;
+}
+
+static inline uint32_t refBits(const uint8_t * report, uint32_t offset, uint32_t size) {
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < size; i++)
+        value |= ((report[(offset + i) / 8] >> ((offset + i) % 8)) & 1) << i;
+    return value;
+}
+
+// Decodes one report the slow way, with the documented button order and axis rules
+static inline bool refDecode(const uint8_t * descriptor, uint16_t length, uint8_t reportId,
+                             const HIDReferenceLayout & layout, const uint8_t * report, GamepadState & state) {
+    static const uint32_t buttonMasks[32] = {
+        GAMEPAD_MASK_B3, GAMEPAD_MASK_B1, GAMEPAD_MASK_B2, GAMEPAD_MASK_B4,
+        GAMEPAD_MASK_L1, GAMEPAD_MASK_R1, GAMEPAD_MASK_L2, GAMEPAD_MASK_R2,
+        GAMEPAD_MASK_S1, GAMEPAD_MASK_S2, GAMEPAD_MASK_L3, GAMEPAD_MASK_R3,
+        GAMEPAD_MASK_A1, GAMEPAD_MASK_A2, GAMEPAD_MASK_A3, GAMEPAD_MASK_A4,
+        0, 0, 0, 0,
+        GAMEPAD_MASK_E1, GAMEPAD_MASK_E2, GAMEPAD_MASK_E3, GAMEPAD_MASK_E4,
+        GAMEPAD_MASK_E5, GAMEPAD_MASK_E6, GAMEPAD_MASK_E7, GAMEPAD_MASK_E8,
+        GAMEPAD_MASK_E9, GAMEPAD_MASK_E10, GAMEPAD_MASK_E11, GAMEPAD_MASK_E12,
+    };
+    static const uint8_t buttonDpad[4] = { GAMEPAD_MASK_UP, GAMEPAD_MASK_DOWN, GAMEPAD_MASK_LEFT, GAMEPAD_MASK_RIGHT };
+    static const uint8_t usageDpad[4] = { GAMEPAD_MASK_UP, GAMEPAD_MASK_DOWN, GAMEPAD_MASK_RIGHT, GAMEPAD_MASK_LEFT };
+    static const uint8_t hat[8] = {
+        GAMEPAD_MASK_UP, GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT, GAMEPAD_MASK_RIGHT, GAMEPAD_MASK_RIGHT | GAMEPAD_MASK_DOWN,
+        GAMEPAD_MASK_DOWN, GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT, GAMEPAD_MASK_LEFT, GAMEPAD_MASK_LEFT | GAMEPAD_MASK_UP,
+    };
+    struct Globals {
+        uint16_t page;
+        int32_t logicalMin;
+        int32_t logicalMax;
+        uint32_t size;
+        uint32_t count;
+        uint8_t id;
+    };
+
+    if (reportId != 0 && report[0] != reportId)
+        return false;
+    const uint8_t * data = reportId != 0 ? report + 1 : report;
+
+    Globals globals = {};
+    Globals stack[4];
+    int stackDepth = 0;
+    uint32_t usages[16];
+    int usageCount = 0;
+    uint32_t usageMin = 0;
+    uint32_t usageMax = 0;
+    bool usageRange = false;
+    uint32_t offsets[256] = {};
+    bool slotSeen[6] = {};
+
+    state.buttons = 0;
+    state.dpad = 0;
+    for (uint16_t pos = 0; pos < length;) {
+        const uint8_t prefix = descriptor[pos];
+        if (prefix == 0xFE) {
+            pos += 3 + descriptor[pos + 1];
+            continue;
+        }
+        const int size = (prefix & 3) == 3 ? 4 : (prefix & 3);
+        const int type = (prefix >> 2) & 3;
+        const int tag = prefix >> 4;
+        const uint8_t * item = descriptor + pos + 1;
+        pos += 1 + size;
+
+        if (type == 1) {
+            switch (tag) {
+                case 0: globals.page = refUnsigned(item, size); break;
+                case 1: globals.logicalMin = refSigned(item, size); break;
+                case 2:
+                    globals.logicalMax = refSigned(item, size);
+                    if (globals.logicalMin >= 0 && globals.logicalMax < globals.logicalMin)
+                        globals.logicalMax = refUnsigned(item, size);
+                    break;
+                case 7: globals.size = refUnsigned(item, size); break;
+                case 8: globals.id = refUnsigned(item, size); break;
+                case 9: globals.count = refUnsigned(item, size); break;
+                case 10: stack[stackDepth++] = globals; break;
+                case 11: globals = stack[--stackDepth]; break;
+            }
+            continue;
+        }
+        if (type == 2) {
+            const uint32_t usage = size == 4 ? refUnsigned(item, size) : (globals.page << 16 | refUnsigned(item, size));
+            if (tag == 0 && usageCount < 16)
+                usages[usageCount++] = usage;
+            if (tag == 1) {
+                usageMin = usage;
+                usageRange = true;
+            }
+            if (tag == 2) {
+                usageMax = usage;
+                usageRange = true;
+            }
+            continue;
+        }
+        if (type != 0)
+            continue;
+
+        const uint32_t flags = refUnsigned(item, size);
+        if (tag == 8 && !(flags & 1) && (flags & 2) && globals.id == reportId) {
+            for (uint32_t i = 0; i < globals.count; i++) {
+                uint32_t usage = 0;
+                if (usageCount)
+                    usage = usages[i < (uint32_t)usageCount ? i : usageCount - 1];
+                else if (usageRange && usageMin + i <= usageMax)
+                    usage = usageMin + i;
+                if (usage == 0 || globals.size > 24)
+                    continue;
+
+                const uint32_t value = refBits(data, offsets[globals.id] + i * globals.size, globals.size);
+                const uint16_t page = usage >> 16;
+                const uint16_t id = usage & 0xFFFF;
+                if (page == 0x09 && id >= 1 && id <= 32 && globals.size == 1) {
+                    if (value && id >= 17 && id <= 20)
+                        state.dpad |= buttonDpad[id - 17];
+                    else if (value)
+                        state.buttons |= buttonMasks[id - 1];
+                    continue;
+                }
+                if (page == 0x01 && id == 0x39) {
+                    const uint32_t positions = globals.logicalMax - globals.logicalMin;
+                    const uint32_t position = value - globals.logicalMin;
+                    if ((positions == 7 || positions == 3) && position <= positions)
+                        state.dpad |= hat[positions == 3 ? position * 2 : position];
+                    continue;
+                }
+                if (page == 0x01 && id >= 0x90 && id <= 0x93 && globals.size == 1) {
+                    if (value)
+                        state.dpad |= usageDpad[id - 0x90];
+                    continue;
+                }
+
+                int slot = -1; // lx ly rx ry lt rt
+                if (page == 0x01) {
+                    switch (id) {
+                        case 0x30: slot = 0; break;
+                        case 0x31: slot = 1; break;
+                        case 0x32: slot = layout.zAndRz ? 2 : -1; break;
+                        case 0x35: slot = layout.zAndRz ? 3 : -1; break;
+                        case 0x33: slot = layout.zAndRz ? (layout.brake ? -1 : 4) : 2; break;
+                        case 0x34: slot = layout.zAndRz ? (layout.accelerator ? -1 : 5) : 3; break;
+                    }
+                }
+                if (page == 0x02 && id == 0xC5)
+                    slot = 4;
+                if (page == 0x02 && id == 0xC4)
+                    slot = 5;
+                if (slot < 0 || slotSeen[slot] || globals.logicalMax <= globals.logicalMin)
+                    continue;
+                slotSeen[slot] = true;
+
+                int64_t signedValue = value;
+                if (globals.logicalMin < 0 && ((value >> (globals.size - 1)) & 1))
+                    signedValue = (int32_t)(value | ~((1u << globals.size) - 1));
+                const int64_t range = (int64_t)globals.logicalMax - globals.logicalMin;
+                int64_t position = signedValue - globals.logicalMin;
+                if (position < 0)
+                    position = 0;
+                if (position > range)
+                    position = range;
+                const uint16_t scaled = (uint16_t)((slot >= 4 ? 255.0 : 65535.0) * position / range);
+                switch (slot) {
+                    case 0: state.lx = scaled; break;
+                    case 1: state.ly = scaled; break;
+                    case 2: state.rx = scaled; break;
+                    case 3: state.ry = scaled; break;
+                    case 4: state.lt = scaled; break;
+                    case 5: state.rt = scaled; break;
+                }
+            }
+        }
+        if (tag == 8)
+            offsets[globals.id] += globals.size * globals.count;
+        usageCount = 0;
+        usageRange = false;
+        usageMin = 0;
+        usageMax = 0;
+    }
+    return true;
+}
+
+// The reference scales with doubles, the plan with fixed point, axes may differ by one
+static inline bool refSameState(const GamepadState & a, const GamepadState & b) {
+    auto closeTo = [](uint16_t x, uint16_t y) { return abs((int)x - (int)y) <= 1; };
+    return a.buttons == b.buttons && a.dpad == b.dpad &&
+        closeTo(a.lx, b.lx) && closeTo(a.ly, b.ly) && closeTo(a.rx, b.rx) && closeTo(a.ry, b.ry) &&
+        closeTo(a.lt, b.lt) && closeTo(a.rt, b.rt);
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Report button bits as the drivers built them before GamepadReportPacker, one pressedX() ternary per button, the
+// reference of the report packer test and benchmark. Each returns the bits in the report's own layout, XInput's
+// buttons1 in the low byte and buttons2 above it, PS3's three button bytes from the first.
+
+#ifndef _HOST_LEGACY_REPORTS_H_
+#define _HOST_LEGACY_REPORTS_H_
+
+#include <stdint.h>
+
+#include "gamepad.h"
+
+#include "drivers/hid/HIDDescriptors.h"
+#include "drivers/ps3/PS3Descriptors.h"
+#include "drivers/switch/SwitchDescriptors.h"
+#include "drivers/xboxog/xid/xid_gamepad.h"
+#include "drivers/xinput/XInputDescriptors.h"
+
+static uint32_t legacyXInput(Gamepad & g) {
+    const uint8_t buttons1 = 0
+        | (g.pressedUp()    ? XBOX_MASK_UP    : 0)
+        | (g.pressedDown()  ? XBOX_MASK_DOWN  : 0)
+        | (g.pressedLeft()  ? XBOX_MASK_LEFT  : 0)
+        | (g.pressedRight() ? XBOX_MASK_RIGHT : 0)
+        | (g.pressedS2()    ? XBOX_MASK_START : 0)
+        | (g.pressedS1()    ? XBOX_MASK_BACK  : 0)
+        | (g.pressedL3()    ? XBOX_MASK_LS    : 0)
+        | (g.pressedR3()    ? XBOX_MASK_RS    : 0)
+    ;
+    const uint8_t buttons2 = 0
+        | (g.pressedL1() ? XBOX_MASK_LB   : 0)
+        | (g.pressedR1() ? XBOX_MASK_RB   : 0)
+        | (g.pressedA1() ? XBOX_MASK_HOME : 0)
+        | (g.pressedB1() ? XBOX_MASK_A    : 0)
+        | (g.pressedB2() ? XBOX_MASK_B    : 0)
+        | (g.pressedB3() ? XBOX_MASK_X    : 0)
+        | (g.pressedB4() ? XBOX_MASK_Y    : 0)
+    ;
+    return buttons1 | (buttons2 << 8);
+}
+
+static uint32_t legacyXboxOriginal(Gamepad & g) {
+    return 0
+        | (g.pressedUp()    ? XID_DUP    : 0)
+        | (g.pressedDown()  ? XID_DDOWN  : 0)
+        | (g.pressedLeft()  ? XID_DLEFT  : 0)
+        | (g.pressedRight() ? XID_DRIGHT : 0)
+        | (g.pressedS2()    ? XID_START  : 0)
+        | (g.pressedS1()    ? XID_BACK   : 0)
+        | (g.pressedL3()    ? XID_LS     : 0)
+        | (g.pressedR3()    ? XID_RS     : 0)
+    ;
+}
+
+static uint32_t legacySwitch(Gamepad & g) {
+    return 0
+        | (g.pressedB1() ? SWITCH_MASK_B       : 0)
+        | (g.pressedB2() ? SWITCH_MASK_A       : 0)
+        | (g.pressedB3() ? SWITCH_MASK_Y       : 0)
+        | (g.pressedB4() ? SWITCH_MASK_X       : 0)
+        | (g.pressedL1() ? SWITCH_MASK_L       : 0)
+        | (g.pressedR1() ? SWITCH_MASK_R       : 0)
+        | (g.pressedL2() ? SWITCH_MASK_ZL      : 0)
+        | (g.pressedR2() ? SWITCH_MASK_ZR      : 0)
+        | (g.pressedS1() ? SWITCH_MASK_MINUS   : 0)
+        | (g.pressedS2() ? SWITCH_MASK_PLUS    : 0)
+        | (g.pressedL3() ? SWITCH_MASK_L3      : 0)
+        | (g.pressedR3() ? SWITCH_MASK_R3      : 0)
+        | (g.pressedA1() ? SWITCH_MASK_HOME    : 0)
+        | (g.pressedA2() ? SWITCH_MASK_CAPTURE : 0)
+    ;
+}
+
+static uint32_t legacyHID(Gamepad & g) {
+    return 0
+        | (g.pressedB1()    ? GAMEPAD_MASK_B2  : 0)
+        | (g.pressedB2()    ? GAMEPAD_MASK_B3  : 0)
+        | (g.pressedB3()    ? GAMEPAD_MASK_B1  : 0)
+        | (g.pressedB4()    ? GAMEPAD_MASK_B4  : 0)
+        | (g.pressedL1()    ? GAMEPAD_MASK_L1  : 0)
+        | (g.pressedR1()    ? GAMEPAD_MASK_R1  : 0)
+        | (g.pressedL2()    ? GAMEPAD_MASK_L2  : 0)
+        | (g.pressedR2()    ? GAMEPAD_MASK_R2  : 0)
+        | (g.pressedS1()    ? GAMEPAD_MASK_S1  : 0)
+        | (g.pressedS2()    ? GAMEPAD_MASK_S2  : 0)
+        | (g.pressedL3()    ? GAMEPAD_MASK_L3  : 0)
+        | (g.pressedR3()    ? GAMEPAD_MASK_R3  : 0)
+        | (g.pressedA1()    ? GAMEPAD_MASK_A1  : 0)
+        | (g.pressedA2()    ? GAMEPAD_MASK_A2  : 0)
+        | (g.pressedA3()    ? GAMEPAD_MASK_A3  : 0)
+        | (g.pressedA4()    ? GAMEPAD_MASK_A4  : 0)
+        | (g.pressedUp()    ? GAMEPAD_MASK_DU  : 0)
+        | (g.pressedDown()  ? GAMEPAD_MASK_DD  : 0)
+        | (g.pressedLeft()  ? GAMEPAD_MASK_DL  : 0)
+        | (g.pressedRight() ? GAMEPAD_MASK_DR  : 0)
+        | (g.pressedE1()    ? GAMEPAD_MASK_E1  : 0)
+        | (g.pressedE2()    ? GAMEPAD_MASK_E2  : 0)
+        | (g.pressedE3()    ? GAMEPAD_MASK_E3  : 0)
+        | (g.pressedE4()    ? GAMEPAD_MASK_E4  : 0)
+        | (g.pressedE5()    ? GAMEPAD_MASK_E5  : 0)
+        | (g.pressedE6()    ? GAMEPAD_MASK_E6  : 0)
+        | (g.pressedE7()    ? GAMEPAD_MASK_E7  : 0)
+        | (g.pressedE8()    ? GAMEPAD_MASK_E8  : 0)
+        | (g.pressedE9()    ? GAMEPAD_MASK_E9  : 0)
+        | (g.pressedE10()   ? GAMEPAD_MASK_E10 : 0)
+        | (g.pressedE11()   ? GAMEPAD_MASK_E11 : 0)
+        | (g.pressedE12()   ? GAMEPAD_MASK_E12 : 0)
+    ;
+}
+
+static uint32_t legacyPS3(Gamepad & g) {
+    return 0
+        | (g.pressedS1()    ? PS3_REPORT_MASK_SELECT : 0)
+        | (g.pressedL3()    ? PS3_REPORT_MASK_L3     : 0)
+        | (g.pressedR3()    ? PS3_REPORT_MASK_R3     : 0)
+        | (g.pressedS2()    ? PS3_REPORT_MASK_START  : 0)
+        | (g.pressedUp()    ? PS3_REPORT_MASK_UP     : 0)
+        | (g.pressedRight() ? PS3_REPORT_MASK_RIGHT  : 0)
+        | (g.pressedDown()  ? PS3_REPORT_MASK_DOWN   : 0)
+        | (g.pressedLeft()  ? PS3_REPORT_MASK_LEFT   : 0)
+        | (g.pressedL2()    ? PS3_REPORT_MASK_L2     : 0)
+        | (g.pressedR2()    ? PS3_REPORT_MASK_R2     : 0)
+        | (g.pressedL1()    ? PS3_REPORT_MASK_L1     : 0)
+        | (g.pressedR1()    ? PS3_REPORT_MASK_R1     : 0)
+        | (g.pressedB4()    ? PS3_REPORT_MASK_NORTH  : 0)
+        | (g.pressedB2()    ? PS3_REPORT_MASK_EAST   : 0)
+        | (g.pressedB1()    ? PS3_REPORT_MASK_SOUTH  : 0)
+        | (g.pressedB3()    ? PS3_REPORT_MASK_WEST   : 0)
+        | (g.pressedA1()    ? PS3_REPORT_MASK_PS     : 0)
+        | (g.pressedA2()    ? PS3_REPORT_MASK_TP     : 0)
+    ;
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#include "harness.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hardware/platform_defs.h"
+#include "storagemanager.h"
+#include "FlashPROM.h"
+
+#define BANK0_MASK ((1u << NUM_BANK0_GPIOS) - 1)
+
+bool loadTrace(const char * path, Trace & trace) {
+    FILE * file = fopen(path, "r");
+    if (file == nullptr) {
+        fprintf(stderr, "cannot open trace %s\n", path);
+        return false;
+    }
+
+    char line[256];
+    uint32_t lineNumber = 0;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        lineNumber++;
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+
+        unsigned long long timeUs;
+        unsigned int rawGpio;
+        unsigned int adc[4] = {};
+        if (sscanf(line, "%llu %x %u %u %u %u", &timeUs, &rawGpio, &adc[0], &adc[1], &adc[2], &adc[3]) < 2 ||
+            (!trace.empty() && timeUs < trace.back().timeUs)) {
+            fprintf(stderr, "%s:%u: bad sample\n", path, lineNumber);
+            fclose(file);
+            return false;
+        }
+        TraceSample sample = { timeUs, rawGpio & BANK0_MASK, {} };
+        for (uint8_t i = 0; i < 4; i++)
+            sample.adc[i] = adc[i] & 0xfff;
+        trace.push_back(sample);
+    }
+    fclose(file);
+    return true;
+}
+
+void provisionConfig(const std::function<void(Config &)> & edit) {
+    Storage & storage = Storage::getInstance();
+    storage.init();
+    edit(storage.getConfig());
+    storage.save(true);
+
+    // The journal write is deferred by FlashPROM, let it fall due
+    host_time_advance_us(EEPROM_WRITE_WAIT * 1000 * 2);
+}
+
+GP2040 * bootFirmware() {
+    GP2040 * gp2040 = new GP2040();
+    gp2040->setup();
+    gp2040->start();
+    return gp2040;
+}
+
+void replaySample(GP2040 * gp2040, const TraceSample & sample) {
+    host_time_advance_to_us(sample.timeUs);
+    host_gpio_set_levels(~sample.rawGpio & BANK0_MASK);
+    for (uint8_t i = 0; i < 4; i++)
+        host_adc_set(i, sample.adc[i]);
+    gp2040->loop();
+}
@@ -0,0 +1,42 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Boots the core0 firmware on the host shim and replays recorded pin and ADC traces through GP2040::loop().
+
+#ifndef _HOST_HARNESS_H_
+#define _HOST_HARNESS_H_
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+#include "gp2040.h"
+#include "host_hal.h"
+
+#include "config.pb.h"
+
+// One line of a trace file: "timeUs rawGpio adc0 adc1 adc2 adc3". rawGpio has a bit set for every pin that is
+// pulled low (pressed), adc values are 12-bit conversions. Lines starting with # are comments.
+struct TraceSample {
+    uint64_t timeUs;
+    uint32_t rawGpio;
+    uint16_t adc[4];
+};
+
+typedef std::vector<TraceSample> Trace;
+
+bool loadTrace(const char * path, Trace & trace);
+
+// Writes the config a boot will load, as saving it in web config would: defaults for the board, then edit
+void provisionConfig(const std::function<void(Config &)> & edit);
+
+// setup() and start() of core0 as main() runs them. Every firmware singleton is created here, so a process
+// boots once.
+GP2040 * bootFirmware();
+
+// Set the pins and ADC inputs of the sample at its time, then run one pass of the loop
+void replaySample(GP2040 * gp2040, const TraceSample & sample);
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Flash image of the host shim, mapped at XIP_BASE before any firmware code runs so that pointers such as
+// EEPROM_ADDRESS_START read it directly. Erase sets bytes to 0xff and program can only clear bits, like NOR flash.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "pico/platform.h"
+#include "hardware/flash.h"
+#include "host_hal.h"
+
+static uint8_t * image = nullptr;
+static uint32_t operations = 0;
+static int32_t failAfter = -1;
+
+__attribute__((constructor(101)))
+static void mapFlash(void) {
+    void * mapped = mmap((void *)(uintptr_t)XIP_BASE, PICO_FLASH_SIZE_BYTES, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (mapped != (void *)(uintptr_t)XIP_BASE) {
+        fprintf(stderr, "Cannot map the flash image at 0x%08x\n", XIP_BASE);
+        abort();
+    }
+    image = (uint8_t *)mapped;
+    memset(image, 0xff, PICO_FLASH_SIZE_BYTES);
+}
+
+uint8_t * host_flash_image(void) {
+    return image;
+}
+
+void host_flash_reset(void) {
+    memset(image, 0xff, PICO_FLASH_SIZE_BYTES);
+    operations = 0;
+    failAfter = -1;
+}
+
+uint32_t host_flash_operations(void) {
+    return operations;
+}
+
+void host_flash_fail_after(int32_t count) {
+    failAfter = count;
+}
+
+// True when this operation is the one that loses power, after half of it reached the flash
+static bool powerLost(void) {
+    operations++;
+    if (failAfter < 0)
+        return false;
+    if (failAfter-- > 0)
+        return false;
+    failAfter = -1;
+    return true;
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES)
+        panic("flash_range_erase(0x%x, 0x%zx) is not sector aligned", flash_offs, count);
+
+    if (powerLost()) {
+        memset(image + flash_offs, 0xff, count / 2);
+        throw HostPowerLoss();
+    }
+    memset(image + flash_offs, 0xff, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t * data, size_t count) {
+    if (flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES)
+        panic("flash_range_program(0x%x, 0x%zx) is not page aligned", flash_offs, count);
+
+    size_t programmed = count;
+    bool lost = powerLost();
+    if (lost)
+        programmed = count / 2;
+    for (size_t i = 0; i < programmed; i++)
+        image[flash_offs + i] &= data[i];
+    if (lost)
+        throw HostPowerLoss();
+}
+
+void flash_get_unique_id(uint8_t * id_out) {
+    static const uint8_t flashId[FLASH_UNIQUE_ID_SIZE_BYTES] = { 0xe6, 0x60, 0x58, 0x38, 0x83, 0x2a, 0x4b, 0x2c };
+    memcpy(id_out, flashId, sizeof(flashId));
+}
+
+void flash_do_cmd(const uint8_t * txbuf, uint8_t * rxbuf, size_t count) {
+    memset(rxbuf, 0, count);
+    // JEDEC ID: manufacturer, memory type, capacity as a power of two
+    if (count >= 4 && txbuf[0] == 0x9f) {
+        rxbuf[1] = 0xef;
+        rxbuf[2] = 0x40;
+        rxbuf[3] = (uint8_t)__builtin_ctz(PICO_FLASH_SIZE_BYTES);
+    }
+}
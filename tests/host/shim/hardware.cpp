@@ -0,0 +1,558 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Register blocks and peripherals of the host shim. Pins and ADC inputs are whatever the harness set, buses
+// have nothing attached, and everything the firmware only configures is recorded and otherwise ignored.
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico/platform.h"
+#include "pico/multicore.h"
+#include "pico/rand.h"
+#include "pico/unique_id.h"
+#include "pico/bootrom.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/spi.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
+#include "hardware/structs/ioqspi.h"
+#include "hardware/structs/padsbank0.h"
+#include "hardware/structs/sio.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/usb.h"
+#include "host_hal.h"
+
+#define BANK0_MASK ((1u << NUM_BANK0_GPIOS) - 1)
+
+adc_hw_t host_adc_hw;
+ioqspi_hw_t host_ioqspi_hw;
+padsbank0_hw_t host_padsbank0_hw;
+pio_hw_t host_pio_hw[2];
+sio_hw_t host_sio_hw = { 0, 0, 0xffffffffu };
+systick_hw_t host_systick_hw;
+usb_hw_t host_usb_hw;
+watchdog_hw_t host_watchdog_hw;
+i2c_inst_t host_i2c_inst[2] = { { 0, 0 }, { 1, 0 } };
+spi_inst_t host_spi_inst[2] = { { 0, 0, {} }, { 1, 0, {} } };
+
+// Linker script symbols, the image and the heap of the host process have no such bounds
+char __flash_binary_start;
+char __flash_binary_end;
+char __bss_end__;
+char __StackLimit;
+char __StackTop;
+
+static uint currentCore = 0;
+static uint32_t inputLevels = BANK0_MASK;
+static uint32_t outputLevels = 0;
+static uint32_t outputEnabled = 0;
+static uint32_t pullUps = 0;
+static uint32_t pullDowns = 0;
+static uint8_t gpioFunctions[NUM_BANK0_GPIOS];
+static uint16_t adcValues[NUM_ADC_CHANNELS];
+static uint adcInput = 0;
+static spin_lock_t spinLocks[NUM_SPIN_LOCKS];
+static uint32_t spinLocksClaimed = 0;
+static uint32_t dmaClaimed = 0;
+static uint32_t sysClockKhz = 125000;
+static uint64_t randState = 0x853c49e6748fea9bULL;
+
+// Platform
+
+uint get_core_num(void) {
+    return currentCore;
+}
+
+void host_set_core_num(uint core) {
+    currentCore = core;
+}
+
+void panic(const char * fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    fputs("panic: ", stderr);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    abort();
+}
+
+uint32_t host_systick_count(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ~(uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+// GPIO
+
+void host_gpio_set_levels(uint32_t levels) {
+    inputLevels = levels & BANK0_MASK;
+}
+
+uint32_t host_gpio_get_levels(void) {
+    return inputLevels;
+}
+
+void gpio_init(uint gpio) {
+    outputEnabled &= ~(1u << gpio);
+    outputLevels &= ~(1u << gpio);
+    gpioFunctions[gpio] = GPIO_FUNC_SIO;
+    padsbank0_hw->io[gpio] |= PADS_BANK0_GPIO0_IE_BITS;
+}
+
+void gpio_deinit(uint gpio) {
+    gpioFunctions[gpio] = GPIO_FUNC_NULL;
+}
+
+void gpio_init_mask(uint gpio_mask) {
+    for (uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++) {
+        if (gpio_mask & (1u << gpio))
+            gpio_init(gpio);
+    }
+}
+
+void gpio_set_function(uint gpio, gpio_function_t fn) {
+    gpioFunctions[gpio] = (uint8_t)fn;
+}
+
+gpio_function_t gpio_get_function(uint gpio) {
+    return (gpio_function_t)gpioFunctions[gpio];
+}
+
+void gpio_set_pulls(uint gpio, bool up, bool down) {
+    pullUps = up ? (pullUps | (1u << gpio)) : (pullUps & ~(1u << gpio));
+    pullDowns = down ? (pullDowns | (1u << gpio)) : (pullDowns & ~(1u << gpio));
+}
+
+bool gpio_is_pulled_up(uint gpio) {
+    return (pullUps >> gpio) & 1u;
+}
+
+bool gpio_is_pulled_down(uint gpio) {
+    return (pullDowns >> gpio) & 1u;
+}
+
+void gpio_set_input_enabled(uint gpio, bool enabled) {
+    if (enabled)
+        padsbank0_hw->io[gpio] |= PADS_BANK0_GPIO0_IE_BITS;
+    else
+        padsbank0_hw->io[gpio] &= ~PADS_BANK0_GPIO0_IE_BITS;
+}
+
+void gpio_set_drive_strength(uint gpio, enum gpio_drive_strength drive) {
+    (void)gpio;
+    (void)drive;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    outputEnabled = out ? (outputEnabled | (1u << gpio)) : (outputEnabled & ~(1u << gpio));
+}
+
+void gpio_set_dir_out_masked(uint32_t mask) {
+    outputEnabled |= mask;
+}
+
+void gpio_set_dir_in_masked(uint32_t mask) {
+    outputEnabled &= ~mask;
+}
+
+bool gpio_is_dir_out(uint gpio) {
+    return (outputEnabled >> gpio) & 1u;
+}
+
+uint gpio_get_dir(uint gpio) {
+    return gpio_is_dir_out(gpio) ? GPIO_OUT : GPIO_IN;
+}
+
+uint32_t gpio_get_all(void) {
+    return (inputLevels & ~outputEnabled) | (outputLevels & outputEnabled);
+}
+
+void gpio_put(uint gpio, bool value) {
+    outputLevels = value ? (outputLevels | (1u << gpio)) : (outputLevels & ~(1u << gpio));
+}
+
+void gpio_put_masked(uint32_t mask, uint32_t value) {
+    outputLevels = (outputLevels & ~mask) | (value & mask);
+}
+
+void gpio_put_all(uint32_t value) {
+    outputLevels = value;
+}
+
+bool gpio_get_out_level(uint gpio) {
+    return (outputLevels >> gpio) & 1u;
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    (void)num;
+    (void)handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    (void)num;
+    (void)enabled;
+}
+
+// ADC
+
+void host_adc_set(uint input, uint16_t value) {
+    if (input < NUM_ADC_CHANNELS)
+        adcValues[input] = value & 0xfff;
+}
+
+void adc_init(void) {
+    adc_hw->cs = ADC_CS_EN_BITS;
+}
+
+void adc_gpio_init(uint gpio) {
+    gpioFunctions[gpio] = GPIO_FUNC_NULL;
+    gpio_set_pulls(gpio, false, false);
+    gpio_set_input_enabled(gpio, false);
+}
+
+void adc_select_input(uint input) {
+    adcInput = input;
+}
+
+uint adc_get_selected_input(void) {
+    return adcInput;
+}
+
+void adc_set_round_robin(uint input_mask) {
+    (void)input_mask;
+}
+
+void adc_set_temp_sensor_enabled(bool enable) {
+    (void)enable;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    (void)clkdiv;
+}
+
+uint16_t adc_read(void) {
+    return adcInput < NUM_ADC_CHANNELS ? adcValues[adcInput] : 0;
+}
+
+// Locks and core1
+
+uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+void restore_interrupts(uint32_t status) {
+    (void)status;
+}
+
+spin_lock_t * spin_lock_instance(uint lock_num) {
+    return &spinLocks[lock_num];
+}
+
+uint spin_lock_get_num(spin_lock_t * lock) {
+    return (uint)(lock - spinLocks);
+}
+
+int spin_lock_claim_unused(bool required) {
+    // The SDK hands out the striped locks 16-23 first, the host does the same for reproducible numbers
+    for (uint lock = 16; lock < NUM_SPIN_LOCKS; lock++) {
+        if (!(spinLocksClaimed & (1u << lock))) {
+            spinLocksClaimed |= 1u << lock;
+            return (int)lock;
+        }
+    }
+    if (required)
+        panic("No spin locks are available");
+    return -1;
+}
+
+void spin_lock_claim(uint lock_num) {
+    spinLocksClaimed |= 1u << lock_num;
+}
+
+void spin_lock_unclaim(uint lock_num) {
+    spinLocksClaimed &= ~(1u << lock_num);
+    spinLocks[lock_num] = 0;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    (void)entry;
+}
+
+void multicore_reset_core1(void) {}
+void multicore_lockout_victim_init(void) {}
+void multicore_lockout_start_blocking(void) {}
+void multicore_lockout_end_blocking(void) {}
+
+bool multicore_lockout_start_timeout_us(uint64_t timeout_us) {
+    (void)timeout_us;
+    return true;
+}
+
+bool multicore_lockout_end_timeout_us(uint64_t timeout_us) {
+    (void)timeout_us;
+    return true;
+}
+
+// Clocks, random numbers and the board ID
+
+bool set_sys_clock_khz(uint32_t freq_khz, bool required) {
+    (void)required;
+    sysClockKhz = freq_khz;
+    return true;
+}
+
+uint32_t clock_get_hz(clock_handle_t clock) {
+    switch (clock) {
+        case clk_sys: return sysClockKhz * 1000;
+        case clk_usb:
+        case clk_adc: return 48000000;
+        case clk_peri: return sysClockKhz * 1000;
+        default: return 12000000;
+    }
+}
+
+void host_rand_seed(uint64_t seed) {
+    randState = seed ? seed : 0x853c49e6748fea9bULL;
+}
+
+uint64_t get_rand_64(void) {
+    // xorshift64*
+    randState ^= randState >> 12;
+    randState ^= randState << 25;
+    randState ^= randState >> 27;
+    return randState * 0x2545f4914f6cdd1dULL;
+}
+
+uint32_t get_rand_32(void) {
+    return (uint32_t)(get_rand_64() >> 32);
+}
+
+void pico_get_unique_board_id(pico_unique_board_id_t * id_out) {
+    static const uint8_t boardId[PICO_UNIQUE_BOARD_ID_SIZE_BYTES] = { 0xe6, 0x60, 0x58, 0x38, 0x83, 0x2a, 0x4b, 0x2c };
+    memcpy(id_out->id, boardId, sizeof(boardId));
+}
+
+void pico_get_unique_board_id_string(char * id_out, uint len) {
+    pico_unique_board_id_t id;
+    pico_get_unique_board_id(&id);
+    uint i = 0;
+    for (; i < 2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES && i + 1 < len; i++) {
+        uint8_t nibble = (id.id[i / 2] >> (i % 2 ? 0 : 4)) & 0x0f;
+        id_out[i] = "0123456789ABCDEF"[nibble];
+    }
+    if (len)
+        id_out[i] = 0;
+}
+
+// Reboots
+
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms) {
+    (void)pc;
+    (void)sp;
+    (void)delay_ms;
+    watchdog_hw->reason = 1;
+    throw HostReboot{ false };
+}
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug) {
+    (void)pause_on_debug;
+    watchdog_hw->load = delay_ms * 1000;
+}
+
+void watchdog_update(void) {}
+
+bool watchdog_caused_reboot(void) {
+    return watchdog_hw->reason != 0;
+}
+
+bool watchdog_enable_caused_reboot(void) {
+    return watchdog_hw->reason != 0;
+}
+
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask) {
+    (void)usb_activity_gpio_pin_mask;
+    (void)disable_interface_mask;
+    throw HostReboot{ true };
+}
+
+void host_power_cycle(void) {
+    memset((void *)&host_watchdog_hw, 0, sizeof(host_watchdog_hw));
+    memset((void *)spinLocks, 0, sizeof(spinLocks));
+}
+
+// Buses with nothing attached
+
+uint i2c_init(i2c_inst_t * i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+void i2c_deinit(i2c_inst_t * i2c) {
+    i2c->baudrate = 0;
+}
+
+uint i2c_set_baudrate(i2c_inst_t * i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t * i2c, uint8_t addr, const uint8_t * src, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)src; (void)len; (void)nostop;
+    return PICO_ERROR_GENERIC;
+}
+
+int i2c_read_blocking(i2c_inst_t * i2c, uint8_t addr, uint8_t * dst, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)dst; (void)len; (void)nostop;
+    return PICO_ERROR_GENERIC;
+}
+
+int i2c_write_blocking_until(i2c_inst_t * i2c, uint8_t addr, const uint8_t * src, size_t len, bool nostop, absolute_time_t until) {
+    (void)until;
+    return i2c_write_blocking(i2c, addr, src, len, nostop);
+}
+
+int i2c_read_blocking_until(i2c_inst_t * i2c, uint8_t addr, uint8_t * dst, size_t len, bool nostop, absolute_time_t until) {
+    (void)until;
+    return i2c_read_blocking(i2c, addr, dst, len, nostop);
+}
+
+int i2c_write_timeout_us(i2c_inst_t * i2c, uint8_t addr, const uint8_t * src, size_t len, bool nostop, uint timeout_us) {
+    (void)timeout_us;
+    return i2c_write_blocking(i2c, addr, src, len, nostop);
+}
+
+int i2c_read_timeout_us(i2c_inst_t * i2c, uint8_t addr, uint8_t * dst, size_t len, bool nostop, uint timeout_us) {
+    (void)timeout_us;
+    return i2c_read_blocking(i2c, addr, dst, len, nostop);
+}
+
+uint spi_init(spi_inst_t * spi, uint baudrate) {
+    spi->baudrate = baudrate;
+    return baudrate;
+}
+
+void spi_deinit(spi_inst_t * spi) {
+    spi->baudrate = 0;
+}
+
+uint spi_set_baudrate(spi_inst_t * spi, uint baudrate) {
+    spi->baudrate = baudrate;
+    return baudrate;
+}
+
+uint spi_get_baudrate(const spi_inst_t * spi) {
+    return spi->baudrate;
+}
+
+void spi_set_format(spi_inst_t * spi, uint data_bits, spi_cpol_t cpol, spi_cpha_t cpha, spi_order_t order) {
+    (void)spi; (void)data_bits; (void)cpol; (void)cpha; (void)order;
+}
+
+void spi_set_slave(spi_inst_t * spi, bool slave) {
+    (void)spi;
+    (void)slave;
+}
+
+int spi_write_read_blocking(spi_inst_t * spi, const uint8_t * src, uint8_t * dst, size_t len) {
+    (void)spi;
+    (void)src;
+    memset(dst, 0xff, len);
+    return (int)len;
+}
+
+int spi_write_blocking(spi_inst_t * spi, const uint8_t * src, size_t len) {
+    (void)spi;
+    (void)src;
+    return (int)len;
+}
+
+int spi_read_blocking(spi_inst_t * spi, uint8_t repeated_tx_data, uint8_t * dst, size_t len) {
+    (void)spi;
+    (void)repeated_tx_data;
+    memset(dst, 0xff, len);
+    return (int)len;
+}
+
+int spi_write16_read16_blocking(spi_inst_t * spi, const uint16_t * src, uint16_t * dst, size_t len) {
+    (void)spi;
+    (void)src;
+    memset(dst, 0xff, len * sizeof(uint16_t));
+    return (int)len;
+}
+
+int spi_write16_blocking(spi_inst_t * spi, const uint16_t * src, size_t len) {
+    (void)spi;
+    (void)src;
+    return (int)len;
+}
+
+int spi_read16_blocking(spi_inst_t * spi, uint16_t repeated_tx_data, uint16_t * dst, size_t len) {
+    (void)spi;
+    (void)repeated_tx_data;
+    memset(dst, 0xff, len * sizeof(uint16_t));
+    return (int)len;
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (uint channel = 0; channel < NUM_DMA_CHANNELS; channel++) {
+        if (!(dmaClaimed & (1u << channel))) {
+            dmaClaimed |= 1u << channel;
+            return (int)channel;
+        }
+    }
+    if (required)
+        panic("No DMA channels are available");
+    return -1;
+}
+
+void dma_channel_claim(uint channel) {
+    dmaClaimed |= 1u << channel;
+}
+
+void dma_channel_unclaim(uint channel) {
+    dmaClaimed &= ~(1u << channel);
+}
+
+bool dma_channel_is_claimed(uint channel) {
+    return (dmaClaimed >> channel) & 1u;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    return dma_channel_config{ 0 };
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config * config, volatile void * write_addr,
+                           const volatile void * read_addr, uint transfer_count, bool trigger) {
+    (void)channel; (void)config; (void)write_addr; (void)read_addr; (void)transfer_count; (void)trigger;
+}
+
+void dma_start_channel_mask(uint32_t chan_mask) {
+    (void)chan_mask;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {
+    (void)channel;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    (void)channel;
+    return false;
+}
+
+void dma_channel_abort(uint channel) {
+    (void)channel;
+}
@@ -0,0 +1,36 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the CDC constants of TinyUSB's class/cdc/cdc.h used by the network descriptors
+
+#ifndef _HOST_TUSB_CDC_H_
+#define _HOST_TUSB_CDC_H_
+
+typedef enum {
+    CDC_COMM_SUBCLASS_DIRECT_LINE_CONTROL_MODEL = 0x01,
+    CDC_COMM_SUBCLASS_ABSTRACT_CONTROL_MODEL,
+    CDC_COMM_SUBCLASS_TELEPHONE_CONTROL_MODEL,
+    CDC_COMM_SUBCLASS_MULTICHANNEL_CONTROL_MODEL,
+    CDC_COMM_SUBCLASS_CAPI_CONTROL_MODEL,
+    CDC_COMM_SUBCLASS_ETHERNET_CONTROL_MODEL,
+    CDC_COMM_SUBCLASS_ATM_NETWORKING_CONTROL_MODEL,
+    CDC_COMM_SUBCLASS_WIRELESS_HANDSET_CONTROL_MODEL,
+    CDC_COMM_SUBCLASS_DEVICE_MANAGEMENT,
+    CDC_COMM_SUBCLASS_MOBILE_DIRECT_LINE_MODEL,
+    CDC_COMM_SUBCLASS_OBEX,
+    CDC_COMM_SUBCLASS_ETHERNET_EMULATION_MODEL,
+    CDC_COMM_SUBCLASS_NETWORK_CONTROL_MODEL
+} cdc_comm_sublcass_type_t;
+
+typedef enum {
+    CDC_FUNC_DESC_HEADER = 0x00,
+    CDC_FUNC_DESC_CALL_MANAGEMENT = 0x01,
+    CDC_FUNC_DESC_ABSTRACT_CONTROL_MANAGEMENT = 0x02,
+    CDC_FUNC_DESC_UNION = 0x06,
+    CDC_FUNC_DESC_ETHERNET_NETWORKING = 0x0F,
+    CDC_FUNC_DESC_NCM = 0x1A,
+} cdc_func_desc_type_t;
+
+#endif
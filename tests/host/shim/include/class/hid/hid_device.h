@@ -0,0 +1,54 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of TinyUSB's class/hid/hid_device.h
+
+#ifndef _HOST_TUSB_HID_DEVICE_H_
+#define _HOST_TUSB_HID_DEVICE_H_
+
+#include "class/hid/hid.h"
+#include "device/usbd_pvt.h"
+
+#ifndef CFG_TUD_HID_EP_BUFSIZE
+#define CFG_TUD_HID_EP_BUFSIZE 64
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool tud_hid_n_ready(uint8_t instance);
+uint8_t tud_hid_n_interface_protocol(uint8_t instance);
+uint8_t tud_hid_n_get_protocol(uint8_t instance);
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, void const * report, uint16_t len);
+
+static inline bool tud_hid_ready(void) { return tud_hid_n_ready(0); }
+static inline bool tud_hid_report(uint8_t report_id, void const * report, uint16_t len) {
+    return tud_hid_n_report(0, report_id, report, len);
+}
+
+// Application callbacks
+uint8_t const * tud_hid_descriptor_report_cb(uint8_t instance);
+uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t * buffer,
+                               uint16_t reqlen);
+void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t const * buffer,
+                           uint16_t bufsize);
+TU_ATTR_WEAK void tud_hid_set_protocol_cb(uint8_t instance, uint8_t protocol);
+TU_ATTR_WEAK bool tud_hid_set_idle_cb(uint8_t instance, uint8_t idle_rate);
+TU_ATTR_WEAK void tud_hid_report_complete_cb(uint8_t instance, uint8_t const * report, uint16_t len);
+
+// Class driver
+void hidd_init(void);
+bool hidd_deinit(void);
+void hidd_reset(uint8_t rhport);
+uint16_t hidd_open(uint8_t rhport, tusb_desc_interface_t const * itf_desc, uint16_t max_len);
+bool hidd_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request);
+bool hidd_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t event, uint32_t xferred_bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of TinyUSB's class/hid/hid_host.h
+
+#ifndef _HOST_TUSB_HID_HOST_H_
+#define _HOST_TUSB_HID_HOST_H_
+
+#include "class/hid/hid.h"
+#include "host/usbh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint8_t report_id;
+    uint8_t usage;
+    uint16_t usage_page;
+} tuh_hid_report_info_t;
+
+uint8_t tuh_hid_itf_get_count(uint8_t dev_addr);
+bool tuh_hid_mounted(uint8_t dev_addr, uint8_t idx);
+uint8_t tuh_hid_interface_protocol(uint8_t dev_addr, uint8_t idx);
+uint8_t tuh_hid_parse_report_descriptor(tuh_hid_report_info_t * reports_info_arr, uint8_t arr_count,
+                                        uint8_t const * desc_report, uint16_t desc_len);
+bool tuh_hid_get_report(uint8_t dev_addr, uint8_t idx, uint8_t report_id, uint8_t report_type, void * report,
+                        uint16_t len);
+bool tuh_hid_set_report(uint8_t dev_addr, uint8_t idx, uint8_t report_id, uint8_t report_type, void * report,
+                        uint16_t len);
+bool tuh_hid_receive_report(uint8_t dev_addr, uint8_t idx);
+bool tuh_hid_send_ready(uint8_t dev_addr, uint8_t idx);
+bool tuh_hid_send_report(uint8_t dev_addr, uint8_t idx, uint8_t report_id, void const * report, uint16_t len);
+
+// Application callbacks
+TU_ATTR_WEAK void tuh_hid_mount_cb(uint8_t dev_addr, uint8_t idx, uint8_t const * report_desc, uint16_t desc_len);
+TU_ATTR_WEAK void tuh_hid_umount_cb(uint8_t dev_addr, uint8_t idx);
+void tuh_hid_report_received_cb(uint8_t dev_addr, uint8_t idx, uint8_t const * report, uint16_t len);
+TU_ATTR_WEAK void tuh_hid_report_sent_cb(uint8_t dev_addr, uint8_t idx, uint8_t const * report, uint16_t len);
+TU_ATTR_WEAK void tuh_hid_get_report_complete_cb(uint8_t dev_addr, uint8_t idx, uint8_t report_id,
+                                                 uint8_t report_type, uint16_t len);
+TU_ATTR_WEAK void tuh_hid_set_report_complete_cb(uint8_t dev_addr, uint8_t idx, uint8_t report_id,
+                                                 uint8_t report_type, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
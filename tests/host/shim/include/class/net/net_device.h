@@ -0,0 +1,47 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of TinyUSB's class/net/net_device.h
+
+#ifndef _HOST_TUSB_NET_DEVICE_H_
+#define _HOST_TUSB_NET_DEVICE_H_
+
+#include "class/cdc/cdc.h"
+#include "device/usbd_pvt.h"
+
+#ifndef CFG_TUD_NET_MTU
+#define CFG_TUD_NET_MTU 1514
+#endif
+
+#ifndef CFG_TUD_NET_ENDPOINT_SIZE
+#define CFG_TUD_NET_ENDPOINT_SIZE 64
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint8_t tud_network_mac_address[6];
+
+void tud_network_init_cb(void);
+bool tud_network_recv_cb(uint8_t const * src, uint16_t size);
+uint16_t tud_network_xmit_cb(uint8_t * dst, void * ref, uint16_t arg);
+bool tud_network_can_xmit(uint16_t size);
+void tud_network_xmit(void * ref, uint16_t arg);
+void tud_network_recv_renew(void);
+
+// Class driver
+void netd_init(void);
+bool netd_deinit(void);
+void netd_reset(uint8_t rhport);
+uint16_t netd_open(uint8_t rhport, tusb_desc_interface_t const * itf_desc, uint16_t max_len);
+bool netd_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request);
+bool netd_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of TinyUSB's common/tusb_common.h
+
+#ifndef _HOST_TUSB_COMMON_H_
+#define _HOST_TUSB_COMMON_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tusb_option.h"
+
+// The pico OS abstraction brings in the SDK base, code using TinyUSB gets MIN/MAX and friends through it
+#if CFG_TUSB_OS == OPT_OS_PICO
+#include "pico.h"
+#endif
+
+#define TU_ATTR_ALIGNED(Bytes) __attribute__((aligned(Bytes)))
+#define TU_ATTR_SECTION(sec_name) __attribute__((section(#sec_name)))
+#define TU_ATTR_PACKED __attribute__((packed))
+#define TU_ATTR_WEAK __attribute__((weak))
+#define TU_ATTR_ALWAYS_INLINE __attribute__((always_inline))
+#define TU_ATTR_DEPRECATED(mess) __attribute__((deprecated(mess)))
+#define TU_ATTR_UNUSED __attribute__((unused))
+#define TU_ATTR_USED __attribute__((used))
+#define TU_ATTR_FALLTHROUGH __attribute__((fallthrough))
+#define TU_ATTR_FAST_FUNC
+#define TU_ATTR_BIT_FIELD_ORDER_BEGIN
+#define TU_ATTR_BIT_FIELD_ORDER_END
+
+#define TU_ARRAY_SIZE(_arr) (sizeof(_arr) / sizeof(_arr[0]))
+#define TU_MIN(_x, _y) (((_x) < (_y)) ? (_x) : (_y))
+#define TU_MAX(_x, _y) (((_x) > (_y)) ? (_x) : (_y))
+#define TU_BIT(n) (1UL << (n))
+#define TU_U16(_high, _low) ((uint16_t)(((_high) << 8) | (_low)))
+#define TU_U16_HIGH(_u16) ((uint8_t)(((_u16) >> 8) & 0x00ff))
+#define TU_U16_LOW(_u16) ((uint8_t)((_u16) & 0x00ff))
+#define U16_TO_U8S_BE(_u16) TU_U16_HIGH(_u16), TU_U16_LOW(_u16)
+#define U16_TO_U8S_LE(_u16) TU_U16_LOW(_u16), TU_U16_HIGH(_u16)
+#define TU_U32_BYTE3(_u32) ((uint8_t)((((uint32_t)_u32) >> 24) & 0x000000ff))
+#define TU_U32_BYTE2(_u32) ((uint8_t)((((uint32_t)_u32) >> 16) & 0x000000ff))
+#define TU_U32_BYTE1(_u32) ((uint8_t)((((uint32_t)_u32) >> 8) & 0x000000ff))
+#define TU_U32_BYTE0(_u32) ((uint8_t)(((uint32_t)_u32) & 0x000000ff))
+#define U32_TO_U8S_LE(_u32) TU_U32_BYTE0(_u32), TU_U32_BYTE1(_u32), TU_U32_BYTE2(_u32), TU_U32_BYTE3(_u32)
+
+#define tu_memclr(buffer, size) memset((buffer), 0, (size))
+#define tu_varclr(_var) tu_memclr(_var, sizeof(*(_var)))
+
+static inline uint16_t tu_u16(uint8_t high, uint8_t low) { return (uint16_t)((((uint16_t)high) << 8) | low); }
+static inline uint8_t tu_u16_high(uint16_t ui16) { return (uint8_t)(ui16 >> 8); }
+static inline uint8_t tu_u16_low(uint16_t ui16) { return (uint8_t)(ui16 & 0x00ff); }
+static inline uint32_t tu_u32(uint8_t b3, uint8_t b2, uint8_t b1, uint8_t b0) {
+    return ((uint32_t)b3 << 24) | ((uint32_t)b2 << 16) | ((uint32_t)b1 << 8) | b0;
+}
+static inline uint16_t tu_unaligned_read16(const void * mem) { uint16_t v; memcpy(&v, mem, 2); return v; }
+static inline uint32_t tu_unaligned_read32(const void * mem) { uint32_t v; memcpy(&v, mem, 4); return v; }
+static inline void tu_unaligned_write16(void * mem, uint16_t value) { memcpy(mem, &value, 2); }
+static inline void tu_unaligned_write32(void * mem, uint32_t value) { memcpy(mem, &value, 4); }
+static inline uint16_t tu_le16toh(uint16_t v) { return v; }
+static inline uint16_t tu_htole16(uint16_t v) { return v; }
+static inline uint32_t tu_le32toh(uint32_t v) { return v; }
+static inline uint32_t tu_htole32(uint32_t v) { return v; }
+static inline int tu_memcpy_s(void * dest, size_t destsz, const void * src, size_t count) {
+    if (dest == NULL || count > destsz)
+        return -1;
+    memcpy(dest, src, count);
+    return 0;
+}
+
+// TU_VERIFY(cond) returns false, TU_VERIFY(cond, ret) returns ret, TU_ASSERT is the same without a debugger
+#define TU_GET_3RD_ARG(arg1, arg2, arg3, ...) arg3
+#define TU_VERIFY_DEFINE(_cond, _ret) do { if (!(_cond)) { return _ret; } } while (0)
+#define TU_VERIFY_1ARGS(_cond) TU_VERIFY_DEFINE(_cond, false)
+#define TU_VERIFY_2ARGS(_cond, _ret) TU_VERIFY_DEFINE(_cond, _ret)
+#define TU_VERIFY(...) TU_GET_3RD_ARG(__VA_ARGS__, TU_VERIFY_2ARGS, TU_VERIFY_1ARGS, _dummy)(__VA_ARGS__)
+#define TU_ASSERT(...) TU_VERIFY(__VA_ARGS__)
+
+#define TU_BREAKPOINT() do {} while (0)
+#define TU_LOG_FAILED() do {} while (0)
+#define TU_LOG(n, ...) do {} while (0)
+#define TU_LOG1(...) do {} while (0)
+#define TU_LOG2(...) do {} while (0)
+#define TU_LOG3(...) do {} while (0)
+#define TU_LOG_MEM(n, ...) do {} while (0)
+#define TU_LOG1_MEM(...) do {} while (0)
+#define TU_LOG2_MEM(...) do {} while (0)
+#define TU_LOG_INT(n, x) do {} while (0)
+#define TU_LOG_HEX(n, x) do {} while (0)
+#define TU_LOG1_INT(x) do {} while (0)
+#define TU_LOG2_INT(x) do {} while (0)
+#define TU_LOG1_HEX(x) do {} while (0)
+#define TU_LOG2_HEX(x) do {} while (0)
+
+#include "common/tusb_types.h"
+
+#endif
@@ -0,0 +1,260 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of TinyUSB's common/tusb_types.h
+
+#ifndef _HOST_TUSB_TYPES_H_
+#define _HOST_TUSB_TYPES_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    TUSB_SPEED_FULL = 0,
+    TUSB_SPEED_LOW = 1,
+    TUSB_SPEED_HIGH = 2,
+    TUSB_SPEED_INVALID = 0xff,
+} tusb_speed_t;
+
+typedef enum {
+    TUSB_XFER_CONTROL = 0,
+    TUSB_XFER_ISOCHRONOUS,
+    TUSB_XFER_BULK,
+    TUSB_XFER_INTERRUPT
+} tusb_xfer_type_t;
+
+typedef enum {
+    TUSB_DIR_OUT = 0,
+    TUSB_DIR_IN = 1,
+    TUSB_DIR_IN_MASK = 0x80
+} tusb_dir_t;
+
+typedef enum {
+    TUSB_DESC_DEVICE = 0x01,
+    TUSB_DESC_CONFIGURATION = 0x02,
+    TUSB_DESC_STRING = 0x03,
+    TUSB_DESC_INTERFACE = 0x04,
+    TUSB_DESC_ENDPOINT = 0x05,
+    TUSB_DESC_DEVICE_QUALIFIER = 0x06,
+    TUSB_DESC_OTHER_SPEED_CONFIG = 0x07,
+    TUSB_DESC_INTERFACE_POWER = 0x08,
+    TUSB_DESC_OTG = 0x09,
+    TUSB_DESC_DEBUG = 0x0A,
+    TUSB_DESC_INTERFACE_ASSOCIATION = 0x0B,
+    TUSB_DESC_BOS = 0x0F,
+    TUSB_DESC_DEVICE_CAPABILITY = 0x10,
+    TUSB_DESC_FUNCTIONAL = 0x21,
+    TUSB_DESC_CS_DEVICE = 0x21,
+    TUSB_DESC_CS_CONFIGURATION = 0x22,
+    TUSB_DESC_CS_STRING = 0x23,
+    TUSB_DESC_CS_INTERFACE = 0x24,
+    TUSB_DESC_CS_ENDPOINT = 0x25,
+} tusb_desc_type_t;
+
+typedef enum {
+    TUSB_REQ_GET_STATUS = 0,
+    TUSB_REQ_CLEAR_FEATURE = 1,
+    TUSB_REQ_SET_FEATURE = 3,
+    TUSB_REQ_SET_ADDRESS = 5,
+    TUSB_REQ_GET_DESCRIPTOR = 6,
+    TUSB_REQ_SET_DESCRIPTOR = 7,
+    TUSB_REQ_GET_CONFIGURATION = 8,
+    TUSB_REQ_SET_CONFIGURATION = 9,
+    TUSB_REQ_GET_INTERFACE = 10,
+    TUSB_REQ_SET_INTERFACE = 11,
+    TUSB_REQ_SYNCH_FRAME = 12
+} tusb_request_code_t;
+
+typedef enum {
+    TUSB_REQ_TYPE_STANDARD = 0,
+    TUSB_REQ_TYPE_CLASS,
+    TUSB_REQ_TYPE_VENDOR,
+    TUSB_REQ_TYPE_INVALID
+} tusb_request_type_t;
+
+typedef enum {
+    TUSB_REQ_RCPT_DEVICE = 0,
+    TUSB_REQ_RCPT_INTERFACE,
+    TUSB_REQ_RCPT_ENDPOINT,
+    TUSB_REQ_RCPT_OTHER
+} tusb_request_recipient_t;
+
+typedef enum {
+    TUSB_CLASS_UNSPECIFIED = 0,
+    TUSB_CLASS_AUDIO = 1,
+    TUSB_CLASS_CDC = 2,
+    TUSB_CLASS_HID = 3,
+    TUSB_CLASS_RESERVED_4 = 4,
+    TUSB_CLASS_PHYSICAL = 5,
+    TUSB_CLASS_IMAGE = 6,
+    TUSB_CLASS_PRINTER = 7,
+    TUSB_CLASS_MSC = 8,
+    TUSB_CLASS_HUB = 9,
+    TUSB_CLASS_CDC_DATA = 10,
+    TUSB_CLASS_SMART_CARD = 11,
+    TUSB_CLASS_RESERVED_12 = 12,
+    TUSB_CLASS_CONTENT_SECURITY = 13,
+    TUSB_CLASS_VIDEO = 14,
+    TUSB_CLASS_PERSONAL_HEALTHCARE = 15,
+    TUSB_CLASS_AUDIO_VIDEO = 16,
+    TUSB_CLASS_DIAGNOSTIC = 0xDC,
+    TUSB_CLASS_WIRELESS_CONTROLLER = 0xE0,
+    TUSB_CLASS_MISC = 0xEF,
+    TUSB_CLASS_APPLICATION_SPECIFIC = 0xFE,
+    TUSB_CLASS_VENDOR_SPECIFIC = 0xFF
+} tusb_class_code_t;
+
+typedef enum {
+    MISC_SUBCLASS_COMMON = 2
+} misc_subclass_type_t;
+
+typedef enum {
+    MISC_PROTOCOL_IAD = 1
+} misc_protocol_type_t;
+
+enum {
+    TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP = 1u << 5,
+    TUSB_DESC_CONFIG_ATT_SELF_POWERED = 1u << 6,
+};
+
+typedef enum {
+    XFER_RESULT_SUCCESS = 0,
+    XFER_RESULT_FAILED,
+    XFER_RESULT_STALLED,
+    XFER_RESULT_TIMEOUT,
+    XFER_RESULT_INVALID
+} xfer_result_t;
+
+enum {
+    CONTROL_STAGE_IDLE = 0,
+    CONTROL_STAGE_SETUP,
+    CONTROL_STAGE_DATA,
+    CONTROL_STAGE_ACK
+};
+
+typedef struct __attribute__((packed)) {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint16_t bcdUSB;
+    uint8_t bDeviceClass;
+    uint8_t bDeviceSubClass;
+    uint8_t bDeviceProtocol;
+    uint8_t bMaxPacketSize0;
+    uint16_t idVendor;
+    uint16_t idProduct;
+    uint16_t bcdDevice;
+    uint8_t iManufacturer;
+    uint8_t iProduct;
+    uint8_t iSerialNumber;
+    uint8_t bNumConfigurations;
+} tusb_desc_device_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint16_t wTotalLength;
+    uint8_t bNumInterfaces;
+    uint8_t bConfigurationValue;
+    uint8_t iConfiguration;
+    uint8_t bmAttributes;
+    uint8_t bMaxPower;
+} tusb_desc_configuration_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bInterfaceNumber;
+    uint8_t bAlternateSetting;
+    uint8_t bNumEndpoints;
+    uint8_t bInterfaceClass;
+    uint8_t bInterfaceSubClass;
+    uint8_t bInterfaceProtocol;
+    uint8_t iInterface;
+} tusb_desc_interface_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bEndpointAddress;
+    struct __attribute__((packed)) {
+        uint8_t xfer : 2;
+        uint8_t sync : 2;
+        uint8_t usage : 2;
+        uint8_t : 2;
+    } bmAttributes;
+    uint16_t wMaxPacketSize;
+    uint8_t bInterval;
+} tusb_desc_endpoint_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bFirstInterface;
+    uint8_t bInterfaceCount;
+    uint8_t bFunctionClass;
+    uint8_t bFunctionSubClass;
+    uint8_t bFunctionProtocol;
+    uint8_t iFunction;
+} tusb_desc_interface_assoc_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint16_t unicode_string[];
+} tusb_desc_string_t;
+
+typedef struct __attribute__((packed)) {
+    union {
+        struct __attribute__((packed)) {
+            uint8_t recipient : 5;
+            uint8_t type : 2;
+            uint8_t direction : 1;
+        } bmRequestType_bit;
+        uint8_t bmRequestType;
+    };
+    uint8_t bRequest;
+    uint16_t wValue;
+    uint16_t wIndex;
+    uint16_t wLength;
+} tusb_control_request_t;
+
+static inline tusb_dir_t tu_edpt_dir(uint8_t addr) {
+    return (addr & TUSB_DIR_IN_MASK) ? TUSB_DIR_IN : TUSB_DIR_OUT;
+}
+
+static inline uint8_t tu_edpt_number(uint8_t addr) {
+    return (uint8_t)(addr & (~TUSB_DIR_IN_MASK));
+}
+
+static inline uint8_t tu_edpt_addr(uint8_t num, uint8_t dir) {
+    return (uint8_t)(num | (dir ? TUSB_DIR_IN_MASK : 0));
+}
+
+static inline uint16_t tu_edpt_packet_size(tusb_desc_endpoint_t const * desc_ep) {
+    return desc_ep->wMaxPacketSize & 0x7FF;
+}
+
+static inline uint8_t const * tu_desc_next(void const * desc) {
+    uint8_t const * desc8 = (uint8_t const *)desc;
+    return desc8 + desc8[0];
+}
+
+static inline uint8_t tu_desc_type(void const * desc) {
+    return ((uint8_t const *)desc)[1];
+}
+
+static inline uint8_t tu_desc_len(void const * desc) {
+    return ((uint8_t const *)desc)[0];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
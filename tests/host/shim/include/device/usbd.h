@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of TinyUSB's device/usbd.h. The device stack itself is tests/host/shim/usb_device.cpp.
+
+#ifndef _HOST_TUSB_USBD_H_
+#define _HOST_TUSB_USBD_H_
+
+#include "common/tusb_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool tud_init(uint8_t rhport);
+bool tud_inited(void);
+void tud_task_ext(uint32_t timeout_ms, bool in_isr);
+static inline void tud_task(void) { tud_task_ext(UINT32_MAX, false); }
+bool tud_task_event_ready(void);
+tusb_speed_t tud_speed_get(void);
+bool tud_connected(void);
+bool tud_mounted(void);
+bool tud_suspended(void);
+static inline bool tud_ready(void) { return tud_mounted() && !tud_suspended(); }
+bool tud_remote_wakeup(void);
+bool tud_disconnect(void);
+bool tud_connect(void);
+void tud_sof_cb_enable(bool en);
+bool tud_control_xfer(uint8_t rhport, tusb_control_request_t const * request, void * buffer, uint16_t len);
+bool tud_control_status(uint8_t rhport, tusb_control_request_t const * request);
+
+// Application callbacks
+uint8_t const * tud_descriptor_device_cb(void);
+uint8_t const * tud_descriptor_configuration_cb(uint8_t index);
+uint16_t const * tud_descriptor_string_cb(uint8_t index, uint16_t langid);
+TU_ATTR_WEAK uint8_t const * tud_descriptor_device_qualifier_cb(void);
+TU_ATTR_WEAK uint8_t const * tud_descriptor_other_speed_configuration_cb(uint8_t index);
+TU_ATTR_WEAK void tud_mount_cb(void);
+TU_ATTR_WEAK void tud_umount_cb(void);
+TU_ATTR_WEAK void tud_suspend_cb(bool remote_wakeup_en);
+TU_ATTR_WEAK void tud_resume_cb(void);
+TU_ATTR_WEAK void tud_sof_cb(uint32_t frame_count);
+TU_ATTR_WEAK bool tud_vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request);
+
+#define TUD_CONFIG_DESC_LEN (9)
+
+// Config number, interface count, string index, total length, attribute, power in mA
+#define TUD_CONFIG_DESCRIPTOR(config_num, _itfcount, _stridx, _total_len, _attribute, _power_ma) \
+    9, TUSB_DESC_CONFIGURATION, U16_TO_U8S_LE(_total_len), _itfcount, config_num, _stridx, \
+    TU_BIT(7) | _attribute, (_power_ma) / 2
+
+#define TUD_HID_DESC_LEN (9 + 9 + 7)
+
+// Interface number, string index, protocol, report descriptor len, EP In address, size & polling interval
+#define TUD_HID_DESCRIPTOR(_itfnum, _stridx, _boot_protocol, _report_desc_len, _epin, _epsize, _ep_interval) \
+    9, TUSB_DESC_INTERFACE, _itfnum, 0, 1, TUSB_CLASS_HID, \
+    (uint8_t)((_boot_protocol) ? (uint8_t)HID_SUBCLASS_BOOT : 0), _boot_protocol, _stridx, \
+    9, HID_DESC_TYPE_HID, U16_TO_U8S_LE(0x0111), 0, 1, HID_DESC_TYPE_REPORT, U16_TO_U8S_LE(_report_desc_len), \
+    7, TUSB_DESC_ENDPOINT, _epin, TUSB_XFER_INTERRUPT, U16_TO_U8S_LE(_epsize), _ep_interval
+
+#define TUD_MSC_DESC_LEN (9 + 7 + 7)
+
+#define TUD_RNDIS_DESC_LEN (8 + 9 + 5 + 5 + 4 + 5 + 7 + 9 + 7 + 7)
+
+#define TUD_RNDIS_DESCRIPTOR(_itfnum, _stridx, _ep_notif, _ep_notif_size, _epout, _epin, _epsize) \
+    8, TUSB_DESC_INTERFACE_ASSOCIATION, _itfnum, 2, TUSB_CLASS_WIRELESS_CONTROLLER, 0x01, 0x03, 0, \
+    9, TUSB_DESC_INTERFACE, _itfnum, 0, 1, TUSB_CLASS_WIRELESS_CONTROLLER, 0x01, 0x03, _stridx, \
+    5, TUSB_DESC_CS_INTERFACE, CDC_FUNC_DESC_HEADER, U16_TO_U8S_LE(0x0110), \
+    5, TUSB_DESC_CS_INTERFACE, CDC_FUNC_DESC_CALL_MANAGEMENT, 0, (uint8_t)((_itfnum) + 1), \
+    4, TUSB_DESC_CS_INTERFACE, CDC_FUNC_DESC_ABSTRACT_CONTROL_MANAGEMENT, 0, \
+    5, TUSB_DESC_CS_INTERFACE, CDC_FUNC_DESC_UNION, _itfnum, (uint8_t)((_itfnum) + 1), \
+    7, TUSB_DESC_ENDPOINT, _ep_notif, TUSB_XFER_INTERRUPT, U16_TO_U8S_LE(_ep_notif_size), 1, \
+    9, TUSB_DESC_INTERFACE, (uint8_t)((_itfnum) + 1), 0, 2, TUSB_CLASS_CDC_DATA, 0, 0, 0, \
+    7, TUSB_DESC_ENDPOINT, _epin, TUSB_XFER_BULK, U16_TO_U8S_LE(_epsize), 0, \
+    7, TUSB_DESC_ENDPOINT, _epout, TUSB_XFER_BULK, U16_TO_U8S_LE(_epsize), 0
+
+#define TUD_CDC_ECM_DESC_LEN (8 + 9 + 5 + 5 + 13 + 7 + 9 + 9 + 7 + 7)
+
+#define TUD_CDC_ECM_DESCRIPTOR(_itfnum, _desc_stridx, _mac_stridx, _ep_notif, _ep_notif_size, _epout, _epin, _epsize, _maxsegmentsize) \
+    8, TUSB_DESC_INTERFACE_ASSOCIATION, _itfnum, 2, TUSB_CLASS_CDC, CDC_COMM_SUBCLASS_ETHERNET_CONTROL_MODEL, 0, 0, \
+    9, TUSB_DESC_INTERFACE, _itfnum, 0, 1, TUSB_CLASS_CDC, CDC_COMM_SUBCLASS_ETHERNET_CONTROL_MODEL, 0, _desc_stridx, \
+    5, TUSB_DESC_CS_INTERFACE, CDC_FUNC_DESC_HEADER, U16_TO_U8S_LE(0x0120), \
+    5, TUSB_DESC_CS_INTERFACE, CDC_FUNC_DESC_UNION, _itfnum, (uint8_t)((_itfnum) + 1), \
+    13, TUSB_DESC_CS_INTERFACE, CDC_FUNC_DESC_ETHERNET_NETWORKING, _mac_stridx, 0, 0, 0, 0, \
+    U16_TO_U8S_LE(_maxsegmentsize), U16_TO_U8S_LE(0), 0, \
+    7, TUSB_DESC_ENDPOINT, _ep_notif, TUSB_XFER_INTERRUPT, U16_TO_U8S_LE(_ep_notif_size), 1, \
+    9, TUSB_DESC_INTERFACE, (uint8_t)((_itfnum) + 1), 0, 0, TUSB_CLASS_CDC_DATA, 0, 0, 0, \
+    9, TUSB_DESC_INTERFACE, (uint8_t)((_itfnum) + 1), 1, 2, TUSB_CLASS_CDC_DATA, 0, 0, 0, \
+    7, TUSB_DESC_ENDPOINT, _epin, TUSB_XFER_BULK, U16_TO_U8S_LE(_epsize), 0, \
+    7, TUSB_DESC_ENDPOINT, _epout, TUSB_XFER_BULK, U16_TO_U8S_LE(_epsize), 0
+
+#ifdef __cplusplus
+}
+#endif
+
+#include "class/cdc/cdc.h"
+#include "class/hid/hid.h"
+
+#endif
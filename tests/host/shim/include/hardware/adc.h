@@ -0,0 +1,31 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/adc.h, conversions return what host_adc_set() set for the selected input
+
+#ifndef _HOST_HARDWARE_ADC_H_
+#define _HOST_HARDWARE_ADC_H_
+
+#include "pico.h"
+#include "hardware/structs/adc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint adc_get_selected_input(void);
+void adc_set_round_robin(uint input_mask);
+void adc_set_temp_sensor_enabled(bool enable);
+void adc_set_clkdiv(float clkdiv);
+uint16_t adc_read(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
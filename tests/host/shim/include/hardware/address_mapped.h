@@ -0,0 +1,24 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/address_mapped.h, the atomic register aliases become plain read-modify-writes
+
+#ifndef _HOST_HARDWARE_ADDRESS_MAPPED_H_
+#define _HOST_HARDWARE_ADDRESS_MAPPED_H_
+
+#include <stdint.h>
+
+typedef volatile uint32_t io_rw_32;
+typedef const volatile uint32_t io_ro_32;
+typedef volatile uint32_t io_wo_32;
+
+static inline void hw_set_bits(io_rw_32 * addr, uint32_t mask) { *addr |= mask; }
+static inline void hw_clear_bits(io_rw_32 * addr, uint32_t mask) { *addr &= ~mask; }
+static inline void hw_xor_bits(io_rw_32 * addr, uint32_t mask) { *addr ^= mask; }
+static inline void hw_write_masked(io_rw_32 * addr, uint32_t values, uint32_t write_mask) {
+    *addr = (*addr & ~write_mask) | (values & write_mask);
+}
+
+#endif
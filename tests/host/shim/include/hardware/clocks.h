@@ -0,0 +1,40 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/clocks.h, the requested system clock is only recorded
+
+#ifndef _HOST_HARDWARE_CLOCKS_H_
+#define _HOST_HARDWARE_CLOCKS_H_
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+typedef enum clock_index clock_handle_t;
+
+bool set_sys_clock_khz(uint32_t freq_khz, bool required);
+uint32_t clock_get_hz(clock_handle_t clock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
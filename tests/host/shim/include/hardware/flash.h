@@ -0,0 +1,28 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/flash.h. The flash image is mapped at XIP_BASE so that the firmware reads it through
+// the same absolute addresses it uses on the device, erase and program have NOR semantics (program only clears bits).
+
+#ifndef _HOST_HARDWARE_FLASH_H_
+#define _HOST_HARDWARE_FLASH_H_
+
+#include "pico.h"
+#include "hardware/platform_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t * data, size_t count);
+void flash_get_unique_id(uint8_t * id_out);
+void flash_do_cmd(const uint8_t * txbuf, uint8_t * rxbuf, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/i2c.h. There is nothing on the bus: writes and reads fail like an unanswered address.
+
+#ifndef _HOST_HARDWARE_I2C_H_
+#define _HOST_HARDWARE_I2C_H_
+
+#include "pico.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    PICO_ERROR_NONE = 0,
+    PICO_ERROR_TIMEOUT = -1,
+    PICO_ERROR_GENERIC = -2,
+    PICO_ERROR_NO_DATA = -3,
+};
+
+typedef struct i2c_inst {
+    uint8_t index;
+    uint32_t baudrate;
+} i2c_inst_t;
+
+extern i2c_inst_t host_i2c_inst[2];
+#define i2c0 (&host_i2c_inst[0])
+#define i2c1 (&host_i2c_inst[1])
+
+static inline uint i2c_hw_index(i2c_inst_t * i2c) { return i2c->index; }
+
+uint i2c_init(i2c_inst_t * i2c, uint baudrate);
+void i2c_deinit(i2c_inst_t * i2c);
+uint i2c_set_baudrate(i2c_inst_t * i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t * i2c, uint8_t addr, const uint8_t * src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t * i2c, uint8_t addr, uint8_t * dst, size_t len, bool nostop);
+int i2c_write_blocking_until(i2c_inst_t * i2c, uint8_t addr, const uint8_t * src, size_t len, bool nostop, absolute_time_t until);
+int i2c_read_blocking_until(i2c_inst_t * i2c, uint8_t addr, uint8_t * dst, size_t len, bool nostop, absolute_time_t until);
+int i2c_write_timeout_us(i2c_inst_t * i2c, uint8_t addr, const uint8_t * src, size_t len, bool nostop, uint timeout_us);
+int i2c_read_timeout_us(i2c_inst_t * i2c, uint8_t addr, uint8_t * dst, size_t len, bool nostop, uint timeout_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/pio.h, the PIO blocks exist only as handles for the LED code's headers
+
+#ifndef _HOST_HARDWARE_PIO_H_
+#define _HOST_HARDWARE_PIO_H_
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t ctrl;
+} pio_hw_t;
+
+typedef pio_hw_t * PIO;
+
+extern pio_hw_t host_pio_hw[2];
+
+#define pio0 (&host_pio_hw[0])
+#define pio1 (&host_pio_hw[1])
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the RP2040 platform definitions
+
+#ifndef _HOST_HARDWARE_PLATFORM_DEFS_H_
+#define _HOST_HARDWARE_PLATFORM_DEFS_H_
+
+#define NUM_CORES 2
+#define NUM_BANK0_GPIOS 30
+#define NUM_ADC_CHANNELS 5
+#define NUM_I2CS 2
+#define NUM_SPIS 2
+#define NUM_DMA_CHANNELS 12
+#define NUM_SPIN_LOCKS 32
+#define NUM_TIMERS 4
+#define NUM_PIOS 2
+
+#define XIP_BASE 0x10000000u
+#define SRAM_BASE 0x20000000u
+#define SRAM_END 0x20042000u
+
+#ifndef PICO_FLASH_SIZE_BYTES
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+#endif
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define FLASH_BLOCK_SIZE (1u << 16)
+#define FLASH_UNIQUE_ID_SIZE_BYTES 8
+#define PICO_UNIQUE_BOARD_ID_SIZE_BYTES 8
+
+#define TIMER_IRQ_0 0
+#define TIMER_IRQ_1 1
+#define TIMER_IRQ_2 2
+#define TIMER_IRQ_3 3
+
+#define PICO_DEFAULT_LED_PIN 25
+#define PICO_DEFAULT_I2C_INSTANCE() i2c0
+#define PICO_DEFAULT_I2C_SDA_PIN 4
+#define PICO_DEFAULT_I2C_SCL_PIN 5
+#define PICO_DEFAULT_SPI_INSTANCE() spi0
+#define PICO_DEFAULT_SPI_SCK_PIN 18
+#define PICO_DEFAULT_SPI_TX_PIN 19
+#define PICO_DEFAULT_SPI_RX_PIN 16
+#define PICO_DEFAULT_SPI_CSN_PIN 17
+
+#endif
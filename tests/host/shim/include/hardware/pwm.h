@@ -0,0 +1,39 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/pwm.h, levels are accepted and dropped
+
+#ifndef _HOST_HARDWARE_PWM_H_
+#define _HOST_HARDWARE_PWM_H_
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t csr;
+    uint32_t div;
+    uint32_t top;
+} pwm_config;
+
+static inline uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1u) & 7u; }
+static inline uint pwm_gpio_to_channel(uint gpio) { return gpio & 1u; }
+static inline pwm_config pwm_get_default_config(void) { pwm_config c = { 0, 1u << 4, 0xffffu }; return c; }
+static inline void pwm_config_set_clkdiv(pwm_config * c, float div) { c->div = (uint32_t)(div * 16); }
+static inline void pwm_config_set_wrap(pwm_config * c, uint16_t wrap) { c->top = wrap; }
+static inline void pwm_init(uint slice_num, pwm_config * c, bool start) { (void)slice_num; (void)c; (void)start; }
+static inline void pwm_set_wrap(uint slice_num, uint16_t wrap) { (void)slice_num; (void)wrap; }
+static inline void pwm_set_clkdiv(uint slice_num, float divider) { (void)slice_num; (void)divider; }
+static inline void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) { (void)slice_num; (void)chan; (void)level; }
+static inline void pwm_set_gpio_level(uint gpio, uint16_t level) { (void)gpio; (void)level; }
+static inline void pwm_set_enabled(uint slice_num, bool enabled) { (void)slice_num; (void)enabled; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
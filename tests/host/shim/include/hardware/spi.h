@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/spi.h. Nothing is attached: transfers complete and read back 0xFF.
+
+#ifndef _HOST_HARDWARE_SPI_H_
+#define _HOST_HARDWARE_SPI_H_
+
+#include "pico.h"
+#include "hardware/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SPI_CPHA_0 = 0,
+    SPI_CPHA_1 = 1
+} spi_cpha_t;
+
+typedef enum {
+    SPI_CPOL_0 = 0,
+    SPI_CPOL_1 = 1
+} spi_cpol_t;
+
+typedef enum {
+    SPI_LSB_FIRST = 0,
+    SPI_MSB_FIRST = 1
+} spi_order_t;
+
+typedef struct {
+    volatile uint32_t cr0;
+    volatile uint32_t cr1;
+    volatile uint32_t dr;
+    volatile uint32_t sr;
+} spi_hw_t;
+
+typedef struct spi_inst {
+    uint8_t index;
+    uint32_t baudrate;
+    spi_hw_t hw;
+} spi_inst_t;
+
+extern spi_inst_t host_spi_inst[2];
+#define spi0 (&host_spi_inst[0])
+#define spi1 (&host_spi_inst[1])
+
+static inline uint spi_get_index(const spi_inst_t * spi) { return spi->index; }
+static inline spi_hw_t * spi_get_hw(spi_inst_t * spi) { return &spi->hw; }
+static inline uint spi_get_dreq(spi_inst_t * spi, bool is_tx) { return 16u + 2u * spi->index + (is_tx ? 0u : 1u); }
+
+uint spi_init(spi_inst_t * spi, uint baudrate);
+void spi_deinit(spi_inst_t * spi);
+uint spi_set_baudrate(spi_inst_t * spi, uint baudrate);
+uint spi_get_baudrate(const spi_inst_t * spi);
+void spi_set_format(spi_inst_t * spi, uint data_bits, spi_cpol_t cpol, spi_cpha_t cpha, spi_order_t order);
+void spi_set_slave(spi_inst_t * spi, bool slave);
+int spi_write_read_blocking(spi_inst_t * spi, const uint8_t * src, uint8_t * dst, size_t len);
+int spi_write_blocking(spi_inst_t * spi, const uint8_t * src, size_t len);
+int spi_read_blocking(spi_inst_t * spi, uint8_t repeated_tx_data, uint8_t * dst, size_t len);
+int spi_write16_read16_blocking(spi_inst_t * spi, const uint16_t * src, uint16_t * dst, size_t len);
+int spi_write16_blocking(spi_inst_t * spi, const uint16_t * src, size_t len);
+int spi_read16_blocking(spi_inst_t * spi, uint16_t repeated_tx_data, uint16_t * dst, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
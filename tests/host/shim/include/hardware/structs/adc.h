@@ -0,0 +1,42 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the RP2040 ADC registers, adc_init() sets EN like the hardware does
+
+#ifndef _HOST_HARDWARE_STRUCTS_ADC_H_
+#define _HOST_HARDWARE_STRUCTS_ADC_H_
+
+#include <stdint.h>
+
+#include "hardware/address_mapped.h"
+
+#define ADC_CS_EN_BITS 0x00000001u
+#define ADC_CS_AINSEL_LSB 12
+#define ADC_CS_AINSEL_BITS 0x00007000u
+
+typedef struct {
+    volatile uint32_t cs;
+    volatile uint32_t result;
+    volatile uint32_t fcs;
+    volatile uint32_t fifo;
+    volatile uint32_t div;
+    volatile uint32_t intr;
+    volatile uint32_t inte;
+    volatile uint32_t intf;
+    volatile uint32_t ints;
+} adc_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern adc_hw_t host_adc_hw;
+#define adc_hw (&host_adc_hw)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
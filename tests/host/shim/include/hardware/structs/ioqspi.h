@@ -0,0 +1,38 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the RP2040 QSPI IO registers
+
+#ifndef _HOST_HARDWARE_STRUCTS_IOQSPI_H_
+#define _HOST_HARDWARE_STRUCTS_IOQSPI_H_
+
+#include <stdint.h>
+
+#include "hardware/address_mapped.h"
+
+#define IO_QSPI_GPIO_QSPI_SS_CTRL_OEOVER_LSB 12
+#define IO_QSPI_GPIO_QSPI_SS_CTRL_OEOVER_BITS 0x00003000u
+
+typedef struct {
+    volatile uint32_t status;
+    volatile uint32_t ctrl;
+} ioqspi_status_ctrl_hw_t;
+
+typedef struct {
+    ioqspi_status_ctrl_hw_t io[6];
+} ioqspi_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern ioqspi_hw_t host_ioqspi_hw;
+#define ioqspi_hw (&host_ioqspi_hw)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,35 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the RP2040 bank 0 pad registers, only the input enable is kept (set by gpio_init)
+
+#ifndef _HOST_HARDWARE_STRUCTS_PADSBANK0_H_
+#define _HOST_HARDWARE_STRUCTS_PADSBANK0_H_
+
+#include <stdint.h>
+
+#include "hardware/address_mapped.h"
+
+#define PADS_BANK0_GPIO0_IE_BITS 0x00000040u
+#define PADS_BANK0_GPIO0_PUE_BITS 0x00000008u
+#define PADS_BANK0_GPIO0_PDE_BITS 0x00000004u
+
+typedef struct {
+    volatile uint32_t voltage_select;
+    volatile uint32_t io[30];
+} padsbank0_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern padsbank0_hw_t host_padsbank0_hw;
+#define padsbank0_hw (&host_padsbank0_hw)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the RP2040 SIO registers. gpio_hi_in holds the QSPI pins, the BOOTSEL button reads high (released).
+
+#ifndef _HOST_HARDWARE_STRUCTS_SIO_H_
+#define _HOST_HARDWARE_STRUCTS_SIO_H_
+
+#include <stdint.h>
+
+#include "hardware/address_mapped.h"
+
+typedef struct {
+    volatile uint32_t cpuid;
+    volatile uint32_t gpio_in;
+    volatile uint32_t gpio_hi_in;
+} sio_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern sio_hw_t host_sio_hw;
+#define sio_hw (&host_sio_hw)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
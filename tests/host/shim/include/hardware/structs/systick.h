@@ -0,0 +1,40 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the Cortex-M SysTick registers. The current value counts down the host's monotonic clock in
+// nanoseconds, so the loop profiler measures real host time (one "cycle" is 1ns) while the firmware itself runs
+// on the virtual clock. Writes to the counter are ignored, it is always free running.
+
+#ifndef _HOST_HARDWARE_STRUCTS_SYSTICK_H_
+#define _HOST_HARDWARE_STRUCTS_SYSTICK_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t host_systick_count(void);
+
+#ifdef __cplusplus
+}
+
+struct host_systick_cvr_t {
+    operator uint32_t() const { return host_systick_count(); }
+    host_systick_cvr_t & operator=(uint32_t) { return *this; }
+};
+
+typedef struct {
+    volatile uint32_t csr;
+    host_systick_cvr_t cvr;
+    volatile uint32_t rvr;
+    volatile uint32_t calib;
+} systick_hw_t;
+
+extern systick_hw_t host_systick_hw;
+#define systick_hw (&host_systick_hw)
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the RP2040 timer registers. Plain memory, nothing fires from them on the host.
+
+#ifndef _HOST_HARDWARE_STRUCTS_TIMER_H_
+#define _HOST_HARDWARE_STRUCTS_TIMER_H_
+
+#include <stdint.h>
+
+#include "hardware/address_mapped.h"
+
+typedef struct {
+    volatile uint32_t timehw;
+    volatile uint32_t timelw;
+    volatile uint32_t timehr;
+    volatile uint32_t timelr;
+    volatile uint32_t alarm[4];
+    volatile uint32_t armed;
+    volatile uint32_t timerawh;
+    volatile uint32_t timerawl;
+    volatile uint32_t dbgpause;
+    volatile uint32_t pause;
+    volatile uint32_t intr;
+    volatile uint32_t inte;
+    volatile uint32_t intf;
+    volatile uint32_t ints;
+} timer_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern timer_hw_t host_timer_hw;
+#define timer_hw (&host_timer_hw)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
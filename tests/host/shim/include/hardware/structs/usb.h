@@ -0,0 +1,36 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the RP2040 USB controller registers
+
+#ifndef _HOST_HARDWARE_STRUCTS_USB_H_
+#define _HOST_HARDWARE_STRUCTS_USB_H_
+
+#include <stdint.h>
+
+#include "hardware/address_mapped.h"
+
+typedef struct {
+    volatile uint32_t dev_addr_ctrl;
+    volatile uint32_t int_ep_addr_ctrl[15];
+    volatile uint32_t main_ctrl;
+    volatile uint32_t sof_wr;
+    volatile uint32_t sof_rd;
+    volatile uint32_t sie_ctrl;
+    volatile uint32_t sie_status;
+} usb_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern usb_hw_t host_usb_hw;
+#define usb_hw (&host_usb_hw)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
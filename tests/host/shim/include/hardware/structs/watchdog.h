@@ -0,0 +1,34 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the RP2040 watchdog registers, the scratch registers survive a reboot until host_power_cycle()
+
+#ifndef _HOST_HARDWARE_STRUCTS_WATCHDOG_H_
+#define _HOST_HARDWARE_STRUCTS_WATCHDOG_H_
+
+#include <stdint.h>
+
+#include "hardware/address_mapped.h"
+
+typedef struct {
+    volatile uint32_t ctrl;
+    volatile uint32_t load;
+    volatile uint32_t reason;
+    volatile uint32_t scratch[8];
+    volatile uint32_t tick;
+} watchdog_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern watchdog_hw_t host_watchdog_hw;
+#define watchdog_hw (&host_watchdog_hw)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/sync.h. The host is single threaded, locks only track whether they are held.
+
+#ifndef _HOST_HARDWARE_SYNC_H_
+#define _HOST_HARDWARE_SYNC_H_
+
+#include "pico.h"
+#include "hardware/platform_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef volatile uint32_t spin_lock_t;
+
+static inline void __mem_fence_acquire(void) { __asm__ volatile ("" : : : "memory"); }
+static inline void __mem_fence_release(void) { __asm__ volatile ("" : : : "memory"); }
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+static inline void restore_interrupts_from_disabled(uint32_t status) { restore_interrupts(status); }
+
+spin_lock_t * spin_lock_instance(uint lock_num);
+uint spin_lock_get_num(spin_lock_t * lock);
+int spin_lock_claim_unused(bool required);
+void spin_lock_claim(uint lock_num);
+void spin_lock_unclaim(uint lock_num);
+static inline void spin_lock_unsafe_blocking(spin_lock_t * lock) { *lock = 1; }
+static inline void spin_unlock_unsafe(spin_lock_t * lock) { *lock = 0; }
+static inline bool is_spin_locked(spin_lock_t * lock) { return *lock != 0; }
+static inline uint32_t spin_lock_blocking(spin_lock_t * lock) {
+    uint32_t save = save_and_disable_interrupts();
+    spin_lock_unsafe_blocking(lock);
+    return save;
+}
+static inline void spin_unlock(spin_lock_t * lock, uint32_t saved_irq) {
+    spin_unlock_unsafe(lock);
+    restore_interrupts(saved_irq);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/timer.h, the timer reads the virtual clock of host_hal.h
+
+#ifndef _HOST_HARDWARE_TIMER_H_
+#define _HOST_HARDWARE_TIMER_H_
+
+#include "pico.h"
+#include "hardware/structs/timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+
+// Waiting moves the virtual clock forward instead of spinning
+void busy_wait_us(uint64_t delay_us);
+void busy_wait_us_32(uint32_t delay_us);
+void busy_wait_ms(uint32_t delay_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
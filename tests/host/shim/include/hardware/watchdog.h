@@ -0,0 +1,29 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of hardware/watchdog.h
+
+#ifndef _HOST_HARDWARE_WATCHDOG_H_
+#define _HOST_HARDWARE_WATCHDOG_H_
+
+#include "pico.h"
+#include "hardware/structs/watchdog.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Throws HostReboot (host_hal.h), the harness decides what a reboot means for the test
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms);
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug);
+void watchdog_update(void);
+bool watchdog_caused_reboot(void);
+bool watchdog_enable_caused_reboot(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
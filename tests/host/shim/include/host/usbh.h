@@ -0,0 +1,68 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of TinyUSB's host/usbh.h. No device is ever attached to the shim's host port.
+
+#ifndef _HOST_TUSB_USBH_H_
+#define _HOST_TUSB_USBH_H_
+
+#include "common/tusb_common.h"
+
+#ifndef CFG_TUH_DEVICE_MAX
+#define CFG_TUH_DEVICE_MAX 4
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tuh_xfer_s tuh_xfer_t;
+typedef void (* tuh_xfer_cb_t)(tuh_xfer_t * xfer);
+
+struct tuh_xfer_s {
+    uint8_t daddr;
+    uint8_t ep_addr;
+    uint8_t reserved;
+    xfer_result_t result;
+    uint32_t actual_len;
+    union {
+        tusb_control_request_t const * setup;
+        uint32_t buflen;
+    };
+    uint8_t * buffer;
+    tuh_xfer_cb_t complete_cb;
+    uintptr_t user_data;
+};
+
+enum {
+    TUH_CFGID_RPI_PIO_USB_CONFIGURATION = OPT_MCU_RP2040 << 8
+};
+
+bool tuh_configure(uint8_t rhport, uint32_t cfg_id, void const * cfg_param);
+bool tuh_init(uint8_t rhport);
+bool tuh_deinit(uint8_t rhport);
+bool tuh_inited(void);
+void tuh_task_ext(uint32_t timeout_ms, bool in_isr);
+static inline void tuh_task(void) { tuh_task_ext(UINT32_MAX, false); }
+bool tuh_vid_pid_get(uint8_t daddr, uint16_t * vid, uint16_t * pid);
+bool tuh_mounted(uint8_t daddr);
+bool tuh_connected(uint8_t daddr);
+bool tuh_suspended(uint8_t daddr);
+static inline bool tuh_ready(uint8_t daddr) { return tuh_mounted(daddr) && !tuh_suspended(daddr); }
+bool tuh_control_xfer(tuh_xfer_t * xfer);
+bool tuh_edpt_xfer(tuh_xfer_t * xfer);
+bool tuh_edpt_open(uint8_t daddr, tusb_desc_endpoint_t const * desc_ep);
+uint8_t tuh_descriptor_get_string_sync(uint8_t daddr, uint8_t index, uint16_t language_id, void * buffer,
+                                       uint16_t len);
+
+// Application callbacks
+TU_ATTR_WEAK void tuh_mount_cb(uint8_t daddr);
+TU_ATTR_WEAK void tuh_umount_cb(uint8_t daddr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
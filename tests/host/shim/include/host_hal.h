@@ -0,0 +1,68 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Controls of the host shim for the harness and the tests: the virtual clock, pin and ADC levels, the flash
+// image, and what the shim's USB device stack sent to the (virtual) host.
+
+#ifndef _HOST_HAL_H_
+#define _HOST_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "pico/types.h"
+
+// Thrown by watchdog_reboot() and reset_usb_boot(), firmware code never returns from a reboot
+struct HostReboot {
+    bool usbBoot;
+};
+
+// Thrown by flash_range_erase()/flash_range_program() when host_flash_fail_after() runs out, after the operation
+// was torn part way through
+struct HostPowerLoss {};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Virtual clock, every firmware time source reads it. Advancing fires the alarms that fall due, in order.
+uint64_t host_time_us(void);
+void host_time_advance_us(uint64_t us);
+void host_time_advance_to_us(uint64_t us);
+
+// Pin levels as gpio_get_all() returns them (1 = high), and the next conversion of an ADC input
+void host_gpio_set_levels(uint32_t levels);
+uint32_t host_gpio_get_levels(void);
+void host_adc_set(uint input, uint16_t value);
+
+void host_set_core_num(uint core);
+void host_rand_seed(uint64_t seed);
+
+// Flash image at XIP_BASE. Reset fills it with the erased state (0xff).
+uint8_t * host_flash_image(void);
+void host_flash_reset(void);
+// Erase and program operations so far, and the number of further operations after which the next one loses
+// power half way (negative: never)
+uint32_t host_flash_operations(void);
+void host_flash_fail_after(int32_t operations);
+
+// Watchdog scratch registers and the reboot reason survive a reboot, this clears them and releases every spin
+// lock as a cold boot would (a HostPowerLoss can leave one held)
+void host_power_cycle(void);
+
+// Reports completed on the device's IN endpoints since the last reset, and a FNV-1a hash over their bytes
+void host_usb_reset_reports(void);
+uint32_t host_usb_report_count(void);
+uint32_t host_usb_report_hash(void);
+const uint8_t * host_usb_last_report(uint16_t * len);
+
+// Frame counter of the shim's device stack, one frame per virtual millisecond
+uint32_t host_usb_frame(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
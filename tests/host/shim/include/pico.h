@@ -0,0 +1,16 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico.h, the base every pico-sdk header includes
+
+#ifndef _HOST_PICO_H_
+#define _HOST_PICO_H_
+
+#include <assert.h>
+
+#include "pico/types.h"
+#include "pico/platform.h"
+
+#endif
@@ -0,0 +1,13 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/binary_info.h, binary info only exists in the firmware image
+
+#ifndef _HOST_PICO_BINARY_INFO_H_
+#define _HOST_PICO_BINARY_INFO_H_
+
+#include "pico/binary_info/code.h"
+
+#endif
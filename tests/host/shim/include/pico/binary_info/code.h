@@ -0,0 +1,22 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/binary_info/code.h
+
+#ifndef _HOST_PICO_BINARY_INFO_CODE_H_
+#define _HOST_PICO_BINARY_INFO_CODE_H_
+
+#define bi_decl(_decl)
+#define bi_decl_if_func_used(_decl)
+#define bi_program_name(name)
+#define bi_program_description(description)
+#define bi_program_version_string(version)
+#define bi_program_build_date_string(date)
+#define bi_program_url(url)
+#define bi_program_feature(feature)
+#define bi_1pin_with_name(p0, name)
+#define bi_2pins_with_func(p0, p1, func)
+
+#endif
@@ -0,0 +1,24 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/bootrom.h
+
+#ifndef _HOST_PICO_BOOTROM_H_
+#define _HOST_PICO_BOOTROM_H_
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Throws HostReboot (host_hal.h) with the USB boot flag set
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/critical_section.h
+
+#ifndef _HOST_PICO_CRITICAL_SECTION_H_
+#define _HOST_PICO_CRITICAL_SECTION_H_
+
+#include "pico/lock_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct critical_section {
+    spin_lock_t * spin_lock;
+    uint32_t save;
+} critical_section_t;
+
+static inline void critical_section_init(critical_section_t * crit_sec) { crit_sec->spin_lock = spin_lock_instance(0); crit_sec->save = 0; }
+static inline void critical_section_init_with_lock_num(critical_section_t * crit_sec, uint lock_num) { crit_sec->spin_lock = spin_lock_instance(lock_num); crit_sec->save = 0; }
+static inline void critical_section_enter_blocking(critical_section_t * crit_sec) { crit_sec->save = spin_lock_blocking(crit_sec->spin_lock); }
+static inline void critical_section_exit(critical_section_t * crit_sec) { spin_unlock(crit_sec->spin_lock, crit_sec->save); }
+static inline void critical_section_deinit(critical_section_t * crit_sec) { crit_sec->spin_lock = NULL; }
+static inline bool critical_section_is_initialized(critical_section_t * crit_sec) { return crit_sec->spin_lock != NULL; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,18 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/lock_core.h
+
+#ifndef _HOST_PICO_LOCK_CORE_H_
+#define _HOST_PICO_LOCK_CORE_H_
+
+#include "pico.h"
+#include "hardware/sync.h"
+
+typedef struct lock_core {
+    spin_lock_t * spin_lock;
+} lock_core_t;
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/mutex.h, single threaded so a mutex only records its owner
+
+#ifndef _HOST_PICO_MUTEX_H_
+#define _HOST_PICO_MUTEX_H_
+
+#include "pico/lock_core.h"
+#include "pico/time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mutex {
+    lock_core_t core;
+    int8_t owner;
+} mutex_t;
+
+typedef struct recursive_mutex {
+    lock_core_t core;
+    int8_t owner;
+    uint8_t enter_count;
+} recursive_mutex_t;
+
+static inline void mutex_init(mutex_t * mtx) { mtx->owner = -1; }
+static inline void mutex_enter_blocking(mutex_t * mtx) { mtx->owner = 0; }
+static inline bool mutex_try_enter(mutex_t * mtx, uint32_t * owner_out) {
+    if (mtx->owner >= 0) {
+        if (owner_out)
+            *owner_out = (uint32_t)mtx->owner;
+        return false;
+    }
+    mtx->owner = 0;
+    return true;
+}
+static inline void mutex_exit(mutex_t * mtx) { mtx->owner = -1; }
+static inline bool mutex_is_initialized(mutex_t * mtx) { (void)mtx; return true; }
+
+static inline void recursive_mutex_init(recursive_mutex_t * mtx) { mtx->owner = -1; mtx->enter_count = 0; }
+static inline void recursive_mutex_enter_blocking(recursive_mutex_t * mtx) { mtx->owner = 0; mtx->enter_count++; }
+static inline void recursive_mutex_exit(recursive_mutex_t * mtx) { if (--mtx->enter_count == 0) mtx->owner = -1; }
+
+#define auto_init_mutex(name) mutex_t name = { { NULL }, -1 }
+#define auto_init_recursive_mutex(name) recursive_mutex_t name = { { NULL }, -1, 0 }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
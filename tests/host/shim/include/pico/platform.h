@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/platform.h: section attributes are dropped, the host runs everything as core0
+
+#ifndef _HOST_PICO_PLATFORM_H_
+#define _HOST_PICO_PLATFORM_H_
+
+#include "pico/types.h"
+#include "hardware/platform_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PICO_SDK_VERSION_MAJOR 2
+#define PICO_SDK_VERSION_MINOR 1
+#define PICO_SDK_VERSION_REVISION 1
+
+#define __not_in_flash(group)
+#define __not_in_flash_func(func_name) func_name
+#define __no_inline_not_in_flash_func(func_name) __attribute__((noinline)) func_name
+#define __time_critical_func(func_name) func_name
+#define __in_flash(group)
+#define __scratch_x(group)
+#define __scratch_y(group)
+#define __uninitialized_ram(var) var
+#define __force_inline inline __attribute__((always_inline))
+#define __packed __attribute__((packed))
+#define __aligned(x) __attribute__((aligned(x)))
+#define _u(x) x ## u
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MIN(a, b) ((b) > (a) ? (a) : (b))
+
+static inline void tight_loop_contents(void) {}
+static inline void __wfi(void) {}
+static inline void __wfe(void) {}
+static inline void __sev(void) {}
+static inline void __dmb(void) {}
+static inline void __compiler_memory_barrier(void) { __asm__ volatile ("" : : : "memory"); }
+
+// Core the caller runs on, host_set_core_num() switches it for code that behaves differently per core
+uint get_core_num(void);
+
+void panic(const char * fmt, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
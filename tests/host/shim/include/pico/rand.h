@@ -0,0 +1,24 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/rand.h, a seeded generator (host_rand_seed()) so that runs are reproducible
+
+#ifndef _HOST_PICO_RAND_H_
+#define _HOST_PICO_RAND_H_
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t get_rand_32(void);
+uint64_t get_rand_64(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
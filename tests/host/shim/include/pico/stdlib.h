@@ -0,0 +1,31 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/stdlib.h
+
+#ifndef _HOST_PICO_STDLIB_H_
+#define _HOST_PICO_STDLIB_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline bool stdio_init_all(void) { return true; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
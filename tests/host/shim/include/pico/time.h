@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/time.h on the virtual clock. Alarms fire from host_time_advance_us(), in order.
+
+#ifndef _HOST_PICO_TIME_H_
+#define _HOST_PICO_TIME_H_
+
+#include "pico.h"
+#include "hardware/timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const absolute_time_t nil_time;
+extern const absolute_time_t at_the_end_of_time;
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+static inline void update_us_since_boot(absolute_time_t * t, uint64_t us) { *t = us; }
+static inline bool is_nil_time(absolute_time_t t) { return t == 0; }
+static inline bool is_at_the_end_of_time(absolute_time_t t) { return t == (absolute_time_t)INT64_MAX; }
+
+absolute_time_t get_absolute_time(void);
+
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) {
+    return ((uint64_t)INT64_MAX - t < us) ? (absolute_time_t)INT64_MAX : t + us;
+}
+static inline absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) { return delayed_by_us(t, (uint64_t)ms * 1000); }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return delayed_by_us(get_absolute_time(), us); }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return delayed_by_ms(get_absolute_time(), ms); }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+static inline absolute_time_t absolute_time_min(absolute_time_t a, absolute_time_t b) { return a < b ? a : b; }
+static inline bool time_reached(absolute_time_t t) { return get_absolute_time() >= t; }
+
+void sleep_until(absolute_time_t target);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp);
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void * user_data);
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void * user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void * user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void * user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t alarm_id);
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t * rt);
+struct repeating_timer {
+    int64_t delay_us;
+    alarm_id_t alarm_id;
+    repeating_timer_callback_t callback;
+    void * user_data;
+};
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void * user_data, repeating_timer_t * out);
+static inline bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void * user_data, repeating_timer_t * out) {
+    return add_repeating_timer_us((int64_t)delay_ms * 1000, callback, user_data, out);
+}
+bool cancel_repeating_timer(repeating_timer_t * timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,24 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the pico-sdk types, see tests/host/CMakeLists.txt
+
+#ifndef _HOST_PICO_TYPES_H_
+#define _HOST_PICO_TYPES_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+// Microseconds since boot of the virtual clock
+typedef uint64_t absolute_time_t;
+
+typedef struct {
+    uint8_t id[8];
+} pico_unique_board_id_t;
+
+#endif
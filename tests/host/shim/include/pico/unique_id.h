@@ -0,0 +1,25 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of pico/unique_id.h, a fixed board ID so descriptors and serials are reproducible
+
+#ifndef _HOST_PICO_UNIQUE_ID_H_
+#define _HOST_PICO_UNIQUE_ID_H_
+
+#include "pico.h"
+#include "hardware/platform_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void pico_get_unique_board_id(pico_unique_board_id_t * id_out);
+void pico_get_unique_board_id_string(char * id_out, uint len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
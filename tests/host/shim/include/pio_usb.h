@@ -0,0 +1,47 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of Pico-PIO-USB's pio_usb.h, only the configuration handed to tuh_configure()
+
+#ifndef _HOST_PIO_USB_H_
+#define _HOST_PIO_USB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Root port state of the PIO host, opaque to the firmware
+typedef struct usb_device_t usb_device_t;
+
+typedef enum {
+    PIO_USB_PINOUT_DPDM = 0,
+    PIO_USB_PINOUT_DMDP,
+} PIO_USB_PINOUT;
+
+typedef struct {
+    uint8_t pin_dp;
+    uint8_t pio_tx_num;
+    uint8_t sm_tx;
+    uint8_t tx_ch;
+    uint8_t pio_rx_num;
+    uint8_t sm_rx;
+    uint8_t sm_eop;
+    void * alarm_pool;
+    int8_t debug_pin_rx;
+    int8_t debug_pin_eop;
+    bool skip_alarm_pool;
+    PIO_USB_PINOUT pinout;
+} pio_usb_configuration_t;
+
+#define PIO_USB_DEFAULT_CONFIG { 0, 0, 0, 0, 1, 0, 1, NULL, -1, -1, false, PIO_USB_PINOUT_DPDM }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
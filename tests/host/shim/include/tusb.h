@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of TinyUSB's tusb.h
+
+#ifndef _HOST_TUSB_H_
+#define _HOST_TUSB_H_
+
+#include "common/tusb_common.h"
+
+#include "host/usbh.h"
+#if CFG_TUH_HID
+    #include "class/hid/hid_host.h"
+#endif
+
+#include "device/usbd.h"
+#if CFG_TUD_HID
+    #include "class/hid/hid_device.h"
+#endif
+#if CFG_TUD_ECM_RNDIS || CFG_TUD_NCM
+    #include "class/net/net_device.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool tusb_init(void);
+bool tusb_inited(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,118 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of TinyUSB's tusb_option.h. The shim headers declare the TinyUSB API the firmware uses, with the
+// same names, types and descriptor macros, so that the firmware compiles unchanged against tests/host/shim.
+
+#ifndef _HOST_TUSB_OPTION_H_
+#define _HOST_TUSB_OPTION_H_
+
+#include <stdint.h>
+
+#define TUSB_VERSION_MAJOR 0
+#define TUSB_VERSION_MINOR 17
+#define TUSB_VERSION_REVISION 0
+
+#define OPT_MCU_NONE 0
+#define OPT_MCU_LPC175X_6X 1
+#define OPT_MCU_LPC177X_8X 2
+#define OPT_MCU_LPC18XX 3
+#define OPT_MCU_LPC40XX 4
+#define OPT_MCU_LPC43XX 5
+#define OPT_MCU_SAMG 202
+#define OPT_MCU_SAMX7X 203
+#define OPT_MCU_NUC505 602
+#define OPT_MCU_CXD56 900
+#define OPT_MCU_MIMXRT10XX 700
+#define OPT_MCU_RP2040 1100
+
+#define OPT_OS_NONE 1
+#define OPT_OS_FREERTOS 2
+#define OPT_OS_MYNEWT 3
+#define OPT_OS_CUSTOM 4
+#define OPT_OS_PICO 5
+
+#define OPT_MODE_NONE 0x0000
+#define OPT_MODE_DEVICE 0x0001
+#define OPT_MODE_HOST 0x0002
+#define OPT_MODE_SPEED_MASK 0xff00
+#define OPT_MODE_LOW_SPEED 0x0100
+#define OPT_MODE_FULL_SPEED 0x0200
+#define OPT_MODE_HIGH_SPEED 0x0400
+#define OPT_MODE_DEFAULT_SPEED 0x0000
+
+#ifdef CFG_TUSB_CONFIG_FILE
+    #include CFG_TUSB_CONFIG_FILE
+#else
+    #include "tusb_config.h"
+#endif
+
+#ifndef CFG_TUSB_RHPORT0_MODE
+#define CFG_TUSB_RHPORT0_MODE OPT_MODE_NONE
+#endif
+
+#ifndef CFG_TUSB_RHPORT1_MODE
+#define CFG_TUSB_RHPORT1_MODE OPT_MODE_NONE
+#endif
+
+#if (CFG_TUSB_RHPORT0_MODE & OPT_MODE_DEVICE)
+    #define TUD_OPT_RHPORT 0
+#elif (CFG_TUSB_RHPORT1_MODE & OPT_MODE_DEVICE)
+    #define TUD_OPT_RHPORT 1
+#else
+    #define TUD_OPT_RHPORT -1
+#endif
+
+#define TUD_OPT_HIGH_SPEED 0
+
+#ifndef CFG_TUSB_DEBUG
+#define CFG_TUSB_DEBUG 0
+#endif
+
+#ifndef CFG_TUSB_MEM_SECTION
+#define CFG_TUSB_MEM_SECTION
+#endif
+
+#ifndef CFG_TUSB_MEM_ALIGN
+#define CFG_TUSB_MEM_ALIGN __attribute__((aligned(4)))
+#endif
+
+#ifndef CFG_TUD_ENDPOINT0_SIZE
+#define CFG_TUD_ENDPOINT0_SIZE 64
+#endif
+
+#ifndef CFG_TUD_CDC
+#define CFG_TUD_CDC 0
+#endif
+
+#ifndef CFG_TUD_MSC
+#define CFG_TUD_MSC 0
+#endif
+
+#ifndef CFG_TUD_HID
+#define CFG_TUD_HID 0
+#endif
+
+#ifndef CFG_TUD_MIDI
+#define CFG_TUD_MIDI 0
+#endif
+
+#ifndef CFG_TUD_VENDOR
+#define CFG_TUD_VENDOR 0
+#endif
+
+#ifndef CFG_TUD_ECM_RNDIS
+#define CFG_TUD_ECM_RNDIS 0
+#endif
+
+#ifndef CFG_TUD_NCM
+#define CFG_TUD_NCM 0
+#endif
+
+#ifndef CFG_TUH_HID
+#define CFG_TUH_HID 0
+#endif
+
+#endif
@@ -0,0 +1,13 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Host shim of the header pioasm generates for NeoPico's ws2812.pio, the LED program itself is not run
+
+#ifndef _HOST_WS2812_PIO_H_
+#define _HOST_WS2812_PIO_H_
+
+#include "hardware/pio.h"
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Virtual clock and alarms. Nothing runs concurrently on the host: alarms fire from whatever advances the
+// clock (the harness, sleep_us() and the busy waits), in time order, like timer interrupts would between
+// instructions of the firmware.
+
+#include <map>
+#include <utility>
+
+#include "pico/time.h"
+#include "host_hal.h"
+
+struct HostAlarm {
+    alarm_id_t id;
+    alarm_callback_t callback;
+    void * userData;
+};
+
+static uint64_t nowUs = 0;
+static alarm_id_t nextAlarmId = 1;
+static std::map<std::pair<uint64_t, alarm_id_t>, HostAlarm> alarms;
+
+const absolute_time_t nil_time = 0;
+const absolute_time_t at_the_end_of_time = (absolute_time_t)INT64_MAX;
+
+timer_hw_t host_timer_hw;
+
+static void fireAlarms(uint64_t untilUs) {
+    while (!alarms.empty() && alarms.begin()->first.first <= untilUs) {
+        auto it = alarms.begin();
+        uint64_t due = it->first.first;
+        HostAlarm alarm = it->second;
+        alarms.erase(it);
+        if (due > nowUs)
+            nowUs = due;
+
+        int64_t result = alarm.callback(alarm.id, alarm.userData);
+        if (result < 0)
+            alarms[{ due + (uint64_t)(-result), alarm.id }] = alarm;
+        else if (result > 0)
+            alarms[{ nowUs + (uint64_t)result, alarm.id }] = alarm;
+    }
+    if (untilUs > nowUs)
+        nowUs = untilUs;
+}
+
+uint64_t host_time_us(void) {
+    return nowUs;
+}
+
+void host_time_advance_us(uint64_t us) {
+    fireAlarms(nowUs + us);
+}
+
+void host_time_advance_to_us(uint64_t us) {
+    fireAlarms(us > nowUs ? us : nowUs);
+}
+
+uint64_t time_us_64(void) {
+    return nowUs;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)nowUs;
+}
+
+absolute_time_t get_absolute_time(void) {
+    return nowUs;
+}
+
+void busy_wait_us(uint64_t delay_us) {
+    host_time_advance_us(delay_us);
+}
+
+void busy_wait_us_32(uint32_t delay_us) {
+    host_time_advance_us(delay_us);
+}
+
+void busy_wait_ms(uint32_t delay_ms) {
+    host_time_advance_us((uint64_t)delay_ms * 1000);
+}
+
+void sleep_until(absolute_time_t target) {
+    host_time_advance_to_us(target);
+}
+
+void sleep_us(uint64_t us) {
+    host_time_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+    host_time_advance_us((uint64_t)ms * 1000);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp) {
+    host_time_advance_to_us(timeout_timestamp);
+    return true;
+}
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void * user_data, bool fire_if_past) {
+    alarm_id_t id = nextAlarmId++;
+    if (time <= nowUs) {
+        if (!fire_if_past)
+            return 0;
+        int64_t result = callback(id, user_data);
+        if (result == 0)
+            return 0;
+        time = result < 0 ? time + (uint64_t)(-result) : nowUs + (uint64_t)result;
+    }
+    alarms[{ time, id }] = { id, callback, user_data };
+    return id;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void * user_data, bool fire_if_past) {
+    return add_alarm_at(delayed_by_us(nowUs, us), callback, user_data, fire_if_past);
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void * user_data, bool fire_if_past) {
+    return add_alarm_at(delayed_by_ms(nowUs, ms), callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    for (auto it = alarms.begin(); it != alarms.end(); ++it) {
+        if (it->second.id == alarm_id) {
+            alarms.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+static int64_t repeatingTimerCallback(alarm_id_t id, void * user_data) {
+    (void)id;
+    repeating_timer_t * rt = (repeating_timer_t *)user_data;
+    if (!rt->callback(rt))
+        return 0;
+    return rt->delay_us;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void * user_data, repeating_timer_t * out) {
+    if (delay_us == 0)
+        delay_us = 1;
+    // Like the SDK: positive delays repeat from the end of the callback, negative ones from the previous due time
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    out->alarm_id = add_alarm_in_us(delay_us < 0 ? (uint64_t)(-delay_us) : (uint64_t)delay_us, repeatingTimerCallback, out, true);
+    return out->alarm_id > 0;
+}
+
+bool cancel_repeating_timer(repeating_timer_t * timer) {
+    bool cancelled = timer->alarm_id ? cancel_alarm(timer->alarm_id) : false;
+    timer->alarm_id = 0;
+    return cancelled;
+}
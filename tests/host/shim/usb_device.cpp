@@ -0,0 +1,477 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// USB device stack of the host shim, standing in for TinyUSB's usbd.c and hid_device.c.
+//
+// The first tud_task() after tud_init() enumerates: it opens every interface of configuration 0 with the
+// application's class driver, the way TinyUSB does on SET_CONFIGURATION, and mounts. From then on the virtual
+// host polls once per 1ms frame: an IN transfer queued in an earlier frame completes in the first tud_task() of
+// a later one, and is recorded for host_usb_report_hash(). OUT endpoints never receive data and there are no
+// control requests from the host, so driver handshakes (console authentication) do not progress.
+
+#include <string.h>
+
+#include "tusb.h"
+#include "device/usbd_pvt.h"
+#include "class/hid/hid_device.h"
+#include "class/net/net_device.h"
+#include "rndis.h"
+#include "host_hal.h"
+
+#define HOST_USB_ENDPOINTS 16
+#define HOST_USB_REPORT_MAX 256
+
+struct HostEndpoint {
+    bool opened;
+    bool busy;
+    bool claimed;
+    uint8_t * buffer;
+    uint16_t length;
+    uint32_t frame;             // Frame the transfer was queued in
+};
+
+static usbd_class_driver_t const * drivers = nullptr;
+static uint8_t driverCount = 0;
+static bool inited = false;
+static bool enumerated = false;
+static bool mounted = false;
+static bool sofEnabled = false;
+static uint32_t lastFrame = 0;
+static HostEndpoint endpoints[2][HOST_USB_ENDPOINTS];    // OUT, IN
+
+static uint32_t reportCount = 0;
+static uint32_t reportHash = 2166136261u;
+static uint8_t lastReport[HOST_USB_REPORT_MAX];
+static uint16_t lastReportLength = 0;
+
+static HostEndpoint & endpoint(uint8_t ep_addr) {
+    return endpoints[tu_edpt_dir(ep_addr)][tu_edpt_number(ep_addr) % HOST_USB_ENDPOINTS];
+}
+
+static uint32_t currentFrame(void) {
+    return (uint32_t)(host_time_us() / 1000);
+}
+
+static void recordReport(const uint8_t * data, uint16_t length) {
+    reportCount++;
+    for (uint16_t i = 0; i < length; i++)
+        reportHash = (reportHash ^ data[i]) * 16777619u;
+    lastReportLength = length < HOST_USB_REPORT_MAX ? length : HOST_USB_REPORT_MAX;
+    memcpy(lastReport, data, lastReportLength);
+}
+
+void host_usb_reset_reports(void) {
+    reportCount = 0;
+    reportHash = 2166136261u;
+    lastReportLength = 0;
+}
+
+uint32_t host_usb_report_count(void) {
+    return reportCount;
+}
+
+uint32_t host_usb_report_hash(void) {
+    return reportHash;
+}
+
+const uint8_t * host_usb_last_report(uint16_t * len) {
+    *len = lastReportLength;
+    return lastReport;
+}
+
+uint32_t host_usb_frame(void) {
+    return currentFrame();
+}
+
+// Open the interfaces of configuration 0 like TinyUSB's process_set_config(). Interfaces no driver claims
+// (e.g. the second function of an IAD the shim's stub class drivers skip) are passed over.
+static void enumerate(uint8_t rhport) {
+    const uint8_t * config = tud_descriptor_configuration_cb(0);
+    if (config == nullptr || tu_desc_type(config) != TUSB_DESC_CONFIGURATION)
+        return;
+
+    const tusb_desc_configuration_t * desc_cfg = (const tusb_desc_configuration_t *)config;
+    const uint8_t * p_desc = config + sizeof(tusb_desc_configuration_t);
+    const uint8_t * desc_end = config + tu_le16toh(desc_cfg->wTotalLength);
+
+    while (p_desc < desc_end) {
+        if (tu_desc_len(p_desc) == 0)
+            break;
+        if (tu_desc_type(p_desc) != TUSB_DESC_INTERFACE) {
+            p_desc = tu_desc_next(p_desc);
+            continue;
+        }
+
+        const tusb_desc_interface_t * desc_itf = (const tusb_desc_interface_t *)p_desc;
+        uint16_t remaining = (uint16_t)(desc_end - p_desc);
+        uint16_t claimed = 0;
+        for (uint8_t i = 0; i < driverCount && claimed == 0; i++) {
+            if (drivers[i].open != nullptr)
+                claimed = drivers[i].open(rhport, desc_itf, remaining);
+        }
+        p_desc = claimed >= sizeof(tusb_desc_interface_t) ? p_desc + claimed : tu_desc_next(p_desc);
+    }
+
+    mounted = true;
+    if (tud_mount_cb)
+        tud_mount_cb();
+}
+
+bool tud_init(uint8_t rhport) {
+    (void)rhport;
+    memset(endpoints, 0, sizeof(endpoints));
+    drivers = usbd_app_driver_get_cb(&driverCount);
+    for (uint8_t i = 0; i < driverCount; i++) {
+        if (drivers[i].init != nullptr)
+            drivers[i].init();
+    }
+    inited = true;
+    enumerated = false;
+    mounted = false;
+    lastFrame = currentFrame();
+    return true;
+}
+
+bool tud_inited(void) {
+    return inited;
+}
+
+void tud_task_ext(uint32_t timeout_ms, bool in_isr) {
+    (void)timeout_ms;
+    (void)in_isr;
+    if (!inited)
+        return;
+
+    if (!enumerated) {
+        enumerated = true;
+        enumerate(TUD_OPT_RHPORT);
+        return;
+    }
+
+    uint32_t frame = currentFrame();
+    if (frame == lastFrame)
+        return;
+    lastFrame = frame;
+
+    for (uint8_t num = 0; num < HOST_USB_ENDPOINTS; num++) {
+        HostEndpoint & ep = endpoints[TUSB_DIR_IN][num];
+        if (!ep.busy || ep.frame == frame)
+            continue;
+        ep.busy = false;
+        recordReport(ep.buffer, ep.length);
+        uint8_t ep_addr = tu_edpt_addr(num, TUSB_DIR_IN);
+        for (uint8_t i = 0; i < driverCount; i++) {
+            if (drivers[i].xfer_cb != nullptr && drivers[i].xfer_cb(TUD_OPT_RHPORT, ep_addr, XFER_RESULT_SUCCESS, ep.length))
+                break;
+        }
+    }
+
+    for (uint8_t i = 0; i < driverCount; i++) {
+        if (drivers[i].sof != nullptr)
+            drivers[i].sof(TUD_OPT_RHPORT, frame);
+    }
+    if (sofEnabled && tud_sof_cb)
+        tud_sof_cb(frame);
+}
+
+bool tud_task_event_ready(void) {
+    return inited && (!enumerated || currentFrame() != lastFrame);
+}
+
+tusb_speed_t tud_speed_get(void) {
+    return TUSB_SPEED_FULL;
+}
+
+bool tud_connected(void) {
+    return mounted;
+}
+
+bool tud_mounted(void) {
+    return mounted;
+}
+
+bool tud_suspended(void) {
+    return false;
+}
+
+bool tud_remote_wakeup(void) {
+    return false;
+}
+
+bool tud_disconnect(void) {
+    return false;
+}
+
+bool tud_connect(void) {
+    return true;
+}
+
+void tud_sof_cb_enable(bool en) {
+    sofEnabled = en;
+}
+
+bool tud_control_xfer(uint8_t rhport, tusb_control_request_t const * request, void * buffer, uint16_t len) {
+    (void)rhport;
+    (void)request;
+    (void)buffer;
+    (void)len;
+    return true;
+}
+
+bool tud_control_status(uint8_t rhport, tusb_control_request_t const * request) {
+    (void)rhport;
+    (void)request;
+    return true;
+}
+
+bool usbd_edpt_open(uint8_t rhport, tusb_desc_endpoint_t const * desc_ep) {
+    (void)rhport;
+    HostEndpoint & ep = endpoint(desc_ep->bEndpointAddress);
+    ep = HostEndpoint();
+    ep.opened = true;
+    return true;
+}
+
+void usbd_edpt_close(uint8_t rhport, uint8_t ep_addr) {
+    (void)rhport;
+    endpoint(ep_addr) = HostEndpoint();
+}
+
+bool usbd_edpt_xfer(uint8_t rhport, uint8_t ep_addr, uint8_t * buffer, uint16_t total_bytes) {
+    (void)rhport;
+    HostEndpoint & ep = endpoint(ep_addr);
+    if (!ep.opened || ep.busy)
+        return false;
+    ep.busy = true;
+    ep.claimed = false;
+    ep.buffer = buffer;
+    ep.length = total_bytes;
+    ep.frame = currentFrame();
+    return true;
+}
+
+bool usbd_edpt_busy(uint8_t rhport, uint8_t ep_addr) {
+    (void)rhport;
+    return endpoint(ep_addr).busy;
+}
+
+bool usbd_edpt_claim(uint8_t rhport, uint8_t ep_addr) {
+    (void)rhport;
+    HostEndpoint & ep = endpoint(ep_addr);
+    if (ep.busy || ep.claimed)
+        return false;
+    ep.claimed = true;
+    return true;
+}
+
+bool usbd_edpt_release(uint8_t rhport, uint8_t ep_addr) {
+    (void)rhport;
+    endpoint(ep_addr).claimed = false;
+    return true;
+}
+
+void usbd_edpt_stall(uint8_t rhport, uint8_t ep_addr) {
+    (void)rhport;
+    (void)ep_addr;
+}
+
+void usbd_edpt_clear_stall(uint8_t rhport, uint8_t ep_addr) {
+    (void)rhport;
+    (void)ep_addr;
+}
+
+bool usbd_edpt_stalled(uint8_t rhport, uint8_t ep_addr) {
+    (void)rhport;
+    (void)ep_addr;
+    return false;
+}
+
+bool usbd_open_edpt_pair(uint8_t rhport, uint8_t const * p_desc, uint8_t ep_count, uint8_t xfer_type,
+                         uint8_t * ep_out, uint8_t * ep_in) {
+    for (uint8_t i = 0; i < ep_count; i++) {
+        const tusb_desc_endpoint_t * desc_ep = (const tusb_desc_endpoint_t *)p_desc;
+        TU_ASSERT(TUSB_DESC_ENDPOINT == desc_ep->bDescriptorType && xfer_type == desc_ep->bmAttributes.xfer);
+        TU_ASSERT(usbd_edpt_open(rhport, desc_ep));
+        if (tu_edpt_dir(desc_ep->bEndpointAddress) == TUSB_DIR_IN)
+            *ep_in = desc_ep->bEndpointAddress;
+        else
+            *ep_out = desc_ep->bEndpointAddress;
+        p_desc = tu_desc_next(p_desc);
+    }
+    return true;
+}
+
+void usbd_defer_func(void (* func)(void *), void * param, bool in_isr) {
+    (void)in_isr;
+    func(param);
+}
+
+// HID class driver
+
+struct HostHIDInterface {
+    uint8_t itf_num;
+    uint8_t ep_in;
+    uint8_t ep_out;
+    uint8_t protocol_mode;
+    uint8_t idle_rate;
+    uint8_t epin_buf[CFG_TUD_HID_EP_BUFSIZE];
+    uint8_t epout_buf[CFG_TUD_HID_EP_BUFSIZE];
+};
+
+static HostHIDInterface hidInterfaces[CFG_TUD_HID];
+
+static uint8_t hidInstance(uint8_t ep_addr) {
+    for (uint8_t i = 0; i < CFG_TUD_HID; i++) {
+        if (ep_addr != 0 && (hidInterfaces[i].ep_in == ep_addr || hidInterfaces[i].ep_out == ep_addr))
+            return i;
+    }
+    return 0xff;
+}
+
+bool tud_hid_n_ready(uint8_t instance) {
+    uint8_t const ep_in = hidInterfaces[instance].ep_in;
+    return tud_ready() && ep_in != 0 && !usbd_edpt_busy(TUD_OPT_RHPORT, ep_in);
+}
+
+uint8_t tud_hid_n_interface_protocol(uint8_t instance) {
+    (void)instance;
+    return HID_ITF_PROTOCOL_NONE;
+}
+
+uint8_t tud_hid_n_get_protocol(uint8_t instance) {
+    return hidInterfaces[instance].protocol_mode;
+}
+
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, void const * report, uint16_t len) {
+    HostHIDInterface & p_hid = hidInterfaces[instance];
+    TU_VERIFY(usbd_edpt_claim(TUD_OPT_RHPORT, p_hid.ep_in));
+
+    if (report_id) {
+        len = TU_MIN(len, CFG_TUD_HID_EP_BUFSIZE - 1);
+        p_hid.epin_buf[0] = report_id;
+        memcpy(p_hid.epin_buf + 1, report, len);
+        len++;
+    } else {
+        len = TU_MIN(len, CFG_TUD_HID_EP_BUFSIZE);
+        memcpy(p_hid.epin_buf, report, len);
+    }
+    return usbd_edpt_xfer(TUD_OPT_RHPORT, p_hid.ep_in, p_hid.epin_buf, len);
+}
+
+void hidd_init(void) {
+    hidd_reset(TUD_OPT_RHPORT);
+}
+
+bool hidd_deinit(void) {
+    return true;
+}
+
+void hidd_reset(uint8_t rhport) {
+    (void)rhport;
+    memset(hidInterfaces, 0, sizeof(hidInterfaces));
+}
+
+uint16_t hidd_open(uint8_t rhport, tusb_desc_interface_t const * itf_desc, uint16_t max_len) {
+    TU_VERIFY(TUSB_CLASS_HID == itf_desc->bInterfaceClass, 0);
+    uint16_t const drv_len = (uint16_t)(sizeof(tusb_desc_interface_t) + 9 + itf_desc->bNumEndpoints * sizeof(tusb_desc_endpoint_t));
+    TU_ASSERT(max_len >= drv_len, 0);
+
+    HostHIDInterface * p_hid = nullptr;
+    for (uint8_t i = 0; i < CFG_TUD_HID; i++) {
+        if (hidInterfaces[i].ep_in == 0) {
+            p_hid = &hidInterfaces[i];
+            break;
+        }
+    }
+    TU_ASSERT(p_hid, 0);
+
+    uint8_t const * p_desc = tu_desc_next(itf_desc);
+    TU_ASSERT(HID_DESC_TYPE_HID == tu_desc_type(p_desc), 0);
+    p_desc = tu_desc_next(p_desc);
+    TU_ASSERT(usbd_open_edpt_pair(rhport, p_desc, itf_desc->bNumEndpoints, TUSB_XFER_INTERRUPT, &p_hid->ep_out, &p_hid->ep_in), 0);
+
+    p_hid->itf_num = itf_desc->bInterfaceNumber;
+    p_hid->protocol_mode = HID_PROTOCOL_REPORT;
+    if (p_hid->ep_out)
+        usbd_edpt_xfer(rhport, p_hid->ep_out, p_hid->epout_buf, sizeof(p_hid->epout_buf));
+    return drv_len;
+}
+
+bool hidd_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request) {
+    (void)rhport;
+    (void)stage;
+    (void)request;
+    return false;
+}
+
+bool hidd_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t event, uint32_t xferred_bytes) {
+    (void)event;
+    uint8_t const instance = hidInstance(ep_addr);
+    TU_VERIFY(instance < CFG_TUD_HID);
+    HostHIDInterface & p_hid = hidInterfaces[instance];
+
+    if (ep_addr == p_hid.ep_in) {
+        if (tud_hid_report_complete_cb)
+            tud_hid_report_complete_cb(instance, p_hid.epin_buf, (uint16_t)xferred_bytes);
+    } else {
+        tud_hid_set_report_cb(instance, 0, HID_REPORT_TYPE_INVALID, p_hid.epout_buf, (uint16_t)xferred_bytes);
+        TU_ASSERT(usbd_edpt_xfer(rhport, p_hid.ep_out, p_hid.epout_buf, sizeof(p_hid.epout_buf)));
+    }
+    return true;
+}
+
+// Network class driver and the RNDIS glue, web config is not served on the host
+
+uint8_t tud_network_mac_address[6] = { 0x02, 0x02, 0x84, 0x6A, 0x96, 0x00 };
+
+void netd_init(void) {}
+
+bool netd_deinit(void) {
+    return true;
+}
+
+void netd_reset(uint8_t rhport) {
+    (void)rhport;
+}
+
+uint16_t netd_open(uint8_t rhport, tusb_desc_interface_t const * itf_desc, uint16_t max_len) {
+    (void)rhport;
+    (void)itf_desc;
+    (void)max_len;
+    return 0;
+}
+
+bool netd_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request) {
+    (void)rhport;
+    (void)stage;
+    (void)request;
+    return false;
+}
+
+bool netd_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes) {
+    (void)rhport;
+    (void)ep_addr;
+    (void)result;
+    (void)xferred_bytes;
+    return false;
+}
+
+bool tud_network_can_xmit(uint16_t size) {
+    (void)size;
+    return false;
+}
+
+void tud_network_xmit(void * ref, uint16_t arg) {
+    (void)ref;
+    (void)arg;
+}
+
+void tud_network_recv_renew(void) {}
+
+int rndis_init(void) {
+    return 0;
+}
+
+void rndis_task(void) {}
@@ -0,0 +1,205 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// USB host stack of the host shim. Nothing is ever plugged into the port: the stack starts, no device mounts,
+// and every transfer is refused. Tests of host-side code (report plans, listeners) drive it directly.
+
+#include "tusb.h"
+#include "host/usbh_pvt.h"
+#include "class/hid/hid_host.h"
+
+static bool inited = false;
+
+bool tuh_configure(uint8_t rhport, uint32_t cfg_id, void const * cfg_param) {
+    (void)rhport;
+    (void)cfg_id;
+    (void)cfg_param;
+    return true;
+}
+
+bool tuh_init(uint8_t rhport) {
+    (void)rhport;
+    uint8_t driverCount = 0;
+    usbh_class_driver_t const * drivers = usbh_app_driver_get_cb ? usbh_app_driver_get_cb(&driverCount) : nullptr;
+    for (uint8_t i = 0; i < driverCount; i++) {
+        if (drivers[i].init != nullptr)
+            drivers[i].init();
+    }
+    inited = true;
+    return true;
+}
+
+bool tuh_deinit(uint8_t rhport) {
+    (void)rhport;
+    inited = false;
+    return true;
+}
+
+bool tuh_inited(void) {
+    return inited;
+}
+
+void tuh_task_ext(uint32_t timeout_ms, bool in_isr) {
+    (void)timeout_ms;
+    (void)in_isr;
+}
+
+bool tuh_vid_pid_get(uint8_t daddr, uint16_t * vid, uint16_t * pid) {
+    (void)daddr;
+    *vid = 0;
+    *pid = 0;
+    return false;
+}
+
+bool tuh_mounted(uint8_t daddr) {
+    (void)daddr;
+    return false;
+}
+
+bool tuh_connected(uint8_t daddr) {
+    (void)daddr;
+    return false;
+}
+
+bool tuh_suspended(uint8_t daddr) {
+    (void)daddr;
+    return false;
+}
+
+bool tuh_control_xfer(tuh_xfer_t * xfer) {
+    (void)xfer;
+    return false;
+}
+
+bool tuh_edpt_xfer(tuh_xfer_t * xfer) {
+    (void)xfer;
+    return false;
+}
+
+bool tuh_edpt_open(uint8_t daddr, tusb_desc_endpoint_t const * desc_ep) {
+    (void)daddr;
+    (void)desc_ep;
+    return false;
+}
+
+uint8_t tuh_descriptor_get_string_sync(uint8_t daddr, uint8_t index, uint16_t language_id, void * buffer,
+                                       uint16_t len) {
+    (void)daddr;
+    (void)index;
+    (void)language_id;
+    (void)buffer;
+    (void)len;
+    return XFER_RESULT_FAILED;
+}
+
+bool usbh_edpt_xfer_with_callback(uint8_t dev_addr, uint8_t ep_addr, uint8_t * buffer, uint16_t total_bytes,
+                                  tuh_xfer_cb_t complete_cb, uintptr_t user_data) {
+    (void)dev_addr;
+    (void)ep_addr;
+    (void)buffer;
+    (void)total_bytes;
+    (void)complete_cb;
+    (void)user_data;
+    return false;
+}
+
+bool usbh_edpt_claim(uint8_t dev_addr, uint8_t ep_addr) {
+    (void)dev_addr;
+    (void)ep_addr;
+    return false;
+}
+
+bool usbh_edpt_release(uint8_t dev_addr, uint8_t ep_addr) {
+    (void)dev_addr;
+    (void)ep_addr;
+    return true;
+}
+
+bool usbh_edpt_busy(uint8_t dev_addr, uint8_t ep_addr) {
+    (void)dev_addr;
+    (void)ep_addr;
+    return false;
+}
+
+void usbh_driver_set_config_complete(uint8_t dev_addr, uint8_t itf_num) {
+    (void)dev_addr;
+    (void)itf_num;
+}
+
+uint8_t usbh_get_rhport(uint8_t dev_addr) {
+    (void)dev_addr;
+    return 1;
+}
+
+// HID host class
+
+uint8_t tuh_hid_itf_get_count(uint8_t dev_addr) {
+    (void)dev_addr;
+    return 0;
+}
+
+bool tuh_hid_mounted(uint8_t dev_addr, uint8_t idx) {
+    (void)dev_addr;
+    (void)idx;
+    return false;
+}
+
+uint8_t tuh_hid_interface_protocol(uint8_t dev_addr, uint8_t idx) {
+    (void)dev_addr;
+    (void)idx;
+    return HID_ITF_PROTOCOL_NONE;
+}
+
+uint8_t tuh_hid_parse_report_descriptor(tuh_hid_report_info_t * reports_info_arr, uint8_t arr_count,
+                                        uint8_t const * desc_report, uint16_t desc_len) {
+    (void)reports_info_arr;
+    (void)arr_count;
+    (void)desc_report;
+    (void)desc_len;
+    return 0;
+}
+
+bool tuh_hid_get_report(uint8_t dev_addr, uint8_t idx, uint8_t report_id, uint8_t report_type, void * report,
+                        uint16_t len) {
+    (void)dev_addr;
+    (void)idx;
+    (void)report_id;
+    (void)report_type;
+    (void)report;
+    (void)len;
+    return false;
+}
+
+bool tuh_hid_set_report(uint8_t dev_addr, uint8_t idx, uint8_t report_id, uint8_t report_type, void * report,
+                        uint16_t len) {
+    (void)dev_addr;
+    (void)idx;
+    (void)report_id;
+    (void)report_type;
+    (void)report;
+    (void)len;
+    return false;
+}
+
+bool tuh_hid_receive_report(uint8_t dev_addr, uint8_t idx) {
+    (void)dev_addr;
+    (void)idx;
+    return false;
+}
+
+bool tuh_hid_send_ready(uint8_t dev_addr, uint8_t idx) {
+    (void)dev_addr;
+    (void)idx;
+    return false;
+}
+
+bool tuh_hid_send_report(uint8_t dev_addr, uint8_t idx, uint8_t report_id, void const * report, uint16_t len) {
+    (void)dev_addr;
+    (void)idx;
+    (void)report_id;
+    (void)report;
+    (void)len;
+    return false;
+}
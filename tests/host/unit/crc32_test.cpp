@@ -0,0 +1,107 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// CRC32 against the nibble table implementation it replaced, kept here as the reference. Built once per
+// CRC32_SLICES setting. Block updates of every alignment and length, and blocks mixed with single bytes, must give
+// the reference checksum.
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "CRC32.h"
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+// One byte at a time through two nibble lookups, as CRC32::update did
+static uint32_t referenceCRC(const uint8_t * data, size_t size) {
+    static const uint32_t table[] = {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+        0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+        0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+        0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+    };
+    uint32_t state = ~0L;
+    for (size_t i = 0; i < size; i++) {
+        state = table[(state ^ data[i]) & 0x0f] ^ (state >> 4);
+        state = table[(state ^ (data[i] >> 4)) & 0x0f] ^ (state >> 4);
+    }
+    return ~state;
+}
+
+static void testCheckValue() {
+    CHECK(CRC32::calculate((const uint8_t *)"123456789", 9) == 0xcbf43926);
+    CHECK(CRC32::calculate((const uint8_t *)"", 0) == 0);
+}
+
+// Every start alignment and every length up to a few slices, then long blocks the size of a Config
+static void testBlocks(const std::vector<uint8_t> & buffer, std::mt19937 & rng) {
+    int mismatches = 0;
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t size = 0; size < 100; size++) {
+            if (CRC32::calculate(buffer.data() + offset, size) != referenceCRC(buffer.data() + offset, size) &&
+                mismatches++ < 3)
+                fprintf(stderr, "offset %zu size %zu\n", offset, size);
+        }
+    }
+    for (int n = 0; n < 2000; n++) {
+        const size_t offset = rng() % 64;
+        const size_t size = rng() % (buffer.size() - 64);
+        if (CRC32::calculate(buffer.data() + offset, size) != referenceCRC(buffer.data() + offset, size) &&
+            mismatches++ < 3)
+            fprintf(stderr, "offset %zu size %zu\n", offset, size);
+    }
+    CHECK(mismatches == 0);
+}
+
+// A checksum carried across block updates, single bytes and multi-byte values comes out the same
+static void testMixedUpdates(const std::vector<uint8_t> & buffer, std::mt19937 & rng) {
+    int mismatches = 0;
+    for (int n = 0; n < 2000; n++) {
+        const size_t size = rng() % 3000;
+        CRC32 crc;
+        size_t i = 0;
+        while (i < size) {
+            const uint32_t kind = rng() % 3;
+            if (kind == 0) {
+                crc.update(buffer[i++]);
+            } else if (kind == 1 && size - i >= sizeof(uint32_t)) {
+                uint32_t word;
+                memcpy(&word, &buffer[i], sizeof(word));
+                crc.update(word);
+                i += sizeof(word);
+            } else {
+                const size_t block = std::min<size_t>(size - i, rng() % 200);
+                crc.update(&buffer[i], block);
+                i += block;
+            }
+        }
+        if (crc.finalize() != referenceCRC(buffer.data(), size) && mismatches++ < 3)
+            fprintf(stderr, "mixed updates of size %zu\n", size);
+    }
+    CHECK(mismatches == 0);
+}
+
+int main() {
+    std::mt19937 rng(CRC32_SLICES + 1);
+    std::vector<uint8_t> buffer(32768);
+    for (uint8_t & byte : buffer)
+        byte = rng();
+
+    testCheckValue();
+    testBlocks(buffer, rng);
+    testMixedUpdates(buffer, rng);
+    printf("CRC32_SLICES=%d %s\n", CRC32_SLICES, failures ? "FAILED" : "OK");
+    return failures != 0;
+}
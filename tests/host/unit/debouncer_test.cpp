@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// GamepadDebouncer over generated bounce traces: taps whose press and release chatter for less than the delay,
+// sampled at uneven loop periods. Every pin gets its own trace and all 30 run through one debouncer, which must
+// agree with one debouncer per pin. Per mode, a tap must come out as exactly one press and one release, with
+// eager edges reported on the first bounce and deferred edges only once the pin has settled.
+
+#include <stdio.h>
+#include <random>
+#include <vector>
+
+#include "GamepadDebouncer.h"
+
+#define PINS 30
+#define MAX_SAMPLE_PERIOD_US 450
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+// A tap on one pin, times in microseconds from the start of the trace
+struct Tap {
+    uint32_t pressUs;
+    uint32_t pressBounceUs;
+    uint32_t releaseUs;
+    uint32_t releaseBounceUs;
+};
+
+struct PinTrace {
+    std::vector<Tap> taps;
+
+    // Raw level at a time: bouncing toggles every 150us for the bounce window after an edge
+    bool level(uint32_t us) const {
+        for (const Tap & tap : taps) {
+            if (us < tap.pressUs)
+                return false;
+            if (us < tap.pressUs + tap.pressBounceUs)
+                return ((us - tap.pressUs) / 150) % 2 == 0;
+            if (us < tap.releaseUs)
+                return true;
+            if (us < tap.releaseUs + tap.releaseBounceUs)
+                return ((us - tap.releaseUs) / 150) % 2 == 1;
+        }
+        return false;
+    }
+};
+
+// Taps that each settle for longer than the delay, so every one of them has to be reported
+static PinTrace generateTrace(std::mt19937 & rng, uint32_t delayMs, uint32_t lengthUs) {
+    PinTrace trace;
+    const uint32_t settleUs = (delayMs + 2) * 1000;
+    const uint32_t bounceMaxUs = delayMs > 1 ? (delayMs - 1) * 1000 : 1;
+    uint32_t us = 1000 + rng() % 5000;
+    while (true) {
+        Tap tap;
+        tap.pressUs = us;
+        tap.pressBounceUs = rng() % bounceMaxUs;
+        tap.releaseUs = tap.pressUs + tap.pressBounceUs + settleUs + rng() % 20000;
+        tap.releaseBounceUs = rng() % bounceMaxUs;
+        us = tap.releaseUs + tap.releaseBounceUs + settleUs + rng() % 20000;
+        if (us >= lengthUs)
+            break;
+        trace.taps.push_back(tap);
+    }
+    return trace;
+}
+
+struct Edge {
+    uint32_t us;
+    bool pressed;
+};
+
+// Runs every pin's trace through one shared debouncer and one debouncer per pin. Collects the raw edges as
+// sampled and the shared debouncer's edges.
+static void runTraces(DebounceMode mode, uint32_t delayMs, uint32_t startUs, const PinTrace * traces,
+                      uint32_t lengthUs, std::mt19937 & rng, std::vector<Edge> * rawEdges,
+                      std::vector<Edge> * edges) {
+    GamepadDebouncer shared;
+    GamepadDebouncer single[PINS];
+    shared.reset(0, mode, delayMs, startUs);
+    for (GamepadDebouncer & debouncer : single)
+        debouncer.reset(0, mode, delayMs, startUs);
+
+    Mask_t previousRaw = 0;
+    Mask_t previous = 0;
+    int divergences = 0;
+    for (uint32_t us = 0; us < lengthUs; us += 50 + rng() % (MAX_SAMPLE_PERIOD_US - 50)) {
+        Mask_t raw = 0;
+        for (uint32_t pin = 0; pin < PINS; pin++) {
+            if (traces[pin].level(us))
+                raw |= 1u << pin;
+        }
+
+        const Mask_t debounced = shared.update(raw, startUs + us);
+        Mask_t separately = 0;
+        for (uint32_t pin = 0; pin < PINS; pin++)
+            separately |= single[pin].update(raw & (1u << pin), startUs + us) & (1u << pin);
+        if (debounced != separately && divergences++ < 3)
+            fprintf(stderr, "mode %d delay %u at %uus: %08x shared, %08x per pin\n", mode, delayMs, us,
+                debounced, separately);
+
+        for (uint32_t pin = 0; pin < PINS; pin++) {
+            if ((raw ^ previousRaw) & (1u << pin))
+                rawEdges[pin].push_back({ us, (raw & (1u << pin)) != 0 });
+            if ((debounced ^ previous) & (1u << pin))
+                edges[pin].push_back({ us, (debounced & (1u << pin)) != 0 });
+        }
+        previousRaw = raw;
+        previous = debounced;
+    }
+    CHECK(divergences == 0);
+}
+
+// An eager edge is reported on the first sample that sees the new level. A deferred edge follows the last raw
+// edge of the bounce after the delay, give or take a millisecond of counter granularity and a sample period (the
+// window starts at the last sample of the old level).
+static bool edgeInWindow(bool eager, uint32_t delayMs, const std::vector<Edge> & rawEdges, uint32_t fromUs,
+                         uint32_t toUs, const Edge & edge) {
+    uint32_t firstUs = 0;
+    uint32_t settledUs = 0;
+    bool seen = false;
+    for (const Edge & raw : rawEdges) {
+        if (raw.us < fromUs || raw.us >= toUs || raw.pressed != edge.pressed)
+            continue;
+        if (!seen)
+            firstUs = raw.us;
+        settledUs = raw.us;
+        seen = true;
+    }
+    if (!seen)
+        return false;
+    if (eager)
+        return edge.us == firstUs;
+    return edge.us + MAX_SAMPLE_PERIOD_US >= settledUs + (delayMs - 1) * 1000 &&
+        edge.us <= settledUs + (delayMs + 1) * 1000 + MAX_SAMPLE_PERIOD_US;
+}
+
+static void checkEdges(DebounceMode mode, uint32_t delayMs, const PinTrace & trace,
+                       const std::vector<Edge> & rawEdges, const std::vector<Edge> & edges) {
+    CHECK(edges.size() == trace.taps.size() * 2);
+    if (edges.size() != trace.taps.size() * 2)
+        return;
+
+    const bool eagerPress = mode != DEBOUNCE_MODE_DEFERRED;
+    const bool eagerRelease = mode == DEBOUNCE_MODE_EAGER;
+    for (size_t i = 0; i < trace.taps.size(); i++) {
+        const Tap & tap = trace.taps[i];
+        const Edge & press = edges[i * 2];
+        const Edge & release = edges[i * 2 + 1];
+        const uint32_t nextUs = (i + 1 < trace.taps.size()) ? trace.taps[i + 1].pressUs : UINT32_MAX;
+
+        CHECK(press.pressed && !release.pressed);
+        CHECK(edgeInWindow(eagerPress, delayMs, rawEdges, tap.pressUs, tap.releaseUs, press));
+        CHECK(edgeInWindow(eagerRelease, delayMs, rawEdges, tap.releaseUs, nextUs, release));
+    }
+}
+
+static void testBounceTraces(uint32_t startUs) {
+    static const DebounceMode modes[] = { DEBOUNCE_MODE_EAGER, DEBOUNCE_MODE_EAGER_PRESS, DEBOUNCE_MODE_DEFERRED };
+    static const uint32_t delays[] = { 2, 5, 10, 20 };
+    const uint32_t lengthUs = 2000000;
+    std::mt19937 rng(startUs ^ 3);
+
+    for (DebounceMode mode : modes) {
+        for (uint32_t delayMs : delays) {
+            PinTrace traces[PINS];
+            std::vector<Edge> rawEdges[PINS];
+            std::vector<Edge> edges[PINS];
+            size_t taps = 0;
+            for (PinTrace & trace : traces) {
+                trace = generateTrace(rng, delayMs, lengthUs);
+                taps += trace.taps.size();
+            }
+            runTraces(mode, delayMs, startUs, traces, lengthUs, rng, rawEdges, edges);
+            for (uint32_t pin = 0; pin < PINS; pin++)
+                checkEdges(mode, delayMs, traces[pin], rawEdges[pin], edges[pin]);
+            printf("start %08x mode %d delay %2ums: %zu taps\n", startUs, mode, delayMs, taps);
+        }
+    }
+}
+
+// Without a delay the raw state passes straight through
+static void testNoDelay() {
+    GamepadDebouncer debouncer;
+    debouncer.reset(0, DEBOUNCE_MODE_DEFERRED, 0, 0);
+    CHECK(debouncer.update(0x15, 100) == 0x15);
+    CHECK(debouncer.update(0x02, 200) == 0x02);
+}
+
+// Buttons held through boot: started from the raw state, the first sample already reports them in every mode,
+// as the boot actions read them, and releasing them afterwards is debounced as usual (deferred but in eager mode)
+static void testBootHeld() {
+    static const DebounceMode modes[] = { DEBOUNCE_MODE_EAGER, DEBOUNCE_MODE_EAGER_PRESS, DEBOUNCE_MODE_DEFERRED };
+    for (DebounceMode mode : modes) {
+        GamepadDebouncer debouncer;
+        debouncer.reset(0x15, mode, 10, 0);
+        CHECK(debouncer.update(0x15, 100) == 0x15);
+        CHECK(debouncer.update(0x14, 1000) == ((mode == DEBOUNCE_MODE_EAGER) ? 0x14 : 0x15));
+        CHECK(debouncer.update(0x14, 12000) == 0x14);
+    }
+}
+
+int main() {
+    testNoDelay();
+    testBootHeld();
+    testBounceTraces(0);
+    // The microsecond timer wraps during the trace
+    testBounceTraces(0xFFFFFFFFu - 1000000);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures != 0;
+}
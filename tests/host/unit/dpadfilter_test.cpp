@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// DpadFilter against the std::list implementation it replaced, kept here as the reference. Every sequence of dpad
+// values up to DEPTH steps, so every order of presses and releases including simultaneous ones, must give the same
+// 4-way output and the same SOCD output in every mode, followed by a long random sequence.
+
+#include <stdio.h>
+#include <list>
+#include <random>
+
+#include "GamepadState.h"
+
+#define DEPTH 5
+
+static const SOCDMode socdModes[] = {
+    SOCD_MODE_UP_PRIORITY, SOCD_MODE_NEUTRAL, SOCD_MODE_SECOND_INPUT_PRIORITY, SOCD_MODE_FIRST_INPUT_PRIORITY,
+    SOCD_MODE_BYPASS,
+};
+#define SOCD_MODES (sizeof(socdModes) / sizeof(socdModes[0]))
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+// updateDpad, filterToFourWayMode and runSOCDCleaner as they were, with the function statics moved into members
+struct ListFilter {
+    bool inList[5] = { false, false, false, false, false };
+    std::list<DpadDirection> dpadList;
+    DpadDirection lastUD = DIRECTION_NONE;
+    DpadDirection lastLR = DIRECTION_NONE;
+
+    uint8_t updateDpad(uint8_t dpad, DpadDirection direction) {
+        if (dpad & getMaskFromDirection(direction)) {
+            if (!inList[direction]) {
+                dpadList.push_back(direction);
+                inList[direction] = true;
+            }
+        } else {
+            if (inList[direction]) {
+                dpadList.remove(direction);
+                inList[direction] = false;
+            }
+        }
+        return dpadList.empty() ? 0 : getMaskFromDirection(dpadList.back());
+    }
+
+    uint8_t filterToFourWayMode(uint8_t dpad) {
+        updateDpad(dpad, DIRECTION_UP);
+        updateDpad(dpad, DIRECTION_DOWN);
+        updateDpad(dpad, DIRECTION_LEFT);
+        return updateDpad(dpad, DIRECTION_RIGHT);
+    }
+
+    uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad) {
+        if (mode == SOCD_MODE_BYPASS)
+            return dpad;
+
+        uint8_t newDpad = 0;
+        switch (dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) {
+            case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN):
+                if (mode == SOCD_MODE_UP_PRIORITY) {
+                    newDpad |= GAMEPAD_MASK_UP;
+                    lastUD = DIRECTION_UP;
+                } else if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
+                    newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
+                else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
+                    newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
+                else
+                    lastUD = DIRECTION_NONE;
+                break;
+            case GAMEPAD_MASK_UP:
+                newDpad |= GAMEPAD_MASK_UP;
+                lastUD = DIRECTION_UP;
+                break;
+            case GAMEPAD_MASK_DOWN:
+                newDpad |= GAMEPAD_MASK_DOWN;
+                lastUD = DIRECTION_DOWN;
+                break;
+            default:
+                lastUD = DIRECTION_NONE;
+                break;
+        }
+
+        switch (dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) {
+            case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
+                if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
+                    newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT;
+                else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
+                    newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT;
+                else
+                    lastLR = DIRECTION_NONE;
+                break;
+            case GAMEPAD_MASK_LEFT:
+                newDpad |= GAMEPAD_MASK_LEFT;
+                lastLR = DIRECTION_LEFT;
+                break;
+            case GAMEPAD_MASK_RIGHT:
+                newDpad |= GAMEPAD_MASK_RIGHT;
+                lastLR = DIRECTION_RIGHT;
+                break;
+            default:
+                lastLR = DIRECTION_NONE;
+                break;
+        }
+        return newDpad;
+    }
+};
+
+// One 4-way filter and one SOCD cleaner per mode, each pair starting from the same history
+struct FilterSet {
+    DpadFilter fourWay;
+    DpadFilter socd[SOCD_MODES];
+    ListFilter referenceFourWay;
+    ListFilter referenceSocd[SOCD_MODES];
+};
+
+static long steps = 0;
+static int mismatches = 0;
+
+static void step(FilterSet & filters, uint8_t dpad, const uint8_t * sequence, int depth) {
+    steps++;
+    bool same = filters.fourWay.filterToFourWayMode(dpad) == filters.referenceFourWay.filterToFourWayMode(dpad);
+    for (size_t m = 0; m < SOCD_MODES; m++)
+        same &= filters.socd[m].runSOCDCleaner(socdModes[m], dpad) ==
+            filters.referenceSocd[m].runSOCDCleaner(socdModes[m], dpad);
+    if (!same && mismatches++ < 3) {
+        fprintf(stderr, "mismatch after dpad sequence");
+        for (int i = 0; i < depth; i++)
+            fprintf(stderr, " %x", sequence[i]);
+        fprintf(stderr, " %x\n", dpad);
+    }
+}
+
+// Walks the tree of all dpad sequences, each node continuing from a copy of its parent's filters
+static void walk(const FilterSet & parent, uint8_t * sequence, int depth) {
+    if (depth == DEPTH)
+        return;
+    for (uint8_t dpad = 0; dpad < 16; dpad++) {
+        FilterSet filters = parent;
+        step(filters, dpad, sequence, depth);
+        sequence[depth] = dpad;
+        walk(filters, sequence, depth + 1);
+    }
+}
+
+static void testEverySequence() {
+    const FilterSet fresh;
+    uint8_t sequence[DEPTH];
+    walk(fresh, sequence, 0);
+    printf("every sequence up to depth %d: %ld steps\n", DEPTH, steps);
+    CHECK(mismatches == 0);
+}
+
+// A long run of single presses and releases with the odd multi-direction change, as a held stick produces
+static void testRandomSequence() {
+    FilterSet filters;
+    std::mt19937 rng(4);
+    uint8_t dpad = 0;
+    mismatches = 0;
+    for (int n = 0; n < 1000000; n++) {
+        dpad ^= (rng() % 8 == 0) ? (rng() & 0x0F) : (1u << (rng() % 4));
+        step(filters, dpad, nullptr, 0);
+    }
+    CHECK(mismatches == 0);
+}
+
+int main() {
+    testEverySequence();
+    testRandomSequence();
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures != 0;
+}
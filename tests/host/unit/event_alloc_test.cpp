@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Heap allocations per loop. Every operator new in the process is counted, and once the firmware is booted and
+// warmed up, replaying the tap trace with the analog stick sweeping must post button and analog events on every
+// edge without a single allocation, with events dispatched as posted, deferred to the end of the loop, or queued
+// from core1.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+
+#include "harness.h"
+#include "eventmanager.h"
+
+#include "enums.pb.h"
+
+static unsigned long allocations = 0;
+
+void * operator new(size_t size) {
+    allocations++;
+    void * p = malloc(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void * operator new[](size_t size) {
+    return operator new(size);
+}
+
+void * operator new(size_t size, const std::nothrow_t &) noexcept {
+    allocations++;
+    return malloc(size ? size : 1);
+}
+
+void * operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void * p) noexcept {
+    free(p);
+}
+
+void operator delete[](void * p) noexcept {
+    free(p);
+}
+
+void operator delete(void * p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void * p, size_t) noexcept {
+    free(p);
+}
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+static unsigned long buttonEvents = 0;
+static unsigned long analogEvents = 0;
+
+// Replays the trace once with the left stick circling, returns the allocations made by the loops
+static unsigned long replay(GP2040 * gp2040, const Trace & trace, uint32_t * loops) {
+    const uint64_t offset = host_time_us() + 1000 - trace.front().timeUs;
+    const unsigned long before = allocations;
+    uint32_t n = 0;
+    for (TraceSample sample : trace) {
+        sample.timeUs += offset;
+        // A triangle wave on each axis, a quarter turn apart
+        sample.adc[0] = (n & 0x800) ? 0xFFF - (n & 0x7FF) * 2 : (n & 0x7FF) * 2;
+        sample.adc[1] = ((n + 0x400) & 0x800) ? 0xFFF - ((n + 0x400) & 0x7FF) * 2 : ((n + 0x400) & 0x7FF) * 2;
+        replaySample(gp2040, sample);
+        n += 37;
+    }
+    *loops += trace.size();
+    return allocations - before;
+}
+
+static void testLoop(GP2040 * gp2040, const Trace & trace, bool deferred) {
+    EventManager::getInstance().setDeferredDispatch(deferred);
+    buttonEvents = 0;
+    analogEvents = 0;
+    uint32_t loops = 0;
+    const unsigned long loopAllocations = replay(gp2040, trace, &loops);
+    printf("%s dispatch: %u loops, %lu button events, %lu analog events, %lu allocations\n",
+        deferred ? "deferred" : "immediate", loops, buttonEvents, analogEvents, loopAllocations);
+    CHECK(buttonEvents > 0);
+    CHECK(analogEvents > 0);
+    CHECK(loopAllocations == 0);
+    CHECK(EventManager::getInstance().getDroppedEvents() == 0);
+    EventManager::getInstance().setDeferredDispatch(false);
+}
+
+// Events posted on core1 wait in the core1 ring for core0's next drain, a full ring drops rather than allocating
+static void testCore1Posting() {
+    EventManager & events = EventManager::getInstance();
+    buttonEvents = 0;
+    const unsigned long before = allocations;
+
+    host_set_core_num(1);
+    for (int i = 0; i < EVENTMGR_QUEUE_SIZE + 4; i++)
+        events.postEvent<GPButtonDownEvent>(GAMEPAD_MASK_UP, 0, 0);
+    host_set_core_num(0);
+    CHECK(buttonEvents == 0);
+    CHECK(events.getDroppedEvents() == 4);
+
+    events.drainEvents();
+    CHECK(buttonEvents == EVENTMGR_QUEUE_SIZE);
+    CHECK(allocations == before);
+}
+
+int main() {
+    Trace trace;
+    if (!loadTrace("traces/tap_sweep.trace", trace) || trace.empty())
+        return 2;
+
+    provisionConfig([](Config & config) {
+        AnalogOptions & analog = config.addonOptions.analogOptions;
+        analog.enabled = true;
+        analog.analogAdc1PinX = 26;
+        analog.analogAdc1PinY = 27;
+        analog.auto_calibrate = false;
+        analog.joystick_center_x = 2048;
+        analog.joystick_center_y = 2048;
+        config.gpioMappings.pins[26].action = GpioAction::NONE;
+        config.gpioMappings.pins[27].action = GpioAction::NONE;
+    });
+    GP2040 * gp2040 = bootFirmware();
+
+    EventManager & events = EventManager::getInstance();
+    events.registerEventHandler(GP_EVENT_BUTTON_DOWN, [](GPEvent *) { buttonEvents++; });
+    events.registerEventHandler(GP_EVENT_BUTTON_UP, [](GPEvent *) { buttonEvents++; });
+    events.registerEventHandler(GP_EVENT_ANALOG_PROCESSED_MOVE, [](GPEvent *) { analogEvents++; });
+
+    // Enumeration, lazily built tables and the first pass may allocate, the loop after that may not
+    uint32_t warmup = 0;
+    host_time_advance_us(100 * 1000);
+    gp2040->loop();
+    replay(gp2040, trace, &warmup);
+
+    testLoop(gp2040, trace, false);
+    testLoop(gp2040, trace, true);
+    testCore1Posting();
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures != 0;
+}
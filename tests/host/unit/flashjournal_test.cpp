@@ -0,0 +1,247 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Crash consistency of the config journal. FlashJournal runs on a RAM medium that loses power after a random
+// number of byte writes, leaving the interrupted erase or program half done, and every remount must find either
+// the last completed record or the interrupted one complete. FlashPROM is then checked on the shim's flash.
+
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "FlashPROM.h"
+#include "host_hal.h"
+
+static const int MOUNTS = 20000;
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+struct PowerLoss {};
+
+static uint8_t medium[EEPROM_SIZE_BYTES];
+static long byteBudget = -1;               // Byte writes until the power goes, negative: never
+static bool cutAfterErase = false;         // The power goes at the first program after an erase
+static bool erasedBeforeCut = false;
+static std::mt19937 rng(1);
+
+static void spendByte() {
+    if (byteBudget == 0)
+        throw PowerLoss();
+    if (byteBudget > 0)
+        byteBudget--;
+}
+
+static void mediumErase(uint32_t offset, uint32_t size) {
+    CHECK(offset % FLASH_JOURNAL_SECTOR_SIZE == 0 && size == FLASH_JOURNAL_SECTOR_SIZE);
+    for (uint32_t i = 0; i < size; i++) {
+        if (byteBudget == 0) {
+            // An interrupted erase leaves the rest of the sector in an undefined state
+            for (uint32_t j = i; j < size; j++)
+                medium[offset + j] |= (uint8_t)rng();
+            throw PowerLoss();
+        }
+        spendByte();
+        medium[offset + i] = 0xFF;
+    }
+    erasedBeforeCut = cutAfterErase;
+}
+
+static void mediumProgram(uint32_t offset, const uint8_t * data, uint32_t size) {
+    CHECK(offset % FLASH_JOURNAL_PAGE_SIZE == 0 && size % FLASH_JOURNAL_PAGE_SIZE == 0);
+    CHECK(offset / FLASH_JOURNAL_SECTOR_SIZE == (offset + size - 1) / FLASH_JOURNAL_SECTOR_SIZE);
+    if (erasedBeforeCut)
+        throw PowerLoss();
+    for (uint32_t i = 0; i < size; i++) {
+        CHECK(medium[offset + i] == 0xFF);
+        spendByte();
+        medium[offset + i] &= data[i];
+    }
+}
+
+static bool holds(const FlashJournal & journal, const std::vector<uint8_t> & data) {
+    return journal.getData() != nullptr && journal.getDataSize() == data.size() &&
+        memcmp(journal.getData(), data.data(), data.size()) == 0;
+}
+
+static void testJournalPowerLoss() {
+    const FlashJournalMedium journalMedium = { medium, sizeof(medium), mediumErase, mediumProgram };
+    std::vector<uint8_t> committed;
+    bool hasCommitted = false;
+    long appends = 0;
+    long losses = 0;
+
+    // The region starts out holding something else, like the footer config of older firmware
+    memset(medium, 0, sizeof(medium));
+    for (int mount = 0; mount < MOUNTS && failures == 0; mount++) {
+        FlashJournal journal;
+        byteBudget = -1;
+        journal.mount(journalMedium);
+        CHECK(hasCommitted ? holds(journal, committed) : journal.getData() == nullptr);
+
+        const int saves = 1 + rng() % 20;
+        for (int save = 0; save < saves; save++) {
+            // Mostly small saves, now and then one up to the largest commit FlashPROM accepts
+            const uint32_t size = 1 + rng() % ((rng() % 10 == 0) ? EEPROM_MAX_DATA_BYTES : 3000);
+            std::vector<uint8_t> data(size);
+            for (uint8_t & byte : data)
+                byte = rng();
+
+            byteBudget = (rng() % 4 == 0) ? (long)(rng() % (size * 3 + 8192)) : -1;
+            try {
+                CHECK(journal.append(data.data(), size));
+                committed = data;
+                hasCommitted = true;
+                appends++;
+            } catch (PowerLoss &) {
+                losses++;
+                FlashJournal remounted;
+                byteBudget = -1;
+                remounted.mount(journalMedium);
+                const bool isOld = hasCommitted && holds(remounted, committed);
+                const bool isNew = holds(remounted, data);
+                CHECK(isOld || isNew || (!hasCommitted && remounted.getData() == nullptr));
+                if (isNew) {
+                    committed = data;
+                    hasCommitted = true;
+                }
+                break;
+            }
+        }
+    }
+    printf("journal: %ld appends, %ld power losses\n", appends, losses);
+}
+
+static std::vector<uint8_t> record(uint32_t size, uint8_t value) {
+    return std::vector<uint8_t>(size, value);
+}
+
+// Appends data with the power going right after the append's erase, then again with power. The remount after the
+// cut must still hold the previous record, whether or not the append wrapped around.
+static bool appendAcrossCut(const FlashJournalMedium & journalMedium, FlashJournal & journal,
+    const std::vector<uint8_t> & previous, const std::vector<uint8_t> & data) {
+    std::vector<uint8_t> snapshot(medium, medium + sizeof(medium));
+    cutAfterErase = true;
+    erasedBeforeCut = false;
+    bool appended = false;
+    try {
+        appended = journal.append(data.data(), data.size());
+    } catch (PowerLoss &) {
+    }
+    cutAfterErase = false;
+    erasedBeforeCut = false;
+
+    FlashJournal remounted;
+    remounted.mount(journalMedium);
+    CHECK(holds(remounted, appended ? data : previous));
+
+    // Back to before the cut, this time the append completes
+    memcpy(medium, snapshot.data(), snapshot.size());
+    journal.mount(journalMedium);
+    return journal.append(data.data(), data.size());
+}
+
+// A largest record, a small one, a largest one C, then a largest one D that wraps around: D's erase is rounded
+// up to whole sectors and must not reach C, or a power loss before D is complete leaves the journal empty
+static void testWrapErase() {
+    const FlashJournalMedium journalMedium = { medium, sizeof(medium), mediumErase, mediumProgram };
+    byteBudget = -1;
+
+    // Records of a third of the region in pages, the size that used to be accepted, and the largest commit
+    const uint32_t sizes[] = {
+        (uint32_t)(sizeof(medium) / 3 / FLASH_JOURNAL_PAGE_SIZE * FLASH_JOURNAL_PAGE_SIZE - sizeof(FlashJournalFooter)),
+        EEPROM_MAX_DATA_BYTES,
+    };
+    for (uint32_t size : sizes) {
+        memset(medium, 0, sizeof(medium));
+        FlashJournal journal;
+        journal.mount(journalMedium);
+        journal.format();
+
+        const std::vector<uint8_t> a = record(size, 0xA1);
+        const std::vector<uint8_t> b = record(400, 0xB2);
+        const std::vector<uint8_t> c = record(size, 0xC3);
+        CHECK(journal.append(a.data(), a.size()));
+        CHECK(appendAcrossCut(journalMedium, journal, a, b));
+        CHECK(appendAcrossCut(journalMedium, journal, b, c));
+
+        // Oversized records are refused where they would erase C, the largest commit always goes through,
+        // around the region a few times
+        std::vector<uint8_t> previous = c;
+        bool wrapped = false;
+        for (uint8_t n = 0; n < 8; n++) {
+            const std::vector<uint8_t> d = record(size, 0xD0 + n);
+            const bool appended = appendAcrossCut(journalMedium, journal, previous, d);
+            CHECK(appended || size > EEPROM_MAX_DATA_BYTES);
+            CHECK(holds(journal, appended ? d : previous));
+            if (!appended)
+                break;
+            wrapped |= journal.getData() == medium;
+            previous = d;
+        }
+        CHECK(wrapped || size > EEPROM_MAX_DATA_BYTES);
+    }
+}
+
+static void flushWrite() {
+    host_time_advance_us(EEPROM_WRITE_WAIT * 1000 * 2);
+}
+
+// Commits through FlashPROM on the shim's flash: oversized data is refused, and a write that loses power keeps
+// the previous commit readable after a power cycle
+static void testFlashPROM() {
+    host_flash_reset();
+    EEPROM.start();
+
+    memset(EEPROM.writeCache, 0x11, 1000);
+    CHECK(EEPROM.commit(1000));
+    CHECK(!EEPROM.commit(EEPROM_MAX_DATA_BYTES + 1));
+    flushWrite();
+
+    uint32_t size = 0;
+    const uint8_t * data = EEPROM.getData(size);
+    CHECK(data != nullptr && size == 1000 && data[999] == 0x11);
+
+    int recovered = 0;
+    for (int32_t operations = 0; operations < 8; operations++) {
+        memset(EEPROM.writeCache, 0x22 + operations, 2000);
+        CHECK(EEPROM.commit(2000));
+        host_flash_fail_after(operations);
+        try {
+            flushWrite();
+        } catch (HostPowerLoss &) {
+            recovered++;
+        }
+        host_flash_fail_after(-1);
+        host_power_cycle();
+        flushWrite();
+
+        EEPROM.start();
+        data = EEPROM.getData(size);
+        CHECK(data != nullptr);
+        if (data != nullptr)
+            CHECK((size == 1000 && data[999] == 0x11) || (size == 2000 && data[1999] == 0x22 + operations));
+        // Start the next round from a known record
+        memset(EEPROM.writeCache, 0x11, 1000);
+        CHECK(EEPROM.commit(1000));
+        flushWrite();
+    }
+    CHECK(recovered > 0);
+}
+
+int main() {
+    testJournalPowerLoss();
+    testWrapErase();
+    testFlashPROM();
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures != 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// HIDReportPlan against the descriptor corpus: which descriptors get a plan, that decode() agrees with the
+// reference decoder on random reports, and that short reports are refused.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+
+#include "drivers/shared/hidreportplan.h"
+
+#include "../corpus/hid_descriptors.h"
+
+static const int REPORTS_PER_DESCRIPTOR = 20000;
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+static void testCorpus() {
+    std::mt19937 rng(1234);
+    for (const HIDDescriptorEntry & entry : hidDescriptorCorpus) {
+        HIDReportPlan plan;
+        const bool planned = plan.compile(entry.descriptor, entry.length);
+        printf("%-32s planned=%d id=%u fields=%u\n", entry.name, planned, plan.getReportId(), plan.getFieldCount());
+        CHECK(planned == entry.planned);
+        if (!planned)
+            continue;
+
+        const HIDReferenceLayout layout = referenceLayout(entry.descriptor, entry.length);
+        int mismatches = 0;
+        for (int n = 0; n < REPORTS_PER_DESCRIPTOR; n++) {
+            uint8_t report[64];
+            for (uint8_t & byte : report)
+                byte = rng();
+            if (plan.getReportId() != 0)
+                report[0] = plan.getReportId();
+
+            GamepadState decoded, expected;
+            plan.decode(report, sizeof(report), decoded);
+            refDecode(entry.descriptor, entry.length, plan.getReportId(), layout, report, expected);
+            if (!refSameState(decoded, expected) && mismatches++ < 3) {
+                fprintf(stderr, "  %s: buttons %08x/%08x dpad %x/%x lx %u/%u ly %u/%u rx %u/%u ry %u/%u lt %u/%u rt %u/%u\n",
+                    entry.name, decoded.buttons, expected.buttons, decoded.dpad, expected.dpad,
+                    decoded.lx, expected.lx, decoded.ly, expected.ly, decoded.rx, expected.rx,
+                    decoded.ry, expected.ry, decoded.lt, expected.lt, decoded.rt, expected.rt);
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+// A run of buttons merged into one field must still count towards the report length
+static void testMergedRunLength() {
+    HIDReportPlan plan;
+    CHECK(plan.compile(merged_run_descriptor, sizeof(merged_run_descriptor)));
+
+    const uint8_t report[3] = { 0x00, 0xFF, 0x80 };
+    GamepadState state;
+    CHECK(!plan.decode(report, 2, state));
+    CHECK(plan.decode(report, 3, state));
+    CHECK(state.buttons & GAMEPAD_MASK_A4);
+}
+
+// Reports other than the planned one, and reports cut short, leave the state alone
+static void testRefusedReports() {
+    HIDReportPlan plan;
+    CHECK(plan.compile(stadia_like_descriptor, sizeof(stadia_like_descriptor)));
+    CHECK(plan.getReportId() == 3);
+
+    uint8_t report[64] = { 5 };
+    GamepadState state;
+    state.buttons = GAMEPAD_MASK_B1;
+    CHECK(!plan.decode(report, sizeof(report), state));
+    report[0] = 3;
+    CHECK(!plan.decode(report, 4, state));
+    CHECK(state.buttons == GAMEPAD_MASK_B1);
+}
+
+int main() {
+    testCorpus();
+    testMergedRunLength();
+    testRefusedReports();
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures != 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// InputTrace as the web config drives it: capturing a held button pulls up the unused pins for as long as
+// the client asks and puts them back after, stick calibration sets up the ADC inputs once and the loop then
+// samples them. Pins in use for buttons, outputs or analog reads are never touched.
+
+#include <stdio.h>
+
+#include "inputtrace.h"
+#include "hardware/adc.h"
+#include "hardware/gpio.h"
+#include "hardware/structs/padsbank0.h"
+#include "host_hal.h"
+
+#define BUTTON_PIN 2
+#define LED_PIN 3
+#define UNUSED_PIN 7
+#define ADC_STICK_PIN 27
+#define ADC_USED_PIN 28
+#define ADC_UNUSED_PIN 29
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+static bool isUnused(uint pin) {
+    return gpio_get_function(pin) == GPIO_FUNC_NULL && (padsbank0_hw->io[pin] & PADS_BANK0_GPIO0_IE_BITS);
+}
+
+// A board after setup(): one button, one LED, an ADC pin in use as a button, everything else unused
+static void setupBoard() {
+    for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+        gpio_set_function(pin, GPIO_FUNC_NULL);
+        gpio_set_input_enabled(pin, true);
+        gpio_disable_pulls(pin);
+    }
+    gpio_init(BUTTON_PIN);
+    gpio_set_dir(BUTTON_PIN, GPIO_IN);
+    gpio_pull_up(BUTTON_PIN);
+    gpio_init(LED_PIN);
+    gpio_set_dir(LED_PIN, GPIO_OUT);
+    gpio_init(ADC_USED_PIN);
+    gpio_set_dir(ADC_USED_PIN, GPIO_IN);
+    gpio_pull_up(ADC_USED_PIN);
+    host_gpio_set_levels(0xffffffffu);
+}
+
+// One loop pass as GP2040::traceInput() runs it
+static bool loopPass(InputTrace & trace) {
+    const uint32_t nowUs = time_us_32();
+    if (!trace.due(nowUs))
+        return false;
+    trace.record(nowUs, ~gpio_get_all(), 0, GamepadState());
+    return true;
+}
+
+static void testUnusedPins(InputTrace & trace) {
+    trace.poll(INPUT_TRACE_DEFAULT_INTERVAL_US, 0, true);
+
+    // Unused pins become pulled up inputs, the ones in use keep their setup
+    CHECK(gpio_get_function(UNUSED_PIN) == GPIO_FUNC_SIO && gpio_is_pulled_up(UNUSED_PIN));
+    CHECK(gpio_is_dir_out(LED_PIN));
+    const uint32_t inputPins = trace.getInputPins();
+    CHECK(inputPins & (1u << UNUSED_PIN));
+    CHECK(inputPins & (1u << BUTTON_PIN));
+    CHECK(!(inputPins & (1u << LED_PIN)));
+
+    // A press on the unused pin shows up in the frames while the loop keeps running
+    const uint32_t first = trace.getSequence();
+    host_gpio_set_levels(~(1u << UNUSED_PIN));
+    for (int pass = 0; pass < 20; pass++) {
+        loopPass(trace);
+        host_time_advance_us(500);
+    }
+    CHECK(trace.getSequence() - first == 10);
+    CHECK((trace.getFrame(trace.getSequence() - 1).rawGpio & inputPins) == (1u << UNUSED_PIN));
+    host_gpio_set_levels(0xffffffffu);
+
+    // Repeated polls leave the pins as they are, a poll without unusedPins puts them back
+    trace.poll(INPUT_TRACE_DEFAULT_INTERVAL_US, 0, true);
+    CHECK(gpio_get_function(UNUSED_PIN) == GPIO_FUNC_SIO);
+    trace.poll(INPUT_TRACE_DEFAULT_INTERVAL_US, 0, false);
+    CHECK(isUnused(UNUSED_PIN) && !gpio_is_pulled_up(UNUSED_PIN));
+    CHECK(gpio_get_function(BUTTON_PIN) == GPIO_FUNC_SIO && gpio_is_pulled_up(BUTTON_PIN));
+
+    // A client that goes away has them put back once the trace goes idle
+    trace.poll(INPUT_TRACE_DEFAULT_INTERVAL_US, 0, true);
+    CHECK(gpio_get_function(UNUSED_PIN) == GPIO_FUNC_SIO);
+    host_time_advance_us(INPUT_TRACE_IDLE_TIMEOUT_US + 1);
+    CHECK(!loopPass(trace));
+    CHECK(isUnused(UNUSED_PIN));
+}
+
+static void testAdcInputs(InputTrace & trace) {
+    host_adc_set(ADC_STICK_PIN - INPUT_TRACE_ADC_FIRST_PIN, 1234);
+    host_adc_set(ADC_USED_PIN - INPUT_TRACE_ADC_FIRST_PIN, 4000);
+    adc_hw->cs = 0;
+
+    const uint8_t adcInputs = (1 << (ADC_STICK_PIN - INPUT_TRACE_ADC_FIRST_PIN))
+        | (1 << (ADC_USED_PIN - INPUT_TRACE_ADC_FIRST_PIN));
+    trace.poll(INPUT_TRACE_DEFAULT_INTERVAL_US, adcInputs, false);
+
+    // The unused stick pin is set up, the one in use as a button and the one not asked for are not
+    CHECK(adc_hw->cs & ADC_CS_EN_BITS);
+    CHECK(gpio_get_function(ADC_STICK_PIN) == GPIO_FUNC_NULL
+        && !(padsbank0_hw->io[ADC_STICK_PIN] & PADS_BANK0_GPIO0_IE_BITS));
+    CHECK(gpio_get_function(ADC_USED_PIN) == GPIO_FUNC_SIO);
+    CHECK(isUnused(ADC_UNUSED_PIN));
+
+    CHECK(loopPass(trace));
+    const InputTraceFrame & frame = trace.getFrame(trace.getSequence() - 1);
+    CHECK(frame.adcMask == (1 << (ADC_STICK_PIN - INPUT_TRACE_ADC_FIRST_PIN)));
+    CHECK(frame.adc[ADC_STICK_PIN - INPUT_TRACE_ADC_FIRST_PIN] == 1234);
+
+    // Stays set up, as the analog add-on would leave it, and capturing a held button leaves it alone
+    host_time_advance_us(INPUT_TRACE_IDLE_TIMEOUT_US + 1);
+    CHECK(!loopPass(trace));
+    CHECK(!(padsbank0_hw->io[ADC_STICK_PIN] & PADS_BANK0_GPIO0_IE_BITS));
+    trace.poll(INPUT_TRACE_DEFAULT_INTERVAL_US, 0, true);
+    CHECK(gpio_get_function(ADC_STICK_PIN) == GPIO_FUNC_NULL);
+    trace.poll(INPUT_TRACE_DEFAULT_INTERVAL_US, 0, false);
+}
+
+int main() {
+    setupBoard();
+    InputTrace & trace = InputTrace::getInstance();
+    testUnusedPins(trace);
+    testAdcInputs(trace);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures != 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// Button bits of the reports the drivers send, built by GamepadReportPacker from each mode's table, against the
+// pressedX() ternaries the drivers used before, kept in corpus/ as the reference. Every combination of the 16 core
+// buttons and 4 dpad directions goes through the booted driver's process() and out over the shim's USB, once on
+// its own and once with a pattern of E1-E12 and stray DU-DR bits set. Usage:
+//   report_packer_test --mode xinput|xboxoriginal|switch|hid|ps3
+
+#include <stdio.h>
+#include <string.h>
+
+#include "harness.h"
+#include "drivermanager.h"
+#include "storagemanager.h"
+
+#include "enums.pb.h"
+
+#include "../corpus/legacy_reports.h"
+
+// Button bits of a sent report, in the reference's layout
+static uint32_t sentXInput(const uint8_t * report) {
+    const XInputReport * xinput = reinterpret_cast<const XInputReport *>(report);
+    return xinput->buttons1 | (xinput->buttons2 << 8);
+}
+
+static uint32_t sentXboxOriginal(const uint8_t * report) {
+    return reinterpret_cast<const USB_XboxGamepad_InReport_t *>(report)->dButtons;
+}
+
+static uint32_t sentSwitch(const uint8_t * report) {
+    return reinterpret_cast<const SwitchReport *>(report)->buttons;
+}
+
+static uint32_t sentHID(const uint8_t * report) {
+    return reinterpret_cast<const HIDReport *>(report)->buttons;
+}
+
+static uint32_t sentPS3(const uint8_t * report) {
+    const uint8_t * buttons = report + PS3_REPORT_BUTTONS_OFFSET;
+    return buttons[0] | (buttons[1] << 8) | (buttons[2] << 16);
+}
+
+static const struct {
+    const char * name;
+    InputMode mode;
+    uint32_t (*legacy)(Gamepad &);
+    uint32_t (*sent)(const uint8_t *);
+} reportModes[] = {
+    { "xinput", INPUT_MODE_XINPUT, legacyXInput, sentXInput },
+    { "xboxoriginal", INPUT_MODE_XBOXORIGINAL, legacyXboxOriginal, sentXboxOriginal },
+    { "switch", INPUT_MODE_SWITCH, legacySwitch, sentSwitch },
+    { "hid", INPUT_MODE_GENERIC, legacyHID, sentHID },
+    { "ps3", INPUT_MODE_PS3, legacyPS3, sentPS3 },
+};
+
+int main(int argc, char ** argv) {
+    const char * name = (argc > 2 && strcmp(argv[1], "--mode") == 0) ? argv[2] : "";
+    const auto * reportMode = &reportModes[0];
+    for (; reportMode != reportModes + sizeof(reportModes) / sizeof(reportModes[0]); reportMode++) {
+        if (strcmp(reportMode->name, name) == 0)
+            break;
+    }
+    if (reportMode == reportModes + sizeof(reportModes) / sizeof(reportModes[0])) {
+        fprintf(stderr, "usage: %s --mode xinput|xboxoriginal|switch|hid|ps3\n", argv[0]);
+        return 2;
+    }
+
+    const InputMode mode = reportMode->mode;
+    provisionConfig([mode](Config & config) { config.gamepadOptions.inputMode = mode; });
+    GP2040 * gp2040 = bootFirmware();
+    host_time_advance_us(100 * 1000);
+    gp2040->loop();
+
+    GPDriver * driver = DriverManager::getInstance().getDriver();
+    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+    uint32_t combinations = 0;
+    uint32_t mismatches = 0;
+    for (uint32_t extras = 0; extras < 2; extras++) {
+        for (uint32_t combination = 0; combination < (1u << 20); combination++) {
+            gamepad->state.buttons = combination & 0xFFFF;
+            gamepad->state.dpad = combination >> 16;
+            if (extras)
+                gamepad->state.buttons |= (combination * 0x9E3779B9u) & 0xFFFF0000u;
+            driver->process(gamepad);
+
+            // The transfer completes in the next frame
+            host_time_advance_us(1000);
+            tud_task();
+
+            uint16_t length = 0;
+            const uint8_t * report = host_usb_last_report(&length);
+            const uint32_t expected = reportMode->legacy(*gamepad);
+            const uint32_t sent = length ? reportMode->sent(report) : ~expected;
+            if (sent != expected && mismatches++ < 3)
+                fprintf(stderr, "buttons %08x dpad %x: sent %06x, expected %06x\n", gamepad->state.buttons,
+                    gamepad->state.dpad, sent, expected);
+            combinations++;
+        }
+    }
+
+    printf("%s: %u button states, %u mismatches, %u reports\n", reportMode->name, combinations, mismatches,
+        host_usb_report_count());
+    printf("%s\n", mismatches ? "FAILED" : "OK");
+    return mismatches != 0;
+}
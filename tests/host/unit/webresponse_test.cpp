@@ -0,0 +1,137 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+// WebResponse as httpd reads it: fs_read_custom() asks for the next chunk at the file index until nothing is left.
+// Responses of several body sizes, with and without an ETag, and the header-only 304 are read at every chunk size
+// around the header/body boundary and the end, and must come out as the header followed by the body, with a
+// Content-Length that matches.
+
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include <string>
+
+#include "webresponse.h"
+
+static int failures = 0;
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+// The whole response in one read
+static std::string readAll(const WebResponse & response) {
+    std::string all(response.getLength() + 16, '\0');
+    all.resize(response.read(0, &all[0], all.size()));
+    return all;
+}
+
+// As httpd does, chunk by chunk from the start until a read returns nothing
+static std::string readChunked(const WebResponse & response, size_t chunk) {
+    std::string all;
+    std::string buffer(chunk, '\0');
+    size_t offset = 0;
+    for (;;) {
+        const size_t length = response.read(offset, &buffer[0], chunk);
+        if (length == 0)
+            break;
+        CHECK(length <= chunk);
+        all.append(buffer, 0, length);
+        offset += length;
+    }
+    return all;
+}
+
+static size_t headerEnd(const std::string & response) {
+    const size_t end = response.find("\r\n\r\n");
+    return (end == std::string::npos) ? std::string::npos : end + 4;
+}
+
+static void checkReads(const WebResponse & response, const std::string & expected, size_t headerLength) {
+    CHECK(response.getLength() == expected.size());
+    CHECK(readAll(response) == expected);
+
+    // Chunk sizes from single bytes to more than the whole response, around httpd's send buffer and the MSS
+    static const size_t chunks[] = { 1, 2, 3, 7, 64, 255, 256, 257, 536, 1460, 2920 };
+    for (size_t chunk : chunks)
+        CHECK(readChunked(response, chunk) == expected);
+    CHECK(readChunked(response, expected.size()) == expected);
+    CHECK(readChunked(response, expected.size() + 1) == expected);
+
+    // Single reads that start just before, at and after the header/body boundary and the end
+    char buffer[64];
+    const size_t offsets[] = { headerLength - 2, headerLength - 1, headerLength, headerLength + 1,
+        expected.size() - 2, expected.size() - 1, expected.size(), expected.size() + 5 };
+    for (size_t offset : offsets) {
+        for (size_t count = 1; count <= sizeof(buffer); count *= 2) {
+            const size_t length = response.read(offset, buffer, count);
+            const std::string part = (offset < expected.size()) ? expected.substr(offset, count) : std::string();
+            CHECK(length == part.size() && memcmp(buffer, part.data(), length) == 0);
+        }
+    }
+}
+
+static void testBodies() {
+    std::mt19937 rng(2040);
+    static const size_t sizes[] = { 1, 2, 100, 1459, 1460, 1461, 5000, 16384 };
+    for (size_t size : sizes) {
+        for (int tagged = 0; tagged < 2; tagged++) {
+            // Binary bodies with zero bytes, as getConfigBinary and getInputTrace send
+            std::string body(size, '\0');
+            for (char & c : body)
+                c = (char)(rng() & ((rng() % 4 == 0) ? 0 : 0xFF));
+
+            WebResponse response(std::string(body), HttpStatusCode::_200, "application/octet-stream");
+            if (tagged)
+                response.setETag("\"0badc0de-12345678\"");
+            const std::string all = readAll(response);
+            const size_t headerLength = headerEnd(all);
+            CHECK(headerLength != std::string::npos && headerLength + size == all.size());
+            if (headerLength == std::string::npos)
+                continue;
+
+            const std::string header = all.substr(0, headerLength);
+            CHECK(header.compare(0, 15, "HTTP/1.0 200 OK") == 0);
+            CHECK(header.find("Content-Type: application/octet-stream\r\n") != std::string::npos);
+            CHECK(header.find("Content-Length: " + std::to_string(size) + "\r\n") != std::string::npos);
+            CHECK((header.find("ETag: \"0badc0de-12345678\"\r\n") != std::string::npos) == (tagged != 0));
+            CHECK(all.compare(headerLength, size, body) == 0);
+            checkReads(response, all, headerLength);
+        }
+    }
+}
+
+// Error responses keep their status and default to JSON
+static void testStatus() {
+    WebResponse response(std::string("{ \"error\": \"invalid config data\" }"), HttpStatusCode::_400);
+    const std::string all = readAll(response);
+    CHECK(all.compare(0, 24, "HTTP/1.0 400 Bad Request") == 0);
+    CHECK(all.find("Content-Type: application/json\r\n") != std::string::npos);
+    CHECK(all.find("Content-Length: 34\r\n") != std::string::npos);
+    checkReads(response, all, headerEnd(all));
+}
+
+// The client's copy is current: headers with the tag, no Content-Type, Content-Length or body
+static void testNotModified() {
+    WebResponse response("\"0badc0de-12345678\"");
+    const std::string all = readAll(response);
+    CHECK(all.compare(0, 25, "HTTP/1.0 304 Not Modified") == 0);
+    CHECK(all.find("ETag: \"0badc0de-12345678\"\r\n") != std::string::npos);
+    CHECK(all.find("Content-Length") == std::string::npos);
+    CHECK(all.find("Content-Type") == std::string::npos);
+    CHECK(headerEnd(all) == all.size());
+    checkReads(response, all, all.size());
+}
+
+int main() {
+    testBodies();
+    testStatus();
+    testNotModified();
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures != 0;
+}
@@ -1,5 +1,6 @@
 import path from 'node:path';
 import fs from 'node:fs';
+import { createHash } from 'node:crypto';
 
 import { fileURLToPath } from 'node:url';
 
@@ -54,6 +55,12 @@ const skipCompressionExtensions = new Set(['png', 'json']);
 
 const serverHeader = 'GP2040-CE';
 
+// Vite puts a content hash in the names of the files under /assets, a new build never reuses a name
+const immutablePrefix = '/assets/';
+const immutableCacheControl = 'public, max-age=31536000, immutable';
+// Everything else (index.html, favicon, ...) is revalidated on every load, answered with a 304 while unchanged
+const revalidateCacheControl = 'no-cache';
+
 const payloadAlignment = 4;
 const hexBytesPerLine = 16;
 
@@ -172,7 +179,8 @@ function makefsdata() {
 		let compressed = fileContent.buffer;
 		let isCompressed = false;
 		if (!skipCompressionExtensions.has(ext)) {
-			compressed = pako.deflate(fileContent, {
+			// gzip rather than brotli, browsers only accept brotli over HTTPS
+			compressed = pako.gzip(fileContent, {
 				level: 9,
 				windowBits: 15,
 				memLevel: 9,
@@ -195,6 +203,15 @@ function makefsdata() {
 			console.log(`Skipping compression of ${qualifiedName} by file extension`);
 		}
 
+		const payload = isCompressed ? compressed : fileContent;
+		const etag = `"${createHash('sha256')
+			.update(payload)
+			.digest('hex')
+			.slice(0, 16)}"`;
+		const cacheControl = qualifiedName.startsWith(immutablePrefix)
+			? immutableCacheControl
+			: revalidateCacheControl;
+
 		const qualifiedNameLength = CStringLength(qualifiedName) + 1;
 		const paddedQualifiedNameLength =
 			Math.ceil(qualifiedNameLength / payloadAlignment) * payloadAlignment;
@@ -216,8 +233,10 @@ function makefsdata() {
 			true,
 		);
 		if (isCompressed) {
-			fsdata += createHexString('Content-Encoding: deflate\r\n', true);
+			fsdata += createHexString('Content-Encoding: gzip\r\n', true);
 		}
+		fsdata += createHexString(`ETag: ${etag}\r\n`, true);
+		fsdata += createHexString(`Cache-Control: ${cacheControl}\r\n`, true);
 		fsdata += createHexString(
 			`Content-Type: ${contentTypes.get(ext) ?? defaultContentType}\r\n\r\n`,
 			true,
@@ -225,11 +244,21 @@ function makefsdata() {
 		fsdata += `/* raw file data (${
 			isCompressed ? compressed.byteLength : fileContent.byteLength
 		} bytes) */\n`;
-		fsdata += createHexString(isCompressed ? compressed : fileContent);
+		fsdata += createHexString(payload);
+		fsdata += '};\n\n';
+
+		const notModified =
+			'HTTP/1.0 304 Not Modified\r\n' +
+			`Server: ${serverHeader}\r\n` +
+			`ETag: ${etag}\r\n` +
+			`Cache-Control: ${cacheControl}\r\n\r\n`;
+		fsdata += `static const unsigned char notmod_${varName}[] = {\n`;
+		fsdata += createHexString(notModified, true);
 		fsdata += '};\n\n';
 
 		fileInfos.push({
 			varName,
+			etag,
 			paddedQualifiedNameLength,
 			isSsiFile: shtmlExtensions.has(ext),
 		});
@@ -246,7 +275,10 @@ function makefsdata() {
 			fileInfo.isSsiFile
 				? 'FS_FILE_FLAGS_SSI'
 				: 'FS_FILE_FLAGS_HEADER_PERSISTENT'
-		}\n`;
+		},\n`;
+		fsdata += `${JSON.stringify(fileInfo.etag)},\n`;
+		fsdata += `notmod_${fileInfo.varName},\n`;
+		fsdata += `sizeof(notmod_${fileInfo.varName})\n`;
 		fsdata += '}};\n\n';
 
 		prevFile = fileInfo.varName;
@@ -116,6 +116,8 @@ app.get('/api/getGamepadOptions', (req, res) => {
 		fnButtonPin: -1,
 		profileNumber: 2,
 		debounceDelay: 5,
+		debounceMode: 0,
+		fastBoot: 0,
 		inputModeB1: 1,
 		inputModeB2: 0,
 		inputModeB3: 2,
@@ -864,15 +866,39 @@ app.get('/api/getMemoryReport', (req, res) => {
 	});
 });
 
-app.get('/api/getHeldPins', async (req, res) => {
-	await new Promise((resolve) => setTimeout(resolve, 2000));
-	return res.send({
-		heldPins: [7],
-	});
-});
+// Input trace of a board whose GP7 button is held for 300ms every 2s, sticks centered
+let inputTraceSequence = 0;
+let inputTraceLastUs = 0;
+app.post('/api/getInputTrace', (req, res) => {
+	const intervalUs = Math.max(Number(req.body.intervalUs) || 1000, 250);
+	const nowUs = Math.floor(performance.now() * 1000);
+	if (!inputTraceLastUs) inputTraceLastUs = nowUs;
+	const frameCount = Math.min(
+		Math.floor((nowUs - inputTraceLastUs) / intervalUs),
+		256,
+	);
+	const firstUs = inputTraceLastUs + intervalUs;
+	inputTraceLastUs = frameCount < 256 ? inputTraceLastUs + frameCount * intervalUs : nowUs;
+
+	const frameSize = 40;
+	const body = Buffer.alloc(16 + frameCount * frameSize);
+	body.writeUInt32LE(inputTraceSequence, 0);
+	body.writeUInt16LE(frameCount, 4);
+	body.writeUInt16LE(frameSize, 6);
+	body.writeUInt32LE(intervalUs, 8);
+	body.writeUInt32LE(0x03ffffff, 12);
+	for (let i = 0; i < frameCount; i++) {
+		const offset = 16 + i * frameSize;
+		const timeUs = firstUs + i * intervalUs;
+		body.writeUInt32LE(timeUs >>> 0, offset);
+		body.writeUInt32LE(timeUs % 2000000 < 300000 ? 1 << 7 : 0, offset + 4);
+		body.writeUInt8(0x0f, offset + 21);
+		for (let input = 0; input < 4; input++)
+			body.writeUInt16LE(2048, offset + 32 + input * 2);
+	}
+	inputTraceSequence += frameCount;
 
-app.get('/api/abortGetHeldPins', async (req, res) => {
-	return res.send();
+	return res.type('application/octet-stream').send(body);
 });
 
 app.post('/api/getHETriggerCalibration', (req, res) => {
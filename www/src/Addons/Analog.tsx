@@ -10,6 +10,7 @@ import AnalogPinOptions from '../Components/AnalogPinOptions';
 import { AppContext } from '../Contexts/AppContext';
 import FormControl from '../Components/FormControl';
 import { AddonPropTypes } from '../Pages/AddonsConfigPage';
+import WebApi from '../Services/WebApi';
 
 const ANALOG_STICK_MODES = [
 	{ label: 'Left Analog', value: 1 },
@@ -413,29 +414,21 @@ const Analog = ({ values, errors, handleChange, handleCheckbox, setFieldValue }:
 													}
 													
 													
-													// Read current center value
-													console.log(`Fetching joystick 1 center for step ${stepNumber}...`);
-													const res = await fetch('/api/getJoystickCenter');
-													console.log('Response status:', res.status);
-													
-													if (!res.ok) {
-														throw new Error(`HTTP error! status: ${res.status}`);
-													}
-													
-													const data = await res.json();
-													console.log('Response data:', data);
-													
-													if (!data.success || data.error) {
-														alert(t('AddonsConfig:analog-calibration-failed', { error: data.error || 'Unknown error' }));
-														console.error('API Error:', data.error);
+													// Read current center value from the input trace
+													if (!values.AnalogInputEnabled) {
+														alert(t('AddonsConfig:analog-calibration-failed', { error: 'Analog input is not enabled' }));
 														return;
 													}
+													const readings = await WebApi.getAnalogPins([values.analogAdc1PinX, values.analogAdc1PinY]);
+													if (!readings) {
+														throw new Error('No response from the input trace');
+													}
 													
 													calibrationValues.push({
 														step: stepNumber,
 														direction: step.direction,
-														x: data.x || 0,
-														y: data.y || 0
+														x: readings[0] || 0,
+														y: readings[1] || 0
 													});
 													
 													console.log(`Step ${stepNumber} completed:`, calibrationValues[i]);
@@ -698,29 +691,21 @@ const Analog = ({ values, errors, handleChange, handleCheckbox, setFieldValue }:
 													}
 													
 													
-													// Read current center value
-													console.log(`Fetching joystick 2 center for step ${stepNumber}...`);
-													const res = await fetch('/api/getJoystickCenter2');
-													console.log('Response status:', res.status);
-													
-													if (!res.ok) {
-														throw new Error(`HTTP error! status: ${res.status}`);
-													}
-													
-													const data = await res.json();
-													console.log('Response data:', data);
-													
-													if (!data.success || data.error) {
-														alert(t('AddonsConfig:analog-calibration-failed', { error: data.error || 'Unknown error' }));
-														console.error('API Error:', data.error);
+													// Read current center value from the input trace
+													if (!values.AnalogInputEnabled) {
+														alert(t('AddonsConfig:analog-calibration-failed', { error: 'Analog input is not enabled' }));
 														return;
 													}
+													const readings = await WebApi.getAnalogPins([values.analogAdc2PinX, values.analogAdc2PinY]);
+													if (!readings) {
+														throw new Error('No response from the input trace');
+													}
 													
 													calibrationValues.push({
 														step: stepNumber,
 														direction: step.direction,
-														x: data.x || 0,
-														y: data.y || 0
+														x: readings[0] || 0,
+														y: readings[1] || 0
 													});
 													
 													console.log(`Step ${stepNumber} completed:`, calibrationValues[i]);
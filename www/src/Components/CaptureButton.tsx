@@ -45,13 +45,6 @@ const CaptureButton = ({
 
 		if (!isNaN(pin)) onChange(currentLabel, pin);
 
-		// Gets called for both skip and stop
-		if (data.canceled) {
-			await timeout(50);
-			await WebApi.abortGetHeldPins();
-			await timeout(50);
-		}
-
 		if (stopRef.current || !hasNext) return closeAndReset();
 
 		setLabelIndex((index) => index + 1);
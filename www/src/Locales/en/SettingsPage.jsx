@@ -59,7 +59,16 @@ export default {
 	},
 	'profile-label': 'Profile',
 	'debounce-delay-label': 'Debounce Delay in milliseconds',
+	'debounce-mode-label': 'Debounce Mode',
+	'debounce-mode-options': {
+		eager: 'Eager',
+		'eager-press': 'Eager Press, Deferred Release',
+		deferred: 'Deferred',
+	},
 	'mini-menu-gamepad-input': 'Use Gamepad Input for Display Mini Menu',
+	'fast-boot-label': 'Fast Boot',
+	'fast-boot-description':
+		'Start USB before the display, LEDs and buzzer, which come up right after the first report.',
 	'ps4-mode-explanation-text':
 		'PS4 mode allows GP2040-CE to run as an authenticated PS4 controller.',
 	'ps4-mode-warning-text':
@@ -275,6 +275,12 @@ const SOCD_MODES = [
 	{ labelKey: 'socd-cleaning-mode-options.off', value: 4 },
 ];
 
+const DEBOUNCE_MODES = [
+	{ labelKey: 'debounce-mode-options.eager', value: 0 },
+	{ labelKey: 'debounce-mode-options.eager-press', value: 1 },
+	{ labelKey: 'debounce-mode-options.deferred', value: 2 },
+];
+
 const PS4_MODES = [
 	{ labelKey: 'ps4-mode-options.controller', value: 0 },
 	{ labelKey: 'ps4-mode-options.arcadestick', value: 7 },
@@ -469,7 +475,13 @@ const schema = yup.object().shape({
 		.oneOf(AUTHENTICATION_TYPES.map((o) => o.value))
 		.label('X-Input Authentication Type'),
 	debounceDelay: yup.number().required().label('Debounce Delay'),
+	debounceMode: yup
+		.number()
+		.required()
+		.oneOf(DEBOUNCE_MODES.map((o) => o.value))
+		.label('Debounce Mode'),
 	miniMenuGamepadInput: yup.number().required().label('Mini Menu'),
+	fastBoot: yup.number().required().label('Fast Boot'),
 	inputModeB1: yup
 		.number()
 		.required()
@@ -1485,6 +1497,7 @@ export default function SettingsPage() {
 	const translatedInputModeGroups = translateArray(INPUT_MODE_GROUPS);
 	const translatedDpadModes = translateArray(DPAD_MODES);
 	const translatedSocdModes = translateArray(SOCD_MODES);
+	const translatedDebounceModes = translateArray(DEBOUNCE_MODES);
 	const translatedHotkeyActions = translateArray(HOTKEY_ACTIONS);
 	const translatedForcedSetupModes = translateArray(FORCED_SETUP_MODES);
 	// Not currently used but we might add the option at a later date (wheel type, etc.)
@@ -1743,6 +1756,32 @@ export default function SettingsPage() {
 															/>
 														</Col>
 													</Form.Group>
+													<Form.Group className="row mb-3">
+														<Form.Label>
+															{t('SettingsPage:debounce-mode-label')}
+														</Form.Label>
+														<Col sm={3}>
+															<Form.Select
+																name="debounceMode"
+																className="form-select-sm"
+																value={values.debounceMode}
+																onChange={handleChange}
+																isInvalid={errors.debounceMode}
+															>
+																{translatedDebounceModes.map((o, i) => (
+																	<option
+																		key={`button-debounceMode-option-${i}`}
+																		value={o.value}
+																	>
+																		{o.label}
+																	</option>
+																))}
+															</Form.Select>
+															<Form.Control.Feedback type="invalid">
+																{errors.debounceMode}
+															</Form.Control.Feedback>
+														</Col>
+													</Form.Group>
 													<Form.Group className="row mb-5">
 														<Col sm={5}>
 															<Form.Check
@@ -1762,6 +1801,23 @@ export default function SettingsPage() {
 															/>
 														</Col>
 													</Form.Group>
+													<Form.Group className="row mb-5">
+														<Col sm={5}>
+															<Form.Check
+																label={t('SettingsPage:fast-boot-label')}
+																type="switch"
+																id="fastBoot"
+																isInvalid={false}
+																checked={Boolean(values.fastBoot)}
+																onChange={(e) => {
+																	setFieldValue('fastBoot', e.target.checked ? 1 : 0);
+																}}
+															/>
+															<Form.Text muted>
+																{t('SettingsPage:fast-boot-description')}
+															</Form.Text>
+														</Col>
+													</Form.Group>
 													<Button type="submit">
 														{t('Common:button-save-label')}
 													</Button>
@@ -670,23 +670,144 @@ async function setHETriggerOptions(triggers) {
 	return Http.post(`${baseUrl}/api/setHETriggerOptions`, triggers);
 }
 
-async function getHeldPins(abortSignal) {
+const INPUT_TRACE_HEADER_SIZE = 16;
+const INPUT_TRACE_DEFAULT_INTERVAL_US = 1000;
+const INPUT_TRACE_POLL_MS = 50;
+const HELD_PINS_TIMEOUT_MS = 5000;
+const HELD_PINS_DEBOUNCE_US = 5000;
+const ADC_FIRST_PIN = 26;
+
+const sleep = (ms) => new Promise((resolve) => setTimeout(resolve, ms));
+
+// Frames recorded after `since`, see InputTraceBatchHeader/InputTraceFrame in headers/inputtrace.h.
+// `adcInputs` sets up ADC inputs for analog reads, `unusedPins` keeps the unused pins pulled up.
+async function getInputTrace(since, intervalUs, { adcInputs = 0, unusedPins = false } = {}) {
 	try {
-		const response = await Http.get(`${baseUrl}/api/getHeldPins`, {
-			signal: abortSignal,
+		// Binary response, Http only decodes JSON
+		const response = await fetch(`${baseUrl}/api/getInputTrace`, {
+			method: 'POST',
+			headers: { 'Content-Type': 'application/json' },
+			body: JSON.stringify({ since, intervalUs, adcInputs, unusedPins }),
 		});
-		return response.data;
+		const view = new DataView(await response.arrayBuffer());
+		const firstSequence = view.getUint32(0, true);
+		const frameCount = view.getUint16(4, true);
+		const frameSize = view.getUint16(6, true);
+		const frames = [];
+		for (let i = 0; i < frameCount; i++) {
+			const offset = INPUT_TRACE_HEADER_SIZE + i * frameSize;
+			frames.push({
+				timeUs: view.getUint32(offset, true),
+				rawGpio: view.getUint32(offset + 4, true),
+				debouncedGpio: view.getUint32(offset + 8, true),
+				buttons: view.getUint32(offset + 12, true),
+				aux: view.getUint16(offset + 16, true),
+				dpad: view.getUint8(offset + 18),
+				lt: view.getUint8(offset + 19),
+				rt: view.getUint8(offset + 20),
+				adcMask: view.getUint8(offset + 21),
+				loops: view.getUint16(offset + 22, true),
+				lx: view.getUint16(offset + 24, true),
+				ly: view.getUint16(offset + 26, true),
+				rx: view.getUint16(offset + 28, true),
+				ry: view.getUint16(offset + 30, true),
+				adc: [0, 1, 2, 3].map((input) =>
+					view.getUint16(offset + 32 + input * 2, true),
+				),
+			});
+		}
+		return {
+			firstSequence,
+			nextSequence: firstSequence + frameCount,
+			intervalUs: view.getUint32(8, true),
+			inputPins: view.getUint32(12, true),
+			frames,
+		};
 	} catch (error) {
-		if (error?.name === 'AbortError') return { canceled: true };
-		else console.error(error);
+		console.error(error);
 	}
 }
 
-async function abortGetHeldPins() {
+// Pins held for a moment and released, or none after HELD_PINS_TIMEOUT_MS. Read from the input trace,
+// the board keeps running its loop and serving requests while the button is held.
+async function getHeldPins(abortSignal) {
+	// Only frames recorded after the first poll pulled up the unused pins, before they may be floating
+	let since = (
+		await getInputTrace(0, INPUT_TRACE_DEFAULT_INTERVAL_US, { unusedPins: true })
+	)?.nextSequence;
+	let idleLevels;
+	const heldSinceUs = {};
+	const heldPins = new Set();
+	const startTime = Date.now();
+
 	try {
-		await Http.get(`${baseUrl}/api/abortGetHeldPins`);
-	} catch (error) {
-		// Expected to fail
+		while (since !== undefined) {
+			await sleep(INPUT_TRACE_POLL_MS);
+			if (abortSignal?.aborted) return { canceled: true };
+
+			const batch = await getInputTrace(since, INPUT_TRACE_DEFAULT_INTERVAL_US, {
+				unusedPins: true,
+			});
+			if (!batch) return;
+			since = batch.nextSequence;
+
+			for (const frame of batch.frames) {
+				const levels = (frame.rawGpio & batch.inputPins) >>> 0;
+				if (idleLevels === undefined) idleLevels = levels;
+				const changed = (levels ^ idleLevels) >>> 0;
+
+				// Pins released
+				if (heldPins.size > 0 && changed === 0)
+					return { heldPins: [...heldPins].sort((a, b) => a - b) };
+
+				for (let pin = 0; pin < 32; pin++) {
+					if (!(changed & (1 << pin))) delete heldSinceUs[pin];
+					else if (heldSinceUs[pin] === undefined)
+						heldSinceUs[pin] = frame.timeUs;
+					else if ((frame.timeUs - heldSinceUs[pin]) >>> 0 > HELD_PINS_DEBOUNCE_US)
+						heldPins.add(pin);
+				}
+			}
+
+			if (heldPins.size === 0 && Date.now() - startTime >= HELD_PINS_TIMEOUT_MS)
+				return { heldPins: [] };
+		}
+	} finally {
+		// Puts the unused pins back instead of waiting for the trace to go idle
+		if (since !== undefined)
+			await getInputTrace(since, INPUT_TRACE_DEFAULT_INTERVAL_US);
+	}
+}
+
+// Current readings of the ADC pins (GPIO26-29), in the order asked for, undefined for other pins.
+// Pins nothing set up for analog reads yet are set up by the first poll.
+async function getAnalogPins(pins) {
+	const adcInputs = pins.reduce(
+		(mask, pin) =>
+			pin >= ADC_FIRST_PIN && pin < ADC_FIRST_PIN + 4
+				? mask | (1 << (pin - ADC_FIRST_PIN))
+				: mask,
+		0,
+	);
+	let batch = await getInputTrace(0, INPUT_TRACE_DEFAULT_INTERVAL_US, {
+		adcInputs,
+	});
+	const since = batch?.nextSequence;
+
+	for (let poll = 0; batch && poll * INPUT_TRACE_POLL_MS < 1000; poll++) {
+		await sleep(INPUT_TRACE_POLL_MS);
+		batch = await getInputTrace(since, INPUT_TRACE_DEFAULT_INTERVAL_US, {
+			adcInputs,
+		});
+		const frame = batch?.frames
+			.filter((frame) => (frame.adcMask & adcInputs) === adcInputs)
+			.at(-1);
+		if (frame)
+			return pins.map((pin) =>
+				adcInputs & (1 << (pin - ADC_FIRST_PIN))
+					? frame.adc[pin - ADC_FIRST_PIN]
+					: undefined,
+			);
 	}
 }
 
@@ -741,6 +862,7 @@ export default {
 	setSplashImage,
 	getUsedPins,
 	getHeldPins,
-	abortGetHeldPins,
+	getInputTrace,
+	getAnalogPins,
 	reboot,
 };